@@ -0,0 +1,197 @@
+/**
+ * @file llasynclog_libtest.cpp
+ * @brief Benchmark of log call cost under contention, synchronous against asynchronous file logging
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+// Linden library includes
+#include "llerror.h"
+#include "llerrorcontrol.h"
+#include "llfile.h"
+#include "lltimer.h"
+
+// system libraries
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// doc string provided when invoking the program with --help
+static const char USAGE[] = "\n"
+"usage:\tllasynclog_libtest [options]\n"
+"\n"
+"Logs from several threads at once to a log file: with the file written\n"
+"on the logging thread, through the asynchronous writer, and through the\n"
+"asynchronous writer with LL_INFOS_ARGS records formatted by the writer\n"
+"thread.  Reports the cost of a log call in each mode along with the\n"
+"number of lines that reached the file.\n"
+"\n"
+" -h, --help\n"
+"        Print this help\n"
+" -t, --threads <n>\n"
+"        Number of logging threads. Default is 4.\n"
+" -n, --lines <n>\n"
+"        Lines logged by each thread. Default is 20000.\n"
+" -o, --output <file>\n"
+"        Log file to write. Default is llasynclog_libtest.log.\n"
+" --no-flush\n"
+"        Do not flush the log file after each line in synchronous mode.\n"
+"\n";
+
+namespace
+{
+    enum EMode
+    {
+        MODE_SYNC,
+        MODE_ASYNC,
+        MODE_ASYNC_ARGS
+    };
+
+    struct BenchResult
+    {
+        F64 mMicrosecondsPerCall;
+        S32 mLinesWritten;
+    };
+
+    S32 count_lines(const std::string& filename)
+    {
+        std::ifstream in(filename.c_str());
+        std::string line;
+        S32 count = 0;
+        while (std::getline(in, line))
+        {
+            if (line.find("benchmark line") != std::string::npos)
+            {
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    BenchResult run_bench(const std::string& filename, EMode mode, S32 num_threads, S32 num_lines)
+    {
+        LLFile::remove(filename, ENOENT);
+        LLError::setAsyncLogging(mode != MODE_SYNC);
+        LLError::logToFile(filename);
+
+        std::vector<F64> elapsed(num_threads);
+        std::vector<std::thread> threads;
+        for (S32 t = 0; t < num_threads; ++t)
+        {
+            threads.emplace_back([&elapsed, t, mode, num_lines]()
+            {
+                LLTimer timer;
+                for (S32 i = 0; i < num_lines; ++i)
+                {
+                    if (mode == MODE_ASYNC_ARGS)
+                    {
+                        LL_INFOS_ARGS("Benchmark", "thread ", t, " benchmark line ", i);
+                    }
+                    else
+                    {
+                        LL_INFOS("Benchmark") << "thread " << t << " benchmark line " << i << LL_ENDL;
+                    }
+                }
+                elapsed[t] = timer.getElapsedTimeF64();
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        // closing the file drains the asynchronous writer
+        LLError::logToFile(std::string());
+
+        F64 total = 0.0;
+        for (F64 seconds : elapsed)
+        {
+            total += seconds;
+        }
+
+        BenchResult result;
+        result.mMicrosecondsPerCall = total * 1000000.0 / ((F64)num_threads * num_lines);
+        result.mLinesWritten = count_lines(filename);
+        return result;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    S32 num_threads = 4;
+    S32 num_lines = 20000;
+    std::string filename = "llasynclog_libtest.log";
+    bool flush = true;
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        if (!strcmp(argv[arg], "--help") || !strcmp(argv[arg], "-h"))
+        {
+            std::cout << USAGE << std::endl;
+            return 0;
+        }
+        else if ((!strcmp(argv[arg], "--threads") || !strcmp(argv[arg], "-t")) && arg < argc-1)
+        {
+            num_threads = llmax(1, atoi(argv[++arg]));
+        }
+        else if ((!strcmp(argv[arg], "--lines") || !strcmp(argv[arg], "-n")) && arg < argc-1)
+        {
+            num_lines = llmax(1, atoi(argv[++arg]));
+        }
+        else if ((!strcmp(argv[arg], "--output") || !strcmp(argv[arg], "-o")) && arg < argc-1)
+        {
+            filename = argv[++arg];
+        }
+        else if (!strcmp(argv[arg], "--no-flush"))
+        {
+            flush = false;
+        }
+        else
+        {
+            std::cerr << "Unknown argument " << argv[arg] << USAGE << std::endl;
+            return 1;
+        }
+    }
+
+    LLError::setDefaultLevel(LLError::LEVEL_INFO);
+    LLError::setTimeFunction(LLError::utcTime);
+    LLError::setAlwaysFlush(flush);
+
+    const S32 total = num_threads * num_lines;
+    std::cout << num_threads << " threads logging " << num_lines << " lines each" << std::endl;
+
+    const char* names[] = { "synchronous:  ", "asynchronous: ", "deferred:     " };
+    for (EMode mode : { MODE_SYNC, MODE_ASYNC, MODE_ASYNC_ARGS })
+    {
+        BenchResult result = run_bench(filename, mode, num_threads, num_lines);
+        std::cout << names[mode] << result.mMicrosecondsPerCall << " us per call, "
+                  << result.mLinesWritten << " of " << total << " lines written" << std::endl;
+    }
+
+    LLFile::remove(filename, ENOENT);
+    return 0;
+}
@@ -0,0 +1,694 @@
+/**
+ * @file llcharacter_libtest.cpp
+ * @brief Headless benchmark of avatar animation evaluation
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+// Linden library includes
+#include "llapr.h"
+#include "llcharacter.h"
+#include "lldatapacker.h"
+#include "llframetimer.h"
+#include "lljoint.h"
+#include "lljointhierarchy.h"
+#include "llkeyframemotion.h"
+#include "llparallelfor.h"
+#include "llquantize.h"
+#include "lltimer.h"
+#include "llxmltree.h"
+#include "threadpool.h"
+
+// system libraries
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <thread>
+
+// doc string provided when invoking the program with --help
+static const char USAGE[] = "\n"
+"usage:\tllcharacter_libtest [options]\n"
+"\n"
+"Animates a crowd of skeletons through LLMotionController, once with every\n"
+"avatar evaluated in turn and once with the per-avatar evaluation (keyframe\n"
+"sampling, constraints and pose blending) run as parallel jobs, and reports\n"
+"the throughput of each in avatars per millisecond.\n"
+"\n"
+" -h, --help\n"
+"        Print this help\n"
+" -i, --input <file1 .. file2>\n"
+"        .anim files to play. Without any, a set of procedural clips\n"
+"        covering the base skeleton is generated.\n"
+" -s, --skeleton <file>\n"
+"        Skeleton definition. Default is character/avatar_skeleton.xml,\n"
+"        relative to the viewer's working directory (indra/newview).\n"
+" -n, --avatars <n>\n"
+"        Number of avatars. Default is 100.\n"
+" -m, --motions <n>\n"
+"        Motions played at once by each avatar. Default is 2.\n"
+" -f, --frames <n>\n"
+"        Frames to time for each mode. Default is 300.\n"
+" -t, --threads <n>\n"
+"        Threads helping the main thread in parallel mode. Default is one\n"
+"        less than the number of hardware threads.\n"
+" --flatten\n"
+"        Update joint world matrices through LLJointHierarchy.\n"
+" --check-deferred\n"
+"        Instead of timing, check that motions started and stopped by other\n"
+"        motions during the parallel evaluation only take effect once the\n"
+"        evaluation is finished, then exit.\n"
+"\n";
+
+static const std::string POOL_NAME("General");
+
+//-----------------------------------------------------------------------------
+// LLBenchCharacter
+// A bare skeleton with just enough of LLCharacter to run keyframe motions.
+//-----------------------------------------------------------------------------
+class LLBenchCharacter : public LLCharacter
+{
+public:
+    LLBenchCharacter(LLXmlTreeNode* skeleton, const LLVector3& position, bool flatten) :
+        mID(LLUUID::generateNewID()),
+        mPosition(position)
+    {
+        mRoot.setup("mRoot");
+        mRoot.setPosition(position);
+        for (LLXmlTreeNode* child = skeleton->getFirstChild(); child; child = skeleton->getNextChild())
+        {
+            if (child->hasName("bone"))
+            {
+                addBone(child, &mRoot);
+            }
+        }
+        if (flatten)
+        {
+            mHierarchy.reset(new LLJointHierarchy(&mRoot));
+        }
+        mRoot.updateWorldMatrixChildren();
+    }
+
+    ~LLBenchCharacter()
+    {
+        // motions keep joint states pointing at our joints
+        flushAllMotions();
+        mHierarchy.reset();
+    }
+
+    LLJointHierarchy* getHierarchy() const { return mHierarchy.get(); }
+
+    // LLCharacter interface
+    const char* getAnimationPrefix() override { return "avatar"; }
+    LLJoint* getRootJoint() override { return &mRoot; }
+    LLVector3 getCharacterPosition() override { return mPosition; }
+    LLQuaternion getCharacterRotation() override { return LLQuaternion::DEFAULT; }
+    LLVector3 getCharacterVelocity() override { return LLVector3::zero; }
+    LLVector3 getCharacterAngularVelocity() override { return LLVector3::zero; }
+    void getGround(const LLVector3& in_pos, LLVector3& out_pos, LLVector3& out_norm) override
+    {
+        out_pos = in_pos;
+        out_pos.mV[VZ] = 0.f;
+        out_norm = LLVector3::z_axis;
+    }
+    LLJoint* getCharacterJoint(U32 i) override { return i < mBones.size() ? mBones[i].get() : NULL; }
+    F32 getTimeDilation() override { return 1.f; }
+    F32 getPixelArea() const override { return 100000.f; }
+    LLPolyMesh* getHeadMesh() override { return NULL; }
+    LLPolyMesh* getUpperBodyMesh() override { return NULL; }
+    LLVector3d getPosGlobalFromAgent(const LLVector3& position) override { return LLVector3d(position); }
+    LLVector3 getPosAgentFromGlobal(const LLVector3d& position) override { return LLVector3(position); }
+    void addDebugText(const std::string& text) override {}
+    const LLUUID& getID() const override { return mID; }
+
+    LLVector3 getVolumePos(S32 joint_index, LLVector3& volume_offset) override
+    {
+        LLJoint* volume = findCollisionVolume(joint_index);
+        if (!volume)
+        {
+            return LLVector3::zero;
+        }
+        LLVector3 result = volume_offset;
+        result.scaleVec(volume->getScale());
+        result.rotVec(volume->getWorldRotation());
+        return result + volume->getWorldPosition();
+    }
+
+    LLJoint* findCollisionVolume(S32 volume_id) override
+    {
+        return (volume_id >= 0 && volume_id < (S32)mVolumes.size()) ? mVolumes[volume_id].get() : NULL;
+    }
+
+    S32 getCollisionVolumeID(std::string& name) override
+    {
+        for (S32 i = 0; i < (S32)mVolumes.size(); ++i)
+        {
+            if (mVolumes[i]->getName() == name)
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+private:
+    static void readTransform(LLXmlTreeNode* node, LLJoint* joint)
+    {
+        LLVector3 pos, rot, scale(1.f, 1.f, 1.f);
+        node->getAttributeVector3("pos", pos);
+        node->getAttributeVector3("rot", rot);
+        node->getAttributeVector3("scale", scale);
+        joint->setPosition(pos);
+        joint->setRotation(mayaQ(rot.mV[VX], rot.mV[VY], rot.mV[VZ], LLQuaternion::XYZ));
+        joint->setScale(scale);
+    }
+
+    void addBone(LLXmlTreeNode* node, LLJoint* parent)
+    {
+        std::string name;
+        node->getAttributeString("name", name);
+
+        mBones.emplace_back(new LLJoint());
+        LLJoint* bone = mBones.back().get();
+        bone->setup(name, parent);
+        bone->setJointNum((S32)mBones.size() - 1);
+        readTransform(node, bone);
+
+        for (LLXmlTreeNode* child = node->getFirstChild(); child; child = node->getNextChild())
+        {
+            if (child->hasName("bone"))
+            {
+                addBone(child, bone);
+            }
+            else if (child->hasName("collision_volume"))
+            {
+                std::string volume_name;
+                child->getAttributeString("name", volume_name);
+                mVolumes.emplace_back(new LLJoint(volume_name, bone));
+                readTransform(child, mVolumes.back().get());
+            }
+        }
+    }
+
+    LLUUID mID;
+    LLVector3 mPosition;
+    LLJoint mRoot;
+    std::vector<std::unique_ptr<LLJoint> > mBones;
+    std::vector<std::unique_ptr<LLJoint> > mVolumes;
+    std::unique_ptr<LLJointHierarchy> mHierarchy;
+};
+
+//-----------------------------------------------------------------------------
+// LLBenchKeyframeLoader
+// Decodes an animation into LLKeyframeDataCache, where every character's
+// motion instance finds it on initialization instead of fetching it.
+//-----------------------------------------------------------------------------
+class LLBenchKeyframeLoader : public LLKeyframeMotion
+{
+public:
+    LLBenchKeyframeLoader(const LLUUID& id) : LLKeyframeMotion(id) {}
+
+    bool load(LLCharacter* character, std::vector<U8>& data)
+    {
+        mCharacter = character;
+        LLDataPackerBinaryBuffer dp(data.data(), (S32)data.size());
+        return deserialize(dp, getID());
+    }
+};
+
+//-----------------------------------------------------------------------------
+// LLBenchTriggerMotion
+// On its first update, starts one motion and stops another, as a keyframe
+// motion with an emote does.
+//-----------------------------------------------------------------------------
+class LLBenchTriggerMotion : public LLNullMotion
+{
+public:
+    LLBenchTriggerMotion(const LLUUID& id) : LLNullMotion(id), mCharacter(NULL) {}
+    static LLMotion* create(const LLUUID& id) { return new LLBenchTriggerMotion(id); }
+
+    LLMotionInitStatus onInitialize(LLCharacter* character) override
+    {
+        mCharacter = character;
+        return STATUS_SUCCESS;
+    }
+
+    bool onUpdate(F32 activeTime, U8* joint_mask) override
+    {
+        if (!sTriggered)
+        {
+            sTriggered = true;
+            mCharacter->startMotion(sStartID);
+            mCharacter->stopMotion(sStopID);
+        }
+        return true;
+    }
+
+    static LLUUID sStartID;
+    static LLUUID sStopID;
+    static bool sTriggered;
+
+private:
+    LLCharacter* mCharacter;
+};
+
+LLUUID LLBenchTriggerMotion::sStartID;
+LLUUID LLBenchTriggerMotion::sStopID;
+bool LLBenchTriggerMotion::sTriggered = false;
+
+// Looping clip of sinusoidal swings on every named joint, plus a pelvis bob,
+// in the same format LLKeyframeMotion::serialize() writes.
+static std::vector<U8> make_procedural_anim(const std::vector<std::string>& joints, S32 variant)
+{
+    const S32 NUM_KEYS = 30;
+    const F32 duration = 1.f + 0.25f * (F32)variant;
+
+    std::vector<U8> buffer(256 + joints.size() * (64 + NUM_KEYS * 16));
+    LLDataPackerBinaryBuffer dp(buffer.data(), (S32)buffer.size());
+
+    dp.packU16(KEYFRAME_MOTION_VERSION, "version");
+    dp.packU16(KEYFRAME_MOTION_SUBVERSION, "sub_version");
+    dp.packS32(LLJoint::MEDIUM_PRIORITY + (variant % 2), "base_priority");
+    dp.packF32(duration, "duration");
+    dp.packString(std::string(), "emote_name");
+    dp.packF32(0.f, "loop_in_point");
+    dp.packF32(duration, "loop_out_point");
+    dp.packS32(1, "loop");
+    dp.packF32(0.3f, "ease_in_duration");
+    dp.packF32(0.3f, "ease_out_duration");
+    dp.packU32(0, "hand_pose");
+    dp.packU32((U32)joints.size(), "num_joints");
+
+    for (size_t j = 0; j < joints.size(); ++j)
+    {
+        const bool pelvis = (joints[j] == "mPelvis");
+        const F32 phase = (F32)(j + variant) * 0.7f;
+        const F32 swing = 0.15f + 0.05f * (F32)((j + variant) % 4);
+
+        dp.packString(joints[j], "joint_name");
+        dp.packS32(LLJoint::USE_MOTION_PRIORITY, "joint_priority");
+
+        dp.packS32(NUM_KEYS, "num_rot_keys");
+        for (S32 k = 0; k < NUM_KEYS; ++k)
+        {
+            const F32 t = duration * (F32)k / (F32)(NUM_KEYS - 1);
+            const F32 a = F_TWO_PI * (F32)k / (F32)(NUM_KEYS - 1) + phase;
+            LLQuaternion rot(swing * sinf(a), LLVector3((F32)(j % 3 == 0), (F32)(j % 3 == 1), (F32)(j % 3 == 2)));
+            LLVector3 packed = rot.packToVector3();
+            dp.packU16(F32_to_U16(t, 0.f, duration), "time");
+            dp.packU16(F32_to_U16(packed.mV[VX], -1.f, 1.f), "rot_angle_x");
+            dp.packU16(F32_to_U16(packed.mV[VY], -1.f, 1.f), "rot_angle_y");
+            dp.packU16(F32_to_U16(packed.mV[VZ], -1.f, 1.f), "rot_angle_z");
+        }
+
+        dp.packS32(pelvis ? NUM_KEYS : 0, "num_pos_keys");
+        for (S32 k = 0; pelvis && k < NUM_KEYS; ++k)
+        {
+            const F32 t = duration * (F32)k / (F32)(NUM_KEYS - 1);
+            const F32 bob = 0.05f * sinf(2.f * F_TWO_PI * (F32)k / (F32)(NUM_KEYS - 1));
+            dp.packU16(F32_to_U16(t, 0.f, duration), "time");
+            dp.packU16(F32_to_U16(0.f, -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET), "pos_x");
+            dp.packU16(F32_to_U16(0.f, -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET), "pos_y");
+            dp.packU16(F32_to_U16(bob, -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET), "pos_z");
+        }
+    }
+
+    dp.packS32(0, "num_constraints");
+    buffer.resize(dp.getCurrentSize());
+    return buffer;
+}
+
+static void collect_base_bones(LLXmlTreeNode* node, std::vector<std::string>& names)
+{
+    for (LLXmlTreeNode* child = node->getFirstChild(); child; child = node->getNextChild())
+    {
+        if (child->hasName("bone"))
+        {
+            std::string support;
+            child->getAttributeString("support", support);
+            if (support == "base")
+            {
+                std::string name;
+                child->getAttributeString("name", name);
+                names.push_back(name);
+            }
+            collect_base_bones(child, names);
+        }
+    }
+}
+
+static bool read_file(const std::string& name, std::vector<U8>& data)
+{
+    std::ifstream file(name.c_str(), std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return !data.empty();
+}
+
+typedef std::vector<std::unique_ptr<LLBenchCharacter> > crowd_t;
+
+// Update joint world matrices, after every pose is in
+static void update_world_matrices(const crowd_t& crowd, bool flatten)
+{
+    if (flatten)
+    {
+        std::vector<LLJointHierarchy*> hierarchies;
+        for (const auto& character : crowd)
+        {
+            hierarchies.push_back(character->getHierarchy());
+        }
+        LLJointHierarchy::updateAll(hierarchies);
+    }
+    else
+    {
+        for (const auto& character : crowd)
+        {
+            character->getRootJoint()->updateWorldMatrixChildren();
+        }
+    }
+}
+
+static void run_serial_frame(const crowd_t& crowd, bool flatten)
+{
+    for (const auto& character : crowd)
+    {
+        character->updateMotions(LLCharacter::NORMAL_UPDATE);
+    }
+    update_world_matrices(crowd, flatten);
+}
+
+static void run_parallel_frame(const crowd_t& crowd, bool flatten, std::vector<LLBenchCharacter*>& pending)
+{
+    pending.clear();
+    for (const auto& character : crowd)
+    {
+        if (character->prepareMotions(LLCharacter::NORMAL_UPDATE))
+        {
+            pending.push_back(character.get());
+        }
+    }
+
+    LL::parallelFor(POOL_NAME, pending.size(), 1,
+                    [&pending](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            pending[i]->evaluateMotions();
+                        }
+                    });
+
+    for (const auto& character : crowd)
+    {
+        character->finishMotions();
+    }
+    update_world_matrices(crowd, flatten);
+}
+
+// Returns milliseconds spent over 'frames' frames
+static F64 time_frames(const crowd_t& crowd, S32 frames, bool parallel, bool flatten)
+{
+    std::vector<LLBenchCharacter*> pending;
+    pending.reserve(crowd.size());
+
+    LLTimer timer;
+    for (S32 frame = 0; frame < frames; ++frame)
+    {
+        LLFrameTimer::updateFrameTime();
+        if (parallel)
+        {
+            run_parallel_frame(crowd, flatten, pending);
+        }
+        else
+        {
+            run_serial_frame(crowd, flatten);
+        }
+    }
+    return timer.getElapsedTimeF64() * 1000.0;
+}
+
+// Returns false if a start or stop request made during the parallel
+// evaluation took effect before finishMotions()
+static bool check_deferred_requests()
+{
+    LLXmlTree skeleton_tree;
+    if (!skeleton_tree.parseString("<linden_skeleton><bone name=\"mPelvis\" pos=\"0 0 1\"/></linden_skeleton>", false))
+    {
+        std::cerr << "Can't parse the check skeleton" << std::endl;
+        return false;
+    }
+    LLBenchCharacter character(skeleton_tree.getRoot(), LLVector3::zero, false);
+
+    const LLUUID trigger_id = LLUUID::generateNewID();
+    LLBenchTriggerMotion::sStartID = LLUUID::generateNewID();
+    LLBenchTriggerMotion::sStopID = LLUUID::generateNewID();
+    character.registerMotion(trigger_id, LLBenchTriggerMotion::create);
+    character.registerMotion(LLBenchTriggerMotion::sStartID, LLNullMotion::create);
+    character.registerMotion(LLBenchTriggerMotion::sStopID, LLNullMotion::create);
+
+    // Get the motion to be stopped playing before the trigger goes
+    character.startMotion(LLBenchTriggerMotion::sStopID);
+    for (S32 frame = 0; frame < 4; ++frame)
+    {
+        LLFrameTimer::updateFrameTime();
+        character.updateMotions(LLCharacter::NORMAL_UPDATE);
+    }
+    LLMotion* stop_motion = character.findMotion(LLBenchTriggerMotion::sStopID);
+    if (!stop_motion || !character.isMotionActive(LLBenchTriggerMotion::sStopID) || stop_motion->isStopped())
+    {
+        std::cerr << "Motion to stop didn't start" << std::endl;
+        return false;
+    }
+
+    character.startMotion(trigger_id);
+    for (S32 frame = 0; frame < 8 && !LLBenchTriggerMotion::sTriggered; ++frame)
+    {
+        LLFrameTimer::updateFrameTime();
+        if (character.prepareMotions(LLCharacter::NORMAL_UPDATE))
+        {
+            LLBenchCharacter* characterp = &character;
+            LL::parallelFor(POOL_NAME, 1, 1,
+                            [characterp](size_t begin, size_t end)
+                            {
+                                characterp->evaluateMotions();
+                            });
+        }
+
+        if (LLBenchTriggerMotion::sTriggered)
+        {
+            if (character.findMotion(LLBenchTriggerMotion::sStartID))
+            {
+                std::cerr << "Motion started during the parallel evaluation" << std::endl;
+                return false;
+            }
+            if (stop_motion->isStopped())
+            {
+                std::cerr << "Motion stopped during the parallel evaluation" << std::endl;
+                return false;
+            }
+        }
+        character.finishMotions();
+    }
+
+    if (!LLBenchTriggerMotion::sTriggered)
+    {
+        std::cerr << "Trigger motion never updated" << std::endl;
+        return false;
+    }
+    if (!character.findMotion(LLBenchTriggerMotion::sStartID))
+    {
+        std::cerr << "Deferred start was not applied by finishMotions()" << std::endl;
+        return false;
+    }
+    if (!stop_motion->isStopped())
+    {
+        std::cerr << "Deferred stop was not applied by finishMotions()" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> input_filenames;
+    std::string skeleton_filename("character/avatar_skeleton.xml");
+    S32 num_avatars = 100;
+    S32 num_motions = 2;
+    S32 num_frames = 300;
+    S32 num_threads = llmax(1, (S32)std::thread::hardware_concurrency() - 1);
+    bool flatten = false;
+    bool check_deferred = false;
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        if (!strcmp(argv[arg], "--help") || !strcmp(argv[arg], "-h"))
+        {
+            std::cout << USAGE << std::endl;
+            return 0;
+        }
+        else if ((!strcmp(argv[arg], "--input") || !strcmp(argv[arg], "-i")) && arg < argc-1)
+        {
+            // if arg starts with '-', we consider it's not a file name but some other argument
+            while (arg < argc-1 && argv[arg+1][0] != '-')
+            {
+                input_filenames.push_back(argv[++arg]);
+            }
+        }
+        else if ((!strcmp(argv[arg], "--skeleton") || !strcmp(argv[arg], "-s")) && arg < argc-1)
+        {
+            skeleton_filename = argv[++arg];
+        }
+        else if ((!strcmp(argv[arg], "--avatars") || !strcmp(argv[arg], "-n")) && arg < argc-1)
+        {
+            num_avatars = llmax(1, atoi(argv[++arg]));
+        }
+        else if ((!strcmp(argv[arg], "--motions") || !strcmp(argv[arg], "-m")) && arg < argc-1)
+        {
+            num_motions = llmax(1, atoi(argv[++arg]));
+        }
+        else if ((!strcmp(argv[arg], "--frames") || !strcmp(argv[arg], "-f")) && arg < argc-1)
+        {
+            num_frames = llmax(1, atoi(argv[++arg]));
+        }
+        else if ((!strcmp(argv[arg], "--threads") || !strcmp(argv[arg], "-t")) && arg < argc-1)
+        {
+            num_threads = llmax(0, atoi(argv[++arg]));
+        }
+        else if (!strcmp(argv[arg], "--flatten"))
+        {
+            flatten = true;
+        }
+        else if (!strcmp(argv[arg], "--check-deferred"))
+        {
+            check_deferred = true;
+        }
+        else
+        {
+            std::cerr << "Unknown argument " << argv[arg] << USAGE << std::endl;
+            return 1;
+        }
+    }
+
+    ll_init_apr();
+
+    if (check_deferred)
+    {
+        LL::ThreadPool pool(POOL_NAME, 1);
+        pool.start();
+        const bool passed = check_deferred_requests();
+        pool.close();
+        std::cout << "deferred motion requests: " << (passed ? "passed" : "FAILED") << std::endl;
+        return passed ? 0 : 1;
+    }
+
+    LLXmlTree skeleton_tree;
+    if (!skeleton_tree.parseFile(skeleton_filename, false) || !skeleton_tree.getRoot())
+    {
+        std::cerr << "Can't parse skeleton " << skeleton_filename << std::endl;
+        return 1;
+    }
+    LLXmlTreeNode* skeleton = skeleton_tree.getRoot();
+
+    // Build the crowd on a grid, a couple of meters apart
+    crowd_t crowd;
+    const S32 row = llmax(1, (S32)sqrtf((F32)num_avatars));
+    for (S32 i = 0; i < num_avatars; ++i)
+    {
+        LLVector3 position(2.f * (F32)(i % row), 2.f * (F32)(i / row), 1.f);
+        crowd.emplace_back(new LLBenchCharacter(skeleton, position, flatten));
+    }
+
+    // Decode the clips once into the shared keyframe cache
+    std::vector<std::vector<U8> > clips;
+    for (const std::string& name : input_filenames)
+    {
+        std::vector<U8> data;
+        if (!read_file(name, data))
+        {
+            std::cerr << "Can't read " << name << std::endl;
+            return 1;
+        }
+        clips.push_back(data);
+    }
+    if (clips.empty())
+    {
+        std::vector<std::string> bones;
+        collect_base_bones(skeleton, bones);
+        for (S32 variant = 0; variant < 4; ++variant)
+        {
+            clips.push_back(make_procedural_anim(bones, variant));
+        }
+    }
+
+    std::vector<LLUUID> clip_ids;
+    for (size_t i = 0; i < clips.size(); ++i)
+    {
+        LLUUID id = LLUUID::generateNewID();
+        std::unique_ptr<LLBenchKeyframeLoader> loader(new LLBenchKeyframeLoader(id));
+        if (!loader->load(crowd.front().get(), clips[i]))
+        {
+            std::cerr << "Can't decode clip " << i
+                      << (i < input_filenames.size() ? " " + input_filenames[i] : std::string()) << std::endl;
+            return 1;
+        }
+        clip_ids.push_back(id);
+    }
+
+    for (size_t i = 0; i < crowd.size(); ++i)
+    {
+        for (S32 m = 0; m < num_motions; ++m)
+        {
+            crowd[i]->startMotion(clip_ids[(i + m) % clip_ids.size()]);
+        }
+    }
+
+    LL::ThreadPool pool(POOL_NAME, num_threads);
+    pool.start();
+
+    // Warm up: load motions, settle ease-ins, fault in caches
+    LLFrameTimer::updateFrameTime();
+    time_frames(crowd, 30, false, flatten);
+
+    const F64 serial_ms = time_frames(crowd, num_frames, false, flatten);
+    const F64 parallel_ms = time_frames(crowd, num_frames, true, flatten);
+
+    pool.close();
+
+    const F64 evaluations = (F64)num_avatars * (F64)num_frames;
+    std::cout << num_avatars << " avatars, " << num_motions << " motions each, "
+              << clip_ids.size() << " clips, " << num_frames << " frames, "
+              << num_threads << " helper threads"
+              << (flatten ? ", flattened skeletons" : "") << std::endl;
+    std::cout << llformat("serial:   %8.3f ms/frame %10.2f avatars/ms",
+                          serial_ms / num_frames, evaluations / serial_ms) << std::endl;
+    std::cout << llformat("parallel: %8.3f ms/frame %10.2f avatars/ms (x%.2f)",
+                          parallel_ms / num_frames, evaluations / parallel_ms,
+                          serial_ms / parallel_ms) << std::endl;
+
+    crowd.clear();
+    return 0;
+}
@@ -0,0 +1,431 @@
+/**
+ * @file llfrustum_libtest.cpp
+ * @brief Microbenchmark of scalar and packet frustum tests for octree groups
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+// Linden library includes
+#include "llcamera.h"
+#include "lloctree.h"
+#include "llparallelfor.h"
+#include "llrand.h"
+#include "lltimer.h"
+#include "threadpool.h"
+
+// system libraries
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+// doc string provided when invoking the program with --help
+static const char USAGE[] = "\n"
+"usage:\tllfrustum_libtest [options]\n"
+"\n"
+"Frustum tests a set of octree group bounds, once one box at a time with\n"
+"each box in its own heap allocation like LLSpatialGroup, and once four\n"
+"boxes at a time from contiguous SoA packets, and reports the throughput\n"
+"of each in groups per microsecond.\n"
+"\n"
+"Then sorts the same bounds into several octrees, like the spatial\n"
+"partitions of a region, and times gathering the frustum results of every\n"
+"tree one after another against one job per tree on a thread pool.\n"
+"\n"
+" -h, --help\n"
+"        Print this help\n"
+" -n, --groups <n>\n"
+"        Number of groups. Default is 100000.\n"
+" -i, --iterations <n>\n"
+"        Passes over all groups for each mode. Default is 100.\n"
+" -p, --partitions <n>\n"
+"        Number of octrees to gather. Default is 16.\n"
+" -t, --threads <n>\n"
+"        Threads in the pool for the parallel gather. Default is 4.\n"
+" --no-far-clip\n"
+"        Ignore the far plane, as for the water and reflection passes.\n"
+"\n";
+
+namespace
+{
+    // Stand in for an octree group: bounds sitting among other members,
+    // allocated one by one
+    struct BenchGroup
+    {
+        LL_ALIGN_16(LLVector4a mBounds[2]);
+        U8 mPadding[192];
+        S32 mResult;
+    };
+    typedef std::vector<std::unique_ptr<BenchGroup> > group_list_t;
+
+    // The same bounds as packets of four: center x, y, z then radius x, y, z
+    struct BenchPacket
+    {
+        LLVector4a mBounds[6];
+    };
+    typedef std::vector<BenchPacket> packet_list_t;
+
+    // Stand in for a drawable: just enough for LLOctreeNode to bin it
+    struct BenchElement
+    {
+        LLVector4a mPosition;
+        F32 mRadius;
+        S32 mBinIndex;
+
+        const LLVector4a& getPositionGroup() const { return mPosition; }
+        F32 getBinRadius() const { return mRadius; }
+        S32 getBinIndex() const { return mBinIndex; }
+        void setBinIndex(S32 index) { mBinIndex = index; }
+    };
+    typedef LLOctreeNode<BenchElement, BenchElement*> bench_node_t;
+    typedef LLOctreeRoot<BenchElement, BenchElement*> bench_root_t;
+
+    // Frustum results for one node in traversal order, like
+    // LLViewerOctreeCull::CullNode
+    struct GatherNode
+    {
+        const bench_node_t* mNode;
+        U32 mEnd;       // index one past the last node of this subtree
+        S32 mFrustum;   // node bounds
+        S32 mObjects;   // elements at least partly in, -1 if not tested
+
+        bool operator==(const GatherNode& rhs) const
+        {
+            return mNode == rhs.mNode && mEnd == rhs.mEnd && mFrustum == rhs.mFrustum && mObjects == rhs.mObjects;
+        }
+    };
+    typedef std::vector<GatherNode> gather_list_t;
+
+    // Camera at the center of the region looking north, 128m draw distance
+    void setup_camera(LLCamera& camera)
+    {
+        const F32 near_dist = 0.5f;
+        const F32 far_dist = 128.f;
+        const F32 tan_half = tanf(30.f * DEG_TO_RAD);
+        const F32 aspect = 16.f / 9.f;
+
+        const LLVector3 origin(128.f, 128.f, 30.f);
+        const LLVector3 at(0.f, 1.f, 0.f);
+        const LLVector3 left(-1.f, 0.f, 0.f);
+        const LLVector3 up(0.f, 0.f, 1.f);
+        camera.setOrigin(origin);
+        camera.setAxes(at, left, up);
+
+        // Near corners then far corners, in the order calcAgentFrustumPlanes() expects
+        static const F32 signs[4][2] = { { 1.f, -1.f }, { -1.f, -1.f }, { -1.f, 1.f }, { 1.f, 1.f } };
+        LLVector3 frust[8];
+        for (S32 i = 0; i < 8; ++i)
+        {
+            F32 dist = i < 4 ? near_dist : far_dist;
+            F32 height = dist * tan_half;
+            frust[i] = origin + at * dist + left * (signs[i % 4][0] * height * aspect) + up * (signs[i % 4][1] * height);
+        }
+        camera.calcAgentFrustumPlanes(frust);
+    }
+
+    F64 time_scalar(LLCamera& camera, group_list_t& groups, S32 iterations, bool no_far_clip, S64& visible)
+    {
+        visible = 0;
+        LLTimer timer;
+        for (S32 i = 0; i < iterations; ++i)
+        {
+            for (std::unique_ptr<BenchGroup>& group : groups)
+            {
+                group->mResult = no_far_clip ? camera.AABBInFrustumNoFarClip(group->mBounds[0], group->mBounds[1])
+                                             : camera.AABBInFrustum(group->mBounds[0], group->mBounds[1]);
+                visible += group->mResult > 0;
+            }
+        }
+        return timer.getElapsedTimeF64() * 1000000.0;
+    }
+
+    F64 time_packets(LLCamera& camera, const packet_list_t& packets, std::vector<S32>& results, S32 iterations,
+                     bool no_far_clip, S64& visible)
+    {
+        visible = 0;
+        LLTimer timer;
+        for (S32 i = 0; i < iterations; ++i)
+        {
+            S32* res = results.data();
+            for (const BenchPacket& packet : packets)
+            {
+                if (no_far_clip)
+                {
+                    camera.AABBInFrustumNoFarClip4(packet.mBounds, packet.mBounds + 3, res);
+                }
+                else
+                {
+                    camera.AABBInFrustum4(packet.mBounds, packet.mBounds + 3, res);
+                }
+                visible += (res[0] > 0) + (res[1] > 0) + (res[2] > 0) + (res[3] > 0);
+                res += 4;
+            }
+        }
+        return timer.getElapsedTimeF64() * 1000000.0;
+    }
+
+    S32 frustum_check(LLCamera& camera, const LLVector4a& center, const LLVector4a& radius, bool no_far_clip)
+    {
+        return no_far_clip ? camera.AABBInFrustumNoFarClip(center, radius) : camera.AABBInFrustum(center, radius);
+    }
+
+    // Same shape as LLViewerOctreeCull::gather(): test a node, test its
+    // elements and descend only if it is partly in
+    void gather(LLCamera& camera, const bench_node_t* n, bool no_far_clip, gather_list_t& nodes)
+    {
+        // Elements stick out of their node by up to twice its size
+        LLVector4a radius;
+        radius.setMul(n->getSize(), 3.f);
+
+        GatherNode node;
+        node.mNode = n;
+        node.mFrustum = frustum_check(camera, n->getCenter(), radius, no_far_clip);
+        node.mObjects = -1;
+        const bool partial = node.mFrustum == 1;
+        if (partial)
+        {
+            node.mObjects = 0;
+            for (auto it = n->getDataBegin(); it != n->getDataEnd(); ++it)
+            {
+                LLVector4a size;
+                size.splat((*it)->getBinRadius());
+                node.mObjects += frustum_check(camera, (*it)->getPositionGroup(), size, no_far_clip) > 0;
+            }
+        }
+
+        const U32 index = (U32)nodes.size();
+        nodes.push_back(node);
+        if (partial)
+        {
+            for (U32 i = 0; i < n->getChildCount(); i++)
+            {
+                gather(camera, n->getChild(i), no_far_clip, nodes);
+            }
+        }
+        nodes[index].mEnd = (U32)nodes.size();
+    }
+
+    F64 time_gather(LLCamera& camera, const std::vector<std::unique_ptr<bench_root_t> >& trees,
+                    std::vector<gather_list_t>& gathered, S32 iterations, bool no_far_clip, const std::string& pool)
+    {
+        LLTimer timer;
+        for (S32 i = 0; i < iterations; ++i)
+        {
+            auto gather_trees = [&](size_t begin, size_t end)
+            {
+                for (size_t t = begin; t < end; ++t)
+                {
+                    gathered[t].clear();
+                    gather(camera, trees[t].get(), no_far_clip, gathered[t]);
+                }
+            };
+
+            if (pool.empty())
+            {
+                gather_trees(0, trees.size());
+            }
+            else
+            {
+                LL::parallelFor(pool, trees.size(), 1, gather_trees);
+            }
+        }
+        return timer.getElapsedTimeF64() * 1000000.0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    S32 num_groups = 100000;
+    S32 num_iterations = 100;
+    S32 num_partitions = 16;
+    S32 num_threads = 4;
+    bool no_far_clip = false;
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        if (!strcmp(argv[arg], "--help") || !strcmp(argv[arg], "-h"))
+        {
+            std::cout << USAGE << std::endl;
+            return 0;
+        }
+        else if ((!strcmp(argv[arg], "--groups") || !strcmp(argv[arg], "-n")) && arg < argc-1)
+        {
+            num_groups = llmax(4, atoi(argv[++arg]));
+        }
+        else if ((!strcmp(argv[arg], "--iterations") || !strcmp(argv[arg], "-i")) && arg < argc-1)
+        {
+            num_iterations = llmax(1, atoi(argv[++arg]));
+        }
+        else if ((!strcmp(argv[arg], "--partitions") || !strcmp(argv[arg], "-p")) && arg < argc-1)
+        {
+            num_partitions = llmax(1, atoi(argv[++arg]));
+        }
+        else if ((!strcmp(argv[arg], "--threads") || !strcmp(argv[arg], "-t")) && arg < argc-1)
+        {
+            num_threads = llmax(1, atoi(argv[++arg]));
+        }
+        else if (!strcmp(argv[arg], "--no-far-clip"))
+        {
+            no_far_clip = true;
+        }
+        else
+        {
+            std::cerr << "Unknown argument " << argv[arg] << USAGE << std::endl;
+            return 1;
+        }
+    }
+    num_groups = (num_groups + 3) & ~3;
+
+    LLCamera camera;
+    setup_camera(camera);
+
+    // Groups of every size scattered over a region, allocated in random
+    // order so neighbours in the list are not neighbours in memory
+    std::vector<LLVector4a> centers(num_groups);
+    std::vector<LLVector4a> radii(num_groups);
+    for (S32 i = 0; i < num_groups; ++i)
+    {
+        F32 size = 0.5f * powf(2.f, (F32)(i % 8));
+        centers[i].set(ll_frand(256.f), ll_frand(256.f), ll_frand(64.f));
+        radii[i].set(size, size, size);
+    }
+
+    std::vector<S32> order(num_groups);
+    for (S32 i = 0; i < num_groups; ++i)
+    {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937(0));
+
+    std::vector<std::unique_ptr<BenchGroup> > allocated(num_groups);
+    for (S32 i : order)
+    {
+        allocated[i].reset(new BenchGroup);
+        allocated[i]->mBounds[0] = centers[i];
+        allocated[i]->mBounds[1] = radii[i];
+    }
+    group_list_t groups(std::move(allocated));
+
+    packet_list_t packets(num_groups / 4);
+    for (S32 p = 0; p < num_groups / 4; ++p)
+    {
+        LL_ALIGN_16(F32 soa[6][4]);
+        for (S32 i = 0; i < 4; ++i)
+        {
+            for (S32 j = 0; j < 3; ++j)
+            {
+                soa[j][i] = centers[p * 4 + i][j];
+                soa[j + 3][i] = radii[p * 4 + i][j];
+            }
+        }
+        for (S32 j = 0; j < 6; ++j)
+        {
+            packets[p].mBounds[j].load4a(soa[j]);
+        }
+    }
+    std::vector<S32> results(num_groups);
+
+    // Warm up and check both paths agree
+    S64 scalar_visible = 0;
+    S64 packet_visible = 0;
+    time_scalar(camera, groups, 1, no_far_clip, scalar_visible);
+    time_packets(camera, packets, results, 1, no_far_clip, packet_visible);
+    for (S32 i = 0; i < num_groups; ++i)
+    {
+        if (groups[i]->mResult != results[i])
+        {
+            std::cerr << "Packet result mismatch for group " << i << ": "
+                      << results[i] << " != " << groups[i]->mResult << std::endl;
+            return 1;
+        }
+    }
+
+    const F64 scalar_us = time_scalar(camera, groups, num_iterations, no_far_clip, scalar_visible);
+    const F64 packet_us = time_packets(camera, packets, results, num_iterations, no_far_clip, packet_visible);
+
+    const F64 tests = (F64)num_groups * (F64)num_iterations;
+    std::cout << num_groups << " groups, " << num_iterations << " iterations, "
+              << scalar_visible / num_iterations << " visible"
+              << (no_far_clip ? ", no far clip" : "") << std::endl;
+    std::cout << llformat("scalar: %10.3f ms/pass %10.2f groups/us",
+                          scalar_us / num_iterations / 1000.0, tests / scalar_us) << std::endl;
+    std::cout << llformat("packet: %10.3f ms/pass %10.2f groups/us (x%.2f)",
+                          packet_us / num_iterations / 1000.0, tests / packet_us,
+                          scalar_us / packet_us) << std::endl;
+
+    // Deal the same bounds out to the partitions with the viewer's octree
+    // settings
+    gOctreeMaxCapacity = 128;
+    gOctreeMinSize = 0.01f;
+
+    std::vector<BenchElement> elements(num_groups);
+    std::vector<std::unique_ptr<bench_root_t> > trees(num_partitions);
+    for (S32 t = 0; t < num_partitions; ++t)
+    {
+        LLVector4a center(128.f, 128.f, 32.f);
+        LLVector4a size(128.f, 128.f, 128.f);
+        trees[t].reset(new bench_root_t(center, size, NULL));
+    }
+    for (S32 i = 0; i < num_groups; ++i)
+    {
+        elements[i].mPosition = centers[i];
+        elements[i].mRadius = radii[i][0];
+        elements[i].mBinIndex = -1;
+        trees[i % num_partitions]->insert(&elements[i]);
+    }
+
+    LL::ThreadPool pool("FrustumGather", num_threads);
+    pool.start();
+
+    // Warm up and check the parallel gather matches the serial one
+    std::vector<gather_list_t> serial_gathered(num_partitions);
+    std::vector<gather_list_t> parallel_gathered(num_partitions);
+    time_gather(camera, trees, serial_gathered, 1, no_far_clip, std::string());
+    time_gather(camera, trees, parallel_gathered, 1, no_far_clip, pool.getName());
+    size_t gathered_nodes = 0;
+    for (S32 t = 0; t < num_partitions; ++t)
+    {
+        if (serial_gathered[t] != parallel_gathered[t])
+        {
+            std::cerr << "Parallel gather mismatch for partition " << t << std::endl;
+            pool.close();
+            return 1;
+        }
+        gathered_nodes += serial_gathered[t].size();
+    }
+
+    const F64 serial_us = time_gather(camera, trees, serial_gathered, num_iterations, no_far_clip, std::string());
+    const F64 parallel_us = time_gather(camera, trees, parallel_gathered, num_iterations, no_far_clip, pool.getName());
+    pool.close();
+
+    std::cout << num_partitions << " partitions, " << gathered_nodes << " nodes gathered, "
+              << num_threads << " threads" << std::endl;
+    std::cout << llformat("serial gather:   %10.3f ms/pass",
+                          serial_us / num_iterations / 1000.0) << std::endl;
+    std::cout << llformat("parallel gather: %10.3f ms/pass (x%.2f)",
+                          parallel_us / num_iterations / 1000.0, serial_us / parallel_us) << std::endl;
+    return 0;
+}
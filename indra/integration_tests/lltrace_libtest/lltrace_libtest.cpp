@@ -0,0 +1,241 @@
+/**
+ * @file lltrace_libtest.cpp
+ * @brief Benchmark of LLTrace block timer and stat overhead and of child thread merges
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+// Linden library includes
+#include "llfasttimer.h"
+#include "lltimer.h"
+#include "lltrace.h"
+#include "lltracerecording.h"
+#include "lltracethreadrecorder.h"
+
+// system libraries
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// doc string provided when invoking the program with --help
+static const char USAGE[] = "\n"
+"usage:\tlltrace_libtest [options]\n"
+"\n"
+"Measures the cost of a block timer scope, of adding to a count stat and\n"
+"of recording an event stat, and the frame cost of all block timers at a\n"
+"given number of scopes per frame. Then runs child threads that add to a\n"
+"stat and push to the main thread recorder while the main thread pulls,\n"
+"and reports the cost of each push and pull.\n"
+"\n"
+" -h, --help\n"
+"        Print this help\n"
+" -n, --calls <n>\n"
+"        Calls per measurement. Default is 10000000.\n"
+" -s, --scopes <n>\n"
+"        Timer scopes per frame for the frame cost estimate. Default is 20000.\n"
+" -t, --threads <n>\n"
+"        Child threads pushing stats. Default is 4.\n"
+" -p, --pulls <n>\n"
+"        Pulls by the main thread. Default is 10000.\n"
+"\n";
+
+namespace
+{
+    LLTrace::BlockTimerStatHandle FTM_BENCH_OUTER("Benchmark outer");
+    LLTrace::BlockTimerStatHandle FTM_BENCH_INNER("Benchmark inner");
+    LLTrace::CountStatHandle<S32> sBenchCount("benchmarkcount", "Benchmark count stat");
+    LLTrace::EventStatHandle<F64> sBenchEvent("benchmarkevent", "Benchmark event stat");
+
+    // a frame at 60 fps
+    const F64 FRAME_NANOSECONDS = 1000000000.0 / 60.0;
+
+    template <typename FUNC>
+    F64 nanoseconds_per_call(S32 calls, FUNC func)
+    {
+        LLTimer timer;
+        for (S32 i = 0; i < calls; ++i)
+        {
+            func(i);
+        }
+        return timer.getElapsedTimeF64() * 1000000000.0 / calls;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    S32 num_calls = 10000000;
+    S32 num_scopes = 20000;
+    S32 num_threads = 4;
+    S32 num_pulls = 10000;
+
+    for (int arg = 1; arg < argc; ++arg)
+    {
+        if (!strcmp(argv[arg], "--help") || !strcmp(argv[arg], "-h"))
+        {
+            std::cout << USAGE << std::endl;
+            return 0;
+        }
+        else if ((!strcmp(argv[arg], "--calls") || !strcmp(argv[arg], "-n")) && arg < argc-1)
+        {
+            num_calls = llmax(1, atoi(argv[++arg]));
+        }
+        else if ((!strcmp(argv[arg], "--scopes") || !strcmp(argv[arg], "-s")) && arg < argc-1)
+        {
+            num_scopes = llmax(1, atoi(argv[++arg]));
+        }
+        else if ((!strcmp(argv[arg], "--threads") || !strcmp(argv[arg], "-t")) && arg < argc-1)
+        {
+            num_threads = llmax(0, atoi(argv[++arg]));
+        }
+        else if ((!strcmp(argv[arg], "--pulls") || !strcmp(argv[arg], "-p")) && arg < argc-1)
+        {
+            num_pulls = llmax(1, atoi(argv[++arg]));
+        }
+        else
+        {
+            std::cerr << "Unknown argument " << argv[arg] << USAGE << std::endl;
+            return 1;
+        }
+    }
+
+    LLTimer::initClass();
+    LLTrace::ThreadRecorder master_recorder;
+    LLTrace::set_master_thread_recorder(&master_recorder);
+
+    LLTrace::Recording recording;
+    recording.start();
+
+    // a loop doing nothing but keeping 'i' alive, subtracted from the rest
+    volatile S32 sink = 0;
+    const F64 empty = nanoseconds_per_call(num_calls, [&sink](S32 i) { sink = i; });
+
+    const F64 scope = nanoseconds_per_call(num_calls, [&sink](S32 i)
+    {
+        const LLTrace::BlockTimer& timer = LLTrace::timeThisBlock(FTM_BENCH_OUTER);
+        (void)timer;
+        sink = i;
+    }) - empty;
+
+    const F64 nested = nanoseconds_per_call(num_calls, [&sink](S32 i)
+    {
+        const LLTrace::BlockTimer& outer = LLTrace::timeThisBlock(FTM_BENCH_OUTER);
+        (void)outer;
+        {
+            const LLTrace::BlockTimer& inner = LLTrace::timeThisBlock(FTM_BENCH_INNER);
+            (void)inner;
+            sink = i;
+        }
+    }) - empty;
+
+    const F64 count = nanoseconds_per_call(num_calls, [](S32 i) { add(sBenchCount, 1); }) - empty;
+    const F64 event = nanoseconds_per_call(num_calls, [](S32 i) { record(sBenchEvent, (F64)i); }) - empty;
+
+    std::cout << "block timer scope:       " << scope << " ns" << std::endl;
+    std::cout << "nested pair of scopes:   " << nested << " ns" << std::endl;
+    std::cout << "count stat add():        " << count << " ns" << std::endl;
+    std::cout << "event stat record():     " << event << " ns" << std::endl;
+    std::cout << num_scopes << " scopes per frame:  "
+              << scope * num_scopes * 100.0 / FRAME_NANOSECONDS << "% of a 60 fps frame" << std::endl;
+
+    // child threads add and push as fast as they can while the main thread pulls
+    std::atomic<bool> stop(false);
+    std::atomic<bool> release(false);
+    std::atomic<S32> ready(0);
+    std::atomic<S32> finished(0);
+    std::vector<S64> pushes(num_threads);
+    std::vector<F64> push_seconds(num_threads);
+    std::vector<std::thread> threads;
+    for (S32 t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            LLTrace::ThreadRecorder child_recorder(master_recorder);
+            ++ready;
+            LLTimer timer;
+            F64 seconds = 0.0;
+            while (!stop)
+            {
+                for (S32 i = 0; i < 100; ++i)
+                {
+                    add(sBenchCount, 1);
+                }
+                timer.reset();
+                child_recorder.pushToParent();
+                seconds += timer.getElapsedTimeF64();
+                ++pushes[t];
+            }
+            push_seconds[t] = seconds;
+            ++finished;
+            // stay registered until the main thread is done pulling
+            while (!release)
+            {
+                std::this_thread::yield();
+            }
+        });
+    }
+    while (ready < num_threads)
+    {
+        std::this_thread::yield();
+    }
+
+    LLTimer pull_timer;
+    for (S32 i = 0; i < num_pulls; ++i)
+    {
+        master_recorder.pullFromChildren();
+    }
+    const F64 pull = pull_timer.getElapsedTimeF64() * 1000000000.0 / num_pulls;
+
+    stop = true;
+    while (finished < num_threads)
+    {
+        std::this_thread::yield();
+    }
+    release = true;
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    S64 total_pushes = 0;
+    F64 total_push_seconds = 0.0;
+    for (S32 t = 0; t < num_threads; ++t)
+    {
+        total_pushes += pushes[t];
+        total_push_seconds += push_seconds[t];
+    }
+
+    std::cout << num_threads << " child threads" << std::endl;
+    std::cout << "pullFromChildren():      " << pull << " ns" << std::endl;
+    if (total_pushes)
+    {
+        std::cout << "pushToParent():          " << total_push_seconds * 1000000000.0 / total_pushes
+                  << " ns over " << total_pushes << " pushes" << std::endl;
+    }
+
+    recording.stop();
+    LLTrace::set_master_thread_recorder(NULL);
+    return 0;
+}
@@ -38,11 +38,20 @@
 #include "llfloater.h"
 #include "llfontfreetype.h"
 #include "llfontgl.h"
+#include "llscrolllistctrl.h"
+#include "lltexteditor.h"
+#include "lltimer.h"
 #include "lltransutil.h"
 #include "llui.h"
 #include "lluictrlfactory.h"
+#include "llurlregistry.h"
+#include "threadpool.h"
+#include "workqueue.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 // *TODO: switch to using TUT
 // *TODO: teach Parabuild about this program, run automatically after full builds
@@ -127,7 +136,7 @@ void init_llui()
     const char* newview_path = "../../../newview";
 #endif
     gDirUtilp->initAppDirs("SecondLife", newview_path);
-    gDirUtilp->setSkinFolder("default", "en");
+    gDirUtilp->setSkinFolder("default", "", "en");
 
     // colors are no longer stored in a LLControlGroup file
     LLUIColorTable::instance().loadFromSettings();
@@ -143,7 +152,7 @@ void init_llui()
     settings["account"] = &gSavedPerAccountSettings;
 
     // Don't use real images as we don't have a GL context
-    LLUI::initClass(settings, &gTestImageProvider);
+    LLUI::createInstance(settings, &gTestImageProvider, nullptr, nullptr);
 
     const bool no_register_widgets = false;
     LLWidgetReg::initClass( no_register_widgets );
@@ -160,7 +169,7 @@ void init_llui()
     LLFontGL::initClass(96.f, 1.f, 1.f,
                         gDirUtilp->getAppRODataDir(),
                         "fonts.xml",
-                        f.0,
+                        0.f,
                         false );    // don't create gl textures
 
     LLFloaterView::Params fvparams;
@@ -216,14 +225,545 @@ void export_test_floaters()
 }
 |*==========================================================================*/
 
+// Append chat-like lines to a text editor, optionally behind an inline widget
+// as chat headers are, and report the cost of an append as the document
+// grows.  Fails if the segments reflowed per append grow with the document,
+// or if the widgets end up anywhere else than where a full layout of the
+// text puts them.  Times are only reported, they vary too much from one
+// machine and run to the next to fail on.
+bool test_text_append(S32 line_count, bool widgets)
+{
+    LLTextEditor::Params params;
+    params.name("benchmark");
+    params.rect(LLRect(0, 480, 640, 0));
+    params.max_text_length(S32_MAX);
+    params.wrap(true);
+    params.track_end(true);
+    LLTextEditor* editor = LLUICtrlFactory::create<LLTextEditor>(params);
+
+    std::vector<LLView*> views;
+    std::vector<F64> batch_times;
+    const S32 batch = llmax(1, line_count / 10);
+    LLTimer timer;
+    F64 batch_start = timer.getElapsedTimeF64();
+    for (S32 i = 0; i < line_count; ++i)
+    {
+        if (widgets)
+        {
+            LLView::Params view_params;
+            view_params.rect(LLRect(0, 16, 200, 0));
+            LLInlineViewSegment::Params segment_params;
+            segment_params.view = LLUICtrlFactory::create<LLView>(view_params);
+            views.push_back(segment_params.view);
+            editor->appendWidget(segment_params, "\n", false);
+        }
+        editor->appendText(llformat("[%02d:%02d] Resident %d: line %d, with enough words that some of them wrap onto a second line of the editor",
+                                    (i / 60) % 24, i % 60, i % 97, i),
+                           i > 0 && !widgets);
+        // lay out as drawing the editor would
+        editor->getTextBoundingRect();
+
+        if ((i + 1) % batch == 0)
+        {
+            F64 now = timer.getElapsedTimeF64();
+            batch_times.push_back((now - batch_start) / batch);
+            std::cout << (i + 1) << " lines: " << (batch_times.back() * 1000000.0) << " us per line" << std::endl;
+            batch_start = now;
+        }
+    }
+    std::cout << editor->getLineCount() << " lines laid out in " << timer.getElapsedTimeF64() << " s" << std::endl;
+
+    bool ok = true;
+
+    // every append reflows the last line and what follows it, plus its share
+    // of the full relayouts, whose number only grows with the log of the
+    // text height.  Reflowing the whole text would be thousands per append.
+    const F64 reflowed_per_append = (F64)editor->getReflowSegmentCount() / (widgets ? 2 * line_count : line_count);
+    std::cout << reflowed_per_append << " segments reflowed per append" << std::endl;
+    if (reflowed_per_append > 32.0)
+    {
+        std::cerr << "appending reflowed " << reflowed_per_append << " segments each, it should not grow with the text" << std::endl;
+        ok = false;
+    }
+
+    std::vector<LLRect> appended_rects;
+    for (LLView* view : views)
+    {
+        appended_rects.push_back(view->calcScreenRect());
+    }
+    editor->needsReflow(0);
+    editor->getTextBoundingRect();
+    for (size_t i = 0; i < views.size(); ++i)
+    {
+        if (views[i]->calcScreenRect() != appended_rects[i])
+        {
+            std::cerr << "widget " << i << " is misplaced after appending" << std::endl;
+            ok = false;
+            break;
+        }
+    }
+
+    delete editor;
+    return ok;
+}
+
+// Find the Urls in a mix of chat lines, one or more for each Url type
+// the registry knows and plain text without any, as appending chat does.
+void benchmark_url_match(S32 line_count)
+{
+    static const char* lines[] =
+    {
+        "Hello everyone, how is it going today?",
+        "lol yes, the sim was lagging a lot earlier",
+        "see http://wiki.secondlife.com/wiki/LSL_Portal for details",
+        "[https://example.com/page the example page] has more",
+        "go to www.example.com/shop",
+        "http://maps.secondlife.com/secondlife/Ahern/128/128/30",
+        "https://secondlife.com/destinations",
+        "secondlife:///app/agent/0e346d8b-4433-4d66-a6b0-fd37083abc4c/inspect said hi",
+        "secondlife:///app/agent/0e346d8b-4433-4d66-a6b0-fd37083abc4c/completename",
+        "secondlife:///app/group/0e346d8b-4433-4d66-a6b0-fd37083abc4c/about",
+        "secondlife:///app/parcel/0e346d8b-4433-4d66-a6b0-fd37083abc4c/about",
+        "secondlife:///app/teleport/Ahern/50/50/50",
+        "secondlife:///app/region/Ahern/50/50/50",
+        "secondlife:///app/worldmap/Ahern/50/50/50",
+        "secondlife:///app/objectim/7bcd7864-da6b-e43f-4486-91d28a28d95b?name=Object",
+        "secondlife:///app/inventory/0e346d8b-4433-4d66-a6b0-fd37083abc4c/select",
+        "secondlife:///app/experience/0e346d8b-4433-4d66-a6b0-fd37083abc4c/profile",
+        "secondlife:///app/chat/42/hello",
+        "secondlife://Ahern/50/50/50",
+        "hop://grid.example.org:8002/Region/128/128/25",
+        "[secondlife:///app/search/all/help search for help]",
+        "<nolink>http://not.a.link.com</nolink>",
+        "mail me at resident@example.com",
+        "http://[2001:0db8:11a3:09d7:1f34:8a2e:07a0:765d]:8080/",
+        "fixed by FIRE-12345 in the last release",
+        "I'll be right back, need to get coffee",
+    };
+    const S32 line_types = static_cast<S32>(LL_ARRAY_SIZE(lines));
+
+    LLUrlRegistry& registry = LLUrlRegistry::instance();
+    S32 url_count = 0;
+    LLTimer timer;
+    for (S32 i = 0; i < line_count; ++i)
+    {
+        LLUrlMatch match;
+        if (registry.findUrl(lines[i % line_types], match))
+        {
+            ++url_count;
+        }
+    }
+    F64 elapsed = timer.getElapsedTimeF64();
+    std::cout << line_count << " lines, " << url_count << " with Urls, "
+              << (elapsed * 1000000.0 / line_count) << " us per line" << std::endl;
+}
+
+// Fill a three column list the way member and object lists are filled,
+// with full rows and then with virtual rows, and time adding, sorting and
+// drawing the first page.
+void benchmark_scroll_list(S32 row_count)
+{
+    for (S32 pass = 0; pass < 2; ++pass)
+    {
+        const bool virtual_rows = pass > 0;
+        LLScrollListCtrl::Params params;
+        params.name("benchmark");
+        params.rect(LLRect(0, 480, 640, 0));
+        LLScrollListCtrl* list = LLUICtrlFactory::create<LLScrollListCtrl>(params);
+
+        LLTimer timer;
+        for (S32 i = 0; i < row_count; ++i)
+        {
+            std::vector<std::string> columns;
+            columns.push_back(llformat("Resident %d", (i * 7919) % row_count));
+            columns.push_back(llformat("%d", i % 23));
+            columns.push_back(llformat("2024-%02d-%02d", i % 12 + 1, i % 28 + 1));
+            if (virtual_rows)
+            {
+                list->addVirtualRow(columns, LLSD(i));
+            }
+            else
+            {
+                LLScrollListItem::Params item_p;
+                item_p.value = LLSD(i);
+                for (const std::string& text : columns)
+                {
+                    item_p.columns.add().value(text);
+                }
+                list->addRow(item_p);
+            }
+        }
+        F64 added = timer.getElapsedTimeF64();
+
+        list->sortByColumnIndex(0, true);
+        list->updateSort();
+        F64 sorted = timer.getElapsedTimeF64();
+
+        list->draw();
+        F64 drawn = timer.getElapsedTimeF64();
+
+        std::cout << (virtual_rows ? "virtual rows: " : "full rows: ") << row_count << " added in " << (added * 1000.0)
+                  << " ms, sorted in " << ((sorted - added) * 1000.0) << " ms, first page drawn in "
+                  << ((drawn - sorted) * 1000.0) << " ms" << std::endl;
+
+        delete list;
+    }
+}
+
+// Text of a column of a list row, whether it is a full or a virtual one
+static std::string get_row_text(const LLScrollListItem* item, S32 column)
+{
+    return item->hasCells() ? item->getColumn(column)->getValue().asString() : item->getVirtualText(column);
+}
+
+// Values of the rows of a list, in list order
+static std::vector<S32> get_row_values(const LLScrollListCtrl* list)
+{
+    std::vector<S32> values;
+    for (const LLScrollListItem* item : list->getAllData())
+    {
+        values.push_back(item->getValue().asInteger());
+    }
+    return values;
+}
+
+static bool expect(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        std::cerr << "virtual rows: " << what << std::endl;
+    }
+    return condition;
+}
+
+// Check that virtual rows keep their text through deletes, column changes
+// and dropped cells, that they sort the way full rows do, and that a
+// background sort which went stale while it ran is not applied as final.
+bool test_virtual_rows()
+{
+    bool ok = true;
+
+    // rows deleted from the store are reused by the next ones added
+    {
+        LLScrollListRowStore store(2);
+        std::vector<std::string> text;
+        text.push_back("a0");
+        text.push_back("a1");
+        S32 row_a = store.addRow(text);
+        text[0] = "b0";
+        text[1] = "b1";
+        S32 row_b = store.addRow(text);
+        text[0] = "c0";
+        text[1] = "c1";
+        S32 row_c = store.addRow(text);
+        store.removeRow(row_b);
+        text.resize(1);
+        text[0] = "d0";
+        S32 row_d = store.addRow(text);
+        ok &= expect(row_d == row_b, "a deleted row was not reused");
+        ok &= expect(store.getText(row_d, 0) == "d0" && store.getText(row_d, 1).empty(), "a reused row kept old text");
+        ok &= expect(store.getText(row_a, 1) == "a1" && store.getText(row_c, 0) == "c0", "reusing a row changed another");
+
+        // text keeps its column when columns come or go
+        store.setNumColumns(3);
+        ok &= expect(store.getText(row_a, 0) == "a0" && store.getText(row_a, 1) == "a1" && store.getText(row_a, 2).empty(),
+                     "adding a column moved the text");
+        ok &= expect(store.getText(row_c, 0) == "c0" && store.getText(row_c, 1) == "c1", "adding a column moved the text");
+        store.setNumColumns(1);
+        ok &= expect(store.getText(row_a, 0) == "a0" && store.getText(row_c, 0) == "c0" && store.getText(row_d, 0) == "d0",
+                     "removing a column moved the text");
+
+        store.removeRow(row_a);
+        store.removeRow(row_c);
+        store.removeRow(row_d);
+    }
+
+    // the same through a list
+    {
+        LLScrollListCtrl::Params params;
+        params.name("virtual_rows");
+        params.rect(LLRect(0, 480, 640, 0));
+        LLScrollListCtrl* list = LLUICtrlFactory::create<LLScrollListCtrl>(params);
+
+        std::vector<std::string> columns;
+        columns.push_back("first");
+        columns.push_back("1");
+        list->addVirtualRow(columns, LLSD(0));
+        columns[0] = "second";
+        list->addVirtualRow(columns, LLSD(1));
+        columns[0] = "third";
+        list->addVirtualRow(columns, LLSD(2));
+        list->deleteSingleItem(1);
+        columns[0] = "fourth";
+        columns.push_back("extra");
+        LLScrollListItem* fourth = list->addVirtualRow(columns, LLSD(3));
+
+        std::vector<LLScrollListItem*> items = list->getAllData();
+        ok &= expect(items.size() == 3, "deleting a virtual row lost count");
+        ok &= expect(get_row_text(items[0], 0) == "first" && get_row_text(items[1], 0) == "third",
+                     "deleting a virtual row changed the others");
+        ok &= expect(get_row_text(fourth, 0) == "fourth" && get_row_text(fourth, 2) == "extra",
+                     "a row reusing a deleted one has the wrong text");
+        ok &= expect(items[0]->getNumColumns() == 3 && get_row_text(items[0], 1) == "1" && get_row_text(items[0], 2).empty(),
+                     "a new column moved the text of older rows");
+
+        delete list;
+    }
+
+    // cells of rows scrolled out of view are dropped and made again with
+    // the current text and column width
+    {
+        LLScrollListCtrl::Params params;
+        params.name("virtual_cells");
+        params.rect(LLRect(0, 480, 640, 0));
+        LLScrollListCtrl* list = LLUICtrlFactory::create<LLScrollListCtrl>(params);
+
+        const S32 row_count = 500;
+        for (S32 i = 0; i < row_count; ++i)
+        {
+            std::vector<std::string> columns;
+            columns.push_back(llformat("Object %d", i));
+            columns.push_back(llformat("%d", i % 17));
+            list->addVirtualRow(columns, LLSD(i));
+        }
+        std::vector<LLScrollListItem*> items = list->getAllData();
+        for (LLScrollListItem* item : items)
+        {
+            item->getColumn(0);
+        }
+        ok &= expect(items.back()->hasCells(), "getColumn() did not make cells");
+
+        list->draw();
+        ok &= expect(items.front()->hasCells(), "a drawn row lost its cells");
+        ok &= expect(!items.back()->hasCells(), "a row out of view kept its cells");
+
+        list->setVirtualRowText(items.back(), 1, "changed");
+        ok &= expect(!items.back()->hasCells(), "setVirtualRowText() made cells");
+        for (S32 col = 0; col < 2; ++col)
+        {
+            const LLScrollListCell* cell = items.back()->getColumn(col);
+            ok &= expect(cell && cell->getWidth() == list->getColumn(col)->getWidth(),
+                         "a remade cell does not have its column width");
+        }
+        ok &= expect(get_row_text(items.back(), 0) == llformat("Object %d", row_count - 1), "a remade cell has the wrong text");
+        ok &= expect(get_row_text(items.back(), 1) == "changed", "a remade cell lost a text change");
+
+        delete list;
+    }
+
+    // full and virtual rows, some with cells and some without, sort
+    // together the way SortScrollListItem sorts full rows: by the last
+    // sort column, then the one before, keeping the order of equal rows
+    {
+        LLScrollListCtrl::Params params;
+        params.name("mixed_rows");
+        params.rect(LLRect(0, 480, 640, 0));
+        LLScrollListCtrl* list = LLUICtrlFactory::create<LLScrollListCtrl>(params);
+
+        static const char* names[] = { "beta", "Alpha", "gamma", "alpha", "Beta" };
+        const S32 row_count = 60;
+        std::vector<std::vector<std::string> > text(row_count);
+        for (S32 i = 0; i < row_count; ++i)
+        {
+            text[i].push_back(names[i % LL_ARRAY_SIZE(names)]);
+            text[i].push_back(llformat("%d", (i * 7) % 4));
+            text[i].push_back(llformat("%d", i));
+            if (i % 2)
+            {
+                LLScrollListItem* item = list->addVirtualRow(text[i], LLSD(i));
+                if (i % 3 == 0)
+                {
+                    item->getColumn(0);
+                }
+            }
+            else
+            {
+                LLScrollListItem::Params item_p;
+                item_p.value = LLSD(i);
+                for (const std::string& column : text[i])
+                {
+                    item_p.columns.add().value(column);
+                }
+                list->addRow(item_p);
+            }
+        }
+
+        list->sortByColumnIndex(1, true);
+        list->sortByColumnIndex(0, false);
+
+        std::vector<S32> expected(row_count);
+        for (S32 i = 0; i < row_count; ++i)
+        {
+            expected[i] = i;
+        }
+        std::stable_sort(expected.begin(), expected.end(), [&text](S32 a, S32 b)
+            {
+                S32 result = -LLStringUtil::compareDict(text[a][0], text[b][0]);
+                if (!result)
+                {
+                    result = LLStringUtil::compareDict(text[a][1], text[b][1]);
+                }
+                return result < 0;
+            });
+        ok &= expect(list->isSorted() && get_row_values(list) == expected, "mixed rows sorted in the wrong order");
+
+        delete list;
+    }
+
+    // a background sort that finishes after rows came or text changed is
+    // not taken as the final order, the list is sorted again after it
+    {
+        LL::WorkQueue main_queue("mainloop");
+        LL::ThreadPool general_pool("General", 1);
+        general_pool.start();
+
+        LLScrollListCtrl::Params params;
+        params.name("background_sort");
+        params.rect(LLRect(0, 480, 640, 0));
+        LLScrollListCtrl* list = LLUICtrlFactory::create<LLScrollListCtrl>(params);
+
+        const S32 row_count = 3000;
+        std::vector<std::string> text(row_count + 1);
+        for (S32 i = 0; i < row_count; ++i)
+        {
+            text[i] = llformat("Object %05d", (i * 7919) % row_count);
+            list->addVirtualRow(std::vector<std::string>(1, text[i]), LLSD(i));
+        }
+        const std::vector<S32> unsorted = get_row_values(list);
+
+        auto wait_for_sort = [&main_queue, list]()
+        {
+            LLTimer timer;
+            while (list->isSortPending() && timer.getElapsedTimeF64() < 30.0)
+            {
+                main_queue.runPending();
+                ms_sleep(1);
+            }
+            return !list->isSortPending();
+        };
+        auto expected_order = [&text](S32 count)
+        {
+            std::vector<S32> order(count);
+            for (S32 i = 0; i < count; ++i)
+            {
+                order[i] = i;
+            }
+            std::stable_sort(order.begin(), order.end(), [&text](S32 a, S32 b)
+                {
+                    return LLStringUtil::compareDict(text[a], text[b]) < 0;
+                });
+            return order;
+        };
+
+        // rows came in this frame, so the sort waits for the next one
+        list->sortByColumnIndex(0, true);
+        ok &= expect(!list->isSortPending() && !list->isSorted(), "a sort started while rows were still coming");
+        LLFrameTimer::updateFrameCount();
+        list->updateSort();
+        ok &= expect(list->isSortPending(), "a long list of virtual rows was not sorted in the background");
+
+        // a row comes while the sort runs, its result must be thrown away
+        text[row_count] = "Object 00000a";
+        list->addVirtualRow(std::vector<std::string>(1, text[row_count]), LLSD(row_count));
+        ok &= expect(wait_for_sort(), "the background sort did not finish");
+        std::vector<S32> with_row(unsorted);
+        with_row.push_back(row_count);
+        ok &= expect(!list->isSorted() && get_row_values(list) == with_row, "a stale background sort was applied");
+
+        LLFrameTimer::updateFrameCount();
+        list->updateSort();
+        LLFrameTimer::updateFrameCount();
+        list->updateSort();
+        ok &= expect(wait_for_sort() && list->isSorted(), "the list was not sorted again after a stale sort");
+        ok &= expect(get_row_values(list) == expected_order(row_count + 1), "the background sort gave the wrong order");
+
+        // text changes while the sort runs, it may be applied but is not final
+        LLScrollListItem* last = list->getAllData().back();
+        const S32 changed = last->getValue().asInteger();
+        text[changed] = "Object";
+        list->setVirtualRowText(last, 0, text[changed]);
+        LLFrameTimer::updateFrameCount();
+        list->updateSort();
+        text[changed] = "Aardvark";
+        list->setVirtualRowText(last, 0, text[changed]);
+        ok &= expect(wait_for_sort() && !list->isSorted(), "a background sort of changed text was taken as final");
+
+        LLFrameTimer::updateFrameCount();
+        list->updateSort();
+        ok &= expect(wait_for_sort() && list->isSorted(), "the list was not sorted again after its text changed");
+        ok &= expect(get_row_values(list) == expected_order(row_count + 1), "the resort after a text change gave the wrong order");
+
+        delete list;
+        general_pool.close();
+    }
+
+    return ok;
+}
+
+static const char USAGE[] = "usage: llui_libtest [--text-append <lines>] [--widgets] [--url-match <lines>] [--scroll-list <rows>] [--virtual-rows]";
+
 int main(int argc, char** argv)
 {
+    S32 text_append_lines = 0;
+    bool widgets = false;
+    S32 url_match_lines = 0;
+    S32 scroll_list_rows = 0;
+    bool virtual_rows = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "--text-append") && i + 1 < argc)
+        {
+            text_append_lines = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--widgets"))
+        {
+            widgets = true;
+        }
+        else if (!strcmp(argv[i], "--url-match") && i + 1 < argc)
+        {
+            url_match_lines = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--scroll-list") && i + 1 < argc)
+        {
+            scroll_list_rows = atoi(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--virtual-rows"))
+        {
+            virtual_rows = true;
+        }
+        else
+        {
+            std::cerr << USAGE << std::endl;
+            return 1;
+        }
+    }
+
     // Must init LLError for llerrs to actually cause errors.
-    LLError::initForApplication(".");
+    LLError::initForApplication(".", ".");
 
     init_llui();
 
 //  export_test_floaters();
 
+    if (text_append_lines > 0 && !test_text_append(text_append_lines, widgets))
+    {
+        return 1;
+    }
+
+    if (virtual_rows && !test_virtual_rows())
+    {
+        return 1;
+    }
+
+    if (url_match_lines > 0)
+    {
+        benchmark_url_match(url_match_lines);
+    }
+
+    if (scroll_list_rows > 0)
+    {
+        benchmark_scroll_list(scroll_list_rows);
+    }
+
     return 0;
 }
@@ -200,6 +200,26 @@ void LLCharacter::updateMotions(e_update_t update_type)
     }
 }
 
+//-----------------------------------------------------------------------------
+// prepareMotions()
+//-----------------------------------------------------------------------------
+bool LLCharacter::prepareMotions(e_update_t update_type)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    if (update_type == HIDDEN_UPDATE)
+    {
+        mMotionController.updateMotionsMinimal();
+        return false;
+    }
+
+    // unpause if the number of outstanding pause requests has dropped to the initial one
+    if (mMotionController.isPaused() && mPauseRequest->getNumRefs() == 1)
+    {
+        mMotionController.unpauseAllMotions();
+    }
+    return mMotionController.prepareMotions(update_type == FORCE_UPDATE);
+}
+
 
 //-----------------------------------------------------------------------------
 // deactivateAllMotions()
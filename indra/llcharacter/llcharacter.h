@@ -123,6 +123,10 @@ public:
     // updates all visual parameters for this character
     virtual void updateVisualParams();
 
+    // for motions: updates visual parameters now, or once the motion
+    // controller has finished evaluating if it runs off the main thread
+    void requestVisualParamsUpdate() { mMotionController.requestVisualParamsUpdate(); }
+
     virtual void addDebugText( const std::string& text ) = 0;
 
     virtual const LLUUID&   getID() const = 0;
@@ -161,6 +165,13 @@ public:
     enum e_update_t { NORMAL_UPDATE, HIDDEN_UPDATE, FORCE_UPDATE };
     void updateMotions(e_update_t update_type);
 
+    // updateMotions() in steps, so that several characters can be
+    // evaluated concurrently; see LLMotionController::prepareMotions().
+    // Returns true if evaluateMotions() needs to be called.
+    bool prepareMotions(e_update_t update_type);
+    void evaluateMotions() { mMotionController.evaluateMotions(); }
+    void finishMotions() { mMotionController.finishMotions(); }
+
     LLAnimPauseRequest requestPause();
     bool areAnimationsPaused() const { return mMotionController.isPaused(); }
     void setAnimTimeFactor(F32 factor) { mMotionController.setTimeFactor(factor); }
@@ -30,6 +30,7 @@
 #include "linden_common.h"
 
 #include "lljoint.h"
+#include "lljointhierarchy.h"
 
 #include "llmath.h"
 #include <boost/algorithm/string.hpp>
@@ -122,6 +123,8 @@ void LLJoint::init()
 {
     mName = "unnamed";
     mParent = NULL;
+    mHierarchy = NULL;
+    mHierarchyIndex = -1;
     mXform.setScaleChildOffset(true);
     mXform.setScale(LLVector3(1.0f, 1.0f, 1.0f));
     mDirtyFlags = MATRIX_DIRTY | ROTATION_DIRTY | POSITION_DIRTY;
@@ -173,6 +176,10 @@ LLJoint::~LLJoint()
         mParent->removeChild( this );
     }
     removeAllChildren();
+    if (mHierarchy && mHierarchyIndex == 0)
+    {
+        mHierarchy->onRootDestroyed();
+    }
 }
 
 
@@ -293,6 +300,10 @@ void LLJoint::addChild(LLJoint* joint)
     joint->mXform.setParent(&mXform);
     joint->mParent = this;
     joint->touch();
+    if (mHierarchy)
+    {
+        mHierarchy->setNeedsRebuild();
+    }
 }
 
 
@@ -309,6 +320,11 @@ void LLJoint::removeChild(LLJoint* joint)
         joint->mXform.setParent(NULL);
         joint->mParent = NULL;
         joint->touch();
+        if (mHierarchy)
+        {
+            mHierarchy->setNeedsRebuild();
+            LLJointHierarchy::detach(joint);
+        }
     }
 }
 
@@ -325,10 +341,18 @@ void LLJoint::removeAllChildren()
             joint->mXform.setParent(NULL);
             joint->mParent = NULL;
             joint->touch();
+            if (mHierarchy)
+            {
+                LLJointHierarchy::detach(joint);
+            }
             //delete joint;
         }
     }
     mChildren.clear();
+    if (mHierarchy)
+    {
+        mHierarchy->setNeedsRebuild();
+    }
 }
 
 
@@ -773,6 +797,11 @@ LLVector3 LLJoint::getWorldPosition()
 //-----------------------------------------------------------------------------
 LLVector3 LLJoint::getLastWorldPosition()
 {
+    if (mHierarchy)
+    {
+        // Only the world matrix is kept current in a flattened tree
+        return mXform.getWorldMatrix().getTranslation();
+    }
     return mXform.getWorldPosition();
 }
 //--------------------------------------------------------------------
@@ -844,6 +873,10 @@ LLQuaternion LLJoint::getWorldRotation()
 //-----------------------------------------------------------------------------
 LLQuaternion LLJoint::getLastWorldRotation()
 {
+    if (mHierarchy)
+    {
+        return LLQuaternion(mHierarchy->getRigidMatrix(mHierarchyIndex).asMatrix4());
+    }
     return mXform.getWorldRotation();
 }
 
@@ -923,6 +956,10 @@ const LLMatrix4a& LLJoint::getWorldMatrix4a()
 {
     updateWorldMatrixParent();
 
+    if (mHierarchy)
+    {
+        return mHierarchy->getWorldMatrix(mHierarchyIndex);
+    }
     return mWorldMatrix;
 }
 
@@ -952,6 +989,12 @@ void LLJoint::updateWorldMatrixParent()
 {
     if (mDirtyFlags & MATRIX_DIRTY)
     {
+        if (mHierarchy)
+        {
+            mHierarchy->updateJoint(this);
+            return;
+        }
+
         LLJoint *parent = getParent();
         if (parent)
         {
@@ -986,6 +1029,13 @@ void LLJoint::updateWorldMatrixChildren()
 {
     if (!this->mUpdateXform) return;
 
+    if (mHierarchy)
+    {
+        // Updates the whole tree, but only dirty joints cost anything
+        mHierarchy->update();
+        return;
+    }
+
     if (mDirtyFlags & MATRIX_DIRTY)
     {
         updateWorldMatrix();
@@ -1003,6 +1053,18 @@ void LLJoint::updateWorldMatrix()
 {
     if (mDirtyFlags & MATRIX_DIRTY)
     {
+        if (mHierarchy)
+        {
+            mHierarchy->updateJoint(this);
+            return;
+        }
+
+        // A flattened parent only keeps its world matrix current
+        if (mParent && mParent->mHierarchy)
+        {
+            mParent->updateWorldPRSParent();
+        }
+
         sNumUpdates++;
         mXform.updateMatrix(false);
         mWorldMatrix.loadu(mXform.getWorldMatrix());
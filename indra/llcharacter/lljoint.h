@@ -40,6 +40,8 @@
 #include "xform.h"
 #include "llmatrix4a.h"
 
+class LLJointHierarchy;
+
 //<FS:ND> Query by JointKey rather than just a string, the key can be a U32 index for faster lookup
 struct JointKey
 {
@@ -115,6 +117,7 @@ LL_ALIGN_PREFIX(16)
 class LLJoint
 {
     LL_ALIGN_NEW
+    friend class LLJointHierarchy;
 public:
     // priority levels, from highest to lowest
     enum JointPriority
@@ -153,6 +156,10 @@ protected:
     // parent joint
     LLJoint *mParent;
 
+    // flattened tree this joint belongs to, if any
+    LLJointHierarchy *mHierarchy;
+    S32 mHierarchyIndex;
+
     LLVector3       mDefaultPosition;
     LLVector3       mDefaultScale;
 
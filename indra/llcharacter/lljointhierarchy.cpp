@@ -0,0 +1,276 @@
+/**
+ * @file lljointhierarchy.cpp
+ * @brief Flattened, array-based world transform update for LLJoint trees
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+//-----------------------------------------------------------------------------
+// Header Files
+//-----------------------------------------------------------------------------
+#include "linden_common.h"
+
+#include "lljointhierarchy.h"
+
+#include "lljoint.h"
+#include "llparallelfor.h"
+#include "m4math.h"
+
+#include <atomic>
+
+// Hierarchies per job in updateAll(); a skeleton is only a few
+// microseconds of work.
+static const size_t UPDATE_ALL_GRAIN = 4;
+
+//-----------------------------------------------------------------------------
+// LLJointHierarchy()
+//-----------------------------------------------------------------------------
+LLJointHierarchy::LLJointHierarchy(LLJoint* root) :
+    mRoot(root),
+    mNeedsRebuild(true),
+    mFullUpdate(true)
+{
+    rebuild();
+}
+
+//-----------------------------------------------------------------------------
+// ~LLJointHierarchy()
+//-----------------------------------------------------------------------------
+LLJointHierarchy::~LLJointHierarchy()
+{
+    if (mRoot)
+    {
+        detach(mRoot);
+    }
+}
+
+//-----------------------------------------------------------------------------
+// detach()
+//-----------------------------------------------------------------------------
+//static
+void LLJointHierarchy::detach(LLJoint* joint)
+{
+    std::vector<LLJoint*> stack(1, joint);
+    while (!stack.empty())
+    {
+        LLJoint* cur = stack.back();
+        stack.pop_back();
+
+        cur->mHierarchy = NULL;
+        cur->mHierarchyIndex = -1;
+        stack.insert(stack.end(), cur->mChildren.begin(), cur->mChildren.end());
+    }
+}
+
+//-----------------------------------------------------------------------------
+// onRootDestroyed()
+//-----------------------------------------------------------------------------
+void LLJointHierarchy::onRootDestroyed()
+{
+    mRoot = NULL;
+    mJoints.clear();
+    mParents.clear();
+    mLocal.clear();
+    mRigid.clear();
+    mWorld.clear();
+    mNeedsRebuild = false;
+}
+
+//-----------------------------------------------------------------------------
+// rebuild()
+// Lays the tree out depth first so every parent precedes its children.
+//-----------------------------------------------------------------------------
+void LLJointHierarchy::rebuild()
+{
+    mJoints.clear();
+    mParents.clear();
+    mNeedsRebuild = false;
+    mFullUpdate = true;
+
+    if (!mRoot)
+    {
+        return;
+    }
+
+    std::vector<std::pair<LLJoint*, S32> > stack(1, std::make_pair(mRoot, -1));
+    while (!stack.empty())
+    {
+        LLJoint* joint = stack.back().first;
+        S32 parent = stack.back().second;
+        stack.pop_back();
+
+        // Joints that opt out of updateWorldMatrixChildren() keep the
+        // lazy per-joint path, and so do their descendants.
+        if (parent >= 0 && !joint->mUpdateXform)
+        {
+            detach(joint);
+            continue;
+        }
+
+        S32 index = static_cast<S32>(mJoints.size());
+        joint->mHierarchy = this;
+        joint->mHierarchyIndex = index;
+        mJoints.push_back(joint);
+        mParents.push_back(parent);
+
+        // Push in reverse so children are laid out in sibling order
+        for (LLJoint::joints_t::reverse_iterator it = joint->mChildren.rbegin(); it != joint->mChildren.rend(); ++it)
+        {
+            stack.push_back(std::make_pair(*it, index));
+        }
+    }
+
+    mLocal.resize(mJoints.size());
+    mRigid.resize(mJoints.size());
+    mWorld.resize(mJoints.size());
+}
+
+//-----------------------------------------------------------------------------
+// updateIndex()
+// Parent must be up to date.
+//-----------------------------------------------------------------------------
+void LLJointHierarchy::updateIndex(S32 index)
+{
+    LLJoint* joint = mJoints[index];
+    LLXformMatrix& xform = joint->mXform;
+    S32 parent = mParents[index];
+
+    if (parent < 0)
+    {
+        // The root may be parented to a non-joint transform, so let the
+        // xform resolve it.
+        xform.updateMatrix(false);
+        mWorld[index].loadu(xform.getWorldMatrix());
+
+        LLMatrix4 rigid;
+        rigid.initAll(LLVector3(1.f, 1.f, 1.f), xform.getWorldRotation(), xform.getWorldPosition());
+        mLocal[index].loadu(rigid);
+        mRigid[index] = mLocal[index];
+
+        joint->mDirtyFlags = 0x0;
+        return;
+    }
+
+    LLVector3 pos = xform.getPosition();
+    LLXformMatrix& parent_xform = mJoints[parent]->mXform;
+    if (parent_xform.getScaleChildOffset())
+    {
+        pos.scaleVec(parent_xform.getScale());
+    }
+
+    LLMatrix4 local;
+    local.initAll(LLVector3(1.f, 1.f, 1.f), xform.getRotation(), pos);
+    mLocal[index].loadu(local);
+    matMulUnsafe(mLocal[index], mRigid[parent], mRigid[index]);
+
+    const LLVector3& scale = xform.getScale();
+    LLMatrix4a& world = mWorld[index];
+    world.mMatrix[0].setMul(mRigid[index].mMatrix[0], scale.mV[VX]);
+    world.mMatrix[1].setMul(mRigid[index].mMatrix[1], scale.mV[VY]);
+    world.mMatrix[2].setMul(mRigid[index].mMatrix[2], scale.mV[VZ]);
+    world.mMatrix[3] = mRigid[index].mMatrix[3];
+
+    // Keep the xform's copy current for code that reads it directly.
+    // World position and rotation stay dirty and are resolved lazily by
+    // LLJoint::updateWorldPRSParent().
+    xform.setWorldMatrix(world.asMatrix4());
+    joint->mDirtyFlags &= ~LLJoint::MATRIX_DIRTY;
+}
+
+//-----------------------------------------------------------------------------
+// updateDirty()
+//-----------------------------------------------------------------------------
+S32 LLJointHierarchy::updateDirty()
+{
+    if (mNeedsRebuild)
+    {
+        rebuild();
+    }
+
+    S32 updated = 0;
+    const S32 count = static_cast<S32>(mJoints.size());
+    for (S32 i = 0; i < count; ++i)
+    {
+        if (mFullUpdate || (mJoints[i]->mDirtyFlags & LLJoint::MATRIX_DIRTY))
+        {
+            updateIndex(i);
+            ++updated;
+        }
+    }
+    mFullUpdate = false;
+    return updated;
+}
+
+//-----------------------------------------------------------------------------
+// update()
+//-----------------------------------------------------------------------------
+void LLJointHierarchy::update()
+{
+    LLJoint::sNumUpdates += updateDirty();
+}
+
+//-----------------------------------------------------------------------------
+// updateJoint()
+//-----------------------------------------------------------------------------
+void LLJointHierarchy::updateJoint(LLJoint* joint)
+{
+    if (mNeedsRebuild || mFullUpdate)
+    {
+        update();
+        return;
+    }
+
+    // Find the topmost dirty ancestor, then walk back down
+    std::vector<S32> chain;
+    for (S32 i = joint->mHierarchyIndex; i >= 0 && (mJoints[i]->mDirtyFlags & LLJoint::MATRIX_DIRTY); i = mParents[i])
+    {
+        chain.push_back(i);
+    }
+    for (std::vector<S32>::reverse_iterator it = chain.rbegin(); it != chain.rend(); ++it)
+    {
+        updateIndex(*it);
+    }
+    LLJoint::sNumUpdates += static_cast<S32>(chain.size());
+}
+
+//-----------------------------------------------------------------------------
+// updateAll()
+//-----------------------------------------------------------------------------
+//static
+void LLJointHierarchy::updateAll(const std::vector<LLJointHierarchy*>& hierarchies)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+
+    std::atomic<S32> updated(0);
+    LL::parallelFor("General", hierarchies.size(), UPDATE_ALL_GRAIN,
+                    [&hierarchies, &updated](size_t begin, size_t end)
+                    {
+                        S32 count = 0;
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            count += hierarchies[i]->updateDirty();
+                        }
+                        updated += count;
+                    });
+    LLJoint::sNumUpdates += updated;
+}
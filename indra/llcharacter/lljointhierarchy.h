@@ -0,0 +1,110 @@
+/**
+ * @file lljointhierarchy.h
+ * @brief Flattened, array-based world transform update for LLJoint trees
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLJOINTHIERARCHY_H
+#define LL_LLJOINTHIERARCHY_H
+
+#include <vector>
+
+#include "llmath.h"
+#include "llmatrix4a.h"
+
+class LLJoint;
+
+//-----------------------------------------------------------------------------
+// class LLJointHierarchy
+//
+// Optional flattened form of a joint tree.  The joints are laid out in
+// depth-first order with a parent index per joint, and their local and
+// world transforms live in contiguous LLMatrix4a arrays, so world
+// transforms are computed by one linear pass instead of a recursive walk
+// over heap-allocated joints.
+//
+// Joints stay the public API: once a tree is attached, LLJoint's world
+// matrix accessors and updateWorldMatrixChildren() read from and update
+// the arrays.  Adding or removing joints marks the layout stale and it is
+// rebuilt before the next update.
+//
+// World transforms match LLXformMatrix: scale is not inherited, but a
+// child's offset is scaled by its parent's scale.  The tree root keeps
+// using its LLXform so that it can still be parented to a non-joint
+// transform (e.g. a seat).
+//
+// Not thread safe, but distinct hierarchies may be updated concurrently;
+// see updateAll().
+//-----------------------------------------------------------------------------
+class LLJointHierarchy
+{
+public:
+    LLJointHierarchy(LLJoint* root);
+    ~LLJointHierarchy();
+
+    // Recompute world transforms of all dirty joints.
+    void update();
+
+    // Recompute the world transform of a joint in this hierarchy and
+    // whichever of its ancestors are dirty.
+    void updateJoint(LLJoint* joint);
+
+    // Update several hierarchies, spread over the General thread pool.
+    static void updateAll(const std::vector<LLJointHierarchy*>& hierarchies);
+
+    void setNeedsRebuild() { mNeedsRebuild = true; }
+
+    // The root joint is being destroyed.
+    void onRootDestroyed();
+
+    // Detach a joint and its descendants from whatever hierarchy they
+    // belong to.
+    static void detach(LLJoint* joint);
+
+    S32 getNumJoints() const { return static_cast<S32>(mJoints.size()); }
+    LLJoint* getJoint(S32 index) const { return mJoints[index]; }
+    S32 getParentIndex(S32 index) const { return mParents[index]; }
+
+    // World transform including the joint's own scale
+    const LLMatrix4a& getWorldMatrix(S32 index) const { return mWorld[index]; }
+    // World transform without scale, i.e. the frame children are placed in
+    const LLMatrix4a& getRigidMatrix(S32 index) const { return mRigid[index]; }
+
+private:
+    void rebuild();
+    void updateIndex(S32 index);
+    S32 updateDirty();
+
+    LLJoint*                mRoot;
+    bool                    mNeedsRebuild;
+    bool                    mFullUpdate;    // Arrays are stale after a rebuild
+
+    std::vector<LLJoint*>   mJoints;
+    std::vector<S32>        mParents;
+    std::vector<LLMatrix4a> mLocal;
+    std::vector<LLMatrix4a> mRigid;
+    std::vector<LLMatrix4a> mWorld;
+};
+
+#endif // LL_LLJOINTHIERARCHY_H
@@ -98,24 +98,24 @@ U32 LLKeyframeMotion::JointMotionList::dumpDiagInfo()
         LL_INFOS() << "\tJoint " << joint_motion_p->mJointName << LL_ENDL;
         if (joint_motion_p->mUsage & LLJointState::SCALE)
         {
-            LL_INFOS() << "\t" << joint_motion_p->mScaleCurve.mNumKeys << " scale keys at "
-            << joint_motion_p->mScaleCurve.mNumKeys * sizeof(ScaleKey) << " bytes" << LL_ENDL;
+            LL_INFOS() << "\t" << joint_motion_p->mScaleCurve.getNumKeys() << " scale keys at "
+            << joint_motion_p->mScaleCurve.getSizeBytes() << " bytes" << LL_ENDL;
 
-            total_size += joint_motion_p->mScaleCurve.mNumKeys * sizeof(ScaleKey);
+            total_size += static_cast<S32>(joint_motion_p->mScaleCurve.getSizeBytes());
         }
         if (joint_motion_p->mUsage & LLJointState::ROT)
         {
-            LL_INFOS() << "\t" << joint_motion_p->mRotationCurve.mNumKeys << " rotation keys at "
-            << joint_motion_p->mRotationCurve.mNumKeys * sizeof(RotationKey) << " bytes" << LL_ENDL;
+            LL_INFOS() << "\t" << joint_motion_p->mRotationCurve.getNumKeys() << " rotation keys at "
+            << joint_motion_p->mRotationCurve.getSizeBytes() << " bytes" << LL_ENDL;
 
-            total_size += joint_motion_p->mRotationCurve.mNumKeys * sizeof(RotationKey);
+            total_size += static_cast<S32>(joint_motion_p->mRotationCurve.getSizeBytes());
         }
         if (joint_motion_p->mUsage & LLJointState::POS)
         {
-            LL_INFOS() << "\t" << joint_motion_p->mPositionCurve.mNumKeys << " position keys at "
-            << joint_motion_p->mPositionCurve.mNumKeys * sizeof(PositionKey) << " bytes" << LL_ENDL;
+            LL_INFOS() << "\t" << joint_motion_p->mPositionCurve.getNumKeys() << " position keys at "
+            << joint_motion_p->mPositionCurve.getSizeBytes() << " bytes" << LL_ENDL;
 
-            total_size += joint_motion_p->mPositionCurve.mNumKeys * sizeof(PositionKey);
+            total_size += static_cast<S32>(joint_motion_p->mPositionCurve.getSizeBytes());
         }
     }
     LL_INFOS() << "Size: " << total_size << " bytes" << LL_ENDL;
@@ -131,225 +131,181 @@ U32 LLKeyframeMotion::JointMotionList::dumpDiagInfo()
 
 
 //-----------------------------------------------------------------------------
-// ScaleCurve::ScaleCurve()
+// ScaleCurve::getValue()
 //-----------------------------------------------------------------------------
-LLKeyframeMotion::ScaleCurve::ScaleCurve()
+LLVector3 LLKeyframeMotion::ScaleCurve::getValue(F32 time, F32 duration) const
 {
-    mInterpolationType = LLKeyframeMotion::IT_LINEAR;
-    mNumKeys = 0;
+    S32 cursor = 0;
+    return getValue(time, duration, cursor);
 }
 
-//-----------------------------------------------------------------------------
-// ScaleCurve::~ScaleCurve()
-//-----------------------------------------------------------------------------
-LLKeyframeMotion::ScaleCurve::~ScaleCurve()
-{
-    mKeys.clear();
-    mNumKeys = 0;
-}
-
-//-----------------------------------------------------------------------------
-// getValue()
-//-----------------------------------------------------------------------------
-LLVector3 LLKeyframeMotion::ScaleCurve::getValue(F32 time, F32 duration)
+LLVector3 LLKeyframeMotion::ScaleCurve::getValue(F32 time, F32 duration, S32& cursor) const
 {
-    LLVector3 value;
-
-    if (mKeys.empty())
+    if (mTimes.empty())
     {
-        value.clearVec();
-        return value;
+        return LLVector3::zero;
     }
 
-    key_map_t::iterator right = mKeys.lower_bound(time);
-    if (right == mKeys.end())
+    S32 right = findKey(time, cursor);
+    if (right == getNumKeys())
     {
         // Past last key
-        --right;
-        value = right->second.mScale;
+        return getKey(right - 1);
     }
-    else if (right == mKeys.begin() || right->first == time)
+    if (right == 0 || mTimes[right] == time)
     {
         // Before first key or exactly on a key
-        value = right->second.mScale;
+        return getKey(right);
     }
-    else
-    {
-        // Between two keys
-        key_map_t::iterator left = right; --left;
-        F32 index_before = left->first;
-        F32 index_after = right->first;
-        ScaleKey& scale_before = left->second;
-        ScaleKey& scale_after = right->second;
-        if (right == mKeys.end())
-        {
-            scale_after = mLoopInKey;
-            index_after = duration;
-        }
 
-        F32 u = (time - index_before) / (index_after - index_before);
-        value = interp(u, scale_before, scale_after);
-    }
-    return value;
+    // Between two keys
+    S32 left = right - 1;
+    F32 u = (time - mTimes[left]) / (mTimes[right] - mTimes[left]);
+    return interp(u, getKey(left), getKey(right));
 }
 
 //-----------------------------------------------------------------------------
 // interp()
 //-----------------------------------------------------------------------------
-LLVector3 LLKeyframeMotion::ScaleCurve::interp(F32 u, ScaleKey& before, ScaleKey& after)
+LLVector3 LLKeyframeMotion::ScaleCurve::interp(F32 u, const LLVector3& before, const LLVector3& after) const
 {
     switch (mInterpolationType)
     {
     case IT_STEP:
-        return before.mScale;
+        return before;
 
     default:
     case IT_LINEAR:
     case IT_SPLINE:
-        return lerp(before.mScale, after.mScale, u);
+        return lerp(before, after, u);
     }
 }
 
 //-----------------------------------------------------------------------------
-// RotationCurve::RotationCurve()
-//-----------------------------------------------------------------------------
-LLKeyframeMotion::RotationCurve::RotationCurve()
-{
-    mInterpolationType = LLKeyframeMotion::IT_LINEAR;
-    mNumKeys = 0;
-}
-
-//-----------------------------------------------------------------------------
-// RotationCurve::~RotationCurve()
+// RotationCurve::getValue()
 //-----------------------------------------------------------------------------
-LLKeyframeMotion::RotationCurve::~RotationCurve()
+LLQuaternion LLKeyframeMotion::RotationCurve::getValue(F32 time, F32 duration) const
 {
-    mKeys.clear();
-    mNumKeys = 0;
+    S32 cursor = 0;
+    return getValue(time, duration, cursor);
 }
 
-//-----------------------------------------------------------------------------
-// RotationCurve::getValue()
-//-----------------------------------------------------------------------------
-LLQuaternion LLKeyframeMotion::RotationCurve::getValue(F32 time, F32 duration)
+LLQuaternion LLKeyframeMotion::RotationCurve::getValue(F32 time, F32 duration, S32& cursor) const
 {
-    LLQuaternion value;
-
-    if (mKeys.empty())
+    if (mTimes.empty())
     {
-        value = LLQuaternion::DEFAULT;
-        return value;
+        return LLQuaternion::DEFAULT;
     }
 
-    key_map_t::iterator right = mKeys.lower_bound(time);
-    if (right == mKeys.end())
+    S32 right = findKey(time, cursor);
+    if (right == getNumKeys())
     {
         // Past last key
-        --right;
-        value = right->second.mRotation;
+        return getKey(right - 1);
     }
-    else if (right == mKeys.begin() || right->first == time)
+    if (right == 0 || mTimes[right] == time)
     {
         // Before first key or exactly on a key
-        value = right->second.mRotation;
+        return getKey(right);
     }
-    else
-    {
-        // Between two keys
-        key_map_t::iterator left = right; --left;
-        F32 index_before = left->first;
-        F32 index_after = right->first;
-        RotationKey& rot_before = left->second;
-        RotationKey& rot_after = right->second;
-        if (right == mKeys.end())
-        {
-            rot_after = mLoopInKey;
-            index_after = duration;
-        }
 
-        F32 u = (time - index_before) / (index_after - index_before);
-        value = interp(u, rot_before, rot_after);
-    }
-    return value;
+    // Between two keys
+    S32 left = right - 1;
+    F32 u = (time - mTimes[left]) / (mTimes[right] - mTimes[left]);
+    return interp(u, getKey(left), getKey(right));
 }
 
 //-----------------------------------------------------------------------------
 // interp()
 //-----------------------------------------------------------------------------
-LLQuaternion LLKeyframeMotion::RotationCurve::interp(F32 u, RotationKey& before, RotationKey& after)
+LLQuaternion LLKeyframeMotion::RotationCurve::interp(F32 u, const LLQuaternion& before, const LLQuaternion& after) const
 {
     switch (mInterpolationType)
     {
     case IT_STEP:
-        return before.mRotation;
+        return before;
 
     default:
     case IT_LINEAR:
     case IT_SPLINE:
-        return nlerp(u, before.mRotation, after.mRotation);
+        return nlerp(u, before, after);
     }
 }
 
+//-----------------------------------------------------------------------------
+// RotationCurve::getKey()
+//-----------------------------------------------------------------------------
+LLQuaternion LLKeyframeMotion::RotationCurve::getKey(S32 index) const
+{
+    return unpack(mValues[index]);
+}
 
 //-----------------------------------------------------------------------------
-// PositionCurve::PositionCurve()
+// RotationCurve::pack()
 //-----------------------------------------------------------------------------
-LLKeyframeMotion::PositionCurve::PositionCurve()
+// static
+LLKeyframeMotion::PackedVector3 LLKeyframeMotion::RotationCurve::pack(const LLQuaternion& rotation)
 {
-    mInterpolationType = LLKeyframeMotion::IT_LINEAR;
-    mNumKeys = 0;
+    LLVector3 rot_vec = rotation.packToVector3();
+    PackedVector3 packed;
+    packed.mV[VX] = F32_to_U16(rot_vec.mV[VX], -1.f, 1.f);
+    packed.mV[VY] = F32_to_U16(rot_vec.mV[VY], -1.f, 1.f);
+    packed.mV[VZ] = F32_to_U16(rot_vec.mV[VZ], -1.f, 1.f);
+    return packed;
 }
 
 //-----------------------------------------------------------------------------
-// PositionCurve::~PositionCurve()
+// RotationCurve::unpack()
 //-----------------------------------------------------------------------------
-LLKeyframeMotion::PositionCurve::~PositionCurve()
+// static
+LLQuaternion LLKeyframeMotion::RotationCurve::unpack(const PackedVector3& packed)
 {
-    mKeys.clear();
-    mNumKeys = 0;
+    LLVector3 rot_vec;
+    rot_vec.mV[VX] = U16_to_F32(packed.mV[VX], -1.f, 1.f);
+    rot_vec.mV[VY] = U16_to_F32(packed.mV[VY], -1.f, 1.f);
+    rot_vec.mV[VZ] = U16_to_F32(packed.mV[VZ], -1.f, 1.f);
+
+    LLQuaternion rotation;
+    rotation.unpackFromVector3(rot_vec);
+    return rotation;
 }
 
 //-----------------------------------------------------------------------------
 // PositionCurve::getValue()
 //-----------------------------------------------------------------------------
-LLVector3 LLKeyframeMotion::PositionCurve::getValue(F32 time, F32 duration)
+LLVector3 LLKeyframeMotion::PositionCurve::getValue(F32 time, F32 duration) const
+{
+    S32 cursor = 0;
+    return getValue(time, duration, cursor);
+}
+
+LLVector3 LLKeyframeMotion::PositionCurve::getValue(F32 time, F32 duration, S32& cursor) const
 {
     LLVector3 value;
 
-    if (mKeys.empty())
+    if (mTimes.empty())
     {
         value.clearVec();
         return value;
     }
 
-    key_map_t::iterator right = mKeys.lower_bound(time);
-    if (right == mKeys.end())
+    S32 right = findKey(time, cursor);
+    if (right == getNumKeys())
     {
         // Past last key
-        --right;
-        value = right->second.mPosition;
+        value = getKey(right - 1);
     }
-    else if (right == mKeys.begin() || right->first == time)
+    else if (right == 0 || mTimes[right] == time)
     {
         // Before first key or exactly on a key
-        value = right->second.mPosition;
+        value = getKey(right);
     }
     else
     {
         // Between two keys
-        key_map_t::iterator left = right; --left;
-        F32 index_before = left->first;
-        F32 index_after = right->first;
-        PositionKey& pos_before = left->second;
-        PositionKey& pos_after = right->second;
-        if (right == mKeys.end())
-        {
-            pos_after = mLoopInKey;
-            index_after = duration;
-        }
-
-        F32 u = (time - index_before) / (index_after - index_before);
-        value = interp(u, pos_before, pos_after);
+        S32 left = right - 1;
+        F32 u = (time - mTimes[left]) / (mTimes[right] - mTimes[left]);
+        value = interp(u, getKey(left), getKey(right));
     }
 
     llassert(value.isFinite());
@@ -360,19 +316,43 @@ LLVector3 LLKeyframeMotion::PositionCurve::getValue(F32 time, F32 duration)
 //-----------------------------------------------------------------------------
 // interp()
 //-----------------------------------------------------------------------------
-LLVector3 LLKeyframeMotion::PositionCurve::interp(F32 u, PositionKey& before, PositionKey& after)
+LLVector3 LLKeyframeMotion::PositionCurve::interp(F32 u, const LLVector3& before, const LLVector3& after) const
 {
     switch (mInterpolationType)
     {
     case IT_STEP:
-        return before.mPosition;
+        return before;
     default:
     case IT_LINEAR:
     case IT_SPLINE:
-        return lerp(before.mPosition, after.mPosition, u);
+        return lerp(before, after, u);
     }
 }
 
+//-----------------------------------------------------------------------------
+// PositionCurve::pack()
+//-----------------------------------------------------------------------------
+// static
+LLKeyframeMotion::PackedVector3 LLKeyframeMotion::PositionCurve::pack(const LLVector3& position)
+{
+    PackedVector3 packed;
+    packed.mV[VX] = F32_to_U16(position.mV[VX], -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET);
+    packed.mV[VY] = F32_to_U16(position.mV[VY], -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET);
+    packed.mV[VZ] = F32_to_U16(position.mV[VZ], -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET);
+    return packed;
+}
+
+//-----------------------------------------------------------------------------
+// PositionCurve::unpack()
+//-----------------------------------------------------------------------------
+// static
+LLVector3 LLKeyframeMotion::PositionCurve::unpack(const PackedVector3& packed)
+{
+    return LLVector3(U16_to_F32(packed.mV[VX], -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET),
+                     U16_to_F32(packed.mV[VY], -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET),
+                     U16_to_F32(packed.mV[VZ], -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET));
+}
+
 
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
@@ -383,7 +363,7 @@ LLVector3 LLKeyframeMotion::PositionCurve::interp(F32 u, PositionKey& before, Po
 //-----------------------------------------------------------------------------
 // JointMotion::update()
 //-----------------------------------------------------------------------------
-void LLKeyframeMotion::JointMotion::update(LLJointState* joint_state, F32 time, F32 duration)
+void LLKeyframeMotion::JointMotion::update(LLJointState* joint_state, F32 time, F32 duration, KeyCursor& cursor) const
 {
     // this value being 0 is the cause of https://jira.lindenlab.com/browse/SL-22678 but I haven't
     // managed to get a stack to see how it got here. Testing for 0 here will stop the crash.
@@ -397,25 +377,25 @@ void LLKeyframeMotion::JointMotion::update(LLJointState* joint_state, F32 time,
     //-------------------------------------------------------------------------
     // update scale component of joint state
     //-------------------------------------------------------------------------
-    if ((usage & LLJointState::SCALE) && mScaleCurve.mNumKeys)
+    if ((usage & LLJointState::SCALE) && mScaleCurve.getNumKeys())
     {
-        joint_state->setScale( mScaleCurve.getValue( time, duration ) );
+        joint_state->setScale( mScaleCurve.getValue( time, duration, cursor.mScale ) );
     }
 
     //-------------------------------------------------------------------------
     // update rotation component of joint state
     //-------------------------------------------------------------------------
-    if ((usage & LLJointState::ROT) && mRotationCurve.mNumKeys)
+    if ((usage & LLJointState::ROT) && mRotationCurve.getNumKeys())
     {
-        joint_state->setRotation( mRotationCurve.getValue( time, duration ) );
+        joint_state->setRotation( mRotationCurve.getValue( time, duration, cursor.mRotation ) );
     }
 
     //-------------------------------------------------------------------------
     // update position component of joint state
     //-------------------------------------------------------------------------
-    if ((usage & LLJointState::POS) && mPositionCurve.mNumKeys)
+    if ((usage & LLJointState::POS) && mPositionCurve.getNumKeys())
     {
-        joint_state->setPosition( mPositionCurve.getValue( time, duration ) );
+        joint_state->setPosition( mPositionCurve.getValue( time, duration, cursor.mPosition ) );
     }
 }
 
@@ -737,12 +717,18 @@ bool LLKeyframeMotion::onUpdate(F32 time, U8* joint_mask)
 //-----------------------------------------------------------------------------
 void LLKeyframeMotion::applyKeyframes(F32 time)
 {
-    llassert_always (mJointMotionList->getNumJointMotions() <= mJointStates.size());
-    for (U32 i=0; i<mJointMotionList->getNumJointMotions(); i++)
+    const U32 num_joint_motions = mJointMotionList->getNumJointMotions();
+    llassert_always (num_joint_motions <= mJointStates.size());
+    if (mKeyCursors.size() != num_joint_motions)
+    {
+        mKeyCursors.resize(num_joint_motions);
+    }
+    for (U32 i=0; i<num_joint_motions; i++)
     {
         mJointMotionList->getJointMotion(i)->update(mJointStates[i],
                                                       time,
-                                                      mJointMotionList->mDuration );
+                                                      mJointMotionList->mDuration,
+                                                      mKeyCursors[i]);
     }
 
     LLJoint::JointPriority* pose_priority = (LLJoint::JointPriority* )mCharacter->getAnimationData("Hand Pose Priority");
@@ -1602,6 +1588,7 @@ bool LLKeyframeMotion::deserialize(LLDataPacker& dp, const LLUUID& asset_id, boo
             rot_key.mTime = time;
             LLVector3 rot_angles;
             U16 x, y, z;
+            PackedVector3 packed;
 
             if (old_version)
             {
@@ -1620,6 +1607,7 @@ bool LLKeyframeMotion::deserialize(LLDataPacker& dp, const LLUUID& asset_id, boo
 
                 LLQuaternion::Order ro = StringToOrder("ZYX");
                 rot_key.mRotation = mayaQ(rot_angles.mV[VX], rot_angles.mV[VY], rot_angles.mV[VZ], ro);
+                packed = RotationCurve::pack(rot_key.mRotation);
             }
             else
             {
@@ -1654,6 +1642,9 @@ bool LLKeyframeMotion::deserialize(LLDataPacker& dp, const LLUUID& asset_id, boo
                     return false;
                 }
                 rot_key.mRotation.unpackFromVector3(rot_vec);
+                packed.mV[VX] = x;
+                packed.mV[VY] = y;
+                packed.mV[VZ] = z;
             }
 
             if (!rot_key.mRotation.isFinite())
@@ -1663,14 +1654,15 @@ bool LLKeyframeMotion::deserialize(LLDataPacker& dp, const LLUUID& asset_id, boo
                 return false;
             }
 
-            rCurve->mKeys[time] = rot_key;
+            rCurve->addKey(time, packed);
         }
+        rCurve->sortKeys();
 
-        if (joint_motion->mRotationCurve.mNumKeys > joint_motion->mRotationCurve.mKeys.size())
+        if (rCurve->mNumKeys > rCurve->getNumKeys())
         {
             rotation_duplicates++;
             LL_INFOS() << "Motion " << asset() << " had duplicated rotation keys that were removed: "
-                << joint_motion->mRotationCurve.mNumKeys << " > " << joint_motion->mRotationCurve.mKeys.size()
+                << rCurve->mNumKeys << " > " << rCurve->getNumKeys()
                 << " (" << rotation_duplicates << ")" << LL_ENDL;
         }
 
@@ -1699,6 +1691,7 @@ bool LLKeyframeMotion::deserialize(LLDataPacker& dp, const LLUUID& asset_id, boo
         {
             U16 time_short;
             PositionKey pos_key;
+            PackedVector3 packed;
 
             if (old_version)
             {
@@ -1735,6 +1728,7 @@ bool LLKeyframeMotion::deserialize(LLDataPacker& dp, const LLUUID& asset_id, boo
                 pos_key.mPosition.mV[VX] = llclamp( pos_key.mPosition.mV[VX], -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET);
                 pos_key.mPosition.mV[VY] = llclamp( pos_key.mPosition.mV[VY], -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET);
                 pos_key.mPosition.mV[VZ] = llclamp( pos_key.mPosition.mV[VZ], -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET);
+                packed = PositionCurve::pack(pos_key.mPosition);
 
             }
             else
@@ -1763,6 +1757,9 @@ bool LLKeyframeMotion::deserialize(LLDataPacker& dp, const LLUUID& asset_id, boo
                 pos_key.mPosition.mV[VX] = U16_to_F32(x, -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET);
                 pos_key.mPosition.mV[VY] = U16_to_F32(y, -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET);
                 pos_key.mPosition.mV[VZ] = U16_to_F32(z, -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET);
+                packed.mV[VX] = x;
+                packed.mV[VY] = y;
+                packed.mV[VZ] = z;
             }
 
             if (!pos_key.mPosition.isFinite())
@@ -1772,7 +1769,7 @@ bool LLKeyframeMotion::deserialize(LLDataPacker& dp, const LLUUID& asset_id, boo
                 return false;
             }
 
-            pCurve->mKeys[pos_key.mTime] = pos_key;
+            pCurve->addKey(pos_key.mTime, packed);
 
             if (is_pelvis)
             {
@@ -1780,11 +1777,13 @@ bool LLKeyframeMotion::deserialize(LLDataPacker& dp, const LLUUID& asset_id, boo
             }
         }
 
-        if (joint_motion->mPositionCurve.mNumKeys > joint_motion->mPositionCurve.mKeys.size())
+        pCurve->sortKeys();
+
+        if (pCurve->mNumKeys > pCurve->getNumKeys())
         {
             position_duplicates++;
             LL_INFOS() << "Motion " << asset() << " had duplicated position keys that were removed: "
-                << joint_motion->mPositionCurve.mNumKeys << " > " << joint_motion->mPositionCurve.mKeys.size()
+                << pCurve->mNumKeys << " > " << pCurve->getNumKeys()
                 << " (" << position_duplicates << ")" << LL_ENDL;
         }
 
@@ -2082,49 +2081,42 @@ bool LLKeyframeMotion::serialize(LLDataPacker& dp) const
         JointMotion* joint_motionp = mJointMotionList->getJointMotion(i);
         success &= dp.packString(joint_motionp->mJointName, "joint_name");
         success &= dp.packS32(joint_motionp->mPriority, "joint_priority");
-        success &= dp.packS32(static_cast<S32>(joint_motionp->mRotationCurve.mKeys.size()), "num_rot_keys");
+        const RotationCurve& rot_curve = joint_motionp->mRotationCurve;
+        const PositionCurve& pos_curve = joint_motionp->mPositionCurve;
+        success &= dp.packS32(rot_curve.getNumKeys(), "num_rot_keys");
 
         LL_DEBUGS("BVH") << "Joint " << i
             << " name: " << joint_motionp->mJointName
-            << " Rotation keys: " << joint_motionp->mRotationCurve.mKeys.size()
-            << " Position keys: " << joint_motionp->mPositionCurve.mKeys.size() << LL_ENDL;
-        for (RotationCurve::key_map_t::value_type& rot_pair : joint_motionp->mRotationCurve.mKeys)
+            << " Rotation keys: " << rot_curve.getNumKeys()
+            << " Position keys: " << pos_curve.getNumKeys() << LL_ENDL;
+        for (S32 k = 0; k < rot_curve.getNumKeys(); k++)
         {
-            RotationKey& rot_key = rot_pair.second;
-            U16 time_short = F32_to_U16(rot_key.mTime, 0.f, mJointMotionList->mDuration);
+            F32 time = rot_curve.mTimes[k];
+            U16 time_short = F32_to_U16(time, 0.f, mJointMotionList->mDuration);
             success &= dp.packU16(time_short, "time");
 
-            LLVector3 rot_angles = rot_key.mRotation.packToVector3();
+            // Keys are held in the quantized form the asset uses
+            const PackedVector3& packed = rot_curve.mValues[k];
+            success &= dp.packU16(packed.mV[VX], "rot_angle_x");
+            success &= dp.packU16(packed.mV[VY], "rot_angle_y");
+            success &= dp.packU16(packed.mV[VZ], "rot_angle_z");
 
-            U16 x, y, z;
-            rot_angles.quantize16(-1.f, 1.f, -1.f, 1.f);
-            x = F32_to_U16(rot_angles.mV[VX], -1.f, 1.f);
-            y = F32_to_U16(rot_angles.mV[VY], -1.f, 1.f);
-            z = F32_to_U16(rot_angles.mV[VZ], -1.f, 1.f);
-            success &= dp.packU16(x, "rot_angle_x");
-            success &= dp.packU16(y, "rot_angle_y");
-            success &= dp.packU16(z, "rot_angle_z");
-
-            LL_DEBUGS("BVH") << "  rot: t " << rot_key.mTime << " angles " << rot_angles.mV[VX] <<","<< rot_angles.mV[VY] <<","<< rot_angles.mV[VZ] << LL_ENDL;
+            LL_DEBUGS("BVH") << "  rot: t " << time << " angles " << packed.mV[VX] <<","<< packed.mV[VY] <<","<< packed.mV[VZ] << LL_ENDL;
         }
 
-        success &= dp.packS32(static_cast<S32>(joint_motionp->mPositionCurve.mKeys.size()), "num_pos_keys");
-        for (PositionCurve::key_map_t::value_type& pos_pair : joint_motionp->mPositionCurve.mKeys)
+        success &= dp.packS32(pos_curve.getNumKeys(), "num_pos_keys");
+        for (S32 k = 0; k < pos_curve.getNumKeys(); k++)
         {
-            PositionKey& pos_key = pos_pair.second;
-            U16 time_short = F32_to_U16(pos_key.mTime, 0.f, mJointMotionList->mDuration);
+            F32 time = pos_curve.mTimes[k];
+            U16 time_short = F32_to_U16(time, 0.f, mJointMotionList->mDuration);
             success &= dp.packU16(time_short, "time");
 
-            U16 x, y, z;
-            pos_key.mPosition.quantize16(-LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET, -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET);
-            x = F32_to_U16(pos_key.mPosition.mV[VX], -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET);
-            y = F32_to_U16(pos_key.mPosition.mV[VY], -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET);
-            z = F32_to_U16(pos_key.mPosition.mV[VZ], -LL_MAX_PELVIS_OFFSET, LL_MAX_PELVIS_OFFSET);
-            success &= dp.packU16(x, "pos_x");
-            success &= dp.packU16(y, "pos_y");
-            success &= dp.packU16(z, "pos_z");
-
-            LL_DEBUGS("BVH") << "  pos: t " << pos_key.mTime << " pos " << pos_key.mPosition.mV[VX] <<","<< pos_key.mPosition.mV[VY] <<","<< pos_key.mPosition.mV[VZ] << LL_ENDL;
+            const PackedVector3& packed = pos_curve.mValues[k];
+            success &= dp.packU16(packed.mV[VX], "pos_x");
+            success &= dp.packU16(packed.mV[VY], "pos_y");
+            success &= dp.packU16(packed.mV[VZ], "pos_z");
+
+            LL_DEBUGS("BVH") << "  pos: t " << time << " pos " << pos_curve.getKey(k) << LL_ENDL;
         }
     }
 
@@ -31,7 +31,9 @@
 // Header files
 //-----------------------------------------------------------------------------
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "llassetstorage.h"
 #include "llbboxlocal.h"
@@ -318,62 +320,161 @@ public:
     };
 
     //-------------------------------------------------------------------------
-    // ScaleCurve
+    // PackedVector3
+    // Three components quantized to 16 bits, as they are stored in the asset.
     //-------------------------------------------------------------------------
-    class ScaleCurve
+    struct PackedVector3
+    {
+        U16 mV[3];
+    };
+
+    //-------------------------------------------------------------------------
+    // KeyCurve
+    // Keys sorted by time in contiguous arrays.  Curves are built once when
+    // the asset is decoded and are then shared, read only, by every
+    // instance of the motion; each instance tracks its own position in the
+    // curve through a cursor passed to findKey().
+    //-------------------------------------------------------------------------
+    template <typename VALUE>
+    class KeyCurve
     {
     public:
-        ScaleCurve();
-        ~ScaleCurve();
-        LLVector3 getValue(F32 time, F32 duration);
-        LLVector3 interp(F32 u, ScaleKey& before, ScaleKey& after);
+        KeyCurve() : mInterpolationType(IT_LINEAR), mNumKeys(0) {}
+
+        S32 getNumKeys() const { return static_cast<S32>(mTimes.size()); }
+        size_t getSizeBytes() const { return mTimes.capacity() * sizeof(F32) + mValues.capacity() * sizeof(VALUE); }
+
+        void addKey(F32 time, const VALUE& value)
+        {
+            mTimes.push_back(time);
+            mValues.push_back(value);
+        }
+
+        // Sort keys by time.  Of several keys with the same time the last
+        // one added is kept.
+        void sortKeys()
+        {
+            const U32 count = static_cast<U32>(mTimes.size());
+            std::vector<U32> order(count);
+            for (U32 i = 0; i < count; ++i)
+            {
+                order[i] = i;
+            }
+            std::stable_sort(order.begin(), order.end(),
+                             [this](U32 a, U32 b) { return mTimes[a] < mTimes[b]; });
+
+            std::vector<F32> times;
+            std::vector<VALUE> values;
+            times.reserve(count);
+            values.reserve(count);
+            for (U32 i : order)
+            {
+                if (!times.empty() && times.back() == mTimes[i])
+                {
+                    values.back() = mValues[i];
+                }
+                else
+                {
+                    times.push_back(mTimes[i]);
+                    values.push_back(mValues[i]);
+                }
+            }
+            mTimes.swap(times);
+            mValues.swap(values);
+        }
+
+        // Index of the first key at or after 'time', or getNumKeys() if
+        // there is none.  Searching forward from 'cursor' makes playback
+        // O(1) per update; seeking backwards falls back to a binary search.
+        S32 findKey(F32 time, S32& cursor) const
+        {
+            const S32 count = getNumKeys();
+            S32 index = llclamp(cursor, 0, count);
+            if (index > 0 && mTimes[index - 1] >= time)
+            {
+                index = static_cast<S32>(std::lower_bound(mTimes.begin(), mTimes.begin() + index, time) - mTimes.begin());
+            }
+            else
+            {
+                while (index < count && mTimes[index] < time)
+                {
+                    ++index;
+                }
+            }
+            cursor = index;
+            return index;
+        }
 
         InterpolationType   mInterpolationType;
-        S32                 mNumKeys;
-        typedef std::map<F32, ScaleKey> key_map_t;
-        key_map_t           mKeys;
+        S32                 mNumKeys;   // As read from the asset, including duplicates
+        std::vector<F32>    mTimes;
+        std::vector<VALUE>  mValues;
+    };
+
+    //-------------------------------------------------------------------------
+    // ScaleCurve
+    //-------------------------------------------------------------------------
+    class ScaleCurve : public KeyCurve<LLVector3>
+    {
+    public:
+        LLVector3 getValue(F32 time, F32 duration) const;
+        LLVector3 getValue(F32 time, F32 duration, S32& cursor) const;
+        LLVector3 interp(F32 u, const LLVector3& before, const LLVector3& after) const;
+        const LLVector3& getKey(S32 index) const { return mValues[index]; }
+
         ScaleKey            mLoopInKey;
         ScaleKey            mLoopOutKey;
     };
 
     //-------------------------------------------------------------------------
     // RotationCurve
+    // Rotations are kept as the quantized vector part of the quaternion.
     //-------------------------------------------------------------------------
-    class RotationCurve
+    class RotationCurve : public KeyCurve<PackedVector3>
     {
     public:
-        RotationCurve();
-        ~RotationCurve();
-        LLQuaternion getValue(F32 time, F32 duration);
-        LLQuaternion interp(F32 u, RotationKey& before, RotationKey& after);
+        LLQuaternion getValue(F32 time, F32 duration) const;
+        LLQuaternion getValue(F32 time, F32 duration, S32& cursor) const;
+        LLQuaternion interp(F32 u, const LLQuaternion& before, const LLQuaternion& after) const;
+        LLQuaternion getKey(S32 index) const;
+
+        static PackedVector3 pack(const LLQuaternion& rotation);
+        static LLQuaternion unpack(const PackedVector3& packed);
 
-        InterpolationType   mInterpolationType;
-        S32                 mNumKeys;
-        typedef std::map<F32, RotationKey> key_map_t;
-        key_map_t       mKeys;
         RotationKey     mLoopInKey;
         RotationKey     mLoopOutKey;
     };
 
     //-------------------------------------------------------------------------
     // PositionCurve
+    // Positions are quantized over +/-LL_MAX_PELVIS_OFFSET.
     //-------------------------------------------------------------------------
-    class PositionCurve
+    class PositionCurve : public KeyCurve<PackedVector3>
     {
     public:
-        PositionCurve();
-        ~PositionCurve();
-        LLVector3 getValue(F32 time, F32 duration);
-        LLVector3 interp(F32 u, PositionKey& before, PositionKey& after);
+        LLVector3 getValue(F32 time, F32 duration) const;
+        LLVector3 getValue(F32 time, F32 duration, S32& cursor) const;
+        LLVector3 interp(F32 u, const LLVector3& before, const LLVector3& after) const;
+        LLVector3 getKey(S32 index) const { return unpack(mValues[index]); }
+
+        static PackedVector3 pack(const LLVector3& position);
+        static LLVector3 unpack(const PackedVector3& packed);
 
-        InterpolationType   mInterpolationType;
-        S32                 mNumKeys;
-        typedef std::map<F32, PositionKey> key_map_t;
-        key_map_t       mKeys;
         PositionKey     mLoopInKey;
         PositionKey     mLoopOutKey;
     };
 
+    //-------------------------------------------------------------------------
+    // KeyCursor
+    // Per instance search positions in the curves of one joint motion.
+    //-------------------------------------------------------------------------
+    struct KeyCursor
+    {
+        S32 mScale = 0;
+        S32 mRotation = 0;
+        S32 mPosition = 0;
+    };
+
     //-------------------------------------------------------------------------
     // JointMotion
     //-------------------------------------------------------------------------
@@ -387,7 +488,7 @@ public:
         U32             mUsage;
         LLJoint::JointPriority  mPriority;
 
-        void update(LLJointState* joint_state, F32 time, F32 duration);
+        void update(LLJointState* joint_state, F32 time, F32 duration, KeyCursor& cursor) const;
     };
 
     //-------------------------------------------------------------------------
@@ -426,6 +527,7 @@ public:
 protected:
     JointMotionList*                mJointMotionList;
     std::vector<LLPointer<LLJointState> > mJointStates;
+    std::vector<KeyCursor>          mKeyCursors;
     LLJoint*                        mPelvisp;
     LLCharacter*                    mCharacter;
     typedef std::list<JointConstraint*> constraint_list_t;
@@ -141,6 +141,8 @@ LLMotionController::LLMotionController()
       mTimeStepCount(0),
       mLastInterp(0.f),
       mIsSelf(false),
+      mDeferCallbacks(false),
+      mVisualParamsDirty(false),
       mLastCountAfterPurge(0)
 {
 }
@@ -401,6 +403,12 @@ LLMotion* LLMotionController::createMotion( const LLUUID &id )
 //-----------------------------------------------------------------------------
 bool LLMotionController::startMotion(const LLUUID &id, F32 start_offset)
 {
+    if (mDeferCallbacks)
+    {
+        mDeferredMotionRequests.push_back({ id, start_offset, true, false });
+        return true;
+    }
+
     // do we have an instance of this motion for this character?
     LLMotion *motion = findMotion(id);
 
@@ -443,6 +451,12 @@ bool LLMotionController::startMotion(const LLUUID &id, F32 start_offset)
 //-----------------------------------------------------------------------------
 bool LLMotionController::stopMotionLocally(const LLUUID &id, bool stop_immediate)
 {
+    if (mDeferCallbacks)
+    {
+        mDeferredMotionRequests.push_back({ id, 0.f, false, stop_immediate });
+        return true;
+    }
+
     // if already inactive, return false
     LLMotion *motion = findMotion(id);
     // SL-1290: always stop immediate if paused
@@ -527,7 +541,7 @@ void LLMotionController::updateIdleMotion(LLMotion* motionp)
         // this will only be called when an animation stops itself (runs out of time)
         if (mLastTime <= motionp->mSendStopTimestamp)
         {
-            mCharacter->requestStopMotion( motionp );
+            notifyStopMotion(motionp);
             stopMotionInstance(motionp, false);
         }
     }
@@ -629,7 +643,7 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
                 // this will only be called when an animation stops itself (runs out of time)
                 if (mLastTime <= motionp->mSendStopTimestamp)
                 {
-                    mCharacter->requestStopMotion( motionp );
+                    notifyStopMotion(motionp);
                     stopMotionInstance(motionp, false);
                 }
             }
@@ -710,7 +724,7 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
                 // this will only be called when an animation stops itself (runs out of time)
                 if (mLastTime <= motionp->mSendStopTimestamp)
                 {
-                    mCharacter->requestStopMotion( motionp );
+                    notifyStopMotion(motionp);
                     stopMotionInstance(motionp, false);
                 }
             }
@@ -756,7 +770,7 @@ void LLMotionController::updateMotionsByType(LLMotion::LLMotionBlendType anim_ty
                 // animation has stopped itself due to internal logic
                 // propagate this to the network
                 // as not all viewers are guaranteed to have access to the same logic
-                mCharacter->requestStopMotion( motionp );
+                notifyStopMotion(motionp);
                 stopMotionInstance(motionp, false);
             }
 
@@ -819,6 +833,21 @@ void LLMotionController::updateLoadingMotions()
 // updateMotion()
 //-----------------------------------------------------------------------------
 void LLMotionController::updateMotions(bool force_update)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    if (prepareMotions(force_update))
+    {
+        blendMotions();
+    }
+//  LL_INFOS() << "Motion controller time " << motionTimer.getElapsedTimeF32() << LL_ENDL;
+}
+
+//-----------------------------------------------------------------------------
+// prepareMotions()
+// steps the clock and loads pending motions, returns true if the active
+// motions need evaluating
+//-----------------------------------------------------------------------------
+bool LLMotionController::prepareMotions(bool force_update)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
     // SL-763: "Distant animated objects run at super fast speed"
@@ -861,7 +890,7 @@ void LLMotionController::updateMotions(bool force_update)
 
                 updateLoadingMotions();
 
-                return;
+                return false;
             }
 
             // is calculating a new keyframe pose, make sure the last one gets applied
@@ -885,29 +914,120 @@ void LLMotionController::updateMotions(bool force_update)
     if (mPaused && !force_update)
     {
         updateIdleActiveMotions();
+        mHasRunOnce = true;
+        return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// blendMotions()
+// runs the active motions and applies the blended pose to the joints
+//-----------------------------------------------------------------------------
+void LLMotionController::blendMotions()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    // update additive motions
+    updateAdditiveMotions();
+
+    resetJointSignatures();
+
+    // update all regular motions
+    updateRegularMotions();
+
+    if (mTimeStep != 0.f)
+    {
+        mPoseBlender.blendAndCache(true);
     }
     else
     {
-        // update additive motions
-        updateAdditiveMotions();
+        mPoseBlender.blendAndApply();
+    }
 
-        resetJointSignatures();
+    mHasRunOnce = true;
+}
 
-        // update all regular motions
-        updateRegularMotions();
+//-----------------------------------------------------------------------------
+// evaluateMotions()
+//-----------------------------------------------------------------------------
+void LLMotionController::evaluateMotions()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    mDeferCallbacks = true;
+    blendMotions();
+    mDeferCallbacks = false;
+}
 
-        if (use_quantum)
+//-----------------------------------------------------------------------------
+// finishMotions()
+// delivers what evaluateMotions() held back
+//-----------------------------------------------------------------------------
+void LLMotionController::finishMotions()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    for (LLMotion* motionp : mDeferredStopRequests)
+    {
+        mCharacter->requestStopMotion(motionp);
+    }
+    mDeferredStopRequests.clear();
+
+    for (LLMotion* motionp : mDeferredRemovals)
+    {
+        removeMotionInstance(motionp);
+    }
+    mDeferredRemovals.clear();
+
+    // swap out first, activating a motion can call startMotion() again
+    std::vector<DeferredMotionRequest> requests;
+    requests.swap(mDeferredMotionRequests);
+    for (const DeferredMotionRequest& request : requests)
+    {
+        if (request.mStart)
         {
-            mPoseBlender.blendAndCache(true);
+            startMotion(request.mID, request.mStartOffset);
         }
         else
         {
-            mPoseBlender.blendAndApply();
+            stopMotionLocally(request.mID, request.mStopImmediate);
         }
     }
 
-    mHasRunOnce = true;
-//  LL_INFOS() << "Motion controller time " << motionTimer.getElapsedTimeF32() << LL_ENDL;
+    if (mVisualParamsDirty)
+    {
+        mVisualParamsDirty = false;
+        mCharacter->updateVisualParams();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// requestVisualParamsUpdate()
+//-----------------------------------------------------------------------------
+void LLMotionController::requestVisualParamsUpdate()
+{
+    if (mDeferCallbacks)
+    {
+        mVisualParamsDirty = true;
+    }
+    else
+    {
+        mCharacter->updateVisualParams();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// notifyStopMotion()
+//-----------------------------------------------------------------------------
+void LLMotionController::notifyStopMotion(LLMotion* motionp)
+{
+    if (mDeferCallbacks)
+    {
+        mDeferredStopRequests.push_back(motionp);
+    }
+    else
+    {
+        mCharacter->requestStopMotion(motionp);
+    }
 }
 
 //-----------------------------------------------------------------------------
@@ -1005,7 +1125,16 @@ bool LLMotionController::deactivateMotionInstance(LLMotion *motion)
     if (found_it != mDeprecatedMotions.end())
     {
         // deprecated motions need to be completely excised
-        removeMotionInstance(motion);
+        if (mDeferCallbacks)
+        {
+            // a stop request for it may still be pending
+            mActiveMotions.remove(motion);
+            mDeferredRemovals.push_back(motion);
+        }
+        else
+        {
+            removeMotionInstance(motion);
+        }
         mDeprecatedMotions.erase(found_it);
     }
     else
@@ -33,6 +33,7 @@
 #include <string>
 #include <map>
 #include <deque>
+#include <vector>
 
 #include "llmotion.h"
 #include "llpose.h"
@@ -132,6 +133,20 @@ public:
     // deactivates terminated motions`
     void updateMotions(bool force_update = false);
 
+    // updateMotions() split in three, so the motions of several characters
+    // can be evaluated concurrently.  prepareMotions() and finishMotions()
+    // must run on the main thread.  evaluateMotions() may run on any thread
+    // and must be called in between if prepareMotions() returned true.
+    // Callbacks into the character (stop requests, visual param updates),
+    // startMotion()/stopMotionLocally() calls made by motions (emotes)
+    // and deletion of deprecated motions are held until finishMotions().
+    bool prepareMotions(bool force_update = false);
+    void evaluateMotions();
+    void finishMotions();
+
+    // called by motions after changing visual param weights
+    void requestVisualParamsUpdate();
+
     // minimal update (e.g. while hidden)
     void updateMotionsMinimal();
 
@@ -190,6 +205,8 @@ protected:
     void updateAdditiveMotions();
     void resetJointSignatures();
     void updateMotionsByType(LLMotion::LLMotionBlendType motion_type);
+    void blendMotions();
+    void notifyStopMotion(LLMotion* motionp);
     void updateIdleMotion(LLMotion* motionp);
     void updateIdleActiveMotions();
     void purgeExcessMotions();
@@ -232,6 +249,23 @@ protected:
     F32                 mLastInterp;
 
     U8                  mJointSignature[2][LL_CHARACTER_MAX_ANIMATED_JOINTS];
+
+    // held back by evaluateMotions() for finishMotions()
+    bool                mDeferCallbacks;
+    bool                mVisualParamsDirty;
+    std::vector<LLMotion*> mDeferredStopRequests;
+    std::vector<LLMotion*> mDeferredRemovals;
+
+    // start/stop calls made during evaluateMotions(), in call order;
+    // creating a motion touches the shared LLKeyframeDataCache
+    struct DeferredMotionRequest
+    {
+        LLUUID  mID;
+        F32     mStartOffset;
+        bool    mStart;
+        bool    mStopImmediate;
+    };
+    std::vector<DeferredMotionRequest> mDeferredMotionRequests;
 private:
     U32                 mLastCountAfterPurge; //for logging and debugging purposes
 };
@@ -31,6 +31,7 @@
 #include "v3math.h"
 
 #include "../lljoint.h"
+#include "../lljointhierarchy.h"
 
 #include "../test/lltut.h"
 
@@ -222,6 +223,75 @@ namespace tut
     }
 
 
+    static void build_chain(LLJoint& root, LLJoint& mid, LLJoint& leaf)
+    {
+        root.setup("root");
+        mid.setup("mid", &root);
+        leaf.setup("leaf", &mid);
+
+        root.setPosition(LLVector3(1.f, 2.f, 3.f));
+        root.setRotation(LLQuaternion(0.3f, LLVector3(0.f, 0.f, 1.f)));
+        root.setScale(LLVector3(1.5f, 1.f, 0.5f));
+        mid.setPosition(LLVector3(0.5f, -1.f, 2.f));
+        mid.setRotation(LLQuaternion(0.7f, LLVector3(1.f, 0.f, 0.f)));
+        mid.setScale(LLVector3(2.f, 2.f, 1.f));
+        leaf.setPosition(LLVector3(0.1f, 0.2f, 0.3f));
+        leaf.setRotation(LLQuaternion(-0.4f, LLVector3(0.f, 1.f, 0.f)));
+        leaf.setScale(LLVector3(0.5f, 1.f, 3.f));
+    }
+
+    static bool same_world(LLJoint& a, LLJoint& b)
+    {
+        const F32* ma = a.getWorldMatrix4a().getF32ptr();
+        const F32* mb = b.getWorldMatrix4a().getF32ptr();
+        for (S32 row = 0; row < 4; ++row)
+        {
+            for (S32 col = 0; col < 3; ++col)
+            {
+                if (fabsf(ma[row * 4 + col] - mb[row * 4 + col]) > 1.0e-5f)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    template<> template<>
+    void lljoint_object::test<15>()
+    {
+        // Flattened hierarchy matches the tree walk
+        LLJoint root, mid, leaf;
+        LLJoint flat_root, flat_mid, flat_leaf;
+        build_chain(root, mid, leaf);
+        build_chain(flat_root, flat_mid, flat_leaf);
+
+        LLJointHierarchy hierarchy(&flat_root);
+        ensure_equals("joint count", hierarchy.getNumJoints(), 3);
+        ensure_equals("topological order", hierarchy.getParentIndex(2), 1);
+
+        root.updateWorldMatrixChildren();
+        flat_root.updateWorldMatrixChildren();
+        ensure("root differs", same_world(root, flat_root));
+        ensure("leaf differs", same_world(leaf, flat_leaf));
+
+        // Lazy update of a single joint after a change
+        mid.setRotation(LLQuaternion(1.1f, LLVector3(0.f, 1.f, 0.f)));
+        flat_mid.setRotation(LLQuaternion(1.1f, LLVector3(0.f, 1.f, 0.f)));
+        ensure("lazy leaf differs", same_world(leaf, flat_leaf));
+        ensure("last world position",
+               dist_vec(leaf.getLastWorldPosition(), flat_leaf.getLastWorldPosition()) < 1.0e-5f);
+
+        // Topology changes detach and relayout
+        flat_mid.removeChild(&flat_leaf);
+        flat_root.updateWorldMatrixChildren();
+        ensure_equals("leaf not dropped", hierarchy.getNumJoints(), 2);
+        flat_root.addChild(&flat_leaf);
+        flat_root.updateWorldMatrixChildren();
+        ensure_equals("leaf not readded", hierarchy.getNumJoints(), 3);
+        ensure_equals("readded leaf parent", hierarchy.getParentIndex(2), 0);
+    }
+
     /*
         Test cases for the following not added. They perform operations
         on underlying LLXformMatrix and LLVector3 elements which have
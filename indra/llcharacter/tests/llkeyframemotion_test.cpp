@@ -0,0 +1,143 @@
+/**
+ * @file llkeyframemotion_test.cpp
+ * @brief LLKeyframeMotion key curve unit test
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llkeyframemotion.h"
+
+#include "../test/lltut.h"
+
+namespace tut
+{
+    struct keycurve_data
+    {
+        typedef LLKeyframeMotion::KeyCurve<S32> curve_t;
+
+        // Keys at 0.1, 0.3 and 0.5, added out of order
+        static void makeCurve(curve_t& curve)
+        {
+            curve.addKey(0.5f, 5);
+            curve.addKey(0.1f, 1);
+            curve.addKey(0.3f, 3);
+            curve.sortKeys();
+        }
+    };
+    typedef test_group<keycurve_data> keycurve_test;
+    typedef keycurve_test::object keycurve_object;
+    tut::keycurve_test keycurve_testcase("LLKeyframeMotion::KeyCurve");
+
+    template<> template<>
+    void keycurve_object::test<1>()
+    {
+        // sortKeys() orders keys by time, values follow their keys
+        curve_t curve;
+        makeCurve(curve);
+        ensure_equals("key count", curve.getNumKeys(), 3);
+        ensure_equals("time 0", curve.mTimes[0], 0.1f);
+        ensure_equals("time 1", curve.mTimes[1], 0.3f);
+        ensure_equals("time 2", curve.mTimes[2], 0.5f);
+        ensure_equals("value 0", curve.mValues[0], 1);
+        ensure_equals("value 1", curve.mValues[1], 3);
+        ensure_equals("value 2", curve.mValues[2], 5);
+    }
+
+    template<> template<>
+    void keycurve_object::test<2>()
+    {
+        // of several keys with the same time, the last one added is kept
+        curve_t curve;
+        curve.addKey(0.2f, 1);
+        curve.addKey(0.1f, 2);
+        curve.addKey(0.2f, 3);
+        curve.addKey(0.2f, 4);
+        curve.addKey(0.1f, 5);
+        curve.sortKeys();
+        ensure_equals("duplicates removed", curve.getNumKeys(), 2);
+        ensure_equals("time 0", curve.mTimes[0], 0.1f);
+        ensure_equals("time 1", curve.mTimes[1], 0.2f);
+        ensure_equals("last of 0.1 kept", curve.mValues[0], 5);
+        ensure_equals("last of 0.2 kept", curve.mValues[1], 4);
+    }
+
+    template<> template<>
+    void keycurve_object::test<3>()
+    {
+        // findKey() returns the first key at or after the time
+        curve_t curve;
+        makeCurve(curve);
+        S32 cursor = 0;
+        ensure_equals("before the first key", curve.findKey(0.f, cursor), 0);
+        ensure_equals("on the first key", curve.findKey(0.1f, cursor), 0);
+        ensure_equals("between keys", curve.findKey(0.2f, cursor), 1);
+        ensure_equals("on a key", curve.findKey(0.3f, cursor), 1);
+        ensure_equals("just after a key", curve.findKey(0.31f, cursor), 2);
+        ensure_equals("on the last key", curve.findKey(0.5f, cursor), 2);
+        ensure_equals("after the last key", curve.findKey(0.6f, cursor), 3);
+        ensure_equals("cursor follows", cursor, 3);
+    }
+
+    template<> template<>
+    void keycurve_object::test<4>()
+    {
+        // the cursor only changes how the key is found, not which one
+        curve_t curve;
+        makeCurve(curve);
+        const F32 times[] = { 0.f, 0.1f, 0.2f, 0.3f, 0.4f, 0.5f, 0.6f };
+        const S32 keys[] = { 0, 0, 1, 1, 2, 2, 3 };
+        const S32 count = LL_ARRAY_SIZE(times);
+
+        // forward, backwards (a loop or a seek), and from a stale cursor
+        S32 cursor = 0;
+        for (S32 i = 0; i < count; ++i)
+        {
+            ensure_equals("forward", curve.findKey(times[i], cursor), keys[i]);
+        }
+        for (S32 i = count - 1; i >= 0; --i)
+        {
+            ensure_equals("backwards", curve.findKey(times[i], cursor), keys[i]);
+        }
+        for (S32 i = 0; i < count; ++i)
+        {
+            cursor = 100;
+            ensure_equals("cursor past the end", curve.findKey(times[i], cursor), keys[i]);
+            cursor = -5;
+            ensure_equals("cursor before the start", curve.findKey(times[i], cursor), keys[i]);
+        }
+    }
+
+    template<> template<>
+    void keycurve_object::test<5>()
+    {
+        // an empty curve has no key at or after any time
+        curve_t curve;
+        curve.sortKeys();
+        S32 cursor = 2;
+        ensure_equals("no keys", curve.getNumKeys(), 0);
+        ensure_equals("end of an empty curve", curve.findKey(0.5f, cursor), 0);
+        ensure_equals("cursor clamped", cursor, 0);
+    }
+}
@@ -353,6 +353,9 @@ void LLApp::runErrorHandler()
         LLApp::sErrorHandler();
     }
 
+    // get anything the asynchronous log writer still holds into the log file
+    LLError::flushLogs();
+
     //LL_INFOS() << "App status now STOPPED" << LL_ENDL;
     LLApp::setStopped();
 }
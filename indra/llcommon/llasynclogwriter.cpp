@@ -0,0 +1,318 @@
+/**
+ * @file llasynclogwriter.cpp
+ * @brief Per-thread lock-free log buffers drained to a stream by a background thread
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llasynclogwriter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace LLError
+{
+
+namespace
+{
+    // How long the writer thread sleeps between batches when nobody wakes it
+    const std::chrono::milliseconds WRITE_INTERVAL(50);
+    // How long flush() waits for a batch in progress on the writer thread
+    const std::chrono::milliseconds FLUSH_TIMEOUT(500);
+
+    std::atomic<U64> sNextWriterID(1);
+
+    struct EntryHeader
+    {
+        AsyncLogWriter::formatter_t mFormatter; // NULL for a plain line
+        size_t                      mSize;
+    };
+
+    size_t ring_size_for(size_t requested)
+    {
+        size_t size = 1024;
+        while (size < requested)
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+}
+
+// Single producer, single consumer byte ring. mHead and mTail count bytes
+// since creation, the buffer index is the count modulo the power of two size.
+// Each line is an EntryHeader followed by its text, or by the data for its
+// formatter.
+struct AsyncLogWriter::Ring
+{
+    Ring(size_t size)
+    :   mData(new char[size]),
+        mSize(size),
+        mHead(0),
+        mTail(0),
+        mDropped(0),
+        mOrphaned(false)
+    {}
+
+    // copy in or out at 'pos', in at most two pieces around the end
+    void write(size_t pos, const void* src, size_t count)
+    {
+        const size_t begin = pos & (mSize - 1);
+        const size_t first = std::min(count, mSize - begin);
+        memcpy(mData.get() + begin, src, first);
+        memcpy(mData.get(), (const char*)src + first, count - first);
+    }
+
+    void read(size_t pos, void* dst, size_t count) const
+    {
+        const size_t begin = pos & (mSize - 1);
+        const size_t first = std::min(count, mSize - begin);
+        memcpy(dst, mData.get() + begin, first);
+        memcpy((char*)dst + first, mData.get(), count - first);
+    }
+
+    std::unique_ptr<char[]> mData;
+    const size_t            mSize;
+    alignas(64) std::atomic<size_t> mHead;  // written by the owning thread only
+    alignas(64) std::atomic<size_t> mTail;  // written by the drainer only
+    std::atomic<U32>        mDropped;
+    std::atomic<bool>       mOrphaned;      // the owning thread has exited
+};
+
+AsyncLogWriter::AsyncLogWriter(std::ostream& out, size_t ring_size, dropped_formatter_t dropped_formatter)
+:   mOut(out),
+    mRingSize(ring_size_for(ring_size)),
+    mDroppedFormatter(dropped_formatter),
+    mID(sNextWriterID++),
+    mStop(false),
+    mDropped(0)
+{
+    mThread = std::thread([this]() { run(); });
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mStop = true;
+    }
+    mWake.notify_one();
+    mThread.join();
+
+    std::lock_guard<std::timed_mutex> lock(mDrainMutex);
+    drain();
+}
+
+AsyncLogWriter::Ring* AsyncLogWriter::getRing()
+{
+    // A thread can post to several writers, e.g. the log file and the
+    // telemetry export, so it keeps one ring per writer.  The writer owns
+    // the rings; a ring outlives its thread until it has been drained.
+    struct ThreadRing
+    {
+        U64                     mWriterID;
+        Ring*                   mRing;      // valid while the writer lives
+        std::weak_ptr<Ring>     mOwned;     // expires with the writer
+    };
+    struct ThreadRings
+    {
+        std::vector<ThreadRing> mRings;
+
+        ~ThreadRings()
+        {
+            for (const ThreadRing& entry : mRings)
+            {
+                if (std::shared_ptr<Ring> ring = entry.mOwned.lock())
+                {
+                    ring->mOrphaned = true;
+                }
+            }
+        }
+    };
+    thread_local ThreadRings thread_rings;
+
+    std::vector<ThreadRing>& rings = thread_rings.mRings;
+    for (const ThreadRing& entry : rings)
+    {
+        if (entry.mWriterID == mID)
+        {
+            return entry.mRing;
+        }
+    }
+
+    // first post from this thread: forget writers that have gone away
+    rings.erase(std::remove_if(rings.begin(), rings.end(),
+                               [](const ThreadRing& entry) { return entry.mOwned.expired(); }),
+                rings.end());
+
+    std::shared_ptr<Ring> ring = std::make_shared<Ring>(mRingSize);
+    {
+        std::lock_guard<std::mutex> lock(mRingsMutex);
+        mRings.push_back(ring);
+    }
+    rings.push_back({ mID, ring.get(), ring });
+    return ring.get();
+}
+
+void AsyncLogWriter::post(const std::string& line)
+{
+    post(NULL, line.data(), line.size());
+}
+
+void AsyncLogWriter::post(formatter_t formatter, const void* data, size_t size)
+{
+    Ring* ring = getRing();
+
+    const EntryHeader header = { formatter, size };
+    const size_t length = sizeof(header) + size;
+    const size_t head = ring->mHead.load(std::memory_order_relaxed);
+    const size_t tail = ring->mTail.load(std::memory_order_acquire);
+    const size_t used = head - tail;
+    if (length > ring->mSize - used)
+    {
+        ring->mDropped.fetch_add(1, std::memory_order_relaxed);
+        mWake.notify_one();
+        return;
+    }
+
+    ring->write(head, &header, sizeof(header));
+    ring->write(head + sizeof(header), data, size);
+
+    ring->mHead.store(head + length, std::memory_order_release);
+
+    // wake the writer early rather than let a busy thread fill its ring
+    if (used + length > ring->mSize / 2)
+    {
+        mWake.notify_one();
+    }
+}
+
+bool AsyncLogWriter::flush()
+{
+    std::unique_lock<std::timed_mutex> lock(mDrainMutex, std::defer_lock);
+    if (!lock.try_lock_for(FLUSH_TIMEOUT))
+    {
+        return false;
+    }
+    drain();
+    return true;
+}
+
+void AsyncLogWriter::run()
+{
+    std::unique_lock<std::mutex> lock(mWakeMutex);
+    while (!mStop)
+    {
+        mWake.wait_for(lock, WRITE_INTERVAL);
+        lock.unlock();
+        {
+            std::lock_guard<std::timed_mutex> drain_lock(mDrainMutex);
+            drain();
+        }
+        lock.lock();
+    }
+}
+
+void AsyncLogWriter::drain()
+{
+    ring_list_t rings;
+    {
+        std::lock_guard<std::mutex> lock(mRingsMutex);
+        rings = mRings;
+    }
+
+    bool wrote = false;
+    for (const std::shared_ptr<Ring>& ring : rings)
+    {
+        const size_t tail = ring->mTail.load(std::memory_order_relaxed);
+        const size_t head = ring->mHead.load(std::memory_order_acquire);
+        for (size_t pos = tail; pos != head; )
+        {
+            EntryHeader header;
+            ring->read(pos, &header, sizeof(header));
+            pos += sizeof(header);
+
+            const size_t begin = pos & (ring->mSize - 1);
+            const size_t first = std::min(header.mSize, ring->mSize - begin);
+            if (!header.mFormatter)
+            {
+                mOut.write(ring->mData.get() + begin, first);
+                mOut.write(ring->mData.get(), header.mSize - first);
+            }
+            else if (first == header.mSize)
+            {
+                header.mFormatter(mOut, ring->mData.get() + begin, header.mSize);
+            }
+            else
+            {
+                // formatters want their data in one piece
+                mScratch.resize(header.mSize);
+                ring->read(pos, &mScratch[0], header.mSize);
+                header.mFormatter(mOut, mScratch.data(), header.mSize);
+            }
+            mOut << '\n';
+            pos += header.mSize;
+            wrote = true;
+        }
+        if (head != tail)
+        {
+            ring->mTail.store(head, std::memory_order_release);
+        }
+
+        U32 dropped = ring->mDropped.exchange(0, std::memory_order_relaxed);
+        if (dropped)
+        {
+            if (mDroppedFormatter)
+            {
+                mDroppedFormatter(mOut, dropped);
+            }
+            else
+            {
+                mOut << "(" << dropped << " log lines dropped, logging thread outpaced the log file)";
+            }
+            mOut << '\n';
+            mDropped.fetch_add(dropped, std::memory_order_relaxed);
+            wrote = true;
+        }
+    }
+
+    if (wrote)
+    {
+        mOut.flush();
+    }
+
+    // forget the rings of threads that have exited once they are empty
+    std::lock_guard<std::mutex> lock(mRingsMutex);
+    mRings.erase(std::remove_if(mRings.begin(), mRings.end(),
+                                [](const std::shared_ptr<Ring>& ring)
+                                {
+                                    return ring->mOrphaned.load(std::memory_order_acquire) &&
+                                           ring->mHead.load(std::memory_order_acquire) == ring->mTail.load(std::memory_order_relaxed);
+                                }),
+                 mRings.end());
+}
+
+} // namespace LLError
@@ -0,0 +1,123 @@
+/**
+ * @file llasynclogwriter.h
+ * @brief Per-thread lock-free log buffers drained to a stream by a background thread
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLASYNCLOGWRITER_H
+#define LL_LLASYNCLOGWRITER_H
+
+#include "llpreprocessor.h"
+#include "stdtypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace LLError
+{
+
+/**
+ * Moves log file output off the threads that log.  Each logging thread
+ * gets its own single producer ring of lines, so posting a line costs a
+ * copy and a couple of atomic operations and never waits on disk.  A
+ * background thread drains every ring into the stream and flushes once
+ * per batch.  Lines may also be posted unformatted, as a block of bytes and
+ * the function that turns them into text on the writer thread.
+ *
+ * Memory is bounded by the ring size per logging thread and writer.  A line
+ * that does not fit in its thread's ring is dropped, and the number of lines
+ * dropped is written to the stream with the next batch.
+ *
+ * Lines from one thread keep their order, lines from different threads are
+ * interleaved per batch rather than by time.
+ */
+class LL_COMMON_API AsyncLogWriter
+{
+public:
+    static const size_t DEFAULT_RING_SIZE = 256 * 1024;
+
+    /// Writes the line posted as 'data', without the newline.  Runs on the
+    /// writer thread, or on the thread calling flush().
+    typedef void (*formatter_t)(std::ostream& out, const char* data, size_t size);
+    /// Writes the note that 'dropped' lines were lost, without the newline.
+    typedef void (*dropped_formatter_t)(std::ostream& out, U32 dropped);
+
+    /// 'ring_size' is rounded up to a power of two of at least 1KB.  'out'
+    /// must outlive the writer.  'dropped_formatter' replaces the plain text
+    /// note about dropped lines, for streams with a format of their own.
+    AsyncLogWriter(std::ostream& out, size_t ring_size = DEFAULT_RING_SIZE,
+                   dropped_formatter_t dropped_formatter = NULL);
+    /// Drains everything posted so far and stops the writer thread.
+    ~AsyncLogWriter();
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    /// Queue one line, a newline is appended.  Never blocks.
+    void post(const std::string& line);
+    /// Queue a line that 'formatter' will write from a copy of 'data'.
+    void post(formatter_t formatter, const void* data, size_t size);
+
+    /// Write out everything posted so far and flush the stream, from the
+    /// calling thread.  Meant for error handling: rather than wait for long
+    /// on a stuck writer thread it gives up and returns false.
+    bool flush();
+
+    /// Total lines dropped because a ring was full.
+    U32 getDroppedCount() const { return mDropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Ring;
+    typedef std::vector<std::shared_ptr<Ring> > ring_list_t;
+
+    Ring* getRing();
+    void run();
+    void drain(); // requires mDrainMutex
+
+    std::ostream&           mOut;
+    const size_t            mRingSize;
+    const dropped_formatter_t mDroppedFormatter;
+    const U64               mID;        // tells threads' rings of this writer from a previous one
+
+    std::mutex              mRingsMutex; // guards mRings, taken once per thread and per batch
+    ring_list_t             mRings;
+
+    std::timed_mutex        mDrainMutex; // one drainer at a time, writer thread or flush()
+    std::string             mScratch;   // unwrapped copy of a formatter's data, requires mDrainMutex
+    std::mutex              mWakeMutex;
+    std::condition_variable mWake;
+    std::atomic<bool>       mStop;
+    std::atomic<U32>        mDropped;
+    std::thread             mThread;
+};
+
+} // namespace LLError
+
+#endif // LL_LLASYNCLOGWRITER_H
@@ -36,6 +36,7 @@
 # include <cxxabi.h>
 #endif // __GNUC__
 #include <sstream>
+#include <unordered_map>
 #if !LL_WINDOWS
 # include <syslog.h>
 # include <unistd.h>
@@ -48,6 +49,7 @@
 
 #include "llapp.h"
 #include "llapr.h"
+#include "llasynclogwriter.h"
 #include "llfile.h"
 #include "lllivefile.h"
 #include "llsd.h"
@@ -127,6 +129,10 @@ namespace {
     };
 #endif
 
+    // hands a record to the writer thread, defined below
+    void postRecord(LLError::AsyncLogWriter& writer, LLError::Recorder& recorder,
+                    const LLError::LogRecord& record);
+
     class RecordToFile : public LLError::Recorder
     {
     public:
@@ -151,6 +157,7 @@ namespace {
 
         ~RecordToFile()
         {
+            mAsyncWriter.reset(); // drains what is still queued
             mFile.close();
         }
 
@@ -171,6 +178,17 @@ namespace {
                                     const std::string& message) override
         {
             LL_PROFILE_ZONE_SCOPED_CATEGORY_LOGGING;
+            if (LLError::AsyncLogWriter* writer = asyncWriter())
+            {
+                writer->post(message);
+                if (level == LLError::LEVEL_ERROR)
+                {
+                    // the fatal function comes next, get this line on disk first
+                    writer->flush();
+                }
+                return;
+            }
+
             if (LLError::getAlwaysFlush())
             {
                 mFile << message << std::endl;
@@ -181,9 +199,49 @@ namespace {
             }
         }
 
+        virtual bool recordDeferred(const LLError::LogRecord& record) override
+        {
+            LL_PROFILE_ZONE_SCOPED_CATEGORY_LOGGING;
+            LLError::AsyncLogWriter* writer = asyncWriter();
+            if (!writer)
+            {
+                return false;
+            }
+            postRecord(*writer, *this, record);
+            return true;
+        }
+
+        void flush()
+        {
+            if (mAsyncWriter)
+            {
+                mAsyncWriter->flush();
+            }
+            else
+            {
+                mFile.flush();
+            }
+        }
+
     private:
+        // the writer if logging asynchronously, started on first use
+        LLError::AsyncLogWriter* asyncWriter()
+        {
+            if (!LLError::getAsyncLogging())
+            {
+                mAsyncWriter.reset();
+            }
+            else if (!mAsyncWriter)
+            {
+                // mFile now belongs to the writer thread
+                mAsyncWriter = std::make_unique<LLError::AsyncLogWriter>(mFile);
+            }
+            return mAsyncWriter.get();
+        }
+
         const std::string mName;
         llofstream mFile;
+        std::unique_ptr<LLError::AsyncLogWriter> mAsyncWriter;
     };
 
 
@@ -499,6 +557,7 @@ namespace
         LLError::ELevel                     mDefaultLevel;
 
         bool                                mLogAlwaysFlush;
+        bool                                mLogAsync;
 
         U32                                 mEnabledLogTypesMask;
 
@@ -526,6 +585,7 @@ namespace
         : LLRefCount(),
         mDefaultLevel(LLError::LEVEL_DEBUG),
         mLogAlwaysFlush(true),
+        mLogAsync(false),
         mEnabledLogTypesMask(255),
         mFunctionLevelMap(),
         mClassLevelMap(),
@@ -840,6 +900,18 @@ namespace LLError
         return s->mLogAlwaysFlush;
     }
 
+    void setAsyncLogging(bool async)
+    {
+        SettingsConfigPtr s = Globals::getInstance()->getSettingsConfig();
+        s->mLogAsync = async;
+    }
+
+    bool getAsyncLogging()
+    {
+        SettingsConfigPtr s = Globals::getInstance()->getSettingsConfig();
+        return s->mLogAsync;
+    }
+
     void setEnabledLogTypesMask(U32 mask)
     {
         SettingsConfigPtr s = Globals::getInstance()->getSettingsConfig();
@@ -940,6 +1012,10 @@ namespace LLError
         {
             setAlwaysFlush(config["log-always-flush"]);
         }
+        if (config.has("log-async"))
+        {
+            setAsyncLogging(config["log-async"]);
+        }
         if (config.has("enabled-log-types-mask"))
         {
             setEnabledLogTypesMask(config["enabled-log-types-mask"].asInteger());
@@ -1159,6 +1235,27 @@ namespace LLError
         return found? found->getFilename() : std::string();
     }
 
+    void flushLogs()
+    {
+        // hold the recorder lock so the file recorder cannot go away or
+        // switch modes under us.  It is recursive, so a crash inside a
+        // recorder on this thread still gets it, but another thread may
+        // have died holding it: this runs from the error handler, so
+        // give up rather than wait.
+        SettingsConfigPtr s = Globals::getInstance()->getSettingsConfig();
+        std::unique_lock lock(s->mRecorderMutex, std::try_to_lock);
+        if (!lock.owns_lock())
+        {
+            return;
+        }
+        LL_PROFILE_MUTEX_LOCK(s->mRecorderMutex);
+        auto found = findRecorderPos<RecordToFile>(s).first;
+        if (found)
+        {
+            found->flush();
+        }
+    }
+
     void logToStderr()
     {
         if (! findRecorder<RecordToStderr>())
@@ -1224,10 +1321,89 @@ namespace
         return out.str();
     }
 
+    // The parts of the line prefix a recorder wants
+    struct LineFormat
+    {
+        bool mTime;
+        bool mLevel;
+        bool mTags;
+        bool mLocation;
+        bool mFunction;
+        bool mMultiline;
+    };
+
+    LineFormat lineFormat(LLError::Recorder& r)
+    {
+        return { r.wantsTime(), r.wantsLevel(), r.wantsTags(),
+                 r.wantsLocation(), r.wantsFunctionName(), r.wantsMultiline() };
+    }
+
+    // SITE is a CallSite or an InternedSite
+    template <typename SITE>
+    void formatLine(std::ostream& out, const LineFormat& format, const SITE& site,
+                    const std::string& time, const std::string& message,
+                    std::string& escaped_message)
+    {
+        out << time << " ";
+
+        if (format.mLevel)
+        {
+            out << site.mLevelString;
+        }
+        out << " ";
+
+        if (format.mTags)
+        {
+            out << site.mTagString;
+        }
+        out << " ";
+
+        if (format.mLocation || site.mLevel == LLError::LEVEL_ERROR)
+        {
+            out << site.mLocationString;
+        }
+        out << " ";
+
+        if (format.mFunction)
+        {
+            out << site.mFunctionString;
+        }
+        out << " : ";
+
+        if (format.mMultiline)
+        {
+            out << message;
+        }
+        else
+        {
+            if (escaped_message.empty())
+            {
+                escaped_message = escapedMessageLines(message);
+            }
+            out << escaped_message;
+        }
+    }
+
+    void writeToRecorder(LLError::Recorder& r, const SettingsConfigPtr& s,
+                         const LLError::CallSite& site, const std::string& message,
+                         std::string& escaped_message)
+    {
+        const LineFormat format = lineFormat(r);
+
+        std::string time;
+        if (format.mTime && s->mTimeFunction != NULL)
+        {
+            time = s->mTimeFunction();
+        }
+
+        std::ostringstream message_stream;
+        formatLine(message_stream, format, site, time, message, escaped_message);
+        r.recordMessage(site.mLevel, message_stream.str());
+    }
+
     void writeToRecorders(const LLError::CallSite& site, const std::string& message)
     {
         LL_PROFILE_ZONE_SCOPED_CATEGORY_LOGGING;
-        LLError::ELevel level = site.mLevel;
         SettingsConfigPtr s = Globals::getInstance()->getSettingsConfig();
 
         std::string escaped_message;
@@ -1242,53 +1418,101 @@ namespace
                 continue;
             }
 
-            std::ostringstream message_stream;
+            writeToRecorder(*r, s, site, message, escaped_message);
+        }
+    }
 
-            if (r->wantsTime() && s->mTimeFunction != NULL)
-            {
-                message_stream << s->mTimeFunction();
-            }
-            message_stream << " ";
+    std::string formatUTCTime(time_t time)
+    {
+        const size_t BUF_SIZE = 64;
+        char time_str[BUF_SIZE];    /* Flawfinder: ignore */
 
-            if (r->wantsLevel())
-            {
-                message_stream << site.mLevelString;
-            }
-            message_stream << " ";
+        // Called from the asynchronous log writer's thread as well, so
+        // stay clear of gmtime()'s shared buffer.
+        struct tm utc;
+#if LL_WINDOWS
+        bool converted = gmtime_s(&utc, &time) == 0;
+#else
+        bool converted = gmtime_r(&time, &utc) != NULL;
+#endif
+        auto chars = converted ? strftime(time_str, BUF_SIZE,
+                                          "%Y-%m-%dT%H:%M:%SZ",
+                                          &utc) : 0;
 
-            if (r->wantsTags())
-            {
-                message_stream << site.mTagString;
-            }
-            message_stream << " ";
+        return chars ? time_str : "time error";
+    }
 
-            if (r->wantsLocation() || level == LLError::LEVEL_ERROR)
-            {
-                message_stream << site.mLocationString;
-            }
-            message_stream << " ";
+    // The prefix strings of a CallSite, copied once per site for records
+    // formatted on the writer thread: that may still be busy while the
+    // static CallSites are destroyed at exit.
+    struct InternedSite
+    {
+        LLError::ELevel mLevel;
+        const char*     mLevelString;
+        std::string     mTagString;
+        std::string     mLocationString;
+        std::string     mFunctionString;
+    };
 
-            if (r->wantsFunctionName())
-            {
-                message_stream << site.mFunctionString;
-            }
-            message_stream << " : ";
+    const InternedSite* internSite(const LLError::CallSite& site)
+    {
+        // never freed, see above
+        static std::mutex* sMutex = new std::mutex;
+        static auto* sSites = new std::unordered_map<const LLError::CallSite*, const InternedSite*>;
 
-            if (r->wantsMultiline())
-            {
-                message_stream << message;
-            }
-            else
-            {
-                if (escaped_message.empty())
-                {
-                    escaped_message = escapedMessageLines(message);
-                }
-                message_stream << escaped_message;
-            }
+        std::lock_guard<std::mutex> lock(*sMutex);
+        const InternedSite*& interned = (*sSites)[&site];
+        if (!interned)
+        {
+            interned = new InternedSite{ site.mLevel, site.mLevelString, site.mTagString,
+                                         site.mLocationString, site.mFunctionString };
+        }
+        return interned;
+    }
+
+    // Leads the data of a record posted to the writer thread
+    struct DeferredHeader
+    {
+        const InternedSite*     mSite;
+        time_t                  mTime;
+        LLError::TimeFunction   mTimeFunction;
+        LineFormat              mFormat;
+    };
 
-            r->recordMessage(level, message_stream.str());
+    // AsyncLogWriter::formatter_t for postRecord()
+    void formatDeferred(std::ostream& out, const char* data, size_t size)
+    {
+        DeferredHeader header;
+        memcpy(&header, data, sizeof(header));
+
+        std::ostringstream message;
+        LLError::LogRecord::format(message, data + sizeof(header), size - sizeof(header));
+
+        std::string time;
+        if (header.mFormat.mTime && header.mTimeFunction != NULL)
+        {
+            // the default clock is read when the message is logged, others
+            // only now
+            time = (header.mTimeFunction == &LLError::utcTime)
+                ? formatUTCTime(header.mTime)
+                : header.mTimeFunction();
         }
+
+        std::string escaped_message;
+        formatLine(out, header.mFormat, *header.mSite, time, message.str(), escaped_message);
+    }
+
+    void postRecord(LLError::AsyncLogWriter& writer, LLError::Recorder& recorder,
+                    const LLError::LogRecord& record)
+    {
+        SettingsConfigPtr s = Globals::getInstance()->getSettingsConfig();
+        const DeferredHeader header = { internSite(record.getSite()), record.getTime(),
+                                        s->mTimeFunction, lineFormat(recorder) };
+
+        char buffer[sizeof(DeferredHeader) + LLError::LogRecord::CAPACITY];
+        memcpy(buffer, &header, sizeof(header));
+        memcpy(buffer + sizeof(header), record.getData(), record.getSize());
+        writer.post(&formatDeferred, buffer, sizeof(header) + record.getSize());
     }
 }
 
@@ -1456,6 +1680,94 @@ namespace LLError
             }
         }
     }
+
+    void Log::flush(const LogRecord& record)
+    {
+        LL_PROFILE_ZONE_SCOPED_CATEGORY_LOGGING;
+        // No print-once or fatal handling here, so unlike the stream flush()
+        // this does not need the log mutex and never drops the message.
+        const CallSite& site = record.getSite();
+        SettingsConfigPtr s = Globals::getInstance()->getSettingsConfig();
+
+        std::string message, escaped_message;
+        bool formatted = false;
+
+        std::unique_lock lock(s->mRecorderMutex); LL_PROFILE_MUTEX_LOCK(s->mRecorderMutex);
+        for (RecorderPtr& r : s->mRecorders)
+        {
+            if (!r || !r->enabled() || r->recordDeferred(record))
+            {
+                continue;
+            }
+
+            // this recorder wants text, format the message once for all of them
+            if (!formatted)
+            {
+                std::ostringstream out;
+                record.format(out);
+                message = out.str();
+                formatted = true;
+            }
+            writeToRecorder(*r, s, site, message, escaped_message);
+        }
+    }
+
+    LogRecord::LogRecord(const CallSite& site)
+    :   mSite(site),
+        mTime(time(NULL)),
+        mSize(0),
+        mFull(false)
+    {
+    }
+
+    // Each argument is stored as its formatter, its size and its bytes.
+    void LogRecord::addArg(formatter_t formatter, const void* data, size_t size)
+    {
+        const size_t header = sizeof(formatter) + sizeof(size);
+        if (mFull || mSize + header > CAPACITY)
+        {
+            mFull = true;
+            return;
+        }
+        if (mSize + header + size > CAPACITY)
+        {
+            mFull = true;
+            if (formatter != &formatString)
+            {
+                // part of a value is no use
+                return;
+            }
+            size = CAPACITY - mSize - header;
+        }
+
+        memcpy(mData + mSize, &formatter, sizeof(formatter));
+        memcpy(mData + mSize + sizeof(formatter), &size, sizeof(size));
+        memcpy(mData + mSize + header, data, size);
+        mSize += header + size;
+    }
+
+    // static
+    void LogRecord::format(std::ostream& out, const char* data, size_t size)
+    {
+        size_t pos = 0;
+        while (pos < size)
+        {
+            formatter_t formatter;
+            size_t arg_size;
+            memcpy(&formatter, data + pos, sizeof(formatter));
+            pos += sizeof(formatter);
+            memcpy(&arg_size, data + pos, sizeof(arg_size));
+            pos += sizeof(arg_size);
+            formatter(out, data + pos, arg_size);
+            pos += arg_size;
+        }
+    }
+
+    // static
+    void LogRecord::formatString(std::ostream& out, const char* data, size_t size)
+    {
+        out.write(data, size);
+    }
 }
 
 namespace LLError
@@ -1519,15 +1831,7 @@ namespace LLError
 
     std::string utcTime()
     {
-        time_t now = time(NULL);
-        const size_t BUF_SIZE = 64;
-        char time_str[BUF_SIZE];    /* Flawfinder: ignore */
-
-        auto chars = strftime(time_str, BUF_SIZE,
-                                  "%Y-%m-%dT%H:%M:%SZ",
-                                  gmtime(&now));
-
-        return chars ? time_str : "time error";
+        return formatUTCTime(time(NULL));
     }
 }
 
@@ -28,8 +28,12 @@
 #ifndef LL_LLERROR_H
 #define LL_LLERROR_H
 
+#include <cstring>
+#include <ctime>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <typeinfo>
 #include <vector>
 
@@ -187,6 +191,21 @@ const int LL_ERR_NOERR = 0;
     #ifdef _DEBUG constructs.  LL_DEBUGS("StringTag") messages are compiled into all builds,
     even release.  Which means you can use them to help debug even when deployed
     to a real grid.
+
+    Builds that want them gone entirely can define LL_LOG_COMPILE_LEVEL: sites
+    below that level (1 drops LL_DEBUGS, 2 drops LL_INFOS as well) compile to
+    nothing, streamed expressions included.
+
+    For chatty tags that should stay enabled in production, messages made of
+    a few values can be logged as a list of arguments instead of a stream:
+
+        LL_DEBUGS_ARGS("MeshStreaming", "fetched ", bytes, " bytes for mesh ", mesh_id);
+
+    The arguments are concatenated as << would.  Numbers, enums, UUIDs and
+    strings are copied into a binary record as they are; anything else is
+    formatted on the spot.  When the log file is written asynchronously (see
+    LLError::setAsyncLogging()) the record goes to the writer thread as is, and
+    the message and its prefix are formatted there rather than by the caller.
 */
 namespace LLError
 {
@@ -212,12 +231,17 @@ namespace LLError
     */
 
     struct CallSite;
+    class LogRecord;
 
     class LL_COMMON_API Log
     {
     public:
         static bool shouldLog(CallSite&);
         static void flush(const std::ostringstream&, const CallSite&);
+        static void flush(const LogRecord&);
+        /// build a record of 'args' and log it, see LL_DEBUGS_ARGS()
+        template <typename... ARGS>
+        static void record(const CallSite&, const ARGS&... args);
         static std::string demangle(const char* mangled);
         /// classname<TYPE>()
         template <typename T>
@@ -280,6 +304,91 @@ namespace LLError
     };
 
 
+    /// Specialize as true_type for a trivially copyable type whose operator<<
+    /// only depends on its value, so LogRecord may copy it and format it
+    /// later, possibly on another thread. Types holding pointers or
+    /// references must not opt in.
+    template <typename T>
+    struct DeferFormat : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T>> {};
+
+    /// The arguments of one LL_DEBUGS_ARGS() style message in binary form,
+    /// each stored with the function that formats it. Used by the macros
+    /// below, not intended for general use.
+    class LL_COMMON_API LogRecord
+    {
+    public:
+        /// Bytes of arguments a record holds, anything past that is cut
+        static const size_t CAPACITY = 1024;
+
+        typedef void (*formatter_t)(std::ostream& out, const char* data, size_t size);
+
+        LogRecord(const CallSite& site);
+
+        template <typename T>
+        void add(const T& arg)
+        {
+            if constexpr (std::is_convertible_v<const T&, const char*>)
+            {
+                // a null C string is undefined behaviour for string_view
+                const char* str = arg;
+                addString(str ? std::string_view(str) : std::string_view("(null)"));
+            }
+            else if constexpr (std::is_convertible_v<const T&, std::string_view>)
+            {
+                addString(arg);
+            }
+            else if constexpr (DeferFormat<T>::value)
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "DeferFormat types must be trivially copyable");
+                addArg(&formatValue<T>, &arg, sizeof(T));
+            }
+            else
+            {
+                std::ostringstream out;
+                out << arg;
+                addString(out.str());
+            }
+        }
+
+        const CallSite& getSite() const { return mSite; }
+        time_t getTime() const { return mTime; }
+        const char* getData() const { return mData; }
+        size_t getSize() const { return mSize; }
+
+        /// write the message to 'out'
+        void format(std::ostream& out) const { format(out, mData, mSize); }
+        /// write a message stored by a record, 'data' as from getData()
+        static void format(std::ostream& out, const char* data, size_t size);
+
+    private:
+        void addArg(formatter_t formatter, const void* data, size_t size);
+        void addString(std::string_view str) { addArg(&formatString, str.data(), str.size()); }
+
+        static void formatString(std::ostream& out, const char* data, size_t size);
+
+        template <typename T>
+        static void formatValue(std::ostream& out, const char* data, size_t size)
+        {
+            T value;
+            memcpy(&value, data, sizeof(T));
+            out << value;
+        }
+
+        const CallSite& mSite;
+        const time_t    mTime;
+        size_t          mSize;
+        bool            mFull;      // an argument was cut, ignore the rest
+        char            mData[CAPACITY];
+    };
+
+    template <typename... ARGS>
+    void Log::record(const CallSite& site, const ARGS&... args)
+    {
+        LogRecord record(site);
+        (record.add(args), ...);
+        flush(record);
+    }
+
     class End { };
     inline std::ostream& operator<<(std::ostream& s, const End&)
         { return s; }
@@ -385,8 +494,18 @@ typedef LLError::NoClassInfo _LL_CLASS_TO_LOG;
 // writing control flow statements without braces:
 // if (condition) LL_INFOS() << "True" << LL_ENDL; else LL_INFOS()() << "False" << LL_ENDL;
 
+// Sites below LL_LOG_COMPILE_LEVEL are compiled out. Warnings and errors
+// are always kept.
+#ifndef LL_LOG_COMPILE_LEVEL
+#define LL_LOG_COMPILE_LEVEL 0
+#endif
+#if LL_LOG_COMPILE_LEVEL > 2
+#error "LL_LOG_COMPILE_LEVEL may not compile out warnings or errors"
+#endif
+
 #define lllog(level, once, ...)                                         \
     do {                                                                \
+        if ((level) < LL_LOG_COMPILE_LEVEL) break;                      \
         LL_PROFILE_ZONE_NAMED("lllog");                                 \
         const char* tags[] = {"", ##__VA_ARGS__};                       \
         static LLError::CallSite _site(lllog_site_args_(level, once, tags)); \
@@ -459,6 +578,25 @@ typedef LLError::NoClassInfo _LL_CLASS_TO_LOG;
 #define LL_INFOS_ONCE(...)  lllog(LLError::LEVEL_INFO, true, ##__VA_ARGS__)
 #define LL_WARNS_ONCE(...)  lllog(LLError::LEVEL_WARN, true, ##__VA_ARGS__)
 
+// Log a list of arguments as one message, see "Error Logging Facility" at
+// the top of this file. Takes exactly one tag.
+#define LL_DEBUGS_ARGS(tag, ...)    lllog_args(LLError::LEVEL_DEBUG, tag, __VA_ARGS__)
+#define LL_INFOS_ARGS(tag, ...)     lllog_args(LLError::LEVEL_INFO, tag, __VA_ARGS__)
+#define LL_WARNS_ARGS(tag, ...)     lllog_args(LLError::LEVEL_WARN, tag, __VA_ARGS__)
+
+#define lllog_args(level, tag, ...)                                     \
+    do {                                                                \
+        if ((level) < LL_LOG_COMPILE_LEVEL) break;                      \
+        const char* _tags[] = { tag };                                  \
+        static LLError::CallSite _site(level, __FILE__, __LINE__,       \
+                                       typeid(_LL_CLASS_TO_LOG), __FUNCTION__, \
+                                       false, _tags, 1);                \
+        if (LL_UNLIKELY(_site.shouldLog()))                             \
+        {                                                               \
+            LLError::Log::record(_site, __VA_ARGS__);                   \
+        }                                                               \
+    } while (0)
+
 // Use this if you need to pass LLError::ELevel as a variable.
 #define LL_VLOGS(level, ...)      llvlog(level, false, ##__VA_ARGS__)
 #define LL_VLOGS_ONCE(level, ...) llvlog(level, true,  ##__VA_ARGS__)
@@ -75,6 +75,10 @@ namespace LLError
     LL_COMMON_API ELevel getDefaultLevel();
     LL_COMMON_API void setAlwaysFlush(bool flush);
     LL_COMMON_API bool getAlwaysFlush();
+    LL_COMMON_API void setAsyncLogging(bool async);
+        // When set, the log file is written by a background thread from
+        // per-thread buffers instead of on the thread that logs.
+    LL_COMMON_API bool getAsyncLogging();
     LL_COMMON_API void setEnabledLogTypesMask(U32 mask);
     LL_COMMON_API U32 getEnabledLogTypesMask();
     LL_COMMON_API void setFunctionLevel(const std::string& function_name, LLError::ELevel);
@@ -148,6 +152,10 @@ namespace LLError
         virtual void recordMessage(LLError::ELevel, const std::string& message) = 0;
             // use the level for better display, not for filtering
 
+        virtual bool recordDeferred(const LogRecord& record) { return false; }
+            // take a message from LL_DEBUGS_ARGS() and friends before it has
+            // been formatted, return false to get it through recordMessage()
+
         virtual bool enabled() { return true; }
 
         bool wantsTime();
@@ -226,6 +234,10 @@ namespace LLError
         // Passing the empty string or NULL to just removes any prior.
     LL_COMMON_API std::string logFileName();
         // returns name of current logging file, empty string if none
+    LL_COMMON_API void flushLogs();
+        // writes out anything the log file recorder still has queued,
+        // for error handling before the process goes down.  Does
+        // nothing if another thread holds the recorders.
 
 
     /*
@@ -0,0 +1,136 @@
+/**
+ * @file llframearena.cpp
+ * @brief Linear per-thread arena for short-lived allocations
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llframearena.h"
+
+#include "llmemory.h"
+
+#include <new>
+
+namespace
+{
+    // Blocks start on a cache line
+    const size_t BLOCK_ALIGNMENT = 64;
+}
+
+LLFrameArena::LLFrameArena(size_t block_size)
+:   mCursor(0),
+    mLimit(0),
+    mBlockSize(block_size),
+    mAllocations(0),
+    mBytes(0),
+    mBlockAllocations(0),
+    mLastAllocations(0),
+    mLastBytes(0),
+    mLastBlockAllocations(0)
+{
+}
+
+LLFrameArena::~LLFrameArena()
+{
+    freeBlocks();
+}
+
+// static
+LLFrameArena& LLFrameArena::current()
+{
+    static thread_local LLFrameArena sArena;
+    return sArena;
+}
+
+void LLFrameArena::reset()
+{
+    mLastAllocations = mAllocations;
+    mLastBytes = mBytes;
+    mLastBlockAllocations = mBlockAllocations;
+    mAllocations = 0;
+    mBytes = 0;
+    mBlockAllocations = 0;
+
+    if (mBlocks.size() > 1)
+    {
+        // This frame overflowed the first block, make room for all of it
+        size_t capacity = getCapacity();
+        freeBlocks();
+        addBlock(capacity);
+    }
+    if (!mBlocks.empty())
+    {
+        useBlock(0);
+    }
+}
+
+size_t LLFrameArena::getCapacity() const
+{
+    size_t capacity = 0;
+    for (const Block& block : mBlocks)
+    {
+        capacity += block.mSize;
+    }
+    return capacity;
+}
+
+void* LLFrameArena::allocateSlow(size_t size, size_t alignment)
+{
+    // Grow geometrically so a large frame chains only a few blocks
+    size_t block_size = llmax(mBlockSize, getCapacity(), size + alignment);
+    addBlock(block_size);
+    useBlock(mBlocks.size() - 1);
+    return allocate(size, alignment);
+}
+
+void LLFrameArena::addBlock(size_t size)
+{
+    Block block;
+    block.mData = (char*)ll_aligned_malloc<BLOCK_ALIGNMENT>(size);
+    if (!block.mData)
+    {
+        throw std::bad_alloc();
+    }
+    block.mSize = size;
+    mBlocks.push_back(block);
+    ++mBlockAllocations;
+}
+
+void LLFrameArena::useBlock(size_t index)
+{
+    mCursor = (uintptr_t)mBlocks[index].mData;
+    mLimit = mCursor + mBlocks[index].mSize;
+}
+
+void LLFrameArena::freeBlocks()
+{
+    for (const Block& block : mBlocks)
+    {
+        ll_aligned_free<BLOCK_ALIGNMENT>(block.mData);
+    }
+    mBlocks.clear();
+    mCursor = 0;
+    mLimit = 0;
+}
@@ -0,0 +1,189 @@
+/**
+ * @file llframearena.h
+ * @brief Linear per-thread arena for short-lived allocations
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLFRAMEARENA_H
+#define LL_LLFRAMEARENA_H
+
+#include "llpreprocessor.h"
+#include "stdtypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <vector>
+
+/**
+ * Bump allocator for temporaries that live no longer than a frame, such as
+ * the light and point lists the render pipeline builds and throws away
+ * every frame.  Allocation is a pointer increment, deallocation does
+ * nothing (unless it is the most recent allocation, which is given back),
+ * and everything is released at once by reset().
+ *
+ * Each thread has its own arena, see current().  The main thread resets
+ * its arena at the start of every frame, and threads serving a WorkQueue
+ * (thread pools, LLQueuedThread) reset theirs after every work item.
+ * Memory from an arena must therefore never be kept past that point, nor
+ * across a coroutine suspension.  Other threads must reset their arena
+ * themselves if they use it.
+ *
+ * The arena starts with one block and chains more as needed.  When a
+ * frame needed more than one block, reset() replaces them with a single
+ * block large enough for the whole frame, so that in steady state a frame
+ * makes no heap allocations at all.  Memory is not returned until the
+ * arena is destroyed, and peaks at the largest frame seen.
+ */
+class LL_COMMON_API LLFrameArena
+{
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    LLFrameArena(size_t block_size = DEFAULT_BLOCK_SIZE);
+    ~LLFrameArena();
+
+    LLFrameArena(const LLFrameArena&) = delete;
+    LLFrameArena& operator=(const LLFrameArena&) = delete;
+
+    /// The calling thread's arena, created on first use.
+    static LLFrameArena& current();
+
+    /// 'alignment' must be a power of two.
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+    {
+        uintptr_t ptr = (mCursor + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        if (ptr + size > mLimit)
+        {
+            return allocateSlow(size, alignment);
+        }
+        mCursor = ptr + size;
+        ++mAllocations;
+        mBytes += size;
+        return (void*)ptr;
+    }
+
+    /// Only reclaims the space if 'ptr' was the last allocation made.
+    void deallocate(void* ptr, size_t size)
+    {
+        if ((uintptr_t)ptr + size == mCursor)
+        {
+            mCursor = (uintptr_t)ptr;
+        }
+    }
+
+    /// Release everything allocated since the last reset.
+    void reset();
+
+    /// Counts since the last reset.
+    U32 getAllocationCount() const { return mAllocations; }
+    size_t getBytesAllocated() const { return mBytes; }
+    /// Blocks allocated from the heap since the last reset.
+    U32 getBlockAllocationCount() const { return mBlockAllocations; }
+
+    /// Counts for the period ended by the last reset, e.g. the last frame.
+    U32 getLastAllocationCount() const { return mLastAllocations; }
+    size_t getLastBytesAllocated() const { return mLastBytes; }
+    U32 getLastBlockAllocationCount() const { return mLastBlockAllocations; }
+
+    /// Total size of the blocks held.
+    size_t getCapacity() const;
+
+private:
+    struct Block
+    {
+        char*   mData;
+        size_t  mSize;
+    };
+
+    void* allocateSlow(size_t size, size_t alignment);
+    void addBlock(size_t size);
+    void useBlock(size_t index);
+    void freeBlocks();
+
+    std::vector<Block>  mBlocks;
+    uintptr_t           mCursor;
+    uintptr_t           mLimit;
+    const size_t        mBlockSize;
+
+    U32                 mAllocations;
+    size_t              mBytes;
+    U32                 mBlockAllocations;
+    U32                 mLastAllocations;
+    size_t              mLastBytes;
+    U32                 mLastBlockAllocations;
+};
+
+/**
+ * STL allocator over an LLFrameArena, by default the arena of the thread
+ * that constructs it.  Containers using it follow the arena's lifetime
+ * rules: build them, use them and drop them within the frame.
+ */
+template <typename T>
+class LLFrameAllocator
+{
+public:
+    typedef T value_type;
+
+    LLFrameAllocator() : mArena(&LLFrameArena::current()) {}
+    explicit LLFrameAllocator(LLFrameArena& arena) : mArena(&arena) {}
+
+    template <typename U>
+    LLFrameAllocator(const LLFrameAllocator<U>& other) : mArena(other.getArena()) {}
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(mArena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n)
+    {
+        mArena->deallocate(ptr, n * sizeof(T));
+    }
+
+    LLFrameArena* getArena() const { return mArena; }
+
+private:
+    LLFrameArena* mArena;
+};
+
+template <typename T, typename U>
+bool operator==(const LLFrameAllocator<T>& lhs, const LLFrameAllocator<U>& rhs)
+{
+    return lhs.getArena() == rhs.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const LLFrameAllocator<T>& lhs, const LLFrameAllocator<U>& rhs)
+{
+    return lhs.getArena() != rhs.getArena();
+}
+
+template <typename T>
+using LLFrameVector = std::vector<T, LLFrameAllocator<T> >;
+
+template <typename T>
+using LLFrameList = std::list<T, LLFrameAllocator<T> >;
+
+#endif // LL_LLFRAMEARENA_H
@@ -0,0 +1,114 @@
+/**
+ * @file llparallelfor.h
+ * @brief Fork/join helper that spreads a loop over a ThreadPool
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLPARALLELFOR_H
+#define LL_LLPARALLELFOR_H
+
+#include "threadpool.h"
+#include "workqueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace LL
+{
+    /**
+     * Call func(begin, end) over [0, count) in chunks of at most 'grain'
+     * indices, spreading the chunks over the threads of the named
+     * ThreadPool. The calling thread claims chunks too, so parallelFor()
+     * makes progress (and never deadlocks) even when every pool thread is
+     * busy with something else, or when it is itself called from a pool
+     * thread. It returns once every chunk has finished.
+     *
+     * Falls back to running the whole range on the calling thread if the
+     * pool doesn't exist, is closed, or there is only one chunk.
+     *
+     * func must not throw and must be safe to call concurrently for
+     * disjoint ranges.
+     */
+    template <typename FUNC>
+    void parallelFor(const std::string& pool, size_t count, size_t grain, FUNC&& func)
+    {
+        if (!count)
+        {
+            return;
+        }
+        grain = std::max<size_t>(grain, 1);
+        const size_t chunks = (count + grain - 1) / grain;
+
+        auto queue = WorkQueueBase::getInstance(pool);
+        const size_t helpers = std::min(chunks - 1, ThreadPoolBase::getWidth(pool, 0));
+        if (!queue || queue->isClosed() || !helpers)
+        {
+            func(size_t(0), count);
+            return;
+        }
+
+        // Helpers may be dequeued after we've returned, so the shared
+        // state outlives this call.  func itself is only touched while a
+        // chunk is outstanding, which we wait out below.
+        struct State
+        {
+            std::atomic<size_t> mNext{ 0 };
+            std::atomic<size_t> mDone{ 0 };
+            std::mutex mMutex;
+            std::condition_variable mCondition;
+        };
+        auto state = std::make_shared<State>();
+        auto worker = [state, chunks, count, grain, &func]()
+        {
+            size_t chunk;
+            while ((chunk = state->mNext.fetch_add(1)) < chunks)
+            {
+                const size_t begin = chunk * grain;
+                func(begin, std::min(begin + grain, count));
+                if (state->mDone.fetch_add(1) + 1 == chunks)
+                {
+                    std::lock_guard<std::mutex> lock(state->mMutex);
+                    state->mCondition.notify_all();
+                }
+            }
+        };
+
+        // A helper that runs late finds every chunk claimed and exits
+        // without touching func; one we fail to post costs nothing.
+        for (size_t i = 0; i < helpers; ++i)
+        {
+            queue->post(worker);
+        }
+        worker();
+
+        std::unique_lock<std::mutex> lock(state->mMutex);
+        state->mCondition.wait(lock, [&state, chunks]() { return state->mDone.load() == chunks; });
+    }
+} // namespace LL
+
+#endif // LL_LLPARALLELFOR_H
@@ -36,10 +36,12 @@
 #include "llthreadlocalstorage.h"
 #include "llmemory.h"
 #include <limits>
+#include <memory>
 
 namespace LLTrace
 {
     constexpr F64 NaN = std::numeric_limits<double>::quiet_NaN();
+    constexpr size_t CACHE_LINE_SIZE = 64;
 
     enum EBufferAppendType
     {
@@ -81,7 +83,7 @@ namespace LLTrace
             {
                 LLThreadLocalSingletonPointer<ACCUMULATOR>::setInstance(NULL);
             }
-            delete[] mStorage;
+            freeStorage(mStorage, mStorageSize);
         }
 
         LL_FORCE_INLINE ACCUMULATOR& operator[](size_t index)
@@ -183,7 +185,7 @@ namespace LLTrace
             if (new_size <= mStorageSize) return;
 
             ACCUMULATOR* old_storage = mStorage;
-            mStorage = new ACCUMULATOR[new_size];
+            mStorage = allocateStorage(new_size);
             if (old_storage)
             {
                 for (S32 i = 0; i < mStorageSize; i++)
@@ -191,8 +193,8 @@ namespace LLTrace
                     mStorage[i] = old_storage[i];
                 }
             }
+            freeStorage(old_storage, mStorageSize);
             mStorageSize = new_size;
-            delete[] old_storage;
 
             self_t* default_buffer = getDefaultBuffer();
             if (this != default_buffer
@@ -234,6 +236,25 @@ namespace LLTrace
         }
 
     private:
+        // Storage starts on a cache line and fills whole lines, so a thread
+        // writing its own buffer never touches a line holding another's.
+        static ACCUMULATOR* allocateStorage(size_t count)
+        {
+            const size_t bytes = (count * sizeof(ACCUMULATOR) + CACHE_LINE_SIZE - 1) & ~(CACHE_LINE_SIZE - 1);
+            ACCUMULATOR* storage = static_cast<ACCUMULATOR*>(ll_aligned_malloc<CACHE_LINE_SIZE>(bytes));
+            std::uninitialized_default_construct_n(storage, count);
+            return storage;
+        }
+
+        static void freeStorage(ACCUMULATOR* storage, size_t count)
+        {
+            if (storage)
+            {
+                std::destroy_n(storage, count);
+                ll_aligned_free<CACHE_LINE_SIZE>(storage);
+            }
+        }
+
         ACCUMULATOR*    mStorage;
         size_t          mStorageSize;
         static size_t   sNextStorageSlot;
@@ -454,7 +475,8 @@ namespace LLTrace
         S32 mNumSamples;
     };
 
-    class alignas(32) TimeBlockAccumulator
+    // one cache line per timer, so the bookkeeping of a scope never straddles two
+    class alignas(CACHE_LINE_SIZE) TimeBlockAccumulator
     {
     public:
         typedef F64Seconds value_t;
@@ -473,17 +495,6 @@ namespace LLTrace
             typedef F64Seconds value_t;
         };
 
-        // arrays are allocated with 32 byte alignment
-        void *operator new [](size_t size)
-        {
-            return ll_aligned_malloc<32>(size);
-        }
-
-        void operator delete[](void* ptr, size_t size)
-        {
-            ll_aligned_free<32>(ptr);
-        }
-
         TimeBlockAccumulator();
         void addSamples(const self_t& other, EBufferAppendType append_type);
         void reset(const self_t* other);
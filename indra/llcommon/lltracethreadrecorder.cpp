@@ -30,6 +30,8 @@
 #include "lltrace.h"
 #include "llstl.h"
 
+#include <thread>
+
 namespace LLTrace
 {
 //extern MemStatHandle gTraceMemStat;
@@ -41,7 +43,9 @@ static ThreadRecorder* sMasterThreadRecorder = NULL;
 ///////////////////////////////////////////////////////////////////////
 
 ThreadRecorder::ThreadRecorder()
-:   mParentRecorder(NULL)
+:   mParentRecorder(NULL),
+    mSharedEpoch(0),
+    mPushingSlot(0)
 {
     init();
 }
@@ -89,7 +93,9 @@ void ThreadRecorder::init()
 
 
 ThreadRecorder::ThreadRecorder( ThreadRecorder& parent )
-:   mParentRecorder(&parent)
+:   mParentRecorder(&parent),
+    mSharedEpoch(0),
+    mPushingSlot(0)
 {
     init();
     mParentRecorder->addChildRecorder(this);
@@ -267,9 +273,19 @@ void ThreadRecorder::pushToParent()
 #if LL_TRACE_ENABLED
     if (ThreadRecorder* recorder = LLTrace::get_thread_recorder())
     {
-        LLMutexLock lock(&mSharedRecordingMutex);
         recorder->bringUpToDate(&mThreadRecordingBuffers);
-        mSharedRecordingBuffers.append(mThreadRecordingBuffers);
+
+        // claim the slot the parent is not reading, checking the epoch again
+        // after the claim is visible in case the parent flipped it meanwhile
+        U32 slot;
+        do
+        {
+            slot = mSharedEpoch.load() & 1;
+            mPushingSlot.store(slot + 1);
+        } while ((mSharedEpoch.load() & 1) != slot);
+
+        mSharedRecordingBuffers[slot].append(mThreadRecordingBuffers);
+        mPushingSlot.store(0);
         mThreadRecordingBuffers.reset();
     }
 #endif
@@ -287,9 +303,15 @@ void ThreadRecorder::pullFromChildren()
         target_recording_buffers.sync();
         for (LLTrace::ThreadRecorder* rec : mChildThreadRecorders)
         {
-            LLMutexLock lock(&(rec->mSharedRecordingMutex));
-            target_recording_buffers.merge(rec->mSharedRecordingBuffers);
-            rec->mSharedRecordingBuffers.reset();
+            // retire the slot the child has been pushing to; at most one push
+            // can still be writing to it
+            const U32 slot = rec->mSharedEpoch.fetch_add(1) & 1;
+            while (rec->mPushingSlot.load() == slot + 1)
+            {
+                std::this_thread::yield();
+            }
+            target_recording_buffers.merge(rec->mSharedRecordingBuffers[slot]);
+            rec->mSharedRecordingBuffers[slot].reset();
         }
     }
 #endif
@@ -33,6 +33,8 @@
 #include "llmutex.h"
 #include "lltraceaccumulators.h"
 
+#include <atomic>
+
 namespace LLTrace
 {
     class LL_COMMON_API ThreadRecorder
@@ -55,6 +57,7 @@ namespace LLTrace
 
         // call this periodically to gather stats data from child threads
         void pullFromChildren();
+        // call this periodically from a child thread, never blocks
         void pushToParent();
 
         TimeBlockTreeNode* getTimeBlockTreeNode(size_t index);
@@ -84,9 +87,18 @@ namespace LLTrace
         typedef std::list<class ThreadRecorder*> child_thread_recorder_list_t;
 
         child_thread_recorder_list_t    mChildThreadRecorders;  // list of child thread recorders associated with this master
-        LLMutex                         mChildListMutex;        // protects access to child list
-        LLMutex                         mSharedRecordingMutex;
-        AccumulatorBufferGroup          mSharedRecordingBuffers;
+        // Protects the child list. Taken when a child is added or removed, and
+        // by every pullFromChildren(), so that a pull never merges the buffers
+        // of a child being destroyed. Only pushes are lock free.
+        LLMutex                         mChildListMutex;
+
+        // Handoff to the parent without locks: pushToParent() appends to
+        // mSharedRecordingBuffers[mSharedEpoch & 1], pullFromChildren() bumps
+        // the epoch so later pushes go to the other slot, waits out a push
+        // still writing to the old one and merges it.
+        AccumulatorBufferGroup          mSharedRecordingBuffers[2];
+        std::atomic<U32>                mSharedEpoch;
+        std::atomic<U32>                mPushingSlot;           // slot + 1 while a push is writing, else 0
         ThreadRecorder*                 mParentRecorder;
 
     };
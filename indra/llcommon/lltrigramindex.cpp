@@ -0,0 +1,223 @@
+/**
+ * @file lltrigramindex.cpp
+ * @brief Substring search over many short strings through a trigram index
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "lltrigramindex.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Fields share one trigram map, the field number goes in the top byte
+    U32 get_trigram_key(U32 field, const std::string& str, size_t pos)
+    {
+        return (field << 24) | ((U32)(U8)str[pos] << 16) | ((U32)(U8)str[pos + 1] << 8) | (U32)(U8)str[pos + 2];
+    }
+}
+
+LLTrigramIndex::LLTrigramIndex(U32 field_count, S32 min_dead_to_compact)
+:   mFieldCount(field_count),
+    mMinDeadToCompact(min_dead_to_compact),
+    mDeadCount(0)
+{
+    llassert(field_count > 0 && field_count <= 256);
+}
+
+bool LLTrigramIndex::update(const LLUUID& id, const LLUUID& group_id, const std::vector<std::string>& fields)
+{
+    llassert(fields.size() == mFieldCount);
+
+    auto slot_it = mSlots.find(id);
+    if (slot_it != mSlots.end())
+    {
+        const Document& doc = mDocuments[slot_it->second];
+        if (doc.mGroupID == group_id && doc.mFields == fields)
+        {
+            return false;
+        }
+        remove(id);
+    }
+
+    Document doc;
+    doc.mID = id;
+    doc.mGroupID = group_id;
+    doc.mFields = fields;
+    doc.mLive = true;
+
+    const U32 slot = (U32)mDocuments.size();
+    mDocuments.push_back(std::move(doc));
+    mSlots[id] = slot;
+    ++mGroups[group_id];
+    indexDocument(slot);
+    return true;
+}
+
+bool LLTrigramIndex::remove(const LLUUID& id)
+{
+    auto slot_it = mSlots.find(id);
+    if (slot_it == mSlots.end())
+    {
+        return false;
+    }
+
+    Document& doc = mDocuments[slot_it->second];
+    doc.mLive = false;
+    doc.mFields.clear();
+    auto group_it = mGroups.find(doc.mGroupID);
+    if (group_it != mGroups.end() && --group_it->second <= 0)
+    {
+        mGroups.erase(group_it);
+    }
+    mSlots.erase(slot_it);
+
+    if (++mDeadCount >= mMinDeadToCompact && mDeadCount > size())
+    {
+        compact();
+    }
+    return true;
+}
+
+void LLTrigramIndex::clear()
+{
+    mDocuments.clear();
+    mSlots.clear();
+    mTrigrams.clear();
+    mGroups.clear();
+    mDeadCount = 0;
+}
+
+U32 LLTrigramIndex::search(U32 field, const std::string& substring, id_set_t& matches) const
+{
+    // Only documents holding every trigram of the substring can match,
+    // so check those holding the rarest one.
+    const std::vector<U32>* candidates = nullptr;
+    for (size_t i = 0; i + 3 <= substring.size(); ++i)
+    {
+        auto it = mTrigrams.find(get_trigram_key(field, substring, i));
+        if (it == mTrigrams.end())
+        {
+            return 0;
+        }
+        if (!candidates || it->second.size() < candidates->size())
+        {
+            candidates = &it->second;
+        }
+    }
+
+    U32 checked = 0;
+    if (candidates)
+    {
+        for (U32 slot : *candidates)
+        {
+            const Document& doc = mDocuments[slot];
+            if (doc.mLive)
+            {
+                ++checked;
+                if (doc.mFields[field].find(substring) != std::string::npos)
+                {
+                    matches.insert(doc.mID);
+                }
+            }
+        }
+    }
+    else
+    {
+        // Too short to have a trigram
+        for (const Document& doc : mDocuments)
+        {
+            if (doc.mLive)
+            {
+                ++checked;
+                if (doc.mFields[field].find(substring) != std::string::npos)
+                {
+                    matches.insert(doc.mID);
+                }
+            }
+        }
+    }
+    return checked;
+}
+
+void LLTrigramIndex::searchGroups(const id_set_t& groups, id_set_t& matches) const
+{
+    if (groups.empty())
+    {
+        return;
+    }
+    for (const Document& doc : mDocuments)
+    {
+        if (doc.mLive && groups.count(doc.mGroupID))
+        {
+            matches.insert(doc.mID);
+        }
+    }
+}
+
+void LLTrigramIndex::compact()
+{
+    std::vector<Document> documents;
+    documents.reserve(mSlots.size());
+    for (Document& doc : mDocuments)
+    {
+        if (doc.mLive)
+        {
+            documents.push_back(std::move(doc));
+        }
+    }
+
+    mDocuments.swap(documents);
+    mSlots.clear();
+    mTrigrams.clear();
+    mDeadCount = 0;
+    for (U32 slot = 0; slot < (U32)mDocuments.size(); ++slot)
+    {
+        mSlots[mDocuments[slot].mID] = slot;
+        indexDocument(slot);
+    }
+}
+
+void LLTrigramIndex::indexDocument(U32 slot)
+{
+    const Document& doc = mDocuments[slot];
+    std::vector<U32> keys;
+    for (U32 field = 0; field < mFieldCount; ++field)
+    {
+        const std::string& text = doc.mFields[field];
+        for (size_t i = 0; i + 3 <= text.size(); ++i)
+        {
+            keys.push_back(get_trigram_key(field, text, i));
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    for (U32 key : keys)
+    {
+        mTrigrams[key].push_back(slot);
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * @file lltrigramindex.h
+ * @brief Substring search over many short strings through a trigram index
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLTRIGRAMINDEX_H
+#define LL_LLTRIGRAMINDEX_H
+
+#include "lluuid.h"
+
+#include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
+
+#include <string>
+#include <vector>
+
+/**
+ * Index of documents, each made of a fixed number of text fields, that
+ * answers "which documents have this substring in field N" without
+ * scanning them all.  Every field is broken into its three byte
+ * sequences (trigrams), and a search only checks the documents that
+ * hold the rarest trigram of the substring.  Results are exact, as each
+ * of those candidates is then checked with std::string::find().  Search
+ * strings shorter than a trigram check every document.
+ *
+ * The index does no case folding, callers store and search for strings
+ * that are already normalized.  Each document also belongs to a group
+ * (an owner or creator, say), which can be searched for as a whole.
+ *
+ * Removing a document only marks it dead, as finding it in the trigram
+ * lists would mean going through all of them.  Dead documents are
+ * compacted away once there are more of them than live ones.
+ *
+ * Not thread safe, callers lock around it.
+ */
+class LL_COMMON_API LLTrigramIndex
+{
+public:
+    typedef boost::unordered_set<LLUUID> id_set_t;
+    typedef boost::unordered_map<LLUUID, S32> group_map_t;
+
+    LLTrigramIndex(U32 field_count, S32 min_dead_to_compact = 1024);
+
+    /// Add the document, or replace it if any of its fields or its group
+    /// changed.  Returns false if it was already indexed as given.
+    bool update(const LLUUID& id, const LLUUID& group_id, const std::vector<std::string>& fields);
+    /// Returns false if there was no such document.
+    bool remove(const LLUUID& id);
+    void clear();
+
+    /// Add the documents whose 'field' contains 'substring' to 'matches'.
+    /// Returns how many documents were checked.
+    U32 search(U32 field, const std::string& substring, id_set_t& matches) const;
+    /// Add the documents belonging to any of 'groups' to 'matches'.
+    void searchGroups(const id_set_t& groups, id_set_t& matches) const;
+
+    /// Groups with at least one document, and how many they have
+    const group_map_t& getGroups() const { return mGroups; }
+    bool contains(const LLUUID& id) const { return mSlots.count(id) > 0; }
+    S32 size() const { return static_cast<S32>(mSlots.size()); }
+    S32 getDeadCount() const { return mDeadCount; }
+
+    void compact();
+
+private:
+    struct Document
+    {
+        LLUUID                      mID;
+        LLUUID                      mGroupID;
+        std::vector<std::string>    mFields;
+        bool                        mLive;
+    };
+
+    void indexDocument(U32 slot);
+
+    const U32                                       mFieldCount;
+    const S32                                       mMinDeadToCompact;
+    std::vector<Document>                           mDocuments;
+    boost::unordered_map<LLUUID, U32>               mSlots;     // Document id to live slot
+    boost::unordered_map<U32, std::vector<U32> >    mTrigrams;  // Field and trigram to slots
+    group_map_t                                     mGroups;
+    S32                                             mDeadCount;
+};
+
+#endif // LL_LLTRIGRAMINDEX_H
@@ -30,6 +30,7 @@
 #include <set>
 #include <vector>
 #include "stdtypes.h"
+#include "llerror.h"
 #include "llpreprocessor.h"
 #include <boost/functional/hash.hpp>
 
@@ -193,6 +194,9 @@ static_assert(std::is_trivially_copyable<LLUUID>::value, "LLUUID must be trivial
 static_assert(std::is_trivially_move_assignable<LLUUID>::value, "LLUUID must be trivial move");
 static_assert(std::is_standard_layout<LLUUID>::value, "LLUUID must be a standard layout type");
 
+// LL_DEBUGS_ARGS() may copy a UUID and format it later
+template<> struct LLError::DeferFormat<LLUUID> : std::true_type {};
+
 typedef std::vector<LLUUID> uuid_vec_t;
 typedef std::set<LLUUID> uuid_set_t;
 // <FS:Beq> cleanupDeadObject spam avoidance
@@ -0,0 +1,228 @@
+/**
+ * @file   llasynclogwriter_test.cpp
+ * @date   2026-10-19
+ * @brief  Test for llasynclogwriter.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llasynclogwriter.h"
+// STL headers
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+// std headers
+// external library headers
+// other Linden headers
+#include "../test/lltut.h"
+#include "llformat.h"
+
+namespace
+{
+    // split the output into lines, counting the lines of each thread and
+    // checking that each thread's lines arrive in order
+    bool check_lines(const std::string& output, std::map<int, int>& counts)
+    {
+        std::istringstream in(output);
+        std::string line;
+        while (std::getline(in, line))
+        {
+            int thread = 0, index = 0;
+            if (sscanf(line.c_str(), "thread %d line %d", &thread, &index) != 2)
+            {
+                continue;
+            }
+            if (index != counts[thread]++)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llasynclogwriter_data
+    {
+        std::ostringstream out;
+    };
+    typedef test_group<llasynclogwriter_data> llasynclogwriter_group;
+    typedef llasynclogwriter_group::object object;
+    llasynclogwriter_group llasynclogwritergrp("llasynclogwriter");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("flush writes what was posted");
+        LLError::AsyncLogWriter writer(out);
+        writer.post("first");
+        writer.post("second");
+        ensure("flush() failed", writer.flush());
+        ensure_equals(out.str(), "first\nsecond\n");
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("lines from several threads");
+        const int NUM_THREADS = 4;
+        const int NUM_LINES = 10000;
+        {
+            LLError::AsyncLogWriter writer(out);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < NUM_THREADS; ++t)
+            {
+                threads.emplace_back([&writer, t]()
+                {
+                    for (int i = 0; i < NUM_LINES; ++i)
+                    {
+                        writer.post(llformat("thread %d line %d", t, i));
+                        if (i % 1000 == 999)
+                        {
+                            // give the writer thread time to catch up,
+                            // this test is not about dropping lines
+                            std::this_thread::sleep_for(std::chrono::milliseconds(60));
+                        }
+                    }
+                });
+            }
+            for (std::thread& thread : threads)
+            {
+                thread.join();
+            }
+            ensure_equals("lines dropped", writer.getDroppedCount(), 0U);
+        } // destructor drains the rings of the exited threads
+
+        std::map<int, int> counts;
+        ensure("lines out of order", check_lines(out.str(), counts));
+        for (int t = 0; t < NUM_THREADS; ++t)
+        {
+            ensure_equals(llformat("lines of thread %d", t), counts[t], NUM_LINES);
+        }
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("full ring drops whole lines");
+        // overrun a minimal ring in one burst, faster than the writer
+        // thread drains it
+        LLError::AsyncLogWriter writer(out, 1024);
+        const std::string line(100, 'x');
+        for (int i = 0; i < 1000; ++i)
+        {
+            writer.post(line);
+        }
+        ensure("flush() failed", writer.flush());
+
+        const std::string output = out.str();
+        size_t written = 0;
+        std::istringstream in(output);
+        std::string got;
+        while (std::getline(in, got))
+        {
+            if (got == line)
+            {
+                ++written;
+            }
+            else
+            {
+                ensure_contains("unexpected line", got, "log lines dropped");
+            }
+        }
+        ensure_equals("lines lost", written + writer.getDroppedCount(), 1000U);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("a line longer than the ring is dropped");
+        LLError::AsyncLogWriter writer(out, 1024);
+        writer.post(std::string(2048, 'x'));
+        writer.post("short");
+        ensure("flush() failed", writer.flush());
+        ensure_equals(writer.getDroppedCount(), 1U);
+        ensure_contains("later line lost", out.str(), "short\n");
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("formatter runs on data wrapped around the ring");
+        LLError::AsyncLogWriter writer(out, 1024);
+        // move the ring position close to the end of the buffer
+        for (int i = 0; i < 9; ++i)
+        {
+            writer.post(std::string(90, 'x'));
+        }
+        ensure("flush() failed", writer.flush());
+        out.str("");
+
+        std::vector<U32> values;
+        for (U32 i = 0; i < 32; ++i)
+        {
+            values.push_back(i);
+        }
+        writer.post([](std::ostream& out, const char* data, size_t size)
+                    {
+                        U32 sum = 0;
+                        for (size_t i = 0; i < size / sizeof(U32); ++i)
+                        {
+                            U32 value;
+                            memcpy(&value, data + i * sizeof(U32), sizeof(U32));
+                            sum += value;
+                        }
+                        out << "sum " << sum;
+                    },
+                    values.data(), values.size() * sizeof(U32));
+        ensure("flush() failed", writer.flush());
+        ensure_equals(out.str(), "sum 496\n");
+    }
+
+    template<> template<>
+    void object::test<6>()
+    {
+        set_test_name("one thread alternating between writers");
+        std::ostringstream other;
+        LLError::AsyncLogWriter first(out, 1024);
+        LLError::AsyncLogWriter second(other, 1024);
+        // each line is posted to the ring this thread already has for
+        // that writer, so none are lost in between
+        for (int i = 0; i < 5; ++i)
+        {
+            first.post(llformat("first %d", i));
+            second.post(llformat("second %d", i));
+        }
+        ensure("flush() failed", first.flush() && second.flush());
+        ensure_equals(out.str(), "first 0\nfirst 1\nfirst 2\nfirst 3\nfirst 4\n");
+        ensure_equals(other.str(), "second 0\nsecond 1\nsecond 2\nsecond 3\nsecond 4\n");
+    }
+
+    template<> template<>
+    void object::test<7>()
+    {
+        set_test_name("dropped lines reported by the stream's own formatter");
+        LLError::AsyncLogWriter writer(out, 1024,
+                                       [](std::ostream& out, U32 dropped)
+                                       {
+                                           out << "{\"dropped\":" << dropped << "}";
+                                       });
+        writer.post(std::string(2048, 'x'));
+        ensure("flush() failed", writer.flush());
+        ensure_equals(out.str(), "{\"dropped\":1}\n");
+    }
+} // namespace tut
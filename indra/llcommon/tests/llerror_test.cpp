@@ -921,6 +921,58 @@ namespace tut
     }
 }
 
+namespace
+{
+    void writeArgs()
+    {
+        LL_DEBUGS_ARGS("ArgsTag", "one ", 1, " ", 2.5, " ", std::string("three"));
+        LL_INFOS_ARGS("ArgsTag", "line\nbreak");
+    }
+};
+
+namespace tut
+{
+    template<> template<>
+    void ErrorTestObject::test<19>()
+        // messages logged as a list of arguments
+    {
+        LLError::setDefaultLevel(LLError::LEVEL_DEBUG);
+        writeArgs();
+        ensure_message_field_equals(0, LEVEL_FIELD, "DEBUG");
+        ensure_message_field_equals(0, TAGS_FIELD, "#ArgsTag#");
+        ensure_message_field_equals(0, MSG_FIELD, "one 1 2.5 three");
+        ensure_message_field_equals(1, MSG_FIELD, "line\\nbreak");
+        ensure_message_count(2);
+
+        clearMessages();
+        LLError::setTagLevel("ArgsTag", LLError::LEVEL_INFO);
+        writeArgs();
+        ensure_message_field_equals(0, MSG_FIELD, "line\\nbreak");
+        ensure_message_count(1);
+    }
+}
+
+namespace
+{
+    void writeNullArg()
+    {
+        const char* name = NULL;
+        LL_INFOS_ARGS("ArgsTag", "name ", name, " end");
+    }
+};
+
+namespace tut
+{
+    template<> template<>
+    void ErrorTestObject::test<20>()
+        // a null C string argument
+    {
+        writeNullArg();
+        ensure_message_field_equals(0, MSG_FIELD, "name (null) end");
+        ensure_message_count(1);
+    }
+}
+
 /* Tests left:
     handling of classes without LOG_CLASS
 
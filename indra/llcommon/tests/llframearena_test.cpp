@@ -0,0 +1,166 @@
+/**
+ * @file   llframearena_test.cpp
+ * @date   2026-10-19
+ * @brief  Test for llframearena.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llframearena.h"
+#include "workqueue.h"
+// STL headers
+#include <thread>
+// std headers
+// external library headers
+// other Linden headers
+#include "../test/lltut.h"
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llframearena_data
+    {
+    };
+    typedef test_group<llframearena_data> llframearena_group;
+    typedef llframearena_group::object object;
+    llframearena_group llframearenagrp("llframearena");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("allocations are aligned and counted");
+        LLFrameArena arena(1024);
+        char* a = (char*)arena.allocate(3, 1);
+        void* b = arena.allocate(8, 8);
+        void* c = arena.allocate(16, 64);
+        ensure("no memory", a && b && c);
+        ensure_equals("8 byte alignment", (uintptr_t)b % 8, 0);
+        ensure_equals("64 byte alignment", (uintptr_t)c % 64, 0);
+        ensure_equals(arena.getAllocationCount(), 3);
+        ensure_equals(arena.getBytesAllocated(), 27);
+        ensure_equals(arena.getBlockAllocationCount(), 1);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("reset reuses memory");
+        LLFrameArena arena(1024);
+        void* first = arena.allocate(100);
+        arena.reset();
+        ensure_equals("last frame count", arena.getLastAllocationCount(), 1);
+        ensure_equals("count not cleared", arena.getAllocationCount(), 0);
+        ensure("memory not reused", arena.allocate(100) == first);
+        ensure_equals("new block allocated", arena.getBlockAllocationCount(), 0);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("overflow is merged into one block on reset");
+        LLFrameArena arena(1024);
+        for (int i = 0; i < 10; ++i)
+        {
+            arena.allocate(500);
+        }
+        ensure("overflow did not chain blocks", arena.getBlockAllocationCount() > 1);
+        arena.reset();
+        ensure("capacity lost", arena.getCapacity() >= 5000);
+        for (int i = 0; i < 10; ++i)
+        {
+            arena.allocate(500);
+        }
+        // the block made by reset() is counted, but nothing more
+        ensure_equals("steady frame allocated", arena.getBlockAllocationCount(), 1);
+        arena.reset();
+        for (int i = 0; i < 10; ++i)
+        {
+            arena.allocate(500);
+        }
+        ensure_equals("steady frame allocated", arena.getBlockAllocationCount(), 0);
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("last allocation is given back");
+        LLFrameArena arena(1024);
+        void* a = arena.allocate(64);
+        arena.allocate(64);
+        arena.deallocate(a, 64);
+        void* c = arena.allocate(64);
+        ensure("reclaimed out of order", c != a);
+        arena.deallocate(c, 64);
+        ensure("not reclaimed", arena.allocate(64) == c);
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("containers");
+        LLFrameArena arena(256);
+        LLFrameVector<int> values{LLFrameAllocator<int>(arena)};
+        for (int i = 0; i < 1000; ++i)
+        {
+            values.push_back(i);
+        }
+        LLFrameList<int> list{LLFrameAllocator<int>(arena)};
+        list.assign(values.begin(), values.end());
+        int sum = 0;
+        for (int value : list)
+        {
+            sum += value;
+        }
+        ensure_equals(sum, 999 * 1000 / 2);
+        ensure("not served by the arena", arena.getAllocationCount() > 1000);
+    }
+
+    template<> template<>
+    void object::test<6>()
+    {
+        set_test_name("each thread has its own arena");
+        LLFrameArena* main_arena = &LLFrameArena::current();
+        LLFrameArena* other_arena = nullptr;
+        std::thread thread([&other_arena]()
+            {
+                other_arena = &LLFrameArena::current();
+                LLFrameVector<int> values;
+                values.resize(10);
+            });
+        thread.join();
+        ensure("shared arena", main_arena != other_arena);
+        LLFrameVector<int> values;
+        ensure("default allocator arena", values.get_allocator().getArena() == main_arena);
+    }
+
+    template<> template<>
+    void object::test<7>()
+    {
+        set_test_name("work queue threads reset after each item");
+        LL::WorkQueue queue("llframearena_test");
+        U32 allocations = 0;
+        U32 left_over = 1;
+        queue.post([&allocations]()
+            {
+                LLFrameVector<int> values(10);
+                allocations = LLFrameArena::current().getAllocationCount();
+            });
+        queue.post([&left_over]()
+            {
+                left_over = LLFrameArena::current().getAllocationCount();
+            });
+        queue.close();
+        std::thread thread([&queue]() { queue.runUntilClose(); });
+        thread.join();
+        ensure("first item used the arena", allocations > 0);
+        ensure_equals("arena not reset between items", left_over, 0U);
+    }
+} // namespace tut
@@ -0,0 +1,102 @@
+/**
+ * @file llparallelfor_test.cpp
+ * @brief Test for llparallelfor
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "llparallelfor.h"
+// STL headers
+#include <atomic>
+#include <vector>
+// other Linden headers
+#include "../test/lltut.h"
+#include "stringize.h"
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct llparallelfor_data
+    {
+        llparallelfor_data():
+            pool("ParallelForTest", 3)
+        {
+            pool.start();
+        }
+
+        ~llparallelfor_data()
+        {
+            pool.close();
+        }
+
+        LL::ThreadPool pool;
+    };
+    typedef test_group<llparallelfor_data> llparallelfor_group;
+    typedef llparallelfor_group::object object;
+    llparallelfor_group llparallelforgrp("llparallelfor");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("every index visited once");
+        std::vector<std::atomic<int>> hits(1000);
+        LL::parallelFor("ParallelForTest", hits.size(), 7,
+                        [&hits](size_t begin, size_t end)
+                        {
+                            for (size_t i = begin; i < end; ++i)
+                            {
+                                ++hits[i];
+                            }
+                        });
+        for (size_t i = 0; i < hits.size(); ++i)
+        {
+            ensure_equals(STRINGIZE("index " << i), hits[i].load(), 1);
+        }
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("unknown pool runs inline");
+        size_t calls = 0, total = 0;
+        // No synchronization: everything must happen on this thread.
+        LL::parallelFor("NoSuchPool", 100, 10,
+                        [&calls, &total](size_t begin, size_t end)
+                        {
+                            ++calls;
+                            total += end - begin;
+                        });
+        ensure_equals("split without a pool", calls, size_t(1));
+        ensure_equals("range not covered", total, size_t(100));
+
+        calls = 0;
+        LL::parallelFor("ParallelForTest", 0, 10,
+                        [&calls](size_t, size_t) { ++calls; });
+        ensure_equals("called for empty range", calls, size_t(0));
+    }
+}
@@ -32,6 +32,9 @@
 #include "lltracerecording.h"
 #include "../test/lltut.h"
 
+#include <atomic>
+#include <thread>
+
 #ifdef LL_WINDOWS
 #pragma warning(disable : 4244) // possible loss of data on conversions
 #endif
@@ -143,4 +146,43 @@ namespace tut
                 && after_3pm.getMax(sCaffeineLevelStat) == sCaffeinePerOz * ((S32Ounces)S32TallCup(1) + (S32Ounces)S32GrandeCup(3) + (S32Ounces)S32VentiCup(1)).value());
     }
 
+    // child thread stats pushed while the parent pulls
+    template<> template<>
+    void trace_object_t::test<2>()
+    {
+        const S32 NUM_PUSHES = 1000;
+        std::atomic<bool> child_done(false);
+        std::atomic<bool> parent_done(false);
+
+        Recording recording;
+        recording.start();
+
+        std::thread child([this, &child_done, &parent_done]()
+        {
+            ThreadRecorder child_recorder(mRecorder);
+            for (S32 i = 0; i < NUM_PUSHES; i++)
+            {
+                add(sCupsOfCoffeeConsumed, 1);
+                child_recorder.pushToParent();
+            }
+            child_done = true;
+            // stay registered until the parent has pulled everything
+            while (!parent_done)
+            {
+                std::this_thread::yield();
+            }
+        });
+
+        while (!child_done)
+        {
+            mRecorder.pullFromChildren();
+        }
+        mRecorder.pullFromChildren();
+        S32 cups = recording.getSum(sCupsOfCoffeeConsumed);
+        parent_done = true;
+        child.join();
+
+        ensure_equals("every push reaches the parent", cups, NUM_PUSHES);
+    }
+
 }
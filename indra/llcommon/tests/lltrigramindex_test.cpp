@@ -0,0 +1,199 @@
+/**
+ * @file   lltrigramindex_test.cpp
+ * @date   2026-10-19
+ * @brief  Test for lltrigramindex.
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "lltrigramindex.h"
+// STL headers
+// std headers
+// external library headers
+// other Linden headers
+#include "llstring.h"
+#include "../test/lltut.h"
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct lltrigramindex_data
+    {
+        std::vector<std::string> fields(const std::string& name, const std::string& desc = std::string())
+        {
+            std::vector<std::string> result;
+            result.push_back(name);
+            result.push_back(desc);
+            return result;
+        }
+    };
+    typedef test_group<lltrigramindex_data> lltrigramindex_group;
+    typedef lltrigramindex_group::object object;
+    lltrigramindex_group lltrigramindexgrp("lltrigramindex");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("search checks only the rarest trigram's documents");
+        LLTrigramIndex index(2);
+        std::vector<LLUUID> dresses;
+        for (S32 i = 0; i < 1000; ++i)
+        {
+            LLUUID id;
+            id.generate();
+            if (i % 100 == 0)
+            {
+                dresses.push_back(id);
+                index.update(id, LLUUID::null, fields(llformat("RED DRESS %d", i)));
+            }
+            else
+            {
+                index.update(id, LLUUID::null, fields(llformat("RED SHIRT %d", i)));
+            }
+        }
+        ensure_equals(index.size(), 1000);
+
+        LLTrigramIndex::id_set_t matches;
+        U32 checked = index.search(0, "DRESS", matches);
+        ensure_equals("matches", matches.size(), dresses.size());
+        for (const LLUUID& id : dresses)
+        {
+            ensure("dress found", matches.count(id) > 0);
+        }
+        ensure_equals("checked beyond the candidates", checked, (U32)dresses.size());
+
+        matches.clear();
+        ensure_equals("unknown trigram checks nothing", index.search(0, "BLUE", matches), 0U);
+        ensure("unknown trigram matched", matches.empty());
+
+        matches.clear();
+        ensure_equals("short string checks everything", index.search(0, "D ", matches), 1000U);
+        ensure_equals("short string matches", matches.size(), 1000U);
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("candidates are checked for the whole substring");
+        LLTrigramIndex index(2);
+        LLUUID hit, miss;
+        hit.generate();
+        miss.generate();
+        // both hold every trigram of "ABCDE", only one holds the string
+        index.update(hit, LLUUID::null, fields("XABCDEX"));
+        index.update(miss, LLUUID::null, fields("ABCD BCDE CDE"));
+
+        LLTrigramIndex::id_set_t matches;
+        index.search(0, "ABCDE", matches);
+        ensure_equals(matches.size(), 1U);
+        ensure("wrong match", matches.count(hit) > 0);
+    }
+
+    template<> template<>
+    void object::test<3>()
+    {
+        set_test_name("fields are searched separately");
+        LLTrigramIndex index(2);
+        LLUUID named, described;
+        named.generate();
+        described.generate();
+        index.update(named, LLUUID::null, fields("HAIR BASE", "PLAIN"));
+        index.update(described, LLUUID::null, fields("PLAIN", "HAIR BASE"));
+
+        LLTrigramIndex::id_set_t matches;
+        index.search(0, "HAIR", matches);
+        ensure("name match", matches.size() == 1 && matches.count(named));
+        matches.clear();
+        index.search(1, "HAIR", matches);
+        ensure("description match", matches.size() == 1 && matches.count(described));
+    }
+
+    template<> template<>
+    void object::test<4>()
+    {
+        set_test_name("updates replace what was indexed");
+        LLTrigramIndex index(2);
+        LLUUID id, creator, other_creator;
+        id.generate();
+        creator.generate();
+        other_creator.generate();
+
+        ensure("first add", index.update(id, creator, fields("OLD NAME", "OLD DESC")));
+        ensure("unchanged update", !index.update(id, creator, fields("OLD NAME", "OLD DESC")));
+        ensure_equals("nothing marked dead", index.getDeadCount(), 0);
+
+        ensure("renamed", index.update(id, creator, fields("NEW NAME", "OLD DESC")));
+        ensure_equals("one document", index.size(), 1);
+        LLTrigramIndex::id_set_t matches;
+        index.search(0, "OLD NAME", matches);
+        ensure("old name still found", matches.empty());
+        index.search(0, "NEW NAME", matches);
+        ensure("new name not found", matches.count(id) > 0);
+
+        ensure("new creator", index.update(id, other_creator, fields("NEW NAME", "OLD DESC")));
+        ensure("old creator kept", !index.getGroups().count(creator));
+        ensure_equals("new creator count", index.getGroups().at(other_creator), 1);
+
+        LLTrigramIndex::id_set_t groups;
+        groups.insert(other_creator);
+        matches.clear();
+        index.searchGroups(groups, matches);
+        ensure("creator search", matches.size() == 1 && matches.count(id));
+
+        ensure("removed", index.remove(id));
+        ensure("removed twice", !index.remove(id));
+        ensure_equals("empty", index.size(), 0);
+        ensure("groups left", index.getGroups().empty());
+        matches.clear();
+        index.search(1, "OLD DESC", matches);
+        ensure("removed document found", matches.empty());
+    }
+
+    template<> template<>
+    void object::test<5>()
+    {
+        set_test_name("dead documents are compacted away");
+        LLTrigramIndex index(2, 4);
+        std::vector<LLUUID> ids;
+        for (S32 i = 0; i < 10; ++i)
+        {
+            LLUUID id;
+            id.generate();
+            ids.push_back(id);
+            index.update(id, LLUUID::null, fields(llformat("HAT %d", i)));
+        }
+
+        for (S32 i = 0; i < 5; ++i)
+        {
+            index.remove(ids[i]);
+        }
+        ensure_equals("no more dead than live yet", index.getDeadCount(), 5);
+
+        index.remove(ids[5]);
+        ensure_equals("compacted", index.getDeadCount(), 0);
+        ensure_equals("live documents", index.size(), 4);
+
+        LLTrigramIndex::id_set_t matches;
+        U32 checked = index.search(0, "HAT", matches);
+        ensure_equals("matches after compaction", matches.size(), 4U);
+        ensure_equals("checked after compaction", checked, 4U);
+        for (S32 i = 6; i < 10; ++i)
+        {
+            ensure("survivor found", matches.count(ids[i]) > 0);
+        }
+
+        // slots were renumbered, updating must still find the document
+        ensure("update after compaction", index.update(ids[9], LLUUID::null, fields("CAP 9")));
+        matches.clear();
+        index.search(0, "CAP", matches);
+        ensure("renamed survivor", matches.size() == 1 && matches.count(ids[9]));
+    }
+}
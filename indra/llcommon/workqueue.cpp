@@ -21,6 +21,7 @@
 #include LLCOROS_MUTEX_HEADER
 #include "llerror.h"
 #include "llexception.h"
+#include "llframearena.h"
 #include "stringize.h"
 
 using Mutex = LLCoros::Mutex;
@@ -44,6 +45,8 @@ void LL::WorkQueueBase::runUntilClose()
         {
             LL_PROFILE_ZONE_SCOPED_CATEGORY_THREAD;
             callWork(pop_());
+            // each work item is a unit of work for this thread's arena
+            LLFrameArena::current().reset();
         }
     }
     catch (const Closed&)
@@ -153,6 +153,21 @@ constexpr int HTTP_CONNECTION_LIMIT_MAX = 256;
 constexpr long HTTP_PIPELINING_DEFAULT = 0L;
 constexpr long HTTP_PIPELINING_MAX = 20L;
 
+// HTTP protocol version selection
+constexpr long HTTP_VERSION_1_1 = 1L;
+constexpr long HTTP_VERSION_2 = 2L;
+constexpr long HTTP_VERSION_DEFAULT = HTTP_VERSION_1_1;
+
+// HTTP/2 stream weights (RFC 7540 5.3.2)
+constexpr int HTTP_STREAM_WEIGHT_DEFAULT = 16;
+constexpr int HTTP_STREAM_WEIGHT_MIN = 1;
+constexpr int HTTP_STREAM_WEIGHT_MAX = 256;
+
+// Service thread assignment for policy classes.  Zero is
+// the main service thread.
+constexpr long HTTP_SERVICE_THREAD_DEFAULT = 0L;
+constexpr long HTTP_SERVICE_THREADS_MAX = 4L;
+
 // Miscellaneous defaults
 constexpr bool HTTP_USE_RETRY_AFTER_DEFAULT = true;
 constexpr long HTTP_THROTTLE_RATE_DEFAULT = 0L;
@@ -30,6 +30,7 @@
 #include "bufferarray.h"
 #include "_httpoprequest.h"
 #include "_httppolicy.h"
+#include "httpstats.h"
 
 #include "llhttpconstants.h"
 
@@ -363,6 +364,18 @@ bool HttpLibcurl::completeRequest(CURLM * multi_handle, CURL * handle, CURLcode
     {
         op->mStatus = HttpStatus(HttpStatus::EXT_CURL_EASY, status);
     }
+    if (handle)
+    {
+        // Connection accounting for comparing transports.  NUM_CONNECTS
+        // is the count of new connections this transfer had to make,
+        // zero when it rode on an existing connection or stream.
+        long new_connects(0L), http_version(CURL_HTTP_VERSION_NONE);
+        if (CURLE_OK == curl_easy_getinfo(handle, CURLINFO_NUM_CONNECTS, &new_connects)
+            && CURLE_OK == curl_easy_getinfo(handle, CURLINFO_HTTP_VERSION, &http_version))
+        {
+            HTTPStats::instance().recordTransport(new_connects, CURL_HTTP_VERSION_2_0 == http_version);
+        }
+    }
     if (op->mStatus)
     {
         // note: CURLINFO_RESPONSE_CODE requires a long - https://curl.haxx.se/libcurl/c/CURLINFO_RESPONSE_CODE.html
@@ -541,7 +554,29 @@ void HttpLibcurl::policyUpdated(unsigned int policy_class)
         policy.stallPolicy(policy_class, false);
         mDirtyPolicy[policy_class] = false;
 
-        if (options.mPipelining > 1)
+        if (options.mHttpVersion >= HTTP_VERSION_2)
+        {
+            // Multiplex streams over as few connections as possible.
+            // The pipelining depth becomes the stream limit for each
+            // connection and the per-host limit bounds how many
+            // connections libcurl will open before making requests
+            // wait for a free stream.
+            check_curl_multi_setopt(multi_handle,
+                                     CURLMOPT_PIPELINING,
+                                     long(CURLPIPE_MULTIPLEX));
+#if LIBCURL_VERSION_NUM >= 0x074300
+            check_curl_multi_setopt(multi_handle,
+                                     CURLMOPT_MAX_CONCURRENT_STREAMS,
+                                     long(llmax(options.mPipelining, 1L)));
+#endif
+            check_curl_multi_setopt(multi_handle,
+                                     CURLMOPT_MAX_HOST_CONNECTIONS,
+                                     long(options.mPerHostConnectionLimit));
+            check_curl_multi_setopt(multi_handle,
+                                     CURLMOPT_MAX_TOTAL_CONNECTIONS,
+                                     long(options.mConnectionLimit));
+        }
+        else if (options.mPipelining > 1)
         {
             // We'll try to do pipelining on this multihandle
             check_curl_multi_setopt(multi_handle,
@@ -231,6 +231,10 @@ void HttpOpRequest::stageFromActive(HttpService * service)
             // Not as expected, fail the request
             mStatus = HttpStatus(HttpStatus::LLCORE, HE_INV_CONTENT_RANGE_HDR);
         }
+        else if (! mReplyBody && mReplySink && mReplySink->size() && mReplyLength != mReplySink->size())
+        {
+            mStatus = HttpStatus(HttpStatus::LLCORE, HE_INV_CONTENT_RANGE_HDR);
+        }
     }
 
     if (mCurlHeaders)
@@ -488,6 +492,11 @@ HttpStatus HttpOpRequest::prepareRequest(HttpService * service)
         mReplyBody->release();
         mReplyBody = NULL;
     }
+    mReplySink = mReqOptions ? mReqOptions->getBodySink() : HttpBodySink::ptr_t();
+    if (mReplySink)
+    {
+        mReplySink->reset();
+    }
     mReplyOffset = 0;
     mReplyLength = 0;
     mReplyFullLength = 0;
@@ -764,6 +773,19 @@ HttpStatus HttpOpRequest::prepareRequest(HttpService * service)
 /******************************/
         check_curl_easy_setopt(mCurlHandle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_0);
     }
+    if (cpolicy.mHttpVersion >= HTTP_VERSION_2)
+    {
+        // Offer h2 via ALPN on TLS connections only.  Cleartext
+        // requests stay on HTTP/1.1 rather than attempting an
+        // Upgrade: dance with servers that may not tolerate it.
+        // PIPEWAIT has the request queue up behind a connection
+        // that is still negotiating so that it can become another
+        // stream on it instead of opening a parallel connection.
+        check_curl_easy_setopt(mCurlHandle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        check_curl_easy_setopt(mCurlHandle, CURLOPT_PIPEWAIT, 1L);
+        check_curl_easy_setopt(mCurlHandle, CURLOPT_STREAM_WEIGHT,
+                               long(mReqOptions ? mReqOptions->getStreamWeight() : HTTP_STREAM_WEIGHT_DEFAULT));
+    }
     // *DEBUG:  Enable following override for timeout handling and "[curl:bugs] #1420" tests
     //if (cpolicy.mPipelining)
     //{
@@ -799,12 +821,47 @@ size_t HttpOpRequest::writeCallback(void * data, size_t size, size_t nmemb, void
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
     HttpOpRequest::ptr_t op(HttpOpRequest::fromHandle<HttpOpRequest>(userdata));
+    const size_t req_size(size * nmemb);
 
-    if (! op->mReplyBody)
+    if (op->mReplySink && ! op->mReplyBody)
+    {
+        // Caller supplied memory for the body.  Commit to it on the
+        // first block only if the server said how much is coming
+        // and it fits.  Content-Range (when scanned) is more precise
+        // than Content-Length for ranged requests.
+        bool use_sink(true);
+        if (! op->mReplySink->size())
+        {
+            curl_off_t expected(-1);
+            if (op->mReplyLength)
+            {
+                expected = curl_off_t(op->mReplyLength);
+            }
+            else if (CURLE_OK != curl_easy_getinfo(op->mCurlHandle, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &expected))
+            {
+                expected = -1;
+            }
+            use_sink = op->mReplySink->canHold(S64(expected));
+        }
+        if (use_sink && op->mReplySink->append(data, req_size))
+        {
+            HTTPStats::instance().recordDataDown(req_size);
+            return req_size;
+        }
+
+        // Unknown length or overflow (e.g. decoded body larger
+        // than advertised).  Spill to a BufferArray and carry on.
+        op->mReplyBody = new BufferArray();
+        if (op->mReplySink->size())
+        {
+            op->mReplyBody->append(op->mReplySink->getData(), op->mReplySink->size());
+            op->mReplySink->reset();
+        }
+    }
+    else if (! op->mReplyBody)
     {
         op->mReplyBody = new BufferArray();
     }
-    const size_t req_size(size * nmemb);
     const size_t write_size(op->mReplyBody->append(static_cast<char *>(data), req_size));
     HTTPStats::instance().recordDataDown(write_size);
     return write_size;
@@ -212,6 +212,7 @@ public:
     // Result data
     HttpStatus          mStatus;
     BufferArray *       mReplyBody;
+    HttpBodySink::ptr_t mReplySink;             // Caller's body memory, used if mReplyBody is NULL
     off_t               mReplyOffset;
     size_t              mReplyLength;
     size_t              mReplyFullLength;
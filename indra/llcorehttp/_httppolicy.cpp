@@ -414,9 +414,16 @@ bool HttpPolicy::stageAfterCompletion(const HttpOpRequest::ptr_t &op)
                             << LL_ENDL;
     }
 
+    // Latency from request creation, so queueing time is included.
+    // Sampled before the op is handed to the reply queue.
+    const HttpRequest::policy_t policy_class(op->mReqPolicy);
+    const HttpTime latency(totalTime() - op->mMetricCreated);
+    const S32 status_type(op->mStatus.getType());
+
     op->stageFromActive(mService);
 
-    HTTPStats::instance().recordResultCode(op->mStatus.getType());
+    HTTPStats::instance().recordResultCode(status_type);
+    HTTPStats::instance().recordLatency(policy_class, latency);
     return false;                       // not active
 }
 
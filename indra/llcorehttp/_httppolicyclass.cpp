@@ -37,7 +37,9 @@ HttpPolicyClass::HttpPolicyClass()
     : mConnectionLimit(HTTP_CONNECTION_LIMIT_DEFAULT),
       mPerHostConnectionLimit(HTTP_CONNECTION_LIMIT_DEFAULT),
       mPipelining(HTTP_PIPELINING_DEFAULT),
-      mThrottleRate(HTTP_THROTTLE_RATE_DEFAULT)
+      mThrottleRate(HTTP_THROTTLE_RATE_DEFAULT),
+      mHttpVersion(HTTP_VERSION_DEFAULT),
+      mServiceThread(HTTP_SERVICE_THREAD_DEFAULT)
 {}
 
 
@@ -53,6 +55,8 @@ HttpPolicyClass & HttpPolicyClass::operator=(const HttpPolicyClass & other)
         mPerHostConnectionLimit = other.mPerHostConnectionLimit;
         mPipelining = other.mPipelining;
         mThrottleRate = other.mThrottleRate;
+        mHttpVersion = other.mHttpVersion;
+        mServiceThread = other.mServiceThread;
     }
     return *this;
 }
@@ -62,7 +66,9 @@ HttpPolicyClass::HttpPolicyClass(const HttpPolicyClass & other)
     : mConnectionLimit(other.mConnectionLimit),
       mPerHostConnectionLimit(other.mPerHostConnectionLimit),
       mPipelining(other.mPipelining),
-      mThrottleRate(other.mThrottleRate)
+      mThrottleRate(other.mThrottleRate),
+      mHttpVersion(other.mHttpVersion),
+      mServiceThread(other.mServiceThread)
 {}
 
 
@@ -86,6 +92,14 @@ HttpStatus HttpPolicyClass::set(HttpRequest::EPolicyOption opt, long value)
         mThrottleRate = llclamp(value, 0L, 1000000L);
         break;
 
+    case HttpRequest::PO_HTTP_VERSION:
+        mHttpVersion = llclamp(value, HTTP_VERSION_1_1, HTTP_VERSION_2);
+        break;
+
+    case HttpRequest::PO_SERVICE_THREAD:
+        mServiceThread = llclamp(value, 0L, HTTP_SERVICE_THREADS_MAX);
+        break;
+
     default:
         return HttpStatus(HttpStatus::LLCORE, HE_INVALID_ARG);
     }
@@ -114,6 +128,14 @@ HttpStatus HttpPolicyClass::get(HttpRequest::EPolicyOption opt, long * value) co
         *value = mThrottleRate;
         break;
 
+    case HttpRequest::PO_HTTP_VERSION:
+        *value = mHttpVersion;
+        break;
+
+    case HttpRequest::PO_SERVICE_THREAD:
+        *value = mServiceThread;
+        break;
+
     default:
         return HttpStatus(HttpStatus::LLCORE, HE_INVALID_ARG);
     }
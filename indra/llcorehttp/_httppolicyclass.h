@@ -64,6 +64,8 @@ public:
     long                        mPerHostConnectionLimit;
     long                        mPipelining;
     long                        mThrottleRate;
+    long                        mHttpVersion;
+    long                        mServiceThread;
 };  // end class HttpPolicyClass
 
 }  // end namespace LLCore
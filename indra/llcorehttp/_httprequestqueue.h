@@ -49,6 +49,10 @@ class HttpOperation;
 
 class HttpRequestQueue : public LLCoreInt::RefCounted
 {
+    // HttpService creates private queues for its dedicated
+    // service threads.
+    friend class HttpService;
+
 protected:
     /// Caller acquires a Refcount on construction
     HttpRequestQueue();
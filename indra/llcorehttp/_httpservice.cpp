@@ -30,6 +30,9 @@
 #include <boost/function.hpp>
 
 #include "_httpoperation.h"
+#include "_httpoprequest.h"
+#include "_httpopcancel.h"
+#include "_httpopsetget.h"
 #include "_httprequestqueue.h"
 #include "_httppolicy.h"
 #include "_httplibcurl.h"
@@ -63,7 +66,9 @@ const HttpService::OptionDescriptor HttpService::sOptionDesc[] =
     {   true,       true,       true,       false,      false   },      // PO_TRACE
     {   true,       true,       false,      true,       false   },      // PO_ENABLE_PIPELINING
     {   true,       true,       false,      true,       false   },      // PO_THROTTLE_RATE
-    {   false,      false,      true,       false,      true    }       // PO_SSL_VERIFY_CALLBACK
+    {   false,      false,      true,       false,      true    },      // PO_SSL_VERIFY_CALLBACK
+    {   true,       false,      false,      true,       false   },      // PO_HTTP_VERSION
+    {   true,       false,      false,      true,       false   }       // PO_SERVICE_THREAD
 };
 HttpService * HttpService::sInstance(NULL);
 volatile HttpService::EState HttpService::sState(NOT_INITIALIZED);
@@ -74,7 +79,8 @@ HttpService::HttpService()
       mThread(NULL),
       mPolicy(NULL),
       mTransport(NULL),
-      mLastPolicy(0)
+      mLastPolicy(0),
+      mPrimary(NULL)
 {}
 
 
@@ -110,6 +116,13 @@ HttpService::~HttpService()
         }
     }
 
+    for (service_list_t::iterator it(mServiceThreads.begin()); it != mServiceThreads.end(); ++it)
+    {
+        delete *it;
+    }
+    mServiceThreads.clear();
+    mClassServices.clear();
+
     if (mRequestQueue)
     {
         mRequestQueue->release();
@@ -211,6 +224,7 @@ void HttpService::startThread()
     // Push current policy definitions, enable policy & transport components
     mPolicy->start();
     mTransport->start(mLastPolicy + 1);
+    startServiceThreads();
 
     mThread = new LLCoreInt::HttpThread(boost::bind(&HttpService::threadRun, this, _1));
     sState = RUNNING;
@@ -268,6 +282,9 @@ void HttpService::shutdown()
     }
     ops.clear();
 
+    // Secondary services cancel their own requests
+    stopServiceThreads();
+
     // Shutdown transport canceling requests, freeing resources
     mTransport->shutdown();
 
@@ -332,7 +349,156 @@ void HttpService::threadRun(LLCoreInt::HttpThread * thread)
     }
 
     shutdown();
-    sState = STOPPED;
+    if (! mPrimary)
+    {
+        sState = STOPPED;
+    }
+}
+
+
+void HttpService::startServiceThreads()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+    llassert_always(mServiceThreads.empty());
+
+    mClassServices.assign(mLastPolicy + 1, NULL);
+    for (HttpRequest::policy_t pclass(0); pclass <= mLastPolicy; ++pclass)
+    {
+        long thread_id(HTTP_SERVICE_THREAD_DEFAULT);
+        mPolicy->getClassOptions(pclass).get(HttpRequest::PO_SERVICE_THREAD, &thread_id);
+        if (thread_id <= 0)
+        {
+            continue;
+        }
+
+        if (mServiceThreads.size() < size_t(thread_id))
+        {
+            mServiceThreads.resize(thread_id, NULL);
+        }
+
+        HttpService *& service(mServiceThreads[thread_id - 1]);
+        if (! service)
+        {
+            // Secondary service mirrors all of our policy definitions
+            // but will only ever see requests for its own classes.
+            service = new HttpService();
+            service->mPrimary = this;
+            service->mRequestQueue = new HttpRequestQueue();
+            service->mPolicy = new HttpPolicy(service);
+            service->mTransport = new HttpLibcurl(service);
+            while (service->mLastPolicy < mLastPolicy)
+            {
+                service->mLastPolicy = service->mPolicy->createPolicyClass();
+            }
+            service->mPolicy->getGlobalOptions() = mPolicy->getGlobalOptions();
+            for (HttpRequest::policy_t i(0); i <= mLastPolicy; ++i)
+            {
+                service->mPolicy->getClassOptions(i) = mPolicy->getClassOptions(i);
+            }
+        }
+        mClassServices[pclass] = service;
+    }
+
+    for (service_list_t::iterator it(mServiceThreads.begin()); it != mServiceThreads.end(); ++it)
+    {
+        HttpService * service(*it);
+        if (service)
+        {
+            service->mPolicy->start();
+            service->mTransport->start(mLastPolicy + 1);
+            service->mThread = new LLCoreInt::HttpThread(boost::bind(&HttpService::threadRun, service, _1));
+        }
+    }
+}
+
+
+void HttpService::stopServiceThreads()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+    mClassServices.clear();
+
+    for (service_list_t::iterator it(mServiceThreads.begin()); it != mServiceThreads.end(); ++it)
+    {
+        HttpService * service(*it);
+        if (service && service->mThread)
+        {
+            service->mExitRequested = 1U;
+            service->mRequestQueue->stopQueue();
+        }
+    }
+
+    for (service_list_t::iterator it(mServiceThreads.begin()); it != mServiceThreads.end(); ++it)
+    {
+        HttpService * service(*it);
+        if (service && service->mThread)
+        {
+            service->mThread->join();
+            service->mThread->release();
+            service->mThread = NULL;
+        }
+        delete service;
+    }
+    mServiceThreads.clear();
+}
+
+
+HttpService * HttpService::routeOp(const HttpOperation::ptr_t & op)
+{
+    if (mClassServices.empty())
+    {
+        return NULL;
+    }
+
+    HttpRequest::policy_t pclass(HttpRequest::INVALID_POLICY_ID);
+    if (HttpOpRequest * req = dynamic_cast<HttpOpRequest *>(op.get()))
+    {
+        pclass = req->mReqPolicy;
+    }
+    else if (HttpOpCancel * cancel = dynamic_cast<HttpOpCancel *>(op.get()))
+    {
+        // Cancels go wherever the target request was sent
+        HttpOperation::ptr_t target(HttpOperation::fromHandle<HttpOperation>(cancel->mHandle));
+        if (target)
+        {
+            pclass = target->mReqPolicy;
+        }
+    }
+    else if (HttpOpSetGet * setget = dynamic_cast<HttpOpSetGet *>(op.get()))
+    {
+        if (HttpRequest::GLOBAL_POLICY_ID != setget->mReqClass)
+        {
+            pclass = setget->mReqClass;
+        }
+        else if (setget->mReqDoSet)
+        {
+            // Global changes are applied here and mirrored to
+            // each secondary service without a reply path.
+            for (service_list_t::iterator it(mServiceThreads.begin()); it != mServiceThreads.end(); ++it)
+            {
+                if (! *it)
+                {
+                    continue;
+                }
+
+                HttpOpSetGet::ptr_t mirror(new HttpOpSetGet());
+                if (sOptionDesc[setget->mReqOption].mIsLong)
+                {
+                    mirror->setupSet(setget->mReqOption, setget->mReqClass, setget->mReqLongValue);
+                }
+                else
+                {
+                    mirror->setupSet(setget->mReqOption, setget->mReqClass, setget->mReqStrValue);
+                }
+                (*it)->mRequestQueue->addOp(mirror);
+            }
+        }
+    }
+
+    if (pclass >= mClassServices.size())
+    {
+        return NULL;
+    }
+    return mClassServices[pclass];
 }
 
 
@@ -363,8 +529,13 @@ HttpService::ELoopSpeed HttpService::processRequestQueue(ELoopSpeed loop)
                                    << LL_ENDL;
             }
 
-            // Stage
-            op->stageFromRequest(this);
+            // Stage here or hand off to the class's service thread.
+            // A stopped secondary queue leaves the operation with us.
+            HttpService * service(routeOp(op));
+            if (! service || ! service->mRequestQueue->addOp(op))
+            {
+                op->stageFromRequest(this);
+            }
         }
 
         // Done with operation
@@ -36,6 +36,7 @@
 #include "httprequest.h"
 #include "_httppolicyglobal.h"
 #include "_httppolicyclass.h"
+#include "_httpoperation.h"
 
 
 namespace LLCoreInt
@@ -78,6 +79,17 @@ class HttpOpSetGet;
 /// 1:1:1 relationship with HttpService managing instances of the other
 /// two.  So, these classes do not use reference counting to refer
 /// to one another, their lifecycles are always managed together.
+///
+/// Service Threads
+///
+/// Policy classes may be assigned to dedicated service threads with
+/// the PO_SERVICE_THREAD option.  Each such thread is run by a
+/// secondary HttpService instance, owned by the singleton, with its
+/// own private request queue, HttpPolicy and HttpLibcurl (and so its
+/// own CURLM handles).  The singleton's thread still drains the
+/// global request queue and forwards operations for those classes
+/// to the owning instance.  Operations are unaware of the split as
+/// they always work through the HttpService they were staged on.
 
 class HttpService
 {
@@ -180,6 +192,24 @@ protected:
 
     ELoopSpeed processRequestQueue(ELoopSpeed loop);
 
+    /// Create and start the secondary services for classes
+    /// assigned to dedicated service threads.
+    ///
+    /// Threading:  callable by init thread.
+    void startServiceThreads();
+
+    /// Stop, join and release secondary services.
+    ///
+    /// Threading:  callable by worker thread.
+    void stopServiceThreads();
+
+    /// Select the service that should stage an operation taken
+    /// from the request queue.  Returns NULL when the operation
+    /// belongs to this instance.
+    ///
+    /// Threading:  callable by worker thread.
+    HttpService * routeOp(const HttpOperation::ptr_t & op);
+
 protected:
     friend class HttpOpSetGet;
     friend class HttpRequest;
@@ -227,6 +257,13 @@ protected:
     // === main-thread-only data ===
     HttpRequest::policy_t               mLastPolicy;
 
+    // === service thread data, fixed while running ===
+    typedef std::vector<HttpService *> service_list_t;
+
+    HttpService *                       mPrimary;       // NULL for the singleton, not owner
+    service_list_t                      mServiceThreads; // Simple pointers, has ownership
+    service_list_t                      mClassServices; // Indexed by class, NULL for this instance
+
 };  // end class HttpService
 
 }  // end namespace LLCore
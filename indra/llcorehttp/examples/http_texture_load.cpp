@@ -42,6 +42,7 @@
 #include "httpoptions.h"
 #include "httpheaders.h"
 #include "bufferarray.h"
+#include "httpstats.h"
 #include "_mutex.h"
 
 #include <curl/curl.h>
@@ -61,6 +62,7 @@ static int concurrency_limit(40);
 static int highwater(100);
 static int pipeline_depth(0);
 static int tracing(0);
+static int http_version(1);
 static char url_format[1024] = "http://example.com/some/path?texture_id=%s.texture";
 
 #if defined(WIN32)
@@ -167,7 +169,7 @@ int main(int argc, char** argv)
     bool do_verbose(false);
 
     int option(-1);
-    while (-1 != (option = getopt(argc, argv, "u:c:h?RwvH:p:t:")))
+    while (-1 != (option = getopt(argc, argv, "u:c:h?RwvH:p:t:2")))
     {
         switch (option)
         {
@@ -236,6 +238,10 @@ int main(int argc, char** argv)
             }
             break;
 
+        case '2':
+            http_version = 2;
+            break;
+
         case 'R':
             do_random = true;
             do_whole = false;
@@ -291,6 +297,13 @@ int main(int argc, char** argv)
                                                    pipeline_depth,
                                                    NULL);
     }
+    if (http_version > 1)
+    {
+        LLCore::HttpRequest::setStaticPolicyOption(LLCore::HttpRequest::PO_HTTP_VERSION,
+                                                   LLCore::HttpRequest::DEFAULT_POLICY_ID,
+                                                   http_version,
+                                                   NULL);
+    }
     if (tracing)
     {
         LLCore::HttpRequest::setStaticPolicyOption(LLCore::HttpRequest::PO_TRACE,
@@ -359,6 +372,11 @@ int main(int argc, char** argv)
               << " uS  Maximum VSZ: " << metrics.mMaxVSZ
               << " Bytes  Minimum VSZ: " << metrics.mMinVSZ << " Bytes"
               << std::endl;
+    const U64 wall_time(metrics.mEndWallTime - metrics.mStartWallTime);
+    std::cout << "Requests/S: " << (wall_time ? (ws.mSuccesses * 1000000.0 / wall_time) : 0.0)
+              << "  Connections opened: " << LLCore::HTTPStats::instance().getConnectionCount()
+              << "  HTTP/2 responses: " << LLCore::HTTPStats::instance().getHttp2ResponseCount()
+              << std::endl;
 
     // Clean up
     hr->requestStopThread(LLCore::HttpHandler::ptr_t());
@@ -398,6 +416,10 @@ void usage(std::ostream & out)
         "                       depth on HTTP requests.  Default:  " << pipeline_depth << "\n"
         " -t <level>            If <level> is positive ([1..3]), enables and sets HTTP\n"
         "                       tracing on HTTP requests.  Default:  " << tracing << "\n"
+        " -2                    Offer HTTP/2 via ALPN on https: URLs.  Run once with\n"
+        "                       and once without against the same server (e.g. a\n"
+        "                       local 'nghttpd' stand-in) to compare request rate\n"
+        "                       and connection counts with HTTP/1.1.\n"
         " -v                    Verbose mode.  Issue some chatter while running\n"
         " -h                    print this help\n"
         "\n"
@@ -0,0 +1,103 @@
+/**
+ * @file httpbodysink.cpp
+ * @brief Implements the HttpBodySink class
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "httpbodysink.h"
+
+#include "llmemory.h"
+
+
+namespace LLCore
+{
+
+
+HttpBodySink::HttpBodySink(size_t capacity, size_t offset)
+    : mBuffer(NULL),
+      mCapacity(0),
+      mOffset(0),
+      mSize(0),
+      mOwned(true)
+{
+    if (capacity && offset <= capacity)
+    {
+        mBuffer = static_cast<U8 *>(ll_aligned_malloc_16(capacity));
+    }
+    if (mBuffer)
+    {
+        mCapacity = capacity;
+        mOffset = offset;
+    }
+}
+
+
+HttpBodySink::HttpBodySink(U8 * buffer, size_t capacity, size_t offset)
+    : mBuffer(buffer),
+      mCapacity(buffer ? capacity : 0),
+      mOffset(buffer ? llmin(offset, capacity) : 0),
+      mSize(0),
+      mOwned(false)
+{}
+
+
+HttpBodySink::~HttpBodySink()
+{
+    if (mOwned && mBuffer)
+    {
+        ll_aligned_free_16(mBuffer);
+    }
+    mBuffer = NULL;
+}
+
+
+size_t HttpBodySink::append(const void * src, size_t len)
+{
+    if (! canHold(S64(len)))
+    {
+        return 0;
+    }
+    memcpy(mBuffer + mOffset + mSize, src, len);
+    mSize += len;
+    return len;
+}
+
+
+U8 * HttpBodySink::detach()
+{
+    if (! mOwned)
+    {
+        return NULL;
+    }
+
+    U8 * ret(mBuffer);
+    mBuffer = NULL;
+    mCapacity = 0;
+    mOffset = 0;
+    mSize = 0;
+    return ret;
+}
+
+
+}  // end namespace LLCore
@@ -0,0 +1,148 @@
+/**
+ * @file httpbodysink.h
+ * @brief Public-facing declarations for the HttpBodySink class
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef _LLCORE_HTTP_BODY_SINK_H_
+#define _LLCORE_HTTP_BODY_SINK_H_
+
+
+#include "linden_common.h"
+
+#include <memory>
+
+
+namespace LLCore
+{
+
+/// Caller-provided destination for a response body.  When attached
+/// to a request via HttpOptions::setBodySink() and the response
+/// announces its length (Content-Range or Content-Length) and that
+/// length fits, libcurl's write callback copies the body directly
+/// into the sink's memory instead of into a BufferArray.  The caller
+/// then uses the bytes in place and avoids the usual copy out of the
+/// BufferArray into its own contiguous allocation.
+///
+/// If the length is unknown or the body turns out larger than the
+/// sink (e.g. a 200 in response to a Range request or a body grown by
+/// content decoding), the library quietly falls back to a BufferArray
+/// and the response's getBody() carries the data as usual.  Callers
+/// must therefore check both:  a non-empty sink means the body is in
+/// the sink and getBody() is NULL.
+///
+/// Bytes are written beginning at getOffset() which lets a caller
+/// reserve room at the front of the buffer for data it already has.
+///
+/// Threading:  not thread-safe.  Written by the worker thread while
+/// the request is active and only to be read by the caller after the
+/// request's completion has been delivered.  The sink is held by the
+/// request until then so it is safe to drop the caller's reference
+/// on cancelation.
+///
+/// Allocation:  shared_ptr, heap only.
+///
+class HttpBodySink
+{
+public:
+    typedef std::shared_ptr<HttpBodySink> ptr_t;
+
+    /// Allocates a 16-byte aligned buffer of 'capacity' bytes owned
+    /// by the sink.  Ownership may be taken with detach().
+    HttpBodySink(size_t capacity, size_t offset = 0);
+
+    /// Wraps caller memory (e.g. an LLImageFormatted data block).
+    /// The memory is not owned and must remain valid until the
+    /// request completes.
+    HttpBodySink(U8 * buffer, size_t capacity, size_t offset = 0);
+
+    ~HttpBodySink();
+
+private:
+    HttpBodySink(const HttpBodySink &);         // Not defined
+    void operator=(const HttpBodySink &);       // Not defined
+
+public:
+    U8 * getBuffer() const
+        {
+            return mBuffer;
+        }
+
+    size_t getCapacity() const
+        {
+            return mCapacity;
+        }
+
+    size_t getOffset() const
+        {
+            return mOffset;
+        }
+
+    /// Pointer to the first body byte written.
+    U8 * getData() const
+        {
+            return mBuffer ? mBuffer + mOffset : NULL;
+        }
+
+    /// Count of body bytes written so far.
+    size_t size() const
+        {
+            return mSize;
+        }
+
+    /// True if 'len' more bytes can be written.  Negative
+    /// lengths (libcurl's 'unknown') never fit.
+    bool canHold(S64 len) const
+        {
+            return mBuffer && len >= 0 && U64(len) <= U64(mCapacity - mOffset - mSize);
+        }
+
+    /// Appends body bytes if all of them fit.
+    ///
+    /// @return         'len' on success, 0 if nothing was written.
+    size_t append(const void * src, size_t len);
+
+    /// Discards written bytes, e.g. before a retry.
+    void reset()
+        {
+            mSize = 0;
+        }
+
+    /// Hands an owned buffer over to the caller who must release
+    /// it with ll_aligned_free_16().  The sink is empty afterwards.
+    /// Returns NULL for wrapped, unowned memory.
+    U8 * detach();
+
+protected:
+    U8 *                mBuffer;
+    size_t              mCapacity;
+    size_t              mOffset;
+    size_t              mSize;
+    bool                mOwned;
+};  // end class HttpBodySink
+
+
+}  // end namespace LLCore
+
+#endif  // _LLCORE_HTTP_BODY_SINK_H_
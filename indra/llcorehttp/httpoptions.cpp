@@ -48,10 +48,31 @@ HttpOptions::HttpOptions() :
     mVerifyHost(false),
     mDNSCacheTimeout(-1L),
     mNoBody(false),
+    mStreamWeight(HTTP_STREAM_WEIGHT_DEFAULT),
     mLastModified(0) // <FS:Ansariel> GetIfModified request
 {}
 
 
+HttpOptions::HttpOptions(const HttpOptions & other) :
+    mWantHeaders(other.mWantHeaders),
+    mTracing(other.mTracing),
+    mTimeout(other.mTimeout),
+    mTransferTimeout(other.mTransferTimeout),
+    mRetries(other.mRetries),
+    mMinRetryBackoff(other.mMinRetryBackoff),
+    mMaxRetryBackoff(other.mMaxRetryBackoff),
+    mUseRetryAfter(other.mUseRetryAfter),
+    mFollowRedirects(other.mFollowRedirects),
+    mVerifyPeer(other.mVerifyPeer),
+    mVerifyHost(other.mVerifyHost),
+    mDNSCacheTimeout(other.mDNSCacheTimeout),
+    mNoBody(other.mNoBody),
+    mStreamWeight(other.mStreamWeight),
+    mBodySink(),
+    mLastModified(other.mLastModified)
+{}
+
+
 HttpOptions::~HttpOptions()
 {}
 
@@ -130,6 +151,16 @@ void HttpOptions::setHeadersOnly(bool nobody)
     }
 }
 
+void HttpOptions::setStreamWeight(int weight)
+{
+    mStreamWeight = llclamp(weight, HTTP_STREAM_WEIGHT_MIN, HTTP_STREAM_WEIGHT_MAX);
+}
+
+void HttpOptions::setBodySink(const HttpBodySink::ptr_t & sink)
+{
+    mBodySink = sink;
+}
+
 void HttpOptions::setDefaultSSLVerifyPeer(bool verify)
 {
     sDefaultVerifyPeer = verify;
@@ -29,6 +29,7 @@
 
 
 #include "httpcommon.h"
+#include "httpbodysink.h"
 #include "_refcounted.h"
 
 
@@ -64,9 +65,11 @@ public:
 
     virtual ~HttpOptions();                     // Use release()
 
-protected:
+    /// Copies all settings except the body sink.  Used to derive
+    /// per-request options from a shared, pre-configured instance.
+    HttpOptions(const HttpOptions &);
 
-    HttpOptions(const HttpOptions &);           // Not defined
+protected:
     void operator=(const HttpOptions &);        // Not defined
 
 public:
@@ -178,6 +181,29 @@ public:
         return mNoBody;
     }
 
+    /// Sets the relative weight given to this request's stream
+    /// when the policy class multiplexes requests over HTTP/2
+    /// (see HttpRequest::PO_HTTP_VERSION).  Higher weights get
+    /// a larger share of the connection.  Ignored for HTTP/1.1.
+    /// Range: [1..256]
+    /// Default: 16
+    void                setStreamWeight(int weight);
+    int                 getStreamWeight() const
+    {
+        return mStreamWeight;
+    }
+
+    /// Supplies memory the response body will be written into
+    /// directly when its length is known and fits.  Options with
+    /// a sink must not be shared between concurrent requests.
+    /// See HttpBodySink for the fallback rules.
+    /// Default: none
+    void                setBodySink(const HttpBodySink::ptr_t & sink);
+    const HttpBodySink::ptr_t & getBodySink() const
+    {
+        return mBodySink;
+    }
+
     /// Sets default behavior for verifying that the name in the
     /// security certificate matches the name of the host contacted.
     /// Defaults false if not set, but should be set according to
@@ -207,6 +233,8 @@ protected:
     bool                mVerifyHost;
     int                 mDNSCacheTimeout;
     bool                mNoBody;
+    int                 mStreamWeight;
+    HttpBodySink::ptr_t mBodySink;
 
     static bool         sDefaultVerifyPeer;
 
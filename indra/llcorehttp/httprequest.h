@@ -232,6 +232,36 @@ public:
         /// Global only
         PO_SSL_VERIFY_CALLBACK,
 
+        /// Long value selecting the HTTP protocol version offered
+        /// by requests in this class.  Possible values are:
+        /// 1 - HTTP/1.1 only (default)
+        /// 2 - HTTP/2 negotiated via ALPN on https: connections,
+        ///     falling back to HTTP/1.1 when the server declines
+        ///     and for plain http: URLs.
+        ///
+        /// When HTTP/2 is in effect, PO_PIPELINING_DEPTH is
+        /// reinterpreted as the number of concurrent streams
+        /// multiplexed over each connection and requests will
+        /// wait for an existing connection to become available
+        /// rather than open new ones.  Stream weights are taken
+        /// from HttpOptions::setStreamWeight().
+        ///
+        /// Per-class only
+        PO_HTTP_VERSION,
+
+        /// Long value selecting the service thread that runs the
+        /// policy, transport and libcurl multi handle for requests
+        /// in this class.  Zero (the default) keeps the class on
+        /// the main HttpService thread.  Values from 1 to
+        /// HTTP_SERVICE_THREADS_MAX place the class on a dedicated
+        /// worker thread with its own CURLM;  classes given the same
+        /// value share that thread.  Useful to keep a busy class
+        /// (e.g. texture fetches) from delaying completions in the
+        /// others.
+        ///
+        /// Per-class only
+        PO_SERVICE_THREAD,
+
         PO_LAST  // Always at end
     };
 
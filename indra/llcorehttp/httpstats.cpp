@@ -41,15 +41,20 @@ HTTPStats::~HTTPStats()
 
 void HTTPStats::resetStats()
 {
+    std::lock_guard<std::mutex> lock(mMutex);
     mResutCodes.clear();
+    mLatencies.clear();
     mDataDown.reset();
     mDataUp.reset();
     mRequests = 0;
+    mConnections = 0;
+    mHttp2Responses = 0;
 }
 
 
 void HTTPStats::recordResultCode(S32 code)
 {
+    std::lock_guard<std::mutex> lock(mMutex);
     std::map<S32, S32>::iterator it;
 
     it = mResutCodes.find(code);
@@ -61,6 +66,39 @@ void HTTPStats::recordResultCode(S32 code)
 
 }
 
+void HTTPStats::recordLatency(U32 policy_class, U64 usecs)
+{
+    S32 bucket(0);
+    for (U64 ms(usecs / 1000); ms && bucket < LATENCY_BUCKETS - 1; ms >>= 1)
+    {
+        ++bucket;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::map<U32, LatencyHistogram>::iterator it(mLatencies.find(policy_class));
+    if (it == mLatencies.end())
+    {
+        it = mLatencies.insert(std::make_pair(policy_class, LatencyHistogram())).first;
+        it->second.fill(0);
+    }
+    ++it->second[bucket];
+}
+
+
+HTTPStats::LatencyHistogram HTTPStats::getLatencyHistogram(U32 policy_class) const
+{
+    LatencyHistogram result;
+    result.fill(0);
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::map<U32, LatencyHistogram>::const_iterator it(mLatencies.find(policy_class));
+    if (it != mLatencies.end())
+    {
+        result = it->second;
+    }
+    return result;
+}
+
 namespace
 {
     std::string byte_count_converter(F32 bytes)
@@ -86,6 +124,7 @@ namespace
 
 void HTTPStats::dumpStats()
 {
+    std::lock_guard<std::mutex> lock(mMutex);
     std::stringstream out;
 
     out << "HTTP DATA SUMMARY" << std::endl;
@@ -93,6 +132,7 @@ void HTTPStats::dumpStats()
     out << "Data Sent: " << byte_count_converter(mDataUp.getSum()) << "   (" << mDataUp.getSum() << ")" << std::endl;
     out << "Data Recv: " << byte_count_converter(mDataDown.getSum()) << "   (" << mDataDown.getSum() << ")" << std::endl;
     out << "Total requests: " << mRequests << "(request objects created)" << std::endl;
+    out << "Connections opened: " << mConnections << "  HTTP/2 responses: " << mHttp2Responses << std::endl;
     out << std::endl;
     out << "Result Codes:" << std::endl << "--- -----" << std::endl;
 
@@ -101,6 +141,28 @@ void HTTPStats::dumpStats()
         out << (*it).first << " " << (*it).second << std::endl;
     }
 
+    out << std::endl;
+    out << "Latency by policy class (ms, upper bound: count):" << std::endl;
+    for (std::map<U32, LatencyHistogram>::iterator it = mLatencies.begin(); it != mLatencies.end(); ++it)
+    {
+        out << "Class " << (*it).first << ":";
+        for (S32 bucket(0); bucket < LATENCY_BUCKETS; ++bucket)
+        {
+            if ((*it).second[bucket])
+            {
+                if (bucket < LATENCY_BUCKETS - 1)
+                {
+                    out << "  <" << (1U << bucket) << ": " << (*it).second[bucket];
+                }
+                else
+                {
+                    out << "  >=" << (1U << (bucket - 1)) << ": " << (*it).second[bucket];
+                }
+            }
+        }
+        out << std::endl;
+    }
+
     LL_WARNS("HTTPCore") << out.str() << LL_ENDL;
 }
 
@@ -33,6 +33,9 @@
 #include "llsingleton.h"
 #include "llsd.h"
 
+#include <array>
+#include <mutex>
+
 namespace LLCore
 {
     class HTTPStats final : public LLSimpleton<HTTPStats>
@@ -45,28 +48,91 @@ namespace LLCore
 
         typedef LLStatsAccumulator StatsAccumulator;
 
+        /// Request latency histogram buckets.  Bucket 0 counts
+        /// completions under 1ms, bucket N those in [2^(N-1), 2^N) ms
+        /// and the final bucket everything slower.
+        static constexpr S32 LATENCY_BUCKETS = 18;
+        typedef std::array<U32, LATENCY_BUCKETS> LatencyHistogram;
+
+        // Recorders may be called from any HTTP service thread, so
+        // every counter is read and written under mMutex.
         void    recordDataDown(size_t bytes)
         {
+            std::lock_guard<std::mutex> lock(mMutex);
             mDataDown.push((F32)bytes);
         }
 
         void    recordDataUp(size_t bytes)
         {
+            std::lock_guard<std::mutex> lock(mMutex);
             mDataUp.push((F32)bytes);
         }
 
-        void    recordHTTPRequest() { ++mRequests; }
+        void    recordHTTPRequest()
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            ++mRequests;
+        }
 
         void    recordResultCode(S32 code);
 
+        /// Count connections opened by a completed transfer and
+        /// whether the response arrived over HTTP/2.
+        void    recordTransport(long new_connections, bool http2)
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mConnections += new_connections;
+            if (http2)
+            {
+                ++mHttp2Responses;
+            }
+        }
+
+        S32     getRequestCount() const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mRequests;
+        }
+
+        F64     getDataDownBytes() const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mDataDown.getSum();
+        }
+
+        S32     getConnectionCount() const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mConnections;
+        }
+
+        S32     getHttp2ResponseCount() const
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            return mHttp2Responses;
+        }
+
+        /// Count a completed request of the given policy class taking
+        /// 'usecs' from creation to completion.
+        void    recordLatency(U32 policy_class, U64 usecs);
+
+        /// Snapshot of a class's latency histogram, all zero for
+        /// classes with no completions.
+        LatencyHistogram getLatencyHistogram(U32 policy_class) const;
+
         void    dumpStats();
     private:
         StatsAccumulator mDataDown;
         StatsAccumulator mDataUp;
 
         S32              mRequests;
+        S32              mConnections;
+        S32              mHttp2Responses;
 
         std::map<S32, S32> mResutCodes;
+        std::map<U32, LatencyHistogram> mLatencies;
+
+        mutable std::mutex mMutex;
     };
 
 
@@ -95,11 +95,14 @@ const std::string HTTP_IN_HEADER_CACHE_CONTROL("cache-control");
 const std::string HTTP_IN_HEADER_CONTENT_LENGTH("content-length");
 const std::string HTTP_IN_HEADER_CONTENT_LOCATION("content-location");
 const std::string HTTP_IN_HEADER_CONTENT_TYPE("content-type");
+const std::string HTTP_IN_HEADER_ETAG("etag");
 const std::string HTTP_IN_HEADER_HOST("host");
+const std::string HTTP_IN_HEADER_LAST_MODIFIED("last-modified");
 const std::string HTTP_IN_HEADER_LOCATION("location");
 const std::string HTTP_IN_HEADER_RETRY_AFTER("retry-after");
 const std::string HTTP_IN_HEADER_SET_COOKIE("set-cookie");
 const std::string HTTP_IN_HEADER_USER_AGENT("user-agent");
+const std::string HTTP_IN_HEADER_VARY("vary");
 const std::string HTTP_IN_HEADER_X_FORWARDED_FOR("x-forwarded-for");
 
 const std::string HTTP_CONTENT_LLSD_XML("application/llsd+xml");
@@ -185,11 +185,14 @@ extern const std::string HTTP_IN_HEADER_CACHE_CONTROL;
 extern const std::string HTTP_IN_HEADER_CONTENT_LENGTH;
 extern const std::string HTTP_IN_HEADER_CONTENT_LOCATION;
 extern const std::string HTTP_IN_HEADER_CONTENT_TYPE;
+extern const std::string HTTP_IN_HEADER_ETAG;
 extern const std::string HTTP_IN_HEADER_HOST;
+extern const std::string HTTP_IN_HEADER_LAST_MODIFIED;
 extern const std::string HTTP_IN_HEADER_LOCATION;
 extern const std::string HTTP_IN_HEADER_RETRY_AFTER;
 extern const std::string HTTP_IN_HEADER_SET_COOKIE;
 extern const std::string HTTP_IN_HEADER_USER_AGENT;
+extern const std::string HTTP_IN_HEADER_VARY;
 extern const std::string HTTP_IN_HEADER_X_FORWARDED_FOR;
 
 //// HTTP Content Types ////
@@ -0,0 +1,107 @@
+/**
+ * @file test_httpbodysink.hpp
+ * @brief unit tests for the LLCore::HttpBodySink class
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+#ifndef TEST_LLCORE_HTTP_BODY_SINK_H_
+#define TEST_LLCORE_HTTP_BODY_SINK_H_
+
+#include "httpbodysink.h"
+#include "llmemory.h"
+
+#include <iostream>
+
+
+using namespace LLCore;
+
+
+
+namespace tut
+{
+
+struct HttpBodySinkTestData
+{
+    // the test objects inherit from this so the member functions and variables
+    // can be referenced directly inside of the test functions.
+};
+
+typedef test_group<HttpBodySinkTestData> HttpBodySinkTestGroupType;
+typedef HttpBodySinkTestGroupType::object HttpBodySinkTestObjectType;
+HttpBodySinkTestGroupType HttpBodySinkTestGroup("HttpBodySink Tests");
+
+template <> template <>
+void HttpBodySinkTestObjectType::test<1>()
+{
+    set_test_name("HttpBodySink owned buffer");
+
+    HttpBodySink sink(16, 4);
+    ensure("Buffer allocated", NULL != sink.getBuffer());
+    ensure("Capacity recorded", 16 == sink.getCapacity());
+    ensure("Empty on construction", 0 == sink.size());
+    ensure("Data starts at offset", sink.getBuffer() + 4 == sink.getData());
+    ensure("Room for 12", sink.canHold(12));
+    ensure("No room for 13", ! sink.canHold(13));
+    ensure("Unknown length never fits", ! sink.canHold(-1));
+
+    char str1[] = "abcdefgh";
+    ensure("Append fits", 8 == sink.append(str1, 8));
+    ensure("Size updated", 8 == sink.size());
+    ensure("Content written at offset", 0 == memcmp(sink.getBuffer() + 4, str1, 8));
+    ensure("Overflowing append refused", 0 == sink.append(str1, 8));
+    ensure("Size unchanged by refused append", 8 == sink.size());
+
+    sink.reset();
+    ensure("Reset empties", 0 == sink.size());
+
+    U8 * buffer(sink.detach());
+    ensure("Detach hands over buffer", NULL != buffer);
+    ensure("Sink empty after detach", NULL == sink.getBuffer() && 0 == sink.size());
+    ll_aligned_free_16(buffer);
+}
+
+template <> template <>
+void HttpBodySinkTestObjectType::test<2>()
+{
+    set_test_name("HttpBodySink wrapped buffer");
+
+    U8 buffer[10];
+    memset(buffer, 'X', sizeof(buffer));
+
+    HttpBodySink sink(buffer, sizeof(buffer));
+    ensure("Wraps caller memory", buffer == sink.getBuffer());
+
+    char str1[] = "abcd";
+    ensure("Append fits", 4 == sink.append(str1, 4));
+    ensure("Append fits again", 4 == sink.append(str1, 4));
+    ensure("Content contiguous", 0 == memcmp(buffer, "abcdabcd", 8));
+    ensure("Tail untouched", 'X' == buffer[8]);
+    ensure("Third append overflows", 0 == sink.append(str1, 4));
+
+    ensure("Unowned memory not detached", NULL == sink.detach());
+    ensure("Still wrapping after detach", buffer == sink.getBuffer());
+}
+
+}  // end namespace tut
+
+#endif  // TEST_LLCORE_HTTP_BODY_SINK_H_
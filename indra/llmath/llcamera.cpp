@@ -296,6 +296,77 @@ S32 LLCamera::AABBInRegionFrustumNoFarClip(const LLVector4a& center, const LLVec
     return AABBInFrustumNoFarClip(center, radius, mRegionPlanes);
 }
 
+// Test four boxes, given as structure of arrays, against the planes.  Each
+// plane is applied in the same order of operations as AABBInFrustum(), so
+// the results match it.
+static void aabb_in_planes4(const LLPlane* planes, const U8* plane_mask, U32 max_planes, U32 skip_plane,
+                            const LLVector4a* center, const LLVector4a* radius, S32* results)
+{
+    U32 out = 0;
+    U32 partial = 0;
+    for (U32 i = 0; i < max_planes; i++)
+    {
+        U8 mask = plane_mask[i];
+        if (i == skip_plane || mask >= LLCamera::PLANE_MASK_NUM)
+        {
+            continue;
+        }
+
+        const LLPlane& p(planes[i]);
+        LLVector4a px, py, pz, d;
+        px.splat(p[VX]);
+        py.splat(p[VY]);
+        pz.splat(p[VZ]);
+        d.splat(-p[VW]);
+
+        const LLVector4a& scaler = sFrustumScaler[mask];
+        LLVector4a rx, ry, rz;
+        rx.setMul(radius[VX], LLVector4a(scaler[VX]));
+        ry.setMul(radius[VY], LLVector4a(scaler[VY]));
+        rz.setMul(radius[VZ], LLVector4a(scaler[VZ]));
+
+        // dot3 sums x and y first, then z
+        LLVector4a minx, miny, minz, dot, t;
+        minx.setSub(center[VX], rx);
+        miny.setSub(center[VY], ry);
+        minz.setSub(center[VZ], rz);
+        dot.setMul(px, minx);
+        t.setMul(py, miny);
+        dot.add(t);
+        t.setMul(pz, minz);
+        dot.add(t);
+        out |= dot.greaterThan(d).getGatheredBits();
+
+        LLVector4a maxx, maxy, maxz;
+        maxx.setAdd(center[VX], rx);
+        maxy.setAdd(center[VY], ry);
+        maxz.setAdd(center[VZ], rz);
+        dot.setMul(px, maxx);
+        t.setMul(py, maxy);
+        dot.add(t);
+        t.setMul(pz, maxz);
+        dot.add(t);
+        partial |= dot.greaterThan(d).getGatheredBits();
+    }
+
+    for (U32 j = 0; j < 4; j++)
+    {
+        results[j] = (out & (1 << j)) ? 0 : ((partial & (1 << j)) ? 1 : 2);
+    }
+}
+
+void LLCamera::AABBInFrustum4(const LLVector4a* center, const LLVector4a* radius, S32* results, const LLPlane* planes)
+{
+    U32 max_planes = llmin(mPlaneCount, (U32) AGENT_PLANE_USER_CLIP_NUM);
+    aabb_in_planes4(planes ? planes : mAgentPlanes, mPlaneMask, max_planes, U32_MAX, center, radius, results);
+}
+
+void LLCamera::AABBInFrustumNoFarClip4(const LLVector4a* center, const LLVector4a* radius, S32* results, const LLPlane* planes)
+{
+    U32 max_planes = llmin(mPlaneCount, (U32) AGENT_PLANE_USER_CLIP_NUM);
+    aabb_in_planes4(planes ? planes : mAgentPlanes, mPlaneMask, max_planes, AGENT_PLANE_FAR, center, radius, results);
+}
+
 int LLCamera::sphereInFrustumQuick(const LLVector3 &sphere_center, const F32 radius)
 {
     LLVector3 dist = sphere_center-mFrustCenter;
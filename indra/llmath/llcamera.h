@@ -202,6 +202,13 @@ public:
     S32 AABBInFrustumNoFarClip(const LLVector4a& center, const LLVector4a& radius, const LLPlane* planes = NULL);
     S32 AABBInRegionFrustumNoFarClip(const LLVector4a& center, const LLVector4a& radius);
 
+    // Packet forms of AABBInFrustum() and AABBInFrustumNoFarClip() testing
+    // four boxes at once.  Boxes are given as structure of arrays: center[0..2]
+    // and radius[0..2] hold the x, y and z of the four centers and half sizes.
+    // results[0..3] receive the same values the single box tests return.
+    void AABBInFrustum4(const LLVector4a* center, const LLVector4a* radius, S32* results, const LLPlane* planes = NULL);
+    void AABBInFrustumNoFarClip4(const LLVector4a* center, const LLVector4a* radius, S32* results, const LLPlane* planes = NULL);
+
     //does a quick 'n dirty sphere-sphere check
     S32 sphereInFrustumQuick(const LLVector3 &sphere_center, const F32 radius);
 
@@ -0,0 +1,156 @@
+/**
+ * @file llcamera_test.cpp
+ * @brief Test for the packet frustum tests in llcamera.cpp
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+#include "../test/lltut.h"
+
+#include "../llcamera.h"
+
+namespace tut
+{
+    struct llcamera_data
+    {
+        // Looking down +X from the origin with a 90 degree field of view,
+        // near plane at 1m and far plane at 100m
+        llcamera_data()
+        {
+            LLVector3 frust[8] =
+            {
+                LLVector3(1.f, 1.f, -1.f),
+                LLVector3(1.f, -1.f, -1.f),
+                LLVector3(1.f, -1.f, 1.f),
+                LLVector3(1.f, 1.f, 1.f),
+                LLVector3(100.f, 100.f, -100.f),
+                LLVector3(100.f, -100.f, -100.f),
+                LLVector3(100.f, -100.f, 100.f),
+                LLVector3(100.f, 100.f, 100.f)
+            };
+            mCamera.setOrigin(LLVector3::zero);
+            mCamera.calcAgentFrustumPlanes(frust);
+        }
+
+        // Compare the packet tests against the single box tests over a grid
+        // of boxes straddling every plane
+        void checkPackets(const char* msg)
+        {
+            LL_ALIGN_16(F32 soa[6][4]);
+            LLVector4a center[4];
+            LLVector4a radius[4];
+            S32 n = 0;
+            for (S32 x = -40; x <= 140; x += 9)
+            {
+                for (S32 y = -120; y <= 120; y += 11)
+                {
+                    for (S32 z = -120; z <= 120; z += 13)
+                    {
+                        F32 r = (F32)((x + y + z) & 15) + 0.5f;
+                        center[n].set((F32)x, (F32)y, (F32)z);
+                        radius[n].set(r, r * 0.5f, r * 2.f);
+                        for (S32 j = 0; j < 3; j++)
+                        {
+                            soa[j][n] = center[n][j];
+                            soa[j + 3][n] = radius[n][j];
+                        }
+
+                        if (++n == 4)
+                        {
+                            LLVector4a packet[6];
+                            for (S32 j = 0; j < 6; j++)
+                            {
+                                packet[j].load4a(soa[j]);
+                            }
+
+                            S32 results[4];
+                            S32 results_no_far[4];
+                            mCamera.AABBInFrustum4(packet, packet + 3, results);
+                            mCamera.AABBInFrustumNoFarClip4(packet, packet + 3, results_no_far);
+                            for (S32 i = 0; i < 4; i++)
+                            {
+                                ensure_equals(msg, results[i], mCamera.AABBInFrustum(center[i], radius[i]));
+                                ensure_equals(msg, results_no_far[i], mCamera.AABBInFrustumNoFarClip(center[i], radius[i]));
+                            }
+                            n = 0;
+                        }
+                    }
+                }
+            }
+        }
+
+        LLCamera mCamera;
+    };
+    typedef test_group<llcamera_data> llcamera_test;
+    typedef llcamera_test::object llcamera_object;
+    tut::llcamera_test llcamera_testcase("LLCamera");
+
+    template<> template<>
+    void llcamera_object::test<1>()
+    {
+        LLVector4a center[4];
+        LLVector4a radius;
+        radius.splat(1.f);
+        center[0].set(50.f, 0.f, 0.f);      // inside
+        center[1].set(-50.f, 0.f, 0.f);     // behind
+        center[2].set(50.f, 50.f, 0.f);     // on the left plane
+        center[3].set(150.f, 0.f, 0.f);     // past the far plane
+
+        LL_ALIGN_16(F32 soa[6][4]);
+        for (S32 i = 0; i < 4; i++)
+        {
+            for (S32 j = 0; j < 3; j++)
+            {
+                soa[j][i] = center[i][j];
+                soa[j + 3][i] = 1.f;
+            }
+        }
+        LLVector4a packet[6];
+        for (S32 j = 0; j < 6; j++)
+        {
+            packet[j].load4a(soa[j]);
+        }
+
+        S32 results[4];
+        mCamera.AABBInFrustum4(packet, packet + 3, results);
+        ensure_equals("inside", results[0], 2);
+        ensure_equals("behind", results[1], 0);
+        ensure_equals("partial", results[2], 1);
+        ensure_equals("past far plane", results[3], 0);
+
+        mCamera.AABBInFrustumNoFarClip4(packet, packet + 3, results);
+        ensure_equals("past far plane without far clip", results[3], 2);
+    }
+
+    template<> template<>
+    void llcamera_object::test<2>()
+    {
+        checkPackets("frustum");
+
+        LLPlane water;
+        water.setVec(LLVector3(0.f, 0.f, 10.f), LLVector3(0.f, 0.f, 1.f));
+        mCamera.setUserClipPlane(water);
+        checkPackets("user clip plane");
+    }
+}
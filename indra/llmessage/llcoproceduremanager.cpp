@@ -36,6 +36,8 @@
 #include <boost/fiber/buffered_channel.hpp>
 
 #include "llexception.h"
+#include "lltimer.h"
+#include "lltrace.h"
 #include "stringize.h"
 
 //=========================================================================
@@ -47,6 +49,36 @@ static const std::map<std::string, U32> DefaultPoolSizes{
 };
 
 static const U32 DEFAULT_POOL_SIZE = 5;
+// Pools larger than one may grow to this multiple of their configured
+// size unless a PoolSizeMax<name> setting says otherwise.  Pools of one
+// are serialized on purpose and never adapt.
+static const U32 DEFAULT_POOL_GROWTH = 2;
+
+// Statistics floater gauges, handed out to adaptive pools in the order
+// they are created.  Trace stats have to exist before recording starts
+// so there is a fixed number of them; pools beyond that go unreported.
+static LLTrace::SampleStatHandle<> sPoolLimitStats[] = {
+    {"coproc_limit_0", "Concurrency limit of the first adaptive coprocedure pool"},
+    {"coproc_limit_1", "Concurrency limit of the second adaptive coprocedure pool"},
+    {"coproc_limit_2", "Concurrency limit of the third adaptive coprocedure pool"},
+    {"coproc_limit_3", "Concurrency limit of the fourth adaptive coprocedure pool"},
+    {"coproc_limit_4", "Concurrency limit of the fifth adaptive coprocedure pool"},
+    {"coproc_limit_5", "Concurrency limit of the sixth adaptive coprocedure pool"},
+    {"coproc_limit_6", "Concurrency limit of the seventh adaptive coprocedure pool"},
+    {"coproc_limit_7", "Concurrency limit of the eighth adaptive coprocedure pool"},
+};
+static LLTrace::SampleStatHandle<F64Seconds> sPoolLatencyStats[] = {
+    {"coproc_latency_0", "Smoothed request latency in the first adaptive coprocedure pool"},
+    {"coproc_latency_1", "Smoothed request latency in the second adaptive coprocedure pool"},
+    {"coproc_latency_2", "Smoothed request latency in the third adaptive coprocedure pool"},
+    {"coproc_latency_3", "Smoothed request latency in the fourth adaptive coprocedure pool"},
+    {"coproc_latency_4", "Smoothed request latency in the fifth adaptive coprocedure pool"},
+    {"coproc_latency_5", "Smoothed request latency in the sixth adaptive coprocedure pool"},
+    {"coproc_latency_6", "Smoothed request latency in the seventh adaptive coprocedure pool"},
+    {"coproc_latency_7", "Smoothed request latency in the eighth adaptive coprocedure pool"},
+};
+static_assert(LL_ARRAY_SIZE(sPoolLimitStats) == LL_ARRAY_SIZE(sPoolLatencyStats), "one latency gauge per limit gauge");
+static LLTrace::CountStatHandle<> sThrottledCoprocs("coproc_throttled", "Coprocedures whose requests were throttled by the server");
 // SL-14399: When we teleport to a brand-new simulator, the coprocedure queue
 // gets absolutely slammed with fetch requests. Make this queue effectively
 // unlimited.
@@ -58,7 +90,7 @@ class LLCoprocedurePool: private boost::noncopyable
 public:
     typedef LLCoprocedureManager::CoProcedure_t CoProcedure_t;
 
-    LLCoprocedurePool(const std::string &name, size_t size);
+    LLCoprocedurePool(const std::string &name, size_t size, size_t max_size, S32 gauge);
     ~LLCoprocedurePool();
 
     /// Places the coprocedure on the queue for processing.
@@ -90,6 +122,13 @@ public:
         return static_cast<S32>(countPending() + countActive());
     }
 
+    /// Returns the current adaptive concurrency limit.
+    ///
+    inline U32 getLimit() const
+    {
+        return mLimiter.getLimit();
+    }
+
     void close();
 
 private:
@@ -127,8 +166,21 @@ private:
 
     CoroAdapterMap_t mCoroMapping;
 
+    // One invoker coroutine is launched per slot up to the limiter's
+    // maximum.  Those at or above the current limit park on
+    // mLimitCondition until it rises.
+    LLCoprocedureLimiter        mLimiter;
+    LLCoros::Mutex              mLimitMutex;
+    LLCoros::ConditionVariable  mLimitCondition;
+
+    LLTrace::SampleStatHandle<> *           mLimitStat;
+    LLTrace::SampleStatHandle<F64Seconds> * mLatencyStat;
+
     void coprocedureInvokerCoro(CoprocQueuePtr pendingCoprocs,
-                                LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t httpAdapter);
+                                LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t httpAdapter,
+                                size_t slot);
+    void recordCompletion(const LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t &httpAdapter,
+                          U32 completed_before, U32 throttled_before, F64 started, bool saturated);
 };
 
 //=========================================================================
@@ -180,7 +232,35 @@ void LLCoprocedureManager::initializePool(const std::string &poolName)
         LL_WARNS("CoProcMgr") << "LLCoprocedureManager: No setting for \"" << keyName << "\" setting pool size to default of " << size << LL_ENDL;
     }
 
-    poolPtr_t pool(new LLCoprocedurePool(poolName, size));
+    // Upper bound for adaptive sizing
+    keyName = "PoolSizeMax" + poolName;
+    int max_size = 0;
+
+    if (mPropertyQueryFn)
+    {
+        max_size = mPropertyQueryFn(keyName);
+    }
+
+    if (max_size == 0)
+    {
+        max_size = (size > 1) ? size * DEFAULT_POOL_GROWTH : size;
+
+        if (mPropertyDefineFn)
+        {
+            mPropertyDefineFn(keyName, max_size, "Adaptive coroutine pool size limit for " + poolName);
+        }
+    }
+    max_size = llmax(max_size, size);
+
+    // Only pools that can adapt get statistics floater gauges
+    S32 gauge = -1;
+    if (max_size > size && mGaugedPools.size() < LL_ARRAY_SIZE(sPoolLimitStats))
+    {
+        gauge = static_cast<S32>(mGaugedPools.size());
+        mGaugedPools.push_back(poolName);
+    }
+
+    poolPtr_t pool(new LLCoprocedurePool(poolName, size, max_size, gauge));
     LL_ERRS_IF(!pool, "CoprocedureManager") << "Unable to create pool named \"" << poolName << "\" FATAL!" << LL_ENDL;
 
     bool inserted = mPoolMap.emplace(poolName, pool).second;
@@ -278,6 +358,15 @@ size_t LLCoprocedureManager::count(const std::string &pool) const
     return it->second->count();
 }
 
+U32 LLCoprocedureManager::getLimit(const std::string &pool) const
+{
+    poolMap_t::const_iterator it = mPoolMap.find(pool);
+
+    if (it == mPoolMap.end())
+        return 0;
+    return it->second->getLimit();
+}
+
 void LLCoprocedureManager::close()
 {
     for(auto & poolEntry : mPoolMap)
@@ -296,15 +385,19 @@ void LLCoprocedureManager::close(const std::string &pool)
 }
 
 //=========================================================================
-LLCoprocedurePool::LLCoprocedurePool(const std::string &poolName, size_t size):
+LLCoprocedurePool::LLCoprocedurePool(const std::string &poolName, size_t size, size_t max_size, S32 gauge):
     mPoolName(poolName),
-    mPoolSize(size),
+    mPoolSize(max_size),
     mActiveCoprocsCount(0),
     mPending(0),
     mPendingCoprocs(std::make_shared<CoprocQueue_t>(LLCoprocedureManager::DEFAULT_QUEUE_SIZE)),
     mHTTPPolicy(LLCore::HttpRequest::DEFAULT_POLICY_ID),
-    mCoroMapping()
+    mCoroMapping(),
+    mLimiter(static_cast<U32>(size), 1, static_cast<U32>(max_size)),
+    mLimitStat(gauge >= 0 ? &sPoolLimitStats[gauge] : NULL),
+    mLatencyStat(gauge >= 0 ? &sPoolLatencyStats[gauge] : NULL)
 {
+
     try
     {
         // store in our LLTempBoundListener so that when the LLCoprocedurePool is
@@ -347,12 +440,12 @@ LLCoprocedurePool::LLCoprocedurePool(const std::string &poolName, size_t size):
         std::string pooledCoro = LLCoros::instance().launch(
             "LLCoprocedurePool("+mPoolName+")::coprocedureInvokerCoro",
             boost::bind(&LLCoprocedurePool::coprocedureInvokerCoro, this,
-                        mPendingCoprocs, httpAdapter));
+                        mPendingCoprocs, httpAdapter, count));
 
         mCoroMapping.insert(CoroAdapterMap_t::value_type(pooledCoro, httpAdapter));
     }
 
-    LL_INFOS("CoProcMgr") << "Created coprocedure pool named \"" << mPoolName << "\" with " << size << " items, queue max " << LLCoprocedureManager::DEFAULT_QUEUE_SIZE << LL_ENDL;
+    LL_INFOS("CoProcMgr") << "Created coprocedure pool named \"" << mPoolName << "\" with " << size << " items (max " << max_size << "), queue max " << LLCoprocedureManager::DEFAULT_QUEUE_SIZE << LL_ENDL;
 }
 
 LLCoprocedurePool::~LLCoprocedurePool()
@@ -406,10 +499,25 @@ LLUUID LLCoprocedurePool::enqueueCoprocedure(const std::string &name, LLCoproced
 //-------------------------------------------------------------------------
 void LLCoprocedurePool::coprocedureInvokerCoro(
     CoprocQueuePtr pendingCoprocs,
-    LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t httpAdapter)
+    LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t httpAdapter,
+    size_t slot)
 {
     for (;;)
     {
+        if (slot >= mLimiter.getLimit())
+        {
+            {
+                LLCoros::TempStatus st("parked by adaptive pool limit");
+                LLCoros::LockType lock(mLimitMutex);
+                mLimitCondition.wait_for(lock, std::chrono::seconds(10));
+            }
+            if (pendingCoprocs->is_closed())
+            {
+                break;
+            }
+            continue;
+        }
+
         // It is VERY IMPORTANT that we instantiate a new ptr_t just before
         // the pop_wait_for() call below. When this ptr_t was declared at
         // function scope (outside the for loop), NickyD correctly diagnosed a
@@ -449,6 +557,11 @@ void LLCoprocedurePool::coprocedureInvokerCoro(
 
         LL_DEBUGS("CoProcMgr") << "Dequeued and invoking coprocedure(" << coproc->mName << ") with id=" << coproc->mId.asString() << " in pool \"" << mPoolName << "\" (" << mPending << " left)" << LL_ENDL;
 
+        const bool saturated(mActiveCoprocsCount >= mLimiter.getLimit());
+        const U32 completed_before(httpAdapter->getCompletedCount());
+        const U32 throttled_before(httpAdapter->getThrottledCount());
+        const F64 started(LLTimer::getTotalSeconds());
+
         try
         {
             coproc->mProc(httpAdapter, coproc->mId);
@@ -472,11 +585,114 @@ void LLCoprocedurePool::coprocedureInvokerCoro(
         // Nicky: This is super spammy. Consider using LL_DEBUGS here?
         LL_DEBUGS("CoProcMgr") << "Finished coprocedure(" << coproc->mName << ")" << " in pool \"" << mPoolName << "\"" << LL_ENDL;
 
+        recordCompletion(httpAdapter, completed_before, throttled_before, started, saturated);
         mActiveCoprocsCount--;
     }
 }
 
+void LLCoprocedurePool::recordCompletion(const LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t &httpAdapter,
+                                         U32 completed_before, U32 throttled_before, F64 started, bool saturated)
+{
+    // Coprocedures that didn't go to the network say nothing
+    // about the server's health.
+    const U32 completed(httpAdapter->getCompletedCount() - completed_before);
+    if (!completed)
+    {
+        return;
+    }
+
+    const bool throttled(httpAdapter->getThrottledCount() != throttled_before);
+    const F64 latency((LLTimer::getTotalSeconds() - started) / completed);
+    const U32 old_limit(mLimiter.getLimit());
+
+    if (throttled)
+    {
+        add(sThrottledCoprocs, 1);
+    }
+
+    if (mLimiter.recordCompletion(latency, throttled, saturated))
+    {
+        LL_DEBUGS("CoProcMgr") << "Pool \"" << mPoolName << "\" limit " << old_limit << " -> " << mLimiter.getLimit()
+                               << " (latency " << mLimiter.getLatency() << "s, baseline " << mLimiter.getBaselineLatency()
+                               << "s" << (throttled ? ", throttled" : "") << ")" << LL_ENDL;
+        if (mLimiter.getLimit() > old_limit)
+        {
+            mLimitCondition.notify_all();
+        }
+    }
+
+    if (mLimitStat)
+    {
+        sample(*mLimitStat, mLimiter.getLimit());
+        sample(*mLatencyStat, F64Seconds(mLimiter.getLatency()));
+    }
+}
+
 void LLCoprocedurePool::close()
 {
     mPendingCoprocs->close();
+    mLimitCondition.notify_all();
+}
+
+//=========================================================================
+const F64 LLCoprocedureLimiter::LATENCY_SMOOTHING = 0.2;
+const F64 LLCoprocedureLimiter::BASELINE_DRIFT = 0.01;
+const F64 LLCoprocedureLimiter::LATENCY_TOLERANCE = 2.0;
+const F64 LLCoprocedureLimiter::THROTTLE_BACKOFF = 0.5;
+const F64 LLCoprocedureLimiter::LATENCY_BACKOFF = 0.75;
+
+LLCoprocedureLimiter::LLCoprocedureLimiter(U32 initial, U32 min_limit, U32 max_limit):
+    mLimit(llclamp(initial, min_limit, max_limit)),
+    mMinLimit(min_limit),
+    mMaxLimit(max_limit),
+    mLatency(0.0),
+    mBaseline(0.0),
+    mGrowth(0.0),
+    mSinceDecrease(mLimit),
+    mThrottled(0)
+{
+}
+
+bool LLCoprocedureLimiter::recordCompletion(F64 latency, bool throttled, bool saturated)
+{
+    mLatency = (mLatency <= 0.0) ? latency : mLatency + LATENCY_SMOOTHING * (latency - mLatency);
+
+    // Baseline follows improvements at once and degradations slowly so
+    // that a grid that is simply slower today doesn't pin us down forever.
+    mBaseline = (mBaseline <= 0.0 || mLatency < mBaseline) ? mLatency : mBaseline + BASELINE_DRIFT * (mLatency - mBaseline);
+
+    ++mSinceDecrease;
+    if (throttled)
+    {
+        ++mThrottled;
+        return decrease(THROTTLE_BACKOFF);
+    }
+    if (mLatency > mBaseline * LATENCY_TOLERANCE)
+    {
+        return decrease(LATENCY_BACKOFF);
+    }
+    if (saturated && mLimit < mMaxLimit)
+    {
+        mGrowth += 1.0 / mLimit;
+        if (mGrowth >= 1.0)
+        {
+            mGrowth = 0.0;
+            ++mLimit;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool LLCoprocedureLimiter::decrease(F64 factor)
+{
+    if (mSinceDecrease < mLimit || mLimit <= mMinLimit)
+    {
+        return false;
+    }
+
+    mLimit = llmax(mMinLimit, static_cast<U32>(mLimit * factor));
+    mSinceDecrease = 0;
+    mGrowth = 0.0;
+    return true;
 }
@@ -32,9 +32,57 @@
 #include "llcoros.h"
 #include "llcorehttputil.h"
 #include "lluuid.h"
+#include <vector>
 
 class LLCoprocedurePool;
 
+/// Additive-increase/multiplicative-decrease controller for the number
+/// of coprocedures a pool runs at once.  It is fed one sample for each
+/// completed coprocedure that made HTTP requests:
+/// - a throttled completion (503, 429 and the like) halves the limit,
+/// - smoothed latency rising well above the best recently seen trims it,
+/// - otherwise, while the pool is saturated, the limit grows by one for
+///   each limit's worth of completions.
+/// Decreases are applied at most once per window of that size so that a
+/// burst of failures from requests already in flight doesn't collapse
+/// the pool to its minimum.
+class LLCoprocedureLimiter
+{
+public:
+    LLCoprocedureLimiter(U32 initial, U32 min_limit, U32 max_limit);
+
+    /// @param latency   Seconds per request for the completed coprocedure.
+    /// @param throttled True if the server or transport reported overload.
+    /// @param saturated True if the pool was running at its limit.
+    /// @return          True if the limit changed.
+    bool recordCompletion(F64 latency, bool throttled, bool saturated);
+
+    U32 getLimit() const            { return mLimit; }
+    U32 getMinLimit() const         { return mMinLimit; }
+    U32 getMaxLimit() const         { return mMaxLimit; }
+    F64 getLatency() const          { return mLatency; }
+    F64 getBaselineLatency() const  { return mBaseline; }
+    U32 getThrottledCount() const   { return mThrottled; }
+
+    static const F64 LATENCY_SMOOTHING;
+    static const F64 BASELINE_DRIFT;
+    static const F64 LATENCY_TOLERANCE;
+    static const F64 THROTTLE_BACKOFF;
+    static const F64 LATENCY_BACKOFF;
+
+private:
+    bool decrease(F64 factor);
+
+    U32 mLimit;
+    U32 mMinLimit;
+    U32 mMaxLimit;
+    F64 mLatency;           // Smoothed, zero until the first sample
+    F64 mBaseline;          // Lowest smoothed latency, drifting upward
+    F64 mGrowth;            // Fractional additive-increase credit
+    U32 mSinceDecrease;
+    U32 mThrottled;
+};
+
 class LLCoprocedureManager : public LLSingleton < LLCoprocedureManager >
 {
     LLSINGLETON(LLCoprocedureManager);
@@ -81,12 +129,24 @@ public:
 
     void initializePool(const std::string &poolName);
 
+    /// Returns the adaptive concurrency limit of a pool, zero if unknown.
+    U32 getLimit(const std::string &pool) const;
+
+    /// Adaptive pools reporting to the statistics floater, in creation
+    /// order.  The pool at index n samples "coproc_limit_<n>" and
+    /// "coproc_latency_<n>".
+    const std::vector<std::string> &getGaugedPools() const
+    {
+        return mGaugedPools;
+    }
+
 private:
 
     typedef std::shared_ptr<LLCoprocedurePool> poolPtr_t;
     typedef std::map<std::string, poolPtr_t> poolMap_t;
 
     poolMap_t mPoolMap;
+    std::vector<std::string> mGaugedPools;
 
     SettingQuery_t mPropertyQueryFn;
     SettingUpdate_t mPropertyDefineFn;
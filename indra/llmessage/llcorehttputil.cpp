@@ -32,6 +32,7 @@
 #include <iterator>
 #include "llcorehttputil.h"
 #include "llhttpconstants.h"
+#include "llhttpresponsecache.h"
 #include "llsd.h"
 #include "llsdjson.h"
 #include "llsdserialize.h"
@@ -256,8 +257,6 @@ HttpCoroHandler::HttpCoroHandler(LLEventStream &reply) :
 
 void HttpCoroHandler::onCompleted(LLCore::HttpHandle handle, LLCore::HttpResponse * response)
 {
-    LLSD result;
-
     LLCore::HttpStatus status = response->getStatus();
 
     if (status == LLCore::HttpStatus(LLCore::HttpStatus::LLCORE, LLCore::HE_HANDLE_NOT_FOUND))
@@ -266,6 +265,36 @@ void HttpCoroHandler::onCompleted(LLCore::HttpHandle handle, LLCore::HttpRespons
         return;
     }
 
+    if (!mCacheKey.empty() && HttpResponseCache::instanceExists())
+    {
+        HttpResponseCache &cache(HttpResponseCache::instance());
+        if (status.getType() == HTTP_NOT_MODIFIED)
+        {
+            cache.refreshResponse(mCacheKey, response);
+            LLCore::HttpResponse *cached = cache.loadResponse(mCacheKey);
+            if (cached)
+            {
+                cached->setRequestURL(response->getRequestURL());
+                mReplyPump.post(buildResult(cached));
+                cached->release();
+                return;
+            }
+        }
+        else if (status)
+        {
+            cache.storeResponse(mCacheKey, response);
+        }
+    }
+
+    mReplyPump.post(buildResult(response));
+}
+
+LLSD HttpCoroHandler::buildResult(LLCore::HttpResponse * response)
+{
+    LLSD result;
+
+    LLCore::HttpStatus status = response->getStatus();
+
     if (!status)
     {
         bool parseSuccess(false);
@@ -318,7 +347,7 @@ void HttpCoroHandler::onCompleted(LLCore::HttpHandle handle, LLCore::HttpRespons
         }
     }
 
-    mReplyPump.post(result);
+    return result;
 }
 
 void HttpCoroHandler::buildStatusEntry(LLCore::HttpResponse *response, LLCore::HttpStatus status, LLSD &result)
@@ -662,6 +691,7 @@ HttpCoroutineAdapter::HttpCoroutineAdapter(const std::string &name,
     LLCore::HttpRequest::policy_t policyId) :
     mAdapterName(name),
     mPolicyId(policyId),
+    mResponseCaching(false),
     mYieldingHandle(LLCORE_HTTP_HANDLE_INVALID),
     mWeakRequest(),
     mWeakHandler()
@@ -706,6 +736,7 @@ LLSD HttpCoroutineAdapter::postAndSuspend_(LLCore::HttpRequest::ptr_t &request,
     saveState(hhandle, request, handler);
     LLSD results = llcoro::suspendUntilEventOn(handler->getReplyPump());
     cleanState();
+    recordResults(results);
 
     return results;
 }
@@ -829,6 +860,7 @@ LLSD HttpCoroutineAdapter::postAndSuspend_(LLCore::HttpRequest::ptr_t &request,
     saveState(hhandle, request, handler);
     LLSD results = llcoro::suspendUntilEventOn(handler->getReplyPump());
     cleanState();
+    recordResults(results);
 
     return results;
 }
@@ -887,6 +919,7 @@ LLSD HttpCoroutineAdapter::putAndSuspend_(LLCore::HttpRequest::ptr_t &request,
     saveState(hhandle, request, handler);
     LLSD results = llcoro::suspendUntilEventOn(handler->getReplyPump());
     cleanState();
+    recordResults(results);
 
     return results;
 }
@@ -913,6 +946,7 @@ LLSD HttpCoroutineAdapter::putAndSuspend_(LLCore::HttpRequest::ptr_t &request,
     saveState(hhandle, request, handler);
     LLSD results = llcoro::suspendUntilEventOn(handler->getReplyPump());
     cleanState();
+    recordResults(results);
 
     return results;
 }
@@ -956,19 +990,65 @@ LLSD HttpCoroutineAdapter::getAndSuspend_(LLCore::HttpRequest::ptr_t &request,
     HttpRequestPumper pumper(request);
     checkDefaultHeaders(headers);
 
-    // The HTTPCoroHandler does not self delete, so retrieval of a the contained
-    // pointer from the smart pointer is safe in this case.
-    LLCore::HttpHandle hhandle = request->requestGet(mPolicyId,
-        url, options, headers, handler);
-
-    if (hhandle == LLCORE_HTTP_HANDLE_INVALID)
+    std::string cache_key;
+    LLCore::HttpHeaders::ptr_t request_headers(headers);
+    if (mResponseCaching && HttpResponseCache::instanceExists())
     {
-        return HttpCoroutineAdapter::buildImmediateErrorResult(request, url);
+        HttpResponseCache &cache(HttpResponseCache::instance());
+        cache_key = HttpResponseCache::makeKey(url);
+
+        LLCore::HttpResponse *cached = cache.loadFreshResponse(cache_key);
+        if (cached)
+        {
+            cached->setRequestURL(url);
+            LLSD results = handler->buildResult(cached);
+            cached->release();
+            return results;
+        }
+
+        // Cache-Control, ETag and Last-Modified are needed to store
+        // the response.  Options may be shared so change a copy.
+        if (!options || !options->getWantHeaders())
+        {
+            options = LLCore::HttpOptions::ptr_t(options ? new LLCore::HttpOptions(*options)
+                                                         : new LLCore::HttpOptions());
+            options->setWantHeaders(true);
+        }
+
+        request_headers = cache.addValidators(cache_key, headers);
+        handler->setCacheKey(cache_key);
     }
 
-    saveState(hhandle, request, handler);
-    LLSD results = llcoro::suspendUntilEventOn(handler->getReplyPump());
-    cleanState();
+    LLSD results;
+    while (true)
+    {
+        // The HTTPCoroHandler does not self delete, so retrieval of a the contained
+        // pointer from the smart pointer is safe in this case.
+        LLCore::HttpHandle hhandle = request->requestGet(mPolicyId,
+            url, options, request_headers, handler);
+
+        if (hhandle == LLCORE_HTTP_HANDLE_INVALID)
+        {
+            return HttpCoroutineAdapter::buildImmediateErrorResult(request, url);
+        }
+
+        saveState(hhandle, request, handler);
+        results = llcoro::suspendUntilEventOn(handler->getReplyPump());
+        cleanState();
+
+        // A 304 for an entry evicted while the request was in flight
+        // leaves nothing to answer with.  Ask again unconditionally.
+        if (!cache_key.empty() && request_headers != headers
+            && getStatusFromLLSD(results[HttpCoroutineAdapter::HTTP_RESULTS]).getType() == HTTP_NOT_MODIFIED)
+        {
+            LL_DEBUGS("CoreHTTP") << "Cache entry for " << cache_key
+                                  << " evicted during revalidation, refetching" << LL_ENDL;
+            request_headers = headers;
+            continue;
+        }
+        break;
+    }
+    recordResults(results);
 
     return results;
 }
@@ -1015,6 +1095,7 @@ LLSD HttpCoroutineAdapter::deleteAndSuspend_(LLCore::HttpRequest::ptr_t &request
     saveState(hhandle, request, handler);
     LLSD results = llcoro::suspendUntilEventOn(handler->getReplyPump());
     cleanState();
+    recordResults(results);
 
     return results;
 }
@@ -1053,6 +1134,7 @@ LLSD HttpCoroutineAdapter::patchAndSuspend_(LLCore::HttpRequest::ptr_t &request,
     saveState(hhandle, request, handler);
     LLSD results = llcoro::suspendUntilEventOn(handler->getReplyPump());
     cleanState();
+    recordResults(results);
 
     return results;
 }
@@ -1095,6 +1177,7 @@ LLSD HttpCoroutineAdapter::copyAndSuspend_(LLCore::HttpRequest::ptr_t &request,
     saveState(hhandle, request, handler);
     LLSD results = llcoro::suspendUntilEventOn(handler->getReplyPump());
     cleanState();
+    recordResults(results);
 
     return results;
 }
@@ -1137,6 +1220,7 @@ LLSD HttpCoroutineAdapter::moveAndSuspend_(LLCore::HttpRequest::ptr_t &request,
     saveState(hhandle, request, handler);
     LLSD results = llcoro::suspendUntilEventOn(handler->getReplyPump());
     cleanState();
+    recordResults(results);
 
     return results;
 }
@@ -1189,6 +1273,24 @@ void HttpCoroutineAdapter::cleanState()
     mYieldingHandle = LLCORE_HTTP_HANDLE_INVALID;
 }
 
+void HttpCoroutineAdapter::recordResults(const LLSD &results)
+{
+    static const LLCore::HttpStatus unavailable(HTTP_SERVICE_UNAVAILABLE);
+    static const LLCore::HttpStatus too_many(429);
+    static const LLCore::HttpStatus bad_gateway(HTTP_BAD_GATEWAY);
+    static const LLCore::HttpStatus gateway_timeout(HTTP_GATEWAY_TIME_OUT);
+
+    LLCore::HttpStatus status = getStatusFromLLSD(results[HttpCoroutineAdapter::HTTP_RESULTS]);
+
+    // Retryable transport failures are timeouts, resets and the like.
+    ++mCompletedCount;
+    if (status == unavailable || status == too_many || status == bad_gateway ||
+        status == gateway_timeout || (!status.isHttpStatus() && status.isRetryable()))
+    {
+        ++mThrottledCount;
+    }
+}
+
 /*static*/
 LLSD HttpCoroutineAdapter::buildImmediateErrorResult(const LLCore::HttpRequest::ptr_t &request,
     const std::string &url)
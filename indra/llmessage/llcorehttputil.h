@@ -272,11 +272,21 @@ public:
 
     virtual void onCompleted(LLCore::HttpHandle handle, LLCore::HttpResponse * response);
 
+    /// Build the LLSD that onCompleted() would post for this response.
+    LLSD buildResult(LLCore::HttpResponse * response);
+
     inline LLEventStream &getReplyPump()
     {
         return mReplyPump;
     }
 
+    /// Store successful responses in, and resolve 304 Not Modified
+    /// replies from, the HttpResponseCache under this key.
+    void setCacheKey(const std::string &key)
+    {
+        mCacheKey = key;
+    }
+
 protected:
     /// this method may modify the status value
     virtual LLSD handleSuccess(LLCore::HttpResponse * response, LLCore::HttpStatus &status) = 0;
@@ -286,6 +296,7 @@ private:
     void buildStatusEntry(LLCore::HttpResponse *response, LLCore::HttpStatus status, LLSD &result);
 
     LLEventStream &mReplyPump;
+    std::string mCacheKey;
 };
 
 //=========================================================================
@@ -323,6 +334,29 @@ public:
     HttpCoroutineAdapter(const std::string &name, LLCore::HttpRequest::policy_t policyId);
     ~HttpCoroutineAdapter();
 
+    /// Serve GET requests made through this adapter from the
+    /// HttpResponseCache when the server allows it, revalidating
+    /// stale entries with conditional requests.  Response headers
+    /// are requested whatever the options passed say.
+    void setResponseCaching(bool enable)
+    {
+        mResponseCaching = enable;
+    }
+
+    /// Number of requests that have completed through this adapter and
+    /// how many of those indicated the server or network was overloaded
+    /// (503, 429, gateway errors and transport timeouts).  Used by the
+    /// coprocedure pools to size themselves.
+    U32 getCompletedCount() const
+    {
+        return mCompletedCount;
+    }
+
+    U32 getThrottledCount() const
+    {
+        return mThrottledCount;
+    }
+
     /// Execute a Post transaction on the supplied URL and yield execution of
     /// the coroutine until a result is available.
     ///
@@ -616,6 +650,7 @@ private:
     void saveState(LLCore::HttpHandle yieldingHandle, LLCore::HttpRequest::ptr_t &request,
             HttpCoroHandler::ptr_t &handler);
     void cleanState();
+    void recordResults(const LLSD &results);
 
     LLSD postAndSuspend_(LLCore::HttpRequest::ptr_t &request,
         const std::string & url, const LLSD & body,
@@ -668,6 +703,9 @@ private:
 
     std::string                     mAdapterName;
     LLCore::HttpRequest::policy_t   mPolicyId;
+    bool                            mResponseCaching;
+    U32                             mCompletedCount = 0;
+    U32                             mThrottledCount = 0;
 
     LLCore::HttpHandle              mYieldingHandle;
     LLCore::HttpRequest::wptr_t     mWeakRequest;
@@ -256,6 +256,7 @@ void LLExperienceCache::requestExperiencesCoro(LLCoreHttpUtil::HttpCoroutineAdap
 
     //LL_INFOS("requestExperiencesCoro") << "url: " << url << LL_ENDL;
 
+    httpAdapter->setResponseCaching(true);
     LLSD result = httpAdapter->getAndSuspend(httpRequest, url);
 
     LLSD httpResults = result[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS];
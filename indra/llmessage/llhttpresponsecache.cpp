@@ -0,0 +1,526 @@
+/**
+ * @file llhttpresponsecache.cpp
+ * @brief On-disk cache of HTTP GET responses with conditional revalidation
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "llhttpresponsecache.h"
+
+#include <sstream>
+
+#include "bufferarray.h"
+#include "httpresponse.h"
+#include "lldir.h"
+#include "llfile.h"
+#include "llhttpconstants.h"
+#include "llmd5.h"
+#include "llsd.h"
+#include "llsdserialize.h"
+#include "lldate.h"
+#include "llstring.h"
+
+namespace LLCoreHttpUtil
+{
+
+namespace
+{
+    const std::string CACHE_INDEX_FILE("index.llsd");
+    const std::string CACHE_ENTRY_EXT(".resp");
+    const std::string CAP_SEGMENT("/cap/");
+
+    // Largest single response kept, as a fraction of the budget
+    const U64 MAX_ENTRY_FRACTION = 8;
+}
+
+HttpResponseCache::HttpResponseCache(const std::string &dir, U64 max_bytes) :
+    mDir(dir),
+    mMaxBytes(max_bytes),
+    mSizeBytes(0),
+    mHits(0),
+    mRevalidated(0),
+    mStored(0)
+{
+    LLFile::mkdir(mDir);
+    loadIndex();
+}
+
+HttpResponseCache::~HttpResponseCache()
+{
+    LL_INFOS("CoreHTTP") << "HTTP response cache:  " << mEntries.size() << " entries, "
+                         << mSizeBytes << " bytes, " << mHits << " fresh hits, "
+                         << mRevalidated << " revalidated, " << mStored << " stored" << LL_ENDL;
+    saveIndex();
+}
+
+//static
+std::string HttpResponseCache::makeKey(const std::string &url)
+{
+    // Capability URLs carry a per-session UUID,
+    // e.g. https://host:12043/cap/<uuid>/foo?bar
+    std::string key(url);
+    std::string::size_type pos = key.find(CAP_SEGMENT);
+    if (pos != std::string::npos)
+    {
+        pos += CAP_SEGMENT.size();
+        std::string::size_type end = key.find_first_of("/?", pos);
+        key.replace(pos, (end == std::string::npos ? key.size() : end) - pos, "*");
+    }
+    return key;
+}
+
+//static
+bool HttpResponseCache::parseCacheControl(const std::string &value, S32 &max_age)
+{
+    max_age = -1;
+
+    std::string directives(value);
+    LLStringUtil::toLower(directives);
+
+    bool no_cache(false);
+    std::istringstream stream(directives);
+    std::string token;
+    while (std::getline(stream, token, ','))
+    {
+        LLStringUtil::trim(token);
+        if (token == "no-store")
+        {
+            return false;
+        }
+        else if (token == "no-cache")
+        {
+            no_cache = true;
+        }
+        else if (token.compare(0, 8, "max-age=") == 0)
+        {
+            S32 seconds(0);
+            if (LLStringUtil::convertToS32(token.substr(8), seconds))
+            {
+                max_age = llmax(seconds, 0);
+            }
+        }
+    }
+
+    if (no_cache)
+    {
+        max_age = 0;
+    }
+    return true;
+}
+
+//static
+bool HttpResponseCache::getExpiry(const LLCore::HttpHeaders::ptr_t &headers, F64 now, F64 &expires,
+                                  std::string &etag, std::string &last_modified)
+{
+    if (!headers)
+    {
+        return false;
+    }
+
+    S32 max_age(-1);
+    const std::string *cache_control = headers->find(HTTP_IN_HEADER_CACHE_CONTROL);
+    if (cache_control && !parseCacheControl(*cache_control, max_age))
+    {
+        return false;
+    }
+
+    // Only a bare Accept-Encoding variance is safe to ignore
+    const std::string *vary = headers->find(HTTP_IN_HEADER_VARY);
+    if (vary && LLStringUtil::compareInsensitive(*vary, HTTP_OUT_HEADER_ACCEPT_ENCODING) != 0)
+    {
+        return false;
+    }
+
+    const std::string *tag = headers->find(HTTP_IN_HEADER_ETAG);
+    const std::string *modified = headers->find(HTTP_IN_HEADER_LAST_MODIFIED);
+    etag = tag ? *tag : std::string();
+    last_modified = modified ? *modified : std::string();
+
+    // Expires: is not consulted.  Without a max-age a response is
+    // only worth keeping if it can be revalidated.
+    if (max_age < 0)
+    {
+        if (etag.empty() && last_modified.empty())
+        {
+            return false;
+        }
+        max_age = 0;
+    }
+
+    expires = now + max_age;
+    return max_age > 0 || !etag.empty() || !last_modified.empty();
+}
+
+std::string HttpResponseCache::getFilename(const std::string &key) const
+{
+    LLMD5 md5(reinterpret_cast<const unsigned char *>(key.c_str()));
+    char digest[33];
+    md5.hex_digest(digest);
+
+    return mDir + gDirUtilp->getDirDelimiter() + digest + CACHE_ENTRY_EXT;
+}
+
+void HttpResponseCache::touch(Entry &entry, const std::string &key)
+{
+    mLRUList.erase(entry.mLRU);
+    entry.mLRU = mLRUList.insert(mLRUList.end(), key);
+}
+
+void HttpResponseCache::eraseEntry(entry_map_t::iterator it)
+{
+    LLFile::remove(getFilename(it->first), ENOENT);
+    mSizeBytes -= llmin(mSizeBytes, it->second.mSize);
+    mLRUList.erase(it->second.mLRU);
+    mEntries.erase(it);
+}
+
+void HttpResponseCache::evict()
+{
+    while (mSizeBytes > mMaxBytes && !mLRUList.empty())
+    {
+        eraseEntry(mEntries.find(mLRUList.front()));
+    }
+}
+
+bool HttpResponseCache::isFresh(const std::string &key)
+{
+    LLMutexLock lock(&mMutex);
+
+    entry_map_t::iterator it = mEntries.find(key);
+    return it != mEntries.end() && LLDate::now().secondsSinceEpoch() < it->second.mExpires;
+}
+
+LLCore::HttpHeaders::ptr_t HttpResponseCache::addValidators(const std::string &key,
+                                                            const LLCore::HttpHeaders::ptr_t &headers)
+{
+    LLMutexLock lock(&mMutex);
+
+    entry_map_t::iterator it = mEntries.find(key);
+    if (it == mEntries.end())
+    {
+        return headers;
+    }
+
+    // Callers may share header objects between requests so
+    // never add the validators to theirs.
+    LLCore::HttpHeaders::ptr_t result(new LLCore::HttpHeaders);
+    if (headers)
+    {
+        for (LLCore::HttpHeaders::const_iterator hdr = headers->begin(); hdr != headers->end(); ++hdr)
+        {
+            result->append(hdr->first, hdr->second);
+        }
+    }
+    if (!it->second.mETag.empty())
+    {
+        result->append(HTTP_OUT_HEADER_IF_NONE_MATCH, it->second.mETag);
+    }
+    if (!it->second.mLastModified.empty())
+    {
+        result->append(HTTP_OUT_HEADER_IF_MODIFIED_SINCE, it->second.mLastModified);
+    }
+    return result;
+}
+
+LLCore::HttpResponse * HttpResponseCache::loadResponse(const std::string &key)
+{
+    LLMutexLock lock(&mMutex);
+
+    entry_map_t::iterator it = mEntries.find(key);
+    if (it == mEntries.end())
+    {
+        return NULL;
+    }
+    return loadEntry(it, key);
+}
+
+LLCore::HttpResponse * HttpResponseCache::loadFreshResponse(const std::string &key)
+{
+    LLMutexLock lock(&mMutex);
+
+    entry_map_t::iterator it = mEntries.find(key);
+    if (it == mEntries.end() || LLDate::now().secondsSinceEpoch() >= it->second.mExpires)
+    {
+        return NULL;
+    }
+
+    LLCore::HttpResponse *response = loadEntry(it, key);
+    if (response)
+    {
+        ++mHits;
+    }
+    return response;
+}
+
+// Caller holds mMutex.
+LLCore::HttpResponse * HttpResponseCache::loadEntry(entry_map_t::iterator it, const std::string &key)
+{
+    LLSD stored;
+    llifstream file(getFilename(key).c_str(), std::ios::in | std::ios::binary);
+    if (!file.is_open()
+        || LLSDSerialize::fromBinary(stored, file, it->second.mSize) <= 0
+        || stored["key"].asString() != key)
+    {
+        LL_DEBUGS("CoreHTTP") << "Dropping unreadable cache entry for " << key << LL_ENDL;
+        file.close();
+        eraseEntry(it);
+        return NULL;
+    }
+    touch(it->second, key);
+
+    LLCore::HttpHeaders::ptr_t headers(new LLCore::HttpHeaders);
+    const LLSD &stored_headers = stored["headers"];
+    for (LLSD::array_const_iterator hdr = stored_headers.beginArray(); hdr != stored_headers.endArray(); ++hdr)
+    {
+        headers->append((*hdr)[0].asString(), (*hdr)[1].asString());
+    }
+
+    const LLSD::Binary &data = stored["body"].asBinary();
+    LLCore::BufferArray *body = new LLCore::BufferArray;
+    if (!data.empty())
+    {
+        body->append(&data[0], data.size());
+    }
+
+    LLCore::HttpResponse *response = new LLCore::HttpResponse;
+    response->setStatus(LLCore::HttpStatus(HTTP_OK));
+    response->setBody(body);
+    response->setHeaders(headers);
+    response->setContentType(stored["content_type"].asString());
+    response->setRequestURL(stored["url"].asString());
+    response->setRequestMethod(HTTP_VERB_GET);
+    body->release();
+
+    return response;
+}
+
+void HttpResponseCache::storeResponse(const std::string &key, LLCore::HttpResponse *response)
+{
+    const F64 now(LLDate::now().secondsSinceEpoch());
+    LLCore::HttpHeaders::ptr_t headers(response->getHeaders());
+
+    Entry entry;
+    if (response->getStatus().getType() != HTTP_OK
+        || !getExpiry(headers, now, entry.mExpires, entry.mETag, entry.mLastModified))
+    {
+        removeResponse(key);
+        return;
+    }
+
+    LLSD stored;
+    stored["key"] = key;
+    stored["url"] = response->getRequestURL();
+    stored["content_type"] = response->getContentType();
+    LLSD &stored_headers = stored["headers"] = LLSD::emptyArray();
+    for (LLCore::HttpHeaders::const_iterator hdr = headers->begin(); hdr != headers->end(); ++hdr)
+    {
+        LLSD pair = LLSD::emptyArray();
+        pair.append(hdr->first);
+        pair.append(hdr->second);
+        stored_headers.append(pair);
+    }
+
+    LLSD::Binary data(response->getBodySize());
+    if (!data.empty())
+    {
+        response->getBody()->read(0, &data[0], data.size());
+    }
+    stored["body"] = data;
+
+    std::ostringstream serialized;
+    LLSDSerialize::toBinary(stored, serialized);
+    const std::string &bytes = serialized.str();
+    entry.mSize = bytes.size();
+    if (entry.mSize > mMaxBytes / MAX_ENTRY_FRACTION)
+    {
+        removeResponse(key);
+        return;
+    }
+
+    LLMutexLock lock(&mMutex);
+
+    llofstream file(getFilename(key).c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open() || !file.write(bytes.data(), bytes.size()))
+    {
+        LL_WARNS("CoreHTTP") << "Unable to write cache entry for " << key << LL_ENDL;
+        return;
+    }
+
+    entry_map_t::iterator it = mEntries.find(key);
+    if (it != mEntries.end())
+    {
+        mSizeBytes -= llmin(mSizeBytes, it->second.mSize);
+        mLRUList.erase(it->second.mLRU);
+        mEntries.erase(it);
+    }
+    entry.mLRU = mLRUList.insert(mLRUList.end(), key);
+    mEntries[key] = entry;
+    mSizeBytes += entry.mSize;
+    ++mStored;
+
+    evict();
+}
+
+void HttpResponseCache::refreshResponse(const std::string &key, LLCore::HttpResponse *response)
+{
+    LLMutexLock lock(&mMutex);
+
+    entry_map_t::iterator it = mEntries.find(key);
+    if (it == mEntries.end())
+    {
+        return;
+    }
+
+    // A 304 may update validators and lifetime but only the ones it
+    // carries.  Keep the stored values for anything left out and
+    // revalidate again next time if it grants no lifetime.
+    const F64 now(LLDate::now().secondsSinceEpoch());
+    F64 expires(now);
+    std::string etag, last_modified;
+    getExpiry(response->getHeaders(), now, expires, etag, last_modified);
+
+    Entry &entry = it->second;
+    entry.mExpires = expires;
+    if (!etag.empty())
+    {
+        entry.mETag = etag;
+    }
+    if (!last_modified.empty())
+    {
+        entry.mLastModified = last_modified;
+    }
+    touch(entry, key);
+    ++mRevalidated;
+}
+
+U64 HttpResponseCache::getSizeBytes() const
+{
+    LLMutexLock lock(&mMutex);
+    return mSizeBytes;
+}
+
+U32 HttpResponseCache::getEntryCount() const
+{
+    LLMutexLock lock(&mMutex);
+    return static_cast<U32>(mEntries.size());
+}
+
+U32 HttpResponseCache::getHitCount() const
+{
+    LLMutexLock lock(&mMutex);
+    return mHits;
+}
+
+U32 HttpResponseCache::getRevalidatedCount() const
+{
+    LLMutexLock lock(&mMutex);
+    return mRevalidated;
+}
+
+U32 HttpResponseCache::getStoredCount() const
+{
+    LLMutexLock lock(&mMutex);
+    return mStored;
+}
+
+void HttpResponseCache::removeResponse(const std::string &key)
+{
+    LLMutexLock lock(&mMutex);
+
+    entry_map_t::iterator it = mEntries.find(key);
+    if (it != mEntries.end())
+    {
+        eraseEntry(it);
+    }
+}
+
+void HttpResponseCache::clear()
+{
+    LLMutexLock lock(&mMutex);
+
+    while (!mEntries.empty())
+    {
+        eraseEntry(mEntries.begin());
+    }
+}
+
+void HttpResponseCache::loadIndex()
+{
+    LLSD index;
+    llifstream file((mDir + gDirUtilp->getDirDelimiter() + CACHE_INDEX_FILE).c_str(), std::ios::in | std::ios::binary);
+    if (file.is_open())
+    {
+        LLSDSerialize::fromBinary(index, file, LLSDSerialize::SIZE_UNLIMITED);
+    }
+
+    // Index is written least recently used first
+    for (LLSD::array_const_iterator it = index.beginArray(); it != index.endArray(); ++it)
+    {
+        const std::string key = (*it)["key"].asString();
+        if (key.empty() || mEntries.count(key) || !LLFile::isfile(getFilename(key)))
+        {
+            continue;
+        }
+
+        Entry entry;
+        entry.mETag = (*it)["etag"].asString();
+        entry.mLastModified = (*it)["last_modified"].asString();
+        entry.mExpires = (*it)["expires"].asReal();
+        entry.mSize = (*it)["size"].asInteger();
+        entry.mLRU = mLRUList.insert(mLRUList.end(), key);
+        mEntries[key] = entry;
+        mSizeBytes += entry.mSize;
+    }
+
+    // Budget may have shrunk since the last session
+    evict();
+}
+
+void HttpResponseCache::saveIndex()
+{
+    LLMutexLock lock(&mMutex);
+
+    LLSD index = LLSD::emptyArray();
+    for (std::list<std::string>::const_iterator it = mLRUList.begin(); it != mLRUList.end(); ++it)
+    {
+        const Entry &entry = mEntries[*it];
+
+        LLSD item;
+        item["key"] = *it;
+        item["etag"] = entry.mETag;
+        item["last_modified"] = entry.mLastModified;
+        item["expires"] = entry.mExpires;
+        item["size"] = LLSD::Integer(entry.mSize);
+        index.append(item);
+    }
+
+    llofstream file((mDir + gDirUtilp->getDirDelimiter() + CACHE_INDEX_FILE).c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if (file.is_open())
+    {
+        LLSDSerialize::toBinary(index, file);
+    }
+}
+
+} // end namespace LLCoreHttpUtil
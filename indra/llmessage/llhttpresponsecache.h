@@ -0,0 +1,148 @@
+/**
+ * @file llhttpresponsecache.h
+ * @brief On-disk cache of HTTP GET responses with conditional revalidation
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLHTTPRESPONSECACHE_H
+#define LL_LLHTTPRESPONSECACHE_H
+
+#include <list>
+#include <map>
+#include <string>
+
+#include "llsingleton.h"
+#include "llmutex.h"
+#include "httpheaders.h"
+
+namespace LLCore
+{
+class HttpResponse;
+}
+
+namespace LLCoreHttpUtil
+{
+
+/// A size-bounded, least-recently-used store of GET response bodies
+/// kept on disk between sessions.  Responses are stored only when
+/// the server permits it and gives us some way to reuse them:  a
+/// Cache-Control max-age for fresh hits or an ETag/Last-Modified
+/// validator for conditional requests.  'no-store' is honoured and
+/// 'no-cache' forces revalidation on every use.
+///
+/// Entries are keyed by URL with any capability segment
+/// ("/cap/<uuid>") collapsed, as capability URLs change from
+/// session to session while the resources behind them do not.
+///
+/// Call sites opt in through HttpCoroutineAdapter::setResponseCaching().
+/// The cache is inert until an instance has been created.
+///
+/// Threading:  all methods are thread-safe.
+class HttpResponseCache : public LLSimpleton<HttpResponseCache>
+{
+public:
+    HttpResponseCache(const std::string &dir, U64 max_bytes);
+    ~HttpResponseCache();
+
+    /// Build the cache key for a request URL.
+    static std::string makeKey(const std::string &url);
+
+    /// Interpret a Cache-Control header value.  Returns false if the
+    /// response may not be stored.  On return 'max_age' holds the
+    /// freshness lifetime in seconds, zero when the response must
+    /// be revalidated before each use and -1 when not specified.
+    static bool parseCacheControl(const std::string &value, S32 &max_age);
+
+    /// True if an entry exists and may be used without revalidation.
+    bool isFresh(const std::string &key);
+
+    /// Return headers to use for a revalidating request, a copy of
+    /// 'headers' with If-None-Match/If-Modified-Since added when an
+    /// entry is present, otherwise 'headers' itself.
+    LLCore::HttpHeaders::ptr_t addValidators(const std::string &key,
+                                             const LLCore::HttpHeaders::ptr_t &headers);
+
+    /// Build a synthetic 200 response from a stored entry.  Caller
+    /// receives a refcount on the returned response.  Returns NULL
+    /// on a miss or if the stored file is unreadable.
+    LLCore::HttpResponse * loadResponse(const std::string &key);
+
+    /// As loadResponse() but only for an entry that is still fresh,
+    /// counting the hit.  Returns NULL when the request must go to
+    /// the network.
+    LLCore::HttpResponse * loadFreshResponse(const std::string &key);
+
+    /// Store a successful response if its headers allow it.
+    void storeResponse(const std::string &key, LLCore::HttpResponse *response);
+
+    /// Update freshness and validators from a 304 Not Modified.
+    void refreshResponse(const std::string &key, LLCore::HttpResponse *response);
+
+    void removeResponse(const std::string &key);
+    void clear();
+
+    U64 getSizeBytes() const;
+    U32 getEntryCount() const;
+
+    U32 getHitCount() const;
+    U32 getRevalidatedCount() const;
+    U32 getStoredCount() const;
+
+private:
+    struct Entry
+    {
+        std::string     mETag;
+        std::string     mLastModified;
+        F64             mExpires;           // Seconds since epoch
+        U64             mSize;              // Bytes on disk
+        std::list<std::string>::iterator mLRU;
+    };
+    typedef std::map<std::string, Entry> entry_map_t;
+
+    std::string getFilename(const std::string &key) const;
+    LLCore::HttpResponse * loadEntry(entry_map_t::iterator it, const std::string &key);
+    void touch(Entry &entry, const std::string &key);
+    void eraseEntry(entry_map_t::iterator it);
+    void evict();
+    void loadIndex();
+    void saveIndex();
+
+    static bool getExpiry(const LLCore::HttpHeaders::ptr_t &headers, F64 now, F64 &expires,
+                          std::string &etag, std::string &last_modified);
+
+    std::string             mDir;
+    U64                     mMaxBytes;
+    U64                     mSizeBytes;
+    entry_map_t             mEntries;
+    std::list<std::string>  mLRUList;           // Front is least recently used
+    mutable LLMutex         mMutex;
+
+    U32                     mHits;
+    U32                     mRevalidated;
+    U32                     mStored;
+};
+
+} // end namespace LLCoreHttpUtil
+
+#endif // LL_LLHTTPRESPONSECACHE_H
@@ -623,7 +623,7 @@ bool LLMessageSystem::checkMessages(LockMessageChecker&, S64 frame_count )
                         cdp->collectRAck(mCurrentRecvPacketID);
                     }
 
-                    LL_DEBUGS("Messaging") << "Discarding duplicate resend from " << host << LL_ENDL;
+                    LL_DEBUGS_ARGS("Messaging", "Discarding duplicate resend from ", host);
                     if(mVerboseLog)
                     {
                         std::ostringstream str;
@@ -1612,7 +1612,7 @@ bool LLMessageSystem::checkCircuitBlocked(const U32 circuit)
 
     if (!host.isOk())
     {
-        LL_DEBUGS("Messaging") << "checkCircuitBlocked: Unknown circuit " << circuit << LL_ENDL;
+        LL_DEBUGS_ARGS("Messaging", "checkCircuitBlocked: Unknown circuit ", circuit);
         return true;
     }
 
@@ -1634,7 +1634,7 @@ bool LLMessageSystem::checkCircuitAlive(const U32 circuit)
 
     if (!host.isOk())
     {
-        LL_DEBUGS("Messaging") << "checkCircuitAlive: Unknown circuit " << circuit << LL_ENDL;
+        LL_DEBUGS_ARGS("Messaging", "checkCircuitAlive: Unknown circuit ", circuit);
         return false;
     }
 
@@ -1659,7 +1659,7 @@ bool LLMessageSystem::checkCircuitAlive(const LLHost &host)
     }
     else
     {
-        LL_DEBUGS("Messaging") << "checkCircuitAlive(host): Unknown host - " << host << LL_ENDL;
+        LL_DEBUGS_ARGS("Messaging", "checkCircuitAlive(host): Unknown host - ", host);
         return false;
     }
 }
@@ -2076,9 +2076,9 @@ void LLMessageSystem::dispatch(
         return;
     }
     // enable this for output of message names
-    LL_DEBUGS("Messaging") << "< \"" << msg_name << "\"" << LL_ENDL;
-    LL_DEBUGS("Messaging") << "context: " << context << LL_ENDL;
-    LL_DEBUGS("Messaging") << "message: " << message << LL_ENDL;
+    LL_DEBUGS_ARGS("Messaging", "< \"", msg_name, "\"");
+    LL_DEBUGS_ARGS("Messaging", "context: ", context);
+    LL_DEBUGS_ARGS("Messaging", "message: ", message);
 
     handler->post(responsep, context, message);
 }
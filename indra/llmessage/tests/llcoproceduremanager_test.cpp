@@ -68,6 +68,54 @@ LLCore::HttpRequest::~HttpRequest()
 {
 }
 
+namespace
+{
+    // Stand-in for a grid service: requests take a fixed time until the
+    // number in flight exceeds its capacity, after which each additional
+    // request adds another full service time (queueing).  Above
+    // throttle_at it answers with 503s.
+    struct StandInServer
+    {
+        StandInServer(F64 service_time, U32 capacity, U32 throttle_at):
+            mServiceTime(service_time),
+            mCapacity(capacity),
+            mThrottleAt(throttle_at)
+        {}
+
+        F64 latency(U32 in_flight) const
+        {
+            return (in_flight <= mCapacity) ? mServiceTime : mServiceTime * (1 + in_flight - mCapacity);
+        }
+
+        bool throttles(U32 in_flight) const
+        {
+            return in_flight > mThrottleAt;
+        }
+
+        // Drive a saturated pool against the server, returning the
+        // lowest and highest limit seen after the first 'settle' samples.
+        void run(LLCoprocedureLimiter &limiter, int samples, int settle, U32 &low, U32 &high) const
+        {
+            low = limiter.getMaxLimit();
+            high = 0;
+            for (int i = 0; i < samples; ++i)
+            {
+                U32 in_flight = limiter.getLimit();
+                limiter.recordCompletion(latency(in_flight), throttles(in_flight), true);
+                if (i >= settle)
+                {
+                    low = llmin(low, limiter.getLimit());
+                    high = llmax(high, limiter.getLimit());
+                }
+            }
+        }
+
+        F64 mServiceTime;
+        U32 mCapacity;
+        U32 mThrottleAt;
+    };
+}
+
 namespace tut
 {
     struct coproceduremanager_test
@@ -176,4 +224,88 @@ namespace tut
         LL_INFOS("CoMain") << "checking count" << LL_ENDL;
         ensure_equals("coprocedure failed to update counter", counter, 5);
     }
+
+    template<> template<>
+    void coproceduremanager_object_t::test<5>()
+    {
+        set_test_name("limiter grows to its maximum against a fast server");
+
+        StandInServer server(0.05, 100, 100);
+        LLCoprocedureLimiter limiter(4, 1, 16);
+        U32 low, high;
+
+        server.run(limiter, 500, 400, low, high);
+        ensure_equals("limit did not grow to maximum", limiter.getLimit(), 16U);
+        ensure_equals("limit was not stable", low, 16U);
+        ensure_equals("no throttling expected", limiter.getThrottledCount(), 0U);
+
+        // An idle pool must not grow.
+        LLCoprocedureLimiter idle(4, 1, 16);
+        for (int i = 0; i < 100; ++i)
+        {
+            idle.recordCompletion(0.05, false, false);
+        }
+        ensure_equals("unsaturated pool grew", idle.getLimit(), 4U);
+    }
+
+    template<> template<>
+    void coproceduremanager_object_t::test<6>()
+    {
+        set_test_name("limiter halves on 503s, once per window");
+
+        LLCoprocedureLimiter limiter(12, 1, 24);
+
+        // A burst from requests that were already in flight only
+        // counts once.
+        for (int i = 0; i < 5; ++i)
+        {
+            limiter.recordCompletion(0.1, true, true);
+        }
+        ensure_equals("burst not collapsed to one decrease", limiter.getLimit(), 6U);
+        ensure_equals("throttled completions", limiter.getThrottledCount(), 5U);
+
+        // Sustained throttling above 8 in flight keeps the pool near it.
+        StandInServer server(0.1, 100, 8);
+        LLCoprocedureLimiter busy(4, 1, 32);
+        U32 low, high;
+
+        server.run(busy, 2000, 500, low, high);
+        ensure("limit stayed well above throttle point", high <= 9);
+        ensure("limit collapsed", low >= 4);
+        ensure("server never throttled", busy.getThrottledCount() > 0);
+    }
+
+    template<> template<>
+    void coproceduremanager_object_t::test<7>()
+    {
+        set_test_name("limiter backs off on rising latency");
+
+        StandInServer server(0.1, 10, 1000);
+        LLCoprocedureLimiter limiter(4, 1, 32);
+        U32 low, high;
+
+        server.run(limiter, 2000, 500, low, high);
+        ensure("limit ran away past server capacity", high <= 12);
+        ensure("limit backed off too far", low >= 8);
+        ensure_equals("no throttling expected", limiter.getThrottledCount(), 0U);
+        ensure("baseline latency not learned", limiter.getBaselineLatency() < 0.2);
+    }
+
+    template<> template<>
+    void coproceduremanager_object_t::test<8>()
+    {
+        set_test_name("fixed pools never adapt");
+
+        LLCoprocedureLimiter limiter(1, 1, 1);
+
+        for (int i = 0; i < 50; ++i)
+        {
+            limiter.recordCompletion(0.01 * (i + 1), (i % 3) == 0, true);
+        }
+        ensure_equals("fixed pool changed", limiter.getLimit(), 1U);
+        ensure("latency not tracked", limiter.getLatency() > 0.0);
+
+        LLCoprocedureLimiter clamped(30, 2, 8);
+        ensure_equals("initial limit not clamped", clamped.getLimit(), 8U);
+    }
 }  // namespace tut
@@ -0,0 +1,171 @@
+/**
+ * @file llcoprocedurepool_test.cpp
+ * @brief Adaptive coprocedure pool integration test
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+
+#include "linden_common.h"
+
+#include "../llcoproceduremanager.h"
+
+#include "httpoptions.h"
+#include "httprequest.h"
+#include "llevents.h"
+#include "lltimer.h"
+
+#include "../test/lltut.h"
+
+namespace
+{
+    const std::string POOL_NAME("PoolTest");
+    const U32 POOL_SIZE = 4;
+    // Stays below llcorehttp's default connection limit, so that requests
+    // never queue in the transport and look like rising latency
+    const U32 POOL_SIZE_MAX = 6;
+
+    std::string get_base_url()
+    {
+        const char *port(getenv("PORT"));
+        tut::ensure("PORT set in environment; run under test_llcoprocedurepool_peer.py", port != NULL);
+        return llformat("http://127.0.0.1:%s/", port);
+    }
+
+    U32 query_pool_size(const std::string &name)
+    {
+        if (name == "PoolSize" + POOL_NAME)
+        {
+            return POOL_SIZE;
+        }
+        if (name == "PoolSizeMax" + POOL_NAME)
+        {
+            return POOL_SIZE_MAX;
+        }
+        return 0;
+    }
+}
+
+namespace tut
+{
+    struct coprocedurepool_test
+    {
+        coprocedurepool_test()
+        {
+            LLCore::LLHttp::initialize();
+            LLCore::HttpRequest::createService();
+            LLCore::HttpRequest::startThread();
+
+            LLCoprocedureManager &manager(LLCoprocedureManager::instance());
+            manager.setPropertyMethods(query_pool_size, LLCoprocedureManager::SettingUpdate_t());
+            manager.initializePool(POOL_NAME);
+        }
+
+        ~coprocedurepool_test()
+        {
+            LLCoprocedureManager::instance().close();
+
+            LLCore::HttpRequest request;
+            request.requestStopThread(LLCore::HttpHandler::ptr_t());
+            for (int i = 0; i < 20; ++i)
+            {
+                request.update(1000);
+                ms_sleep(50);
+            }
+            LLCore::HttpRequest::destroyService();
+            LLCore::LLHttp::cleanup();
+        }
+
+        // Queue 'count' coprocedures that GET 'path' once each, without
+        // retries so that every 503 reaches the pool.
+        void enqueue(const std::string &path, int count)
+        {
+            const std::string url(get_base_url() + path);
+            for (int i = 0; i < count; ++i)
+            {
+                LLCoprocedureManager::instance().enqueueCoprocedure(POOL_NAME, path,
+                    [this, url](LLCoreHttpUtil::HttpCoroutineAdapter::ptr_t &adapter, const LLUUID &)
+                    {
+                        LLCore::HttpRequest::ptr_t request(new LLCore::HttpRequest);
+                        LLCore::HttpOptions::ptr_t options(new LLCore::HttpOptions);
+                        options->setRetries(0);
+                        LLSD result = adapter->getRawAndSuspend(request, url, options);
+                        if (!LLCoreHttpUtil::HttpCoroutineAdapter::getStatusFromLLSD(
+                                result[LLCoreHttpUtil::HttpCoroutineAdapter::HTTP_RESULTS]))
+                        {
+                            ++mFailed;
+                        }
+                        ++mFinished;
+                    });
+            }
+        }
+
+        // Pump "mainloop", which drives the adapters' requests, until the
+        // pool has run everything queued
+        void runUntilIdle()
+        {
+            LLEventPump &mainloop(LLEventPumps::instance().obtain("mainloop"));
+            LLTimer timer;
+            while (LLCoprocedureManager::instance().count(POOL_NAME) && timer.getElapsedTimeF32() < 60.f)
+            {
+                mainloop.post(LLSD());
+                llcoro::suspend();
+                ms_sleep(5);
+            }
+            ensure_equals("pool ran everything", LLCoprocedureManager::instance().count(POOL_NAME), size_t(0));
+        }
+
+        int mFinished = 0;
+        int mFailed = 0;
+    };
+    typedef test_group<coprocedurepool_test> coprocedurepool_t;
+    typedef coprocedurepool_t::object coprocedurepool_object_t;
+    tut::coprocedurepool_t tut_coprocedurepool("llcoprocedurepool");
+
+    template<> template<>
+    void coprocedurepool_object_t::test<1>()
+    {
+        set_test_name("pool shrinks on 503s and grows back");
+
+        LLCoprocedureManager &manager(LLCoprocedureManager::instance());
+        ensure_equals("initial limit", manager.getLimit(POOL_NAME), POOL_SIZE);
+
+        // Every answer is a 503: each window of completions halves the
+        // limit until only one coprocedure runs at a time
+        enqueue("throttle", 40);
+        runUntilIdle();
+        ensure_equals("all throttled coprocedures ran", mFinished, 40);
+        ensure_equals("all throttled coprocedures failed", mFailed, 40);
+        const U32 throttled_limit(manager.getLimit(POOL_NAME));
+        ensure("pool shrank", throttled_limit < POOL_SIZE);
+        ensure_equals("pool shrank to its minimum", throttled_limit, 1U);
+
+        // The server recovers: a saturated pool with steady latency grows
+        // by one for each limit's worth of completions
+        enqueue("ok", 100);
+        runUntilIdle();
+        ensure_equals("all coprocedures ran", mFinished, 140);
+        ensure_equals("no more failures", mFailed, 40);
+        ensure("pool grew back", manager.getLimit(POOL_NAME) >= POOL_SIZE);
+    }
+}
@@ -0,0 +1,170 @@
+/**
+ * @file llcorehttputil_test.cpp
+ * @brief HttpCoroutineAdapter integration test
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+
+#include "linden_common.h"
+
+#include "../llcorehttputil.h"
+#include "../llhttpresponsecache.h"
+
+#include "httprequest.h"
+#include "lldir.h"
+#include "llevents.h"
+#include "llfile.h"
+#include "lltimer.h"
+#include "lluuid.h"
+
+#include "../test/lltut.h"
+
+using namespace LLCoreHttpUtil;
+
+namespace
+{
+    std::string get_base_url()
+    {
+        const char *port(getenv("PORT"));
+        tut::ensure("PORT set in environment; run under test_llcorehttputil_peer.py", port != NULL);
+        return llformat("http://127.0.0.1:%s/", port);
+    }
+
+    std::string body_of(const LLSD &result)
+    {
+        const LLSD::Binary &raw(result[HttpCoroutineAdapter::HTTP_RESULTS_RAW].asBinary());
+        return std::string(raw.begin(), raw.end());
+    }
+}
+
+namespace tut
+{
+    struct corehttputil_test
+    {
+        corehttputil_test()
+        {
+            mDir = gDirUtilp->add(LLFile::tmpdir(), "httpcache_" + LLUUID::generateNewID().asString());
+            LLCore::LLHttp::initialize();
+            LLCore::HttpRequest::createService();
+            LLCore::HttpRequest::startThread();
+            HttpResponseCache::createInstance(mDir, 1024 * 1024);
+        }
+
+        ~corehttputil_test()
+        {
+            HttpResponseCache::deleteSingleton();
+            gDirUtilp->deleteFilesInDir(mDir, "*");
+            LLFile::rmdir(mDir);
+
+            LLCore::HttpRequest request;
+            request.requestStopThread(LLCore::HttpHandler::ptr_t());
+            for (int i = 0; i < 20; ++i)
+            {
+                request.update(1000);
+                ms_sleep(50);
+            }
+            LLCore::HttpRequest::destroyService();
+            LLCore::LLHttp::cleanup();
+        }
+
+        // Pump "mainloop", which drives the adapter's request, until the
+        // coroutine sets 'done'.
+        void runUntil(const bool &done)
+        {
+            LLEventPump &mainloop(LLEventPumps::instance().obtain("mainloop"));
+            LLTimer timer;
+            while (!done && timer.getElapsedTimeF32() < 10.f)
+            {
+                mainloop.post(LLSD());
+                llcoro::suspend();
+                ms_sleep(10);
+            }
+            ensure("coroutine finished", done);
+        }
+
+        std::string mDir;
+    };
+    typedef test_group<corehttputil_test> corehttputil_t;
+    typedef corehttputil_t::object corehttputil_object_t;
+    tut::corehttputil_t tut_corehttputil("llcorehttputil");
+
+    template<> template<>
+    void corehttputil_object_t::test<1>()
+    {
+        set_test_name("second GET served from the response cache");
+
+        const std::string url(get_base_url() + "cached");
+        LLSD first, second;
+        bool done(false);
+
+        LLCoros::instance().launch("corehttputil_test<1>", [&]()
+        {
+            LLCore::HttpRequest::ptr_t request(new LLCore::HttpRequest);
+            HttpCoroutineAdapter adapter("corehttputil_test", LLCore::HttpRequest::DEFAULT_POLICY_ID);
+            adapter.setResponseCaching(true);
+
+            // Default options, as the name and experience caches pass
+            first = adapter.getRawAndSuspend(request, url);
+            second = adapter.getRawAndSuspend(request, url);
+            done = true;
+        });
+        runUntil(done);
+
+        HttpResponseCache &cache(HttpResponseCache::instance());
+        ensure("first GET succeeded",
+               HttpCoroutineAdapter::getStatusFromLLSD(first[HttpCoroutineAdapter::HTTP_RESULTS]));
+        ensure("second GET succeeded",
+               HttpCoroutineAdapter::getStatusFromLLSD(second[HttpCoroutineAdapter::HTTP_RESULTS]));
+        ensure("first GET has a body", !body_of(first).empty());
+        ensure_equals("second GET answered from the cache", body_of(second), body_of(first));
+        ensure_equals("response stored", cache.getStoredCount(), 1U);
+        ensure_equals("fresh hit counted", cache.getHitCount(), 1U);
+    }
+
+    template<> template<>
+    void corehttputil_object_t::test<2>()
+    {
+        set_test_name("uncacheable responses always reach the server");
+
+        const std::string url(get_base_url() + "uncached");
+        LLSD first, second;
+        bool done(false);
+
+        LLCoros::instance().launch("corehttputil_test<2>", [&]()
+        {
+            LLCore::HttpRequest::ptr_t request(new LLCore::HttpRequest);
+            HttpCoroutineAdapter adapter("corehttputil_test", LLCore::HttpRequest::DEFAULT_POLICY_ID);
+            adapter.setResponseCaching(true);
+
+            first = adapter.getRawAndSuspend(request, url);
+            second = adapter.getRawAndSuspend(request, url);
+            done = true;
+        });
+        runUntil(done);
+
+        ensure("responses differ", body_of(first) != body_of(second));
+        ensure_equals("nothing stored", HttpResponseCache::instance().getStoredCount(), 0U);
+        ensure_equals("no hits", HttpResponseCache::instance().getHitCount(), 0U);
+    }
+}
@@ -0,0 +1,189 @@
+/**
+ * @file llhttpresponsecache_test.cpp
+ * @brief HttpResponseCache unit test
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "linden_common.h"
+
+#include "../llhttpresponsecache.h"
+
+#include "bufferarray.h"
+#include "httpheaders.h"
+#include "httpresponse.h"
+#include "lldir.h"
+#include "llfile.h"
+#include "llhttpconstants.h"
+#include "lluuid.h"
+
+#include "../test/lltut.h"
+
+using namespace LLCoreHttpUtil;
+
+namespace
+{
+    LLCore::HttpResponse * make_response(const std::string &url, const std::string &body,
+                                         const std::string &cache_control, const std::string &etag)
+    {
+        LLCore::HttpHeaders::ptr_t headers(new LLCore::HttpHeaders);
+        if (!cache_control.empty())
+        {
+            headers->append(HTTP_IN_HEADER_CACHE_CONTROL, cache_control);
+        }
+        if (!etag.empty())
+        {
+            headers->append(HTTP_IN_HEADER_ETAG, etag);
+        }
+
+        LLCore::BufferArray *ba = new LLCore::BufferArray;
+        ba->append(body.data(), body.size());
+
+        LLCore::HttpResponse *response = new LLCore::HttpResponse;
+        response->setStatus(LLCore::HttpStatus(HTTP_OK));
+        response->setHeaders(headers);
+        response->setBody(ba);
+        response->setRequestURL(url);
+        ba->release();
+        return response;
+    }
+
+    std::string body_of(LLCore::HttpResponse *response)
+    {
+        std::string body(response->getBodySize(), '\0');
+        if (!body.empty())
+        {
+            response->getBody()->read(0, &body[0], body.size());
+        }
+        return body;
+    }
+}
+
+namespace tut
+{
+    struct httpresponsecache_test
+    {
+        httpresponsecache_test()
+        {
+            mDir = gDirUtilp->add(LLFile::tmpdir(), "httpcache_" + LLUUID::generateNewID().asString());
+        }
+
+        ~httpresponsecache_test()
+        {
+            gDirUtilp->deleteFilesInDir(mDir, "*");
+            LLFile::rmdir(mDir);
+        }
+
+        std::string mDir;
+    };
+    typedef test_group<httpresponsecache_test> httpresponsecache_t;
+    typedef httpresponsecache_t::object httpresponsecache_object_t;
+    tut::httpresponsecache_t tut_httpresponsecache("httpresponsecache");
+
+    template<> template<>
+    void httpresponsecache_object_t::test<1>()
+    {
+        set_test_name("keys and Cache-Control parsing");
+
+        ensure_equals("capability collapsed",
+                      HttpResponseCache::makeKey("https://host:12043/cap/0a1b2c3d-0000-1111-2222-333344445555/id/x?y=1"),
+                      std::string("https://host:12043/cap/*/id/x?y=1"));
+        ensure_equals("plain url kept",
+                      HttpResponseCache::makeKey("https://example.com/a?b"), std::string("https://example.com/a?b"));
+
+        S32 max_age(0);
+        ensure("max-age storable", HttpResponseCache::parseCacheControl("public, Max-Age=60", max_age));
+        ensure_equals("max-age value", max_age, 60);
+        ensure("no-cache storable", HttpResponseCache::parseCacheControl("max-age=60, no-cache", max_age));
+        ensure_equals("no-cache revalidates", max_age, 0);
+        ensure("unspecified storable", HttpResponseCache::parseCacheControl("private", max_age));
+        ensure_equals("unspecified lifetime", max_age, -1);
+        ensure("no-store refused", !HttpResponseCache::parseCacheControl("no-store", max_age));
+    }
+
+    template<> template<>
+    void httpresponsecache_object_t::test<2>()
+    {
+        set_test_name("store, load and revalidate");
+
+        HttpResponseCache cache(mDir, 1024 * 1024);
+
+        LLCore::HttpResponse *fresh = make_response("https://a/1", "fresh body", "max-age=3600", "");
+        cache.storeResponse("a1", fresh);
+        fresh->release();
+
+        LLCore::HttpResponse *tagged = make_response("https://a/2", "tagged body", "", "\"v1\"");
+        cache.storeResponse("a2", tagged);
+        tagged->release();
+
+        LLCore::HttpResponse *refused = make_response("https://a/3", "secret", "no-store", "\"v1\"");
+        cache.storeResponse("a3", refused);
+        refused->release();
+
+        ensure_equals("entries stored", cache.getEntryCount(), 2U);
+        ensure("max-age entry fresh", cache.isFresh("a1"));
+        ensure("etag-only entry stale", !cache.isFresh("a2"));
+
+        LLCore::HttpResponse *loaded = cache.loadResponse("a1");
+        ensure("entry loads", loaded != NULL);
+        ensure_equals("body round trips", body_of(loaded), std::string("fresh body"));
+        ensure_equals("status is 200", S32(loaded->getStatus().getType()), HTTP_OK);
+        loaded->release();
+
+        LLCore::HttpHeaders::ptr_t headers(new LLCore::HttpHeaders);
+        LLCore::HttpHeaders::ptr_t conditional = cache.addValidators("a2", headers);
+        ensure("caller's headers untouched", headers->find(HTTP_OUT_HEADER_IF_NONE_MATCH) == NULL);
+        ensure("validator added", conditional->find(HTTP_OUT_HEADER_IF_NONE_MATCH) != NULL);
+        ensure_equals("validator value", *conditional->find(HTTP_OUT_HEADER_IF_NONE_MATCH), std::string("\"v1\""));
+        ensure("miss leaves headers alone", cache.addValidators("zz", headers) == headers);
+    }
+
+    template<> template<>
+    void httpresponsecache_object_t::test<3>()
+    {
+        set_test_name("LRU eviction and persistence");
+
+        const std::string big(400, 'x');
+        {
+            // Each entry is a bit over 400 bytes, budget allows
+            // a single entry under the 1/8th rule.
+            HttpResponseCache cache(mDir, 8 * 1024);
+            for (int i = 0; i < 30; ++i)
+            {
+                LLCore::HttpResponse *response = make_response("https://b", big, "max-age=600", "");
+                cache.storeResponse(llformat("b%d", i), response);
+                response->release();
+            }
+            ensure("under budget", cache.getSizeBytes() <= 8 * 1024);
+            ensure("oldest evicted", cache.loadResponse("b0") == NULL);
+
+            LLCore::HttpResponse *newest = cache.loadResponse("b29");
+            ensure("newest kept", newest != NULL);
+            newest->release();
+        }
+
+        HttpResponseCache reopened(mDir, 8 * 1024);
+        ensure("index reloaded", reopened.getEntryCount() > 0);
+        ensure("reloaded entry fresh", reopened.isFresh("b29"));
+    }
+}
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""\
+@file   test_llcoprocedurepool_peer.py
+@brief  Runs the executable (with args) specified on the command line while
+        serving slow and overloaded responses for the coprocedure
+        pool tests.
+
+$LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+Phoenix qikfox3D Viewer Source Code
+Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation;
+version 2.1 of the License only.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+http://www.firestormviewer.org
+$/LicenseInfo$
+"""
+
+import os
+import sys
+import time
+from http.server import HTTPServer, BaseHTTPRequestHandler
+from socketserver import ThreadingMixIn
+
+from testrunner import freeport, run, debug, VERBOSE
+
+# Every answer takes this long, so that a pool keeps its requests in
+# flight long enough to be saturated and latency is dominated by it.
+DELAY = 0.05
+
+class TestHTTPRequestHandler(BaseHTTPRequestHandler):
+    """Answers GET /throttle with 503 and anything else with 200, both
+    after DELAY seconds.
+    """
+    def do_GET(self):
+        time.sleep(DELAY)
+        throttle = self.path.rstrip("/").endswith("/throttle")
+        debug("%s: %s", self.path, 503 if throttle else 200)
+        self.send_response(503 if throttle else 200)
+        self.send_header("Content-Type", "text/plain")
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+    if not VERBOSE:
+        def log_request(self, code, size=None):
+            pass
+
+        def log_error(self, format, *args):
+            pass
+
+class Server(ThreadingMixIn, HTTPServer):
+    # The pool under test has several requests in flight at once
+    daemon_threads = True
+    # See test_llsdmessage_peer.py: freeport() depends on this being off.
+    allow_reuse_address = False
+
+if __name__ == "__main__":
+    make_server = lambda port: Server(('127.0.0.1', port), TestHTTPRequestHandler)
+
+    if not sys.platform.startswith("win"):
+        httpd = make_server(0)
+    else:
+        httpd, port = freeport(range(8000, 8020), make_server)
+
+    os.environ["PORT"] = str(httpd.server_port)
+    debug("$PORT = %s", httpd.server_port)
+    sys.exit(run(server_inst=httpd, *sys.argv[1:]))
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""\
+@file   test_llcorehttputil_peer.py
+@brief  Runs the executable (with args) specified on the command line while
+        serving cacheable responses for the HttpCoroutineAdapter tests.
+
+$LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+Phoenix qikfox3D Viewer Source Code
+Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+
+This library is free software; you can redistribute it and/or
+modify it under the terms of the GNU Lesser General Public
+License as published by the Free Software Foundation;
+version 2.1 of the License only.
+
+This library is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public
+License along with this library; if not, write to the Free Software
+Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+http://www.firestormviewer.org
+$/LicenseInfo$
+"""
+
+import os
+import sys
+from http.server import HTTPServer, BaseHTTPRequestHandler
+
+from testrunner import freeport, run, debug, VERBOSE
+
+class TestHTTPRequestHandler(BaseHTTPRequestHandler):
+    """Answers GETs with a body that changes on every request, so the
+    C++ test can tell a network response from a cached one.
+    """
+    # Number of GETs answered, shared by all handler instances
+    count = 0
+
+    def do_GET(self):
+        TestHTTPRequestHandler.count += 1
+        body = ("response %d" % TestHTTPRequestHandler.count).encode("ascii")
+        debug("%s: %s", self.path, body)
+        self.send_response(200)
+        self.send_header("Content-Type", "text/plain")
+        self.send_header("Content-Length", str(len(body)))
+        if self.path.rstrip("/").endswith("/cached"):
+            self.send_header("Cache-Control", "max-age=3600")
+            self.send_header("ETag", '"%d"' % TestHTTPRequestHandler.count)
+        else:
+            self.send_header("Cache-Control", "no-store")
+        self.end_headers()
+        self.wfile.write(body)
+
+    if not VERBOSE:
+        def log_request(self, code, size=None):
+            pass
+
+        def log_error(self, format, *args):
+            pass
+
+class Server(HTTPServer):
+    # See test_llsdmessage_peer.py: freeport() depends on this being off.
+    allow_reuse_address = False
+
+if __name__ == "__main__":
+    make_server = lambda port: Server(('127.0.0.1', port), TestHTTPRequestHandler)
+
+    if not sys.platform.startswith("win"):
+        httpd = make_server(0)
+    else:
+        httpd, port = freeport(range(8000, 8020), make_server)
+
+    os.environ["PORT"] = str(httpd.server_port)
+    debug("$PORT = %s", httpd.server_port)
+    sys.exit(run(server_inst=httpd, *sys.argv[1:]))
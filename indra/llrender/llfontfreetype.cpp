@@ -150,6 +150,7 @@ LLFontFreetype::LLFontFreetype()
     mFTFace(NULL),
     mRenderGlyphCount(0),
     mAddGlyphCount(0),
+    mGlyphGeneration(0),
     mStyle(0),
     mPointSize(0)
 {
@@ -779,6 +780,7 @@ LLFontGlyphInfo* LLFontFreetype::getGlyphInfo(llwchar wch, EFontGlyphType glyph_
 void LLFontFreetype::insertGlyphInfo(llwchar wch, LLFontGlyphInfo* gi) const
 {
     llassert(gi->mGlyphType < EFontGlyphType::Count);
+    ++mGlyphGeneration;
     std::pair<char_glyph_info_map_t::iterator, char_glyph_info_map_t::iterator> range_it = mCharGlyphInfoMap.equal_range(wch);
 
     char_glyph_info_map_t::iterator iter =
@@ -861,6 +863,7 @@ void LLFontFreetype::resetBitmapCache()
         delete it->second;
     }
     mCharGlyphInfoMap.clear();
+    ++mGlyphGeneration;
     mFontBitmapCachep->reset();
 
     // Adding default glyph is skipped for fallback fonts here as well as in loadFace().
@@ -155,6 +155,10 @@ public:
 
     LLFontGlyphInfo* getGlyphInfo(llwchar wch, EFontGlyphType glyph_type) const;
 
+    // Changes whenever glyph info is added or freed, so pointers returned
+    // by getGlyphInfo() may be kept as long as it stays the same
+    U32 getGlyphGeneration() const { return mGlyphGeneration; }
+
     void reset(F32 vert_dpi, F32 horz_dpi);
 
     void destroyGL();
@@ -206,6 +210,7 @@ private:
 
     mutable S32 mRenderGlyphCount;
     mutable S32 mAddGlyphCount;
+    mutable U32 mGlyphGeneration;
 
     // <FS:ND> Save X-kerning data, so far only for all glyphs with index small than 256 (to not waste too much memory)
     // right now it is 256 slots with 256 glyphs each, maybe consider splitting it into smaller slices to use less memory if we
@@ -43,6 +43,7 @@
 #include "llstring.h"
 
 // Third party library includes
+#include <boost/functional/hash.hpp>
 #include <boost/tokenizer.hpp>
 
 #if LL_WINDOWS
@@ -68,10 +69,24 @@ LLCoordGL LLFontGL::sCurOrigin;
 F32 LLFontGL::sCurDepth;
 std::vector<std::pair<LLCoordGL, F32> > LLFontGL::sOriginStack;
 
+U64 LLFontGL::sGlyphRunHits = 0;
+U64 LLFontGL::sGlyphRunMisses = 0;
+U64 LLFontGL::sGlyphRunHitChars = 0;
+U64 LLFontGL::sGlyphRunBuildChars = 0;
+U64 LLFontGL::sGlyphRunBuildClocks = 0;
+U64 LLFontGL::sGlyphRunHitClocks = 0;
+
 const F32 PAD_UVY = 0.5f; // half of vertical padding between glyphs in the glyph texture
 const F32 DROP_SHADOW_SOFT_STRENGTH = 0.3f;
 
+// Longer text is laid out glyph by glyph on every call, as most of it is
+// in text editors that only measure it when it changes
+const S32 MAX_GLYPH_RUN_LENGTH = 128;
+// Number of runs kept per font
+const size_t GLYPH_RUN_CACHE_SIZE = 256;
+
 LLFontGL::LLFontGL()
+:   mGlyphRunGeneration(0)
 {
 }
 
@@ -268,6 +283,9 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
         }
     }
 
+    const EFontGlyphType glyph_type = (!use_color) ? EFontGlyphType::Grayscale : EFontGlyphType::Color;
+    const glyph_run_t* run = getGlyphRun(wstr.c_str() + begin_offset, length, glyph_type);
+
     const LLFontGlyphInfo* next_glyph = NULL;
 
     const S32 GLYPH_BATCH_SIZE = 30;
@@ -291,11 +309,19 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
     {
         llwchar wch = wstr[i];
 
-        const LLFontGlyphInfo* fgi = next_glyph;
-        next_glyph = NULL;
-        if(!fgi)
+        const LLFontGlyphInfo* fgi = NULL;
+        if (run)
         {
-            fgi = mFontFreetype->getGlyphInfo(wch, (!use_color) ? EFontGlyphType::Grayscale : EFontGlyphType::Color);
+            fgi = (*run)[i - begin_offset].mGlyph;
+        }
+        else
+        {
+            fgi = next_glyph;
+            next_glyph = NULL;
+            if(!fgi)
+            {
+                fgi = mFontFreetype->getGlyphInfo(wch, glyph_type);
+            }
         }
         if (!fgi)
         {
@@ -380,8 +406,15 @@ S32 LLFontGL::render(const LLWString &wstr, S32 begin_offset, F32 x, F32 y, cons
         if (next_char && (next_char < LAST_CHARACTER))
         {
             // Kern this puppy.
-            next_glyph = mFontFreetype->getGlyphInfo(next_char, (!use_color) ? EFontGlyphType::Grayscale : EFontGlyphType::Color);
-            cur_x += mFontFreetype->getXKerning(fgi, next_glyph);
+            if (run && (i + 1) < begin_offset + length)
+            {
+                cur_x += (*run)[i - begin_offset].mXKerning;
+            }
+            else
+            {
+                next_glyph = mFontFreetype->getGlyphInfo(next_char, glyph_type);
+                cur_x += mFontFreetype->getXKerning(fgi, next_glyph);
+            }
         }
 
         // Round after kerning.
@@ -535,6 +568,13 @@ F32 LLFontGL::getWidthF32(const llwchar* wchars, S32 begin_offset, S32 max_chars
     F32 cur_x = 0;
     const S32 max_index = begin_offset + max_chars;
 
+    S32 length = 0;
+    while (length <= MAX_GLYPH_RUN_LENGTH && begin_offset + length < max_index && wchars[begin_offset + length] != 0)
+    {
+        length++;
+    }
+    const glyph_run_t* run = getGlyphRun(wchars + begin_offset, length, EFontGlyphType::Unspecified);
+
     const LLFontGlyphInfo* next_glyph = NULL;
 
     F32 width_padding = 0.f;
@@ -542,11 +582,19 @@ F32 LLFontGL::getWidthF32(const llwchar* wchars, S32 begin_offset, S32 max_chars
     {
         llwchar wch = wchars[i];
 
-        const LLFontGlyphInfo* fgi = next_glyph;
-        next_glyph = NULL;
-        if(!fgi)
+        const LLFontGlyphInfo* fgi = NULL;
+        if (run)
         {
-            fgi = mFontFreetype->getGlyphInfo(wch, EFontGlyphType::Unspecified);
+            fgi = (*run)[i - begin_offset].mGlyph;
+        }
+        else
+        {
+            fgi = next_glyph;
+            next_glyph = NULL;
+            if(!fgi)
+            {
+                fgi = mFontFreetype->getGlyphInfo(wch, EFontGlyphType::Unspecified);
+            }
         }
 
         F32 advance = mFontFreetype->getXAdvance(fgi);
@@ -569,8 +617,15 @@ F32 LLFontGL::getWidthF32(const llwchar* wchars, S32 begin_offset, S32 max_chars
             && (next_char < LAST_CHARACTER))
         {
             // Kern this puppy.
-            next_glyph = mFontFreetype->getGlyphInfo(next_char, EFontGlyphType::Unspecified);
-            cur_x += mFontFreetype->getXKerning(fgi, next_glyph);
+            if (run)
+            {
+                cur_x += (*run)[i - begin_offset].mXKerning;
+            }
+            else
+            {
+                next_glyph = mFontFreetype->getGlyphInfo(next_char, EFontGlyphType::Unspecified);
+                cur_x += mFontFreetype->getXKerning(fgi, next_glyph);
+            }
         }
         // Round after kerning.
         cur_x = (F32)ll_round(cur_x);
@@ -585,6 +640,113 @@ F32 LLFontGL::getWidthF32(const llwchar* wchars, S32 begin_offset, S32 max_chars
     return cur_x / sScaleX;
 }
 
+size_t LLFontGL::GlyphRunKeyHash::operator()(const GlyphRunKey& key) const
+{
+    size_t seed = boost::hash_range(key.mText.begin(), key.mText.end());
+    boost::hash_combine(seed, static_cast<U32>(key.mGlyphType));
+    return seed;
+}
+
+const LLFontGL::glyph_run_t* LLFontGL::getGlyphRun(const llwchar* wchars, S32 length, EFontGlyphType glyph_type) const
+{
+    if (length <= 0 || length > MAX_GLYPH_RUN_LENGTH)
+    {
+        return NULL;
+    }
+
+    U64 start_clock = LLTrace::BlockTimer::getCPUClockCount64();
+
+    if (mGlyphRunGeneration != mFontFreetype->getGlyphGeneration())
+    {
+        // glyphs were added or freed since the runs were laid out
+        mGlyphRunIndex.clear();
+        mGlyphRuns.clear();
+        mGlyphRunGeneration = mFontFreetype->getGlyphGeneration();
+    }
+
+    GlyphRunKey key = { LLWStringView(wchars, length), glyph_type };
+    auto found_it = mGlyphRunIndex.find(key);
+    if (found_it != mGlyphRunIndex.end())
+    {
+        mGlyphRuns.splice(mGlyphRuns.begin(), mGlyphRuns, found_it->second);
+        sGlyphRunHits++;
+        sGlyphRunHitChars += length;
+        sGlyphRunHitClocks += LLTrace::BlockTimer::getCPUClockCount64() - start_clock;
+        return &mGlyphRuns.front().mRun;
+    }
+
+    // Adding a glyph may free another, so look them all up again until
+    // none had to be added
+    glyph_run_t run(length);
+    S32 attempts = 0;
+    U32 generation;
+    do
+    {
+        if (++attempts > 3)
+        {
+            return NULL;
+        }
+        generation = mFontFreetype->getGlyphGeneration();
+        for (S32 i = 0; i < length; i++)
+        {
+            run[i].mGlyph = mFontFreetype->getGlyphInfo(wchars[i], glyph_type);
+            if (!run[i].mGlyph)
+            {
+                return NULL;
+            }
+        }
+    }
+    while (generation != mFontFreetype->getGlyphGeneration());
+
+    for (S32 i = 0; i < length - 1; i++)
+    {
+        run[i].mXKerning = mFontFreetype->getXKerning(run[i].mGlyph, run[i + 1].mGlyph);
+    }
+    run[length - 1].mXKerning = 0.f;
+
+    if (mGlyphRunGeneration != generation)
+    {
+        mGlyphRunIndex.clear();
+        mGlyphRuns.clear();
+        mGlyphRunGeneration = generation;
+    }
+    else
+    {
+        // only count the cost of lookups, not of rendering new glyphs
+        sGlyphRunBuildChars += length;
+        sGlyphRunBuildClocks += LLTrace::BlockTimer::getCPUClockCount64() - start_clock;
+    }
+    sGlyphRunMisses++;
+
+    mGlyphRuns.push_front({ LLWString(wchars, length), glyph_type, std::move(run) });
+    const GlyphRunCacheEntry& entry = mGlyphRuns.front();
+    mGlyphRunIndex[{ LLWStringView(entry.mText), glyph_type }] = mGlyphRuns.begin();
+
+    if (mGlyphRuns.size() > GLYPH_RUN_CACHE_SIZE)
+    {
+        const GlyphRunCacheEntry& oldest = mGlyphRuns.back();
+        mGlyphRunIndex.erase({ LLWStringView(oldest.mText), oldest.mGlyphType });
+        mGlyphRuns.pop_back();
+    }
+
+    return &entry.mRun;
+}
+
+// static
+LLFontGL::GlyphRunStats LLFontGL::getGlyphRunStats()
+{
+    GlyphRunStats stats;
+    stats.mHits = sGlyphRunHits;
+    stats.mMisses = sGlyphRunMisses;
+    if (sGlyphRunBuildChars > 0)
+    {
+        F64 clocks_per_char = (F64)sGlyphRunBuildClocks / (F64)sGlyphRunBuildChars;
+        F64 saved_clocks = clocks_per_char * (F64)sGlyphRunHitChars - (F64)sGlyphRunHitClocks;
+        stats.mSecondsSaved = saved_clocks / (F64)LLTrace::BlockTimer::countsPerSecond();
+    }
+    return stats;
+}
+
 void LLFontGL::generateASCIIglyphs()
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_UI;
@@ -616,7 +778,14 @@ S32 LLFontGL::maxDrawableChars(const llwchar* wchars, F32 max_pixels, S32 max_ch
     F32 scaled_max_pixels = max_pixels * sScaleX;
     F32 width_padding = 0.f;
 
-    LLFontGlyphInfo* next_glyph = NULL;
+    S32 length = 0;
+    while (length <= MAX_GLYPH_RUN_LENGTH && length < max_chars && wchars[length] != 0)
+    {
+        length++;
+    }
+    const glyph_run_t* run = getGlyphRun(wchars, length, EFontGlyphType::Unspecified);
+
+    const LLFontGlyphInfo* next_glyph = NULL;
 
     S32 i;
     for (i=0; (i < max_chars); i++)
@@ -660,15 +829,23 @@ S32 LLFontGL::maxDrawableChars(const llwchar* wchars, F32 max_pixels, S32 max_ch
             }
         }
 
-        LLFontGlyphInfo* fgi = next_glyph;
-        next_glyph = NULL;
-        if(!fgi)
+        const LLFontGlyphInfo* fgi = NULL;
+        if (run)
         {
-            fgi = mFontFreetype->getGlyphInfo(wch, EFontGlyphType::Unspecified);
-
-            if (NULL == fgi)
+            fgi = (*run)[i].mGlyph;
+        }
+        else
+        {
+            fgi = next_glyph;
+            next_glyph = NULL;
+            if(!fgi)
             {
-                return 0;
+                fgi = mFontFreetype->getGlyphInfo(wch, EFontGlyphType::Unspecified);
+
+                if (NULL == fgi)
+                {
+                    return 0;
+                }
             }
         }
 
@@ -689,8 +866,15 @@ S32 LLFontGL::maxDrawableChars(const llwchar* wchars, F32 max_pixels, S32 max_ch
         if (((i+1) < max_chars) && wchars[i+1])
         {
             // Kern this puppy.
-            next_glyph = mFontFreetype->getGlyphInfo(wchars[i+1], EFontGlyphType::Unspecified);
-            cur_x += mFontFreetype->getXKerning(fgi, next_glyph);
+            if (run)
+            {
+                cur_x += (*run)[i].mXKerning;
+            }
+            else
+            {
+                next_glyph = mFontFreetype->getGlyphInfo(wchars[i+1], EFontGlyphType::Unspecified);
+                cur_x += mFontFreetype->getXKerning(fgi, next_glyph);
+            }
         }
 
         // Round after kerning.
@@ -35,10 +35,15 @@
 #include "llrect.h"
 #include "v2math.h"
 
+#include <boost/unordered_map.hpp>
+#include <list>
+
 class LLColor4;
 // Key used to request a font.
 class LLFontDescriptor;
 class LLFontFreetype;
+struct LLFontGlyphInfo;
+enum class EFontGlyphType : U32;
 
 // Structure used to store previously requested fonts.
 class LLFontRegistry;
@@ -194,6 +199,15 @@ public:
 
     static void setFontDisplay(bool flag) { sDisplayFont = flag; }
 
+    // Glyph run cache use by all fonts since startup
+    struct GlyphRunStats
+    {
+        U64 mHits = 0;
+        U64 mMisses = 0;
+        F64 mSecondsSaved = 0.0;    // Estimated from the cost of laying out runs on misses
+    };
+    static GlyphRunStats getGlyphRunStats();
+
     // <FS:Beq> Add B&W emoji font support
     //static LLFontGL* getFontEmojiSmall();
     //static LLFontGL* getFontEmojiMedium();
@@ -249,6 +263,55 @@ private:
     LLFontDescriptor mFontDescriptor;
     LLPointer<LLFontFreetype> mFontFreetype;
 
+    // A laid out run of text: the glyph of each character and its kerning
+    // with the next character of the run.  Measuring and drawing the same
+    // strings again, as labels are every frame, then takes no glyph or
+    // kerning lookups.  Style only changes how glyphs are drawn, not where,
+    // so runs are cached per font by text and glyph type alone.
+    struct GlyphRunEntry
+    {
+        const LLFontGlyphInfo* mGlyph;
+        F32 mXKerning;
+    };
+    typedef std::vector<GlyphRunEntry> glyph_run_t;
+
+    // Return the run for 'length' characters, NULL if the text is too
+    // long to cache or has a character without a glyph
+    const glyph_run_t* getGlyphRun(const llwchar* wchars, S32 length, EFontGlyphType glyph_type) const;
+
+    struct GlyphRunKey
+    {
+        LLWStringView mText;    // Points into the cached entry's string
+        EFontGlyphType mGlyphType;
+
+        bool operator==(const GlyphRunKey& other) const
+        {
+            return mGlyphType == other.mGlyphType && mText == other.mText;
+        }
+    };
+    struct GlyphRunKeyHash
+    {
+        size_t operator()(const GlyphRunKey& key) const;
+    };
+    struct GlyphRunCacheEntry
+    {
+        LLWString mText;
+        EFontGlyphType mGlyphType;
+        glyph_run_t mRun;
+    };
+    typedef std::list<GlyphRunCacheEntry> glyph_run_list_t;
+
+    mutable glyph_run_list_t mGlyphRuns;   // Most recently used first
+    mutable boost::unordered_map<GlyphRunKey, glyph_run_list_t::iterator, GlyphRunKeyHash> mGlyphRunIndex;
+    mutable U32 mGlyphRunGeneration;        // LLFontFreetype glyph generation the runs were laid out with
+
+    static U64 sGlyphRunHits;
+    static U64 sGlyphRunMisses;
+    static U64 sGlyphRunHitChars;
+    static U64 sGlyphRunBuildChars;
+    static U64 sGlyphRunBuildClocks;        // Time spent laying out runs on misses
+    static U64 sGlyphRunHitClocks;          // Time spent finding runs on hits
+
     // <FS:Ansariel> Remove QUADS rendering mode
     //void renderQuad(LLVector3* vertex_out, LLVector2* uv_out, LLColor4U* colors_out, const LLRectf& screen_rect, const LLRectf& uv_rect, const LLColor4U& color, F32 slant_amt) const;
     void renderTriangle(LLVector3* vertex_out, LLVector2* uv_out, LLColor4U* colors_out, const LLRectf& screen_rect, const LLRectf& uv_rect, const LLColor4U& color, F32 slant_amt) const;
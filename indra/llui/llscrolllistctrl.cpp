@@ -58,6 +58,7 @@
 #include "llmenugl.h"
 #include "llurlaction.h"
 #include "lltooltip.h"
+#include "workqueue.h"
 
 #include <boost/bind.hpp>
 
@@ -65,6 +66,16 @@
 
 static LLDefaultChildRegistry::Register<LLScrollListCtrl> r("scroll_list");
 
+// Lists of virtual rows at least this long are sorted on a worker thread
+static const size_t MIN_ROWS_FOR_BACKGROUND_SORT = 2000;
+
+// Height of a virtual row that has no cells yet, which will be text in the
+// default cell font
+static S32 get_virtual_row_height()
+{
+    return LLFontGL::getFontEmojiSmall()->getLineHeight();
+}
+
 // local structures & classes.
 struct SortScrollListItem
 {
@@ -122,6 +133,100 @@ struct SortScrollListItem
     const bool mAltSort;
 };
 
+// The strings SortScrollListItem compares, read once per item rather than
+// once per comparison, so that sorting does not need the items (or the
+// main thread) any more.
+struct ScrollListSortKeys
+{
+    typedef std::vector<std::pair<S32, bool> > sort_order_t;
+
+    ScrollListSortKeys(const std::deque<LLScrollListItem*>& items, const sort_order_t& sort_orders, bool alternate_sort)
+    :   mSortOrders(sort_orders),
+        mAltSort(alternate_sort)
+    {
+        const size_t num_orders = mSortOrders.size();
+        mValues.resize(items.size() * num_orders);
+        mAltValues.resize(mAltSort ? mValues.size() : 0);
+        mHasCell.resize(mValues.size());
+
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            const LLScrollListItem* item = items[i];
+            for (size_t order = 0; order < num_orders; ++order)
+            {
+                const S32 col_idx = mSortOrders[order].first;
+                const size_t key = i * num_orders + order;
+                if (!item->hasCells())
+                {
+                    // Virtual rows are compared without making their cells
+                    if (col_idx >= 0 && col_idx < item->getNumColumns())
+                    {
+                        mValues[key] = item->getVirtualText(col_idx);
+                        mHasCell[key] = true;
+                    }
+                }
+                else if (const LLScrollListCell* cell = item->getColumn(col_idx))
+                {
+                    mValues[key] = cell->getValue().asString();
+                    if (mAltSort)
+                    {
+                        mAltValues[key] = cell->getAltValue().asString();
+                    }
+                    mHasCell[key] = true;
+                }
+            }
+        }
+    }
+
+    // Returns the item indices in sorted order, keeping the order of equal ones
+    std::vector<U32> sort() const
+    {
+        std::vector<U32> order(mSortOrders.empty() ? 0 : mHasCell.size() / mSortOrders.size());
+        for (U32 i = 0; i < (U32)order.size(); ++i)
+        {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [this](U32 i1, U32 i2) { return compare(i1, i2) < 0; });
+        return order;
+    }
+
+    // Same as SortScrollListItem
+    S32 compare(U32 i1, U32 i2) const
+    {
+        const size_t num_orders = mSortOrders.size();
+        S32 sort_result = 0;
+        for (size_t order = num_orders; order-- > 0; )
+        {
+            const size_t key1 = i1 * num_orders + order;
+            const size_t key2 = i2 * num_orders + order;
+            if (mHasCell[key1] && mHasCell[key2])
+            {
+                S32 dir = mSortOrders[order].second ? 1 : -1;
+                if (mAltSort && !mAltValues[key1].empty() && !mAltValues[key2].empty())
+                {
+                    sort_result = dir * LLStringUtil::compareDict(mAltValues[key1], mAltValues[key2]);
+                }
+                else
+                {
+                    sort_result = dir * LLStringUtil::compareDict(mValues[key1], mValues[key2]);
+                }
+                if (sort_result != 0)
+                {
+                    break;
+                }
+            }
+        }
+        return sort_result;
+    }
+
+    sort_order_t                mSortOrders;
+    bool                        mAltSort;
+    std::vector<std::string>    mValues;        // Item major, one per sort order
+    std::vector<std::string>    mAltValues;
+    std::vector<bool>           mHasCell;
+};
+
 //---------------------------------------------------------------------------
 // LLScrollListCtrl
 //---------------------------------------------------------------------------
@@ -205,6 +310,10 @@ LLScrollListCtrl::LLScrollListCtrl(const LLScrollListCtrl::Params& p)
     mTotalStaticColumnWidth(0),
     mTotalColumnPadding(0),
     mSorted(false),
+    mSortPending(false),
+    mSortRequest(0),
+    mBackgroundSortRows(0),
+    mBackgroundSortFrame(0),
     mSortLazily(p.sort_lazily),     // <FS:Beq> FIRE-30732 deferred sort configurability
     mDirty(false),
     mOriginalSelection(-1),
@@ -445,7 +554,7 @@ S32 LLScrollListCtrl::getItemCount() const
         for(iter = mItemList.begin(); iter != mItemList.end(); iter++)
         {
             LLScrollListItem* item  = *iter;
-            std::string filterColumnValue = item->getColumn(mFilterColumn)->getValue().asString();
+            std::string filterColumnValue = getFilterText(item);
             std::transform(filterColumnValue.begin(), filterColumnValue.end(), filterColumnValue.begin(), ::tolower);
             if (filterColumnValue.find(mFilterString) == std::string::npos)
             {
@@ -480,6 +589,7 @@ void LLScrollListCtrl::clearRows()
 {
     std::for_each(mItemList.begin(), mItemList.end(), DeletePointer());
     mItemList.clear();
+    mRowStore.reset();
     //mItemCount = 0;
 
     // Scroll the bar back up to the top.
@@ -713,9 +823,10 @@ bool LLScrollListCtrl::addItem( LLScrollListItem* item, EAddPosition pos, bool r
             addColumn(col_params);
         }
 
-        S32 num_cols = item->getNumColumns();
+        // virtual rows get their widths when their cells are made
+        S32 num_cols = item->hasCells() ? item->getNumColumns() : 0;
         S32 i = 0;
-        for (LLScrollListCell* cell = item->getColumn(i); i < num_cols; cell = item->getColumn(++i))
+        for (LLScrollListCell* cell = num_cols ? item->getColumn(i) : NULL; i < num_cols; cell = item->getColumn(++i))
         {
             if (i >= (S32)mColumnsIndexed.size()) break;
 
@@ -753,7 +864,14 @@ S32 LLScrollListCtrl::calcMaxContentWidth()
             item_list::iterator iter;
             for (iter = mItemList.begin(); iter != mItemList.end(); iter++)
             {
-                LLScrollListCell* cellp = (*iter)->getColumn(column->mIndex);
+                const LLScrollListItem* itemp = *iter;
+                if (!itemp->hasCells())
+                {
+                    column->mMaxContentWidth = llmax(LLFontGL::getFontSansSerifSmall()->getWidth(itemp->getVirtualText(column->mIndex)) + mColumnPadding + COLUMN_TEXT_PADDING, column->mMaxContentWidth);
+                    continue;
+                }
+
+                LLScrollListCell* cellp = itemp->getColumn(column->mIndex);
                 if (!cellp) continue;
 
                 column->mMaxContentWidth = llmax(LLFontGL::getFontSansSerifSmall()->getWidth(cellp->getValue().asString()) + mColumnPadding + COLUMN_TEXT_PADDING, column->mMaxContentWidth);
@@ -806,19 +924,19 @@ void LLScrollListCtrl::updateLineHeight()
     item_list::iterator iter;
     for (iter = mItemList.begin(); iter != mItemList.end(); iter++)
     {
-        LLScrollListItem *itemp = *iter;
-        S32 num_cols = itemp->getNumColumns();
-        S32 i = 0;
-        for (const LLScrollListCell* cell = itemp->getColumn(i); i < num_cols; cell = itemp->getColumn(++i))
-        {
-            mLineHeight = llmax( mLineHeight, cell->getHeight() + mRowPadding );
-        }
+        updateLineHeightInsert(*iter);
     }
 }
 
 // when the only change to line height is from an insert, we needn't scan the entire list
 void LLScrollListCtrl::updateLineHeightInsert(LLScrollListItem* itemp)
 {
+    if (!itemp->hasCells())
+    {
+        mLineHeight = llmax( mLineHeight, get_virtual_row_height() + mRowPadding );
+        return;
+    }
+
     S32 num_cols = itemp->getNumColumns();
     S32 i = 0;
     for (const LLScrollListCell* cell = itemp->getColumn(i); i < num_cols; cell = itemp->getColumn(++i))
@@ -891,6 +1009,18 @@ void LLScrollListCtrl::updateColumns(bool force_update)
         }
     }
 
+    // virtual rows make their cells with these
+    if (mRowStore)
+    {
+        for (S32 i = 0; i < llmin(mRowStore->getNumColumns(), (S32)mColumnsIndexed.size()); ++i)
+        {
+            if (mColumnsIndexed[i])
+            {
+                mRowStore->setColumnWidth(i, mColumnsIndexed[i]->getWidth());
+            }
+        }
+    }
+
     // propagate column widths to individual cells
     if (columns_changed_width || force_update)
     {
@@ -898,6 +1028,8 @@ void LLScrollListCtrl::updateColumns(bool force_update)
         for (iter = mItemList.begin(); iter != mItemList.end(); iter++)
         {
             LLScrollListItem *itemp = *iter;
+            if (!itemp->hasCells()) continue;
+
             S32 num_cols = itemp->getNumColumns();
             S32 i = 0;
             for (LLScrollListCell* cell = itemp->getColumn(i); i < num_cols; cell = itemp->getColumn(++i))
@@ -915,7 +1047,7 @@ void LLScrollListCtrl::updateColumns(bool force_update)
         for (iter = mItemList.begin(); iter != mItemList.end(); iter++)
         {
             LLScrollListItem *itemp = *iter;
-            LLScrollListCell* cell = itemp->getColumn(index);
+            LLScrollListCell* cell = itemp->hasCells() ? itemp->getColumn(index) : NULL;
             if (cell)
             {
                 cell->setWidth(last_header->getColumn()->getWidth());
@@ -1798,6 +1930,8 @@ void LLScrollListCtrl::drawItems()
         {
             return;
         }
+
+        std::vector<LLScrollListItem*> drawn_items;
         item_list::iterator iter;
         // <FS:Ansariel> Fix for FS-specific people list (radar)
         //for (S32 line = first_line; line <= last_line; line++)
@@ -1874,12 +2008,23 @@ void LLScrollListCtrl::drawItems()
 
                 item->draw(item_rect, fg_color % alpha, hover_color% alpha, select_color% alpha, highlight_color % alpha, mColumnPadding);
 
+                if (mRowStore)
+                {
+                    drawn_items.push_back(item);
+                }
+
                 cur_y -= mLineHeight;
             }
             // <FS:Ansariel> Fix for FS-specific people list (radar)
             line++;
             // </FS:Ansariel> Fix for FS-specific people list (radar)
         }
+
+        // virtual rows only keep their cells while on screen
+        if (mRowStore && mRowStore->getCellRowCount() > 2 * num_page_lines)
+        {
+            mRowStore->releaseCells(drawn_items);
+        }
     }
 }
 
@@ -3195,11 +3340,12 @@ void LLScrollListCtrl::updateSort() const
     {
         mLastUpdateFrame=0;
     // </FS:Beq>
-        // do stable sort to preserve any previous sorts
-        std::stable_sort(
-            mItemList.begin(),
-            mItemList.end(),
-            SortScrollListItem(mSortColumns,mSortCallback, mAlternateSort));
+        if (sortItemsInBackground())
+        {
+            return;
+        }
+
+        sortItems(mSortColumns);
 
         mSorted = true;
     }
@@ -3211,11 +3357,112 @@ void LLScrollListCtrl::sortOnce(S32 column, bool ascending)
     std::vector<std::pair<S32, bool> > sort_column;
     sort_column.push_back(std::make_pair(column, ascending));
 
-    // do stable sort to preserve any previous sorts
-    std::stable_sort(
-        mItemList.begin(),
-        mItemList.end(),
-        SortScrollListItem(sort_column,mSortCallback,mAlternateSort));
+    sortItems(sort_column);
+}
+
+void LLScrollListCtrl::sortItems(const sort_order_t& sort_orders) const
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_UI;
+
+    if (mSortCallback)
+    {
+        // do stable sort to preserve any previous sorts
+        std::stable_sort(
+            mItemList.begin(),
+            mItemList.end(),
+            SortScrollListItem(sort_orders, mSortCallback, mAlternateSort));
+        return;
+    }
+
+    ScrollListSortKeys keys(mItemList, sort_orders, mAlternateSort);
+    std::vector<U32> order = keys.sort();
+    item_list sorted;
+    for (U32 index : order)
+    {
+        sorted.push_back(mItemList[index]);
+    }
+    mItemList.swap(sorted);
+}
+
+// Long lists of virtual rows are sorted on the "General" work queue.  The
+// keys are read here, and the order is applied once it is back on the main
+// thread, if the rows are still the same (else the sort is posted again).
+// Returns true if a sort is running or waiting for rows to stop coming.
+bool LLScrollListCtrl::sortItemsInBackground() const
+{
+    if (mSortPending)
+    {
+        return true;
+    }
+    if (!mRowStore || mSortCallback || mItemList.size() < MIN_ROWS_FOR_BACKGROUND_SORT)
+    {
+        return false;
+    }
+
+    // a list filling from a stream of replies would only outdate the
+    // result, so wait for a frame in which no rows came or went
+    const U32 frame = LLFrameTimer::getFrameCount();
+    if (mItemList.size() != mBackgroundSortRows)
+    {
+        mBackgroundSortRows = mItemList.size();
+        mBackgroundSortFrame = frame;
+    }
+    if (frame == mBackgroundSortFrame)
+    {
+        mLastUpdateFrame = frame;
+        return true;
+    }
+
+    LL::WorkQueue::ptr_t main_queue = LL::WorkQueue::getInstance("mainloop");
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (!main_queue || !general_queue)
+    {
+        return false;
+    }
+
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_UI;
+    auto keys = std::make_shared<ScrollListSortKeys>(mItemList, mSortColumns, mAlternateSort);
+    std::vector<LLScrollListItem*> items(mItemList.begin(), mItemList.end());
+    LLHandle<LLScrollListCtrl> handle = getDerivedHandle<LLScrollListCtrl>();
+    U32 sort_request = mSortRequest;
+
+    mSortPending = main_queue->postTo(
+        general_queue,
+        [keys]() // Work done on general queue
+        {
+            return keys->sort();
+        },
+        [handle, items, sort_request](std::vector<U32> order) // Callback to main thread
+        {
+            if (LLScrollListCtrl* list = handle.get())
+            {
+                list->applyBackgroundSort(items, order, sort_request);
+            }
+        });
+    return mSortPending;
+}
+
+void LLScrollListCtrl::applyBackgroundSort(const std::vector<LLScrollListItem*>& items, const std::vector<U32>& order, U32 sort_request)
+{
+    mSortPending = false;
+
+    if (items.size() != mItemList.size() || !std::equal(items.begin(), items.end(), mItemList.begin()))
+    {
+        // rows came or went meanwhile, sort again once they settle
+        setNeedsSort();
+        return;
+    }
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        mItemList[i] = items[order[i]];
+    }
+
+    // unless the text or sort order changed meanwhile
+    if (sort_request == mSortRequest)
+    {
+        mSorted = true;
+    }
 }
 
 void LLScrollListCtrl::dirtyColumns()
@@ -3741,6 +3988,67 @@ LLScrollListItem* LLScrollListCtrl::addRow(LLScrollListItem *new_item, const LLS
     return new_item;
 }
 
+LLScrollListItem* LLScrollListCtrl::addVirtualRow(const std::vector<std::string>& columns, const LLSD& value, EAddPosition pos)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_UI;
+
+    // create missing columns on demand, named by ordinal as addRow() does
+    for (S32 col = static_cast<S32>(mColumns.size()); col < llmax(static_cast<S32>(columns.size()), 1); ++col)
+    {
+        LLScrollListColumn::Params new_column;
+        new_column.name = llformat("%d", col);
+        new_column.header.label = new_column.name;
+        addColumn(new_column);
+    }
+
+    const S32 num_columns = static_cast<S32>(mColumns.size());
+    if (!mRowStore)
+    {
+        mRowStore = std::make_unique<LLScrollListRowStore>(num_columns);
+    }
+    else if (mRowStore->getNumColumns() != num_columns)
+    {
+        mRowStore->setNumColumns(num_columns);
+    }
+    for (S32 col = 0; col < llmin(num_columns, (S32)mColumnsIndexed.size()); ++col)
+    {
+        LLScrollListColumn* columnp = mColumnsIndexed[col];
+        if (!columnp) continue;
+
+        mRowStore->setColumnWidth(col, columnp->getWidth());
+        if (columnp->mHeader && col < (S32)columns.size() && !columns[col].empty())
+        {
+            columnp->mHeader->setHasResizableElement(true);
+        }
+    }
+
+    LLScrollListItem::Params item_p;
+    item_p.value = value;
+    LLScrollListItem* new_item = new LLScrollListItem(item_p, mRowStore.get(), mRowStore->addRow(columns));
+    if (!addItem(new_item, pos))
+    {
+        delete new_item;
+        return NULL;
+    }
+    return new_item;
+}
+
+void LLScrollListCtrl::setVirtualRowText(LLScrollListItem* item, S32 column, const std::string& text)
+{
+    if (!item || !item->isVirtual() || column < 0 || column >= mRowStore->getNumColumns())
+    {
+        return;
+    }
+
+    mRowStore->setText(item->mStoreRow, column, text);
+    if (item->hasCells())
+    {
+        item->getColumn(column)->setValue(text);
+    }
+    mColumnWidthsDirty = true;
+    setNeedsSort();
+}
+
 LLScrollListItem* LLScrollListCtrl::addSimpleElement(const std::string& value, EAddPosition pos, const LLSD& id)
 {
     LLSD entry_id = id;
@@ -3929,11 +4237,20 @@ void LLScrollListCtrl::setFilterString(const std::string& str)
     }
 }
 
+std::string LLScrollListCtrl::getFilterText(const LLScrollListItem* item) const
+{
+    if (!item->hasCells())
+    {
+        return item->getVirtualText(mFilterColumn);
+    }
+    return item->getColumn(mFilterColumn)->getValue().asString();
+}
+
 bool LLScrollListCtrl::isFiltered(const LLScrollListItem* item) const
 {
     if (mIsFiltered)
     {
-        std::string filterColumnValue = item->getColumn(mFilterColumn)->getValue().asString();
+        std::string filterColumnValue = getFilterText(item);
         std::transform(filterColumnValue.begin(), filterColumnValue.end(), filterColumnValue.begin(), ::tolower);
         if (filterColumnValue.find(mFilterString) == std::string::npos)
         {
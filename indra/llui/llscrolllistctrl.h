@@ -195,6 +195,14 @@ public:
     // Simple add element. Takes a single array of:
     // [ "value" => value, "font" => font, "font-style" => style ]
     virtual void clearRows(); // clears all elements
+
+    // Virtual rows, for lists of thousands of rows of plain text: the text of
+    // each column is kept in one block and cells are only made for rows being
+    // drawn or looked at, so do not hold on to their cells, and change the
+    // text with setVirtualRowText().  Long lists of them are sorted on a
+    // worker thread, so the order may lag a few frames behind a sort change.
+    LLScrollListItem* addVirtualRow(const std::vector<std::string>& columns, const LLSD& value = LLSD(), EAddPosition pos = ADD_BOTTOM);
+    void            setVirtualRowText(LLScrollListItem* item, S32 column, const std::string& text);
     virtual void sortByColumn(const std::string& name, bool ascending);
 
     // These functions take and return an array of arrays of elements, as above
@@ -222,6 +230,7 @@ public:
     bool            setSelectedByValue(const LLSD& value, bool selected);
 
     bool            isSorted() const { return mSorted; }
+    bool            isSortPending() const { return mSortPending; }   // a background sort is running
 
     virtual bool    isSelected(const LLSD& value) const;
 
@@ -443,7 +452,7 @@ public:
     // manually call this whenever editing list items in place to flag need for resorting
     // <FS:Beq/> FIRE-30667 et al. Avoid hangs on large list updates
     // void         setNeedsSort(bool val = true) { mSorted = !val; }
-    void            setNeedsSort(bool val = true) { mSorted = !val; mLastUpdateFrame = LLFrameTimer::getFrameCount(); }
+    void            setNeedsSort(bool val = true) { mSorted = !val; mLastUpdateFrame = LLFrameTimer::getFrameCount(); if (val) ++mSortRequest; }
     void            dirtyColumns(); // some operation has potentially affected column layout or ordering
 
     bool highlightMatchingItems(const std::string& filter_str);
@@ -489,7 +498,13 @@ public:
     mutable U32     mLastUpdateFrame;
 
 private:
+    typedef std::vector<std::pair<S32, bool> > sort_order_t;
+
     void            drawItems();
+    void            sortItems(const sort_order_t& sort_orders) const;
+    bool            sortItemsInBackground() const;
+    void            applyBackgroundSort(const std::vector<LLScrollListItem*>& items, const std::vector<U32>& order, U32 sort_request);
+    std::string     getFilterText(const LLScrollListItem* item) const;
 
     void            updateLineHeightInsert(LLScrollListItem* item);
     void            reportInvalidInput();
@@ -597,6 +612,12 @@ private:
     bool            mSortLazily;
 
     mutable bool    mSorted;
+    mutable bool    mSortPending;   // A background sort is running
+    U32             mSortRequest;   // Counts setNeedsSort() calls
+    mutable size_t  mBackgroundSortRows;    // Row count last seen by sortItemsInBackground()
+    mutable U32     mBackgroundSortFrame;   // Frame in which it changed
+
+    std::unique_ptr<LLScrollListRowStore> mRowStore;    // Text of virtual rows
 
     typedef std::map<std::string, LLScrollListColumn*> column_map_t;
     column_map_t mColumns;
@@ -29,6 +29,8 @@
 
 #include "llscrolllistitem.h"
 
+#include <algorithm>
+
 #include "llrect.h"
 #include "llui.h"
 
@@ -45,15 +47,55 @@ LLScrollListItem::LLScrollListItem( const Params& p )
     mEnabled(p.enabled),
     mUserdata(p.userdata),
     mItemValue(p.value),
-    mItemAltValue(p.alt_value)
+    mItemAltValue(p.alt_value),
+    mRowStore(NULL),
+    mStoreRow(-1)
 {
 }
 
+LLScrollListItem::LLScrollListItem( const Params& p, LLScrollListRowStore* row_store, S32 row )
+:   LLScrollListItem(p)
+{
+    mRowStore = row_store;
+    mStoreRow = row;
+}
 
 LLScrollListItem::~LLScrollListItem()
+{
+    if (mRowStore)
+    {
+        releaseCells();
+        mRowStore->removeRow(mStoreRow);
+    }
+    std::for_each(mColumns.begin(), mColumns.end(), DeletePointer());
+    mColumns.clear();
+}
+
+void LLScrollListItem::makeCells() const
+{
+    S32 num_cols = mRowStore->getNumColumns();
+    mColumns.reserve(num_cols);
+    for (S32 col = 0; col < num_cols; ++col)
+    {
+        LLScrollListCell::Params cell_p;
+        cell_p.value = mRowStore->getText(mStoreRow, col);
+        cell_p.width = mRowStore->getColumnWidth(col);
+        mColumns.push_back(LLScrollListCell::create(cell_p));
+    }
+    mRowStore->mRowsWithCells.push_back(const_cast<LLScrollListItem*>(this));
+}
+
+void LLScrollListItem::releaseCells()
 {
     std::for_each(mColumns.begin(), mColumns.end(), DeletePointer());
     mColumns.clear();
+
+    std::vector<LLScrollListItem*>& rows = mRowStore->mRowsWithCells;
+    std::vector<LLScrollListItem*>::iterator it = std::find(rows.begin(), rows.end(), this);
+    if (it != rows.end())
+    {
+        rows.erase(it);
+    }
 }
 
 void LLScrollListItem::setSelected(bool b)
@@ -85,6 +127,11 @@ void LLScrollListItem::addColumn(const LLScrollListCell::Params& p)
 
 void LLScrollListItem::setNumColumns(S32 columns)
 {
+    if (!hasCells())
+    {
+        makeCells();
+    }
+
     auto prev_columns = mColumns.size();
     if (columns < prev_columns)
     {
@@ -101,6 +148,11 @@ void LLScrollListItem::setNumColumns(S32 columns)
 
 void LLScrollListItem::setColumn( S32 column, LLScrollListCell *cell )
 {
+    if (!hasCells())
+    {
+        makeCells();
+    }
+
     if (column < (S32)mColumns.size())
     {
         delete mColumns[column];
@@ -115,11 +167,19 @@ void LLScrollListItem::setColumn( S32 column, LLScrollListCell *cell )
 
 S32 LLScrollListItem::getNumColumns() const
 {
+    if (!hasCells())
+    {
+        return mRowStore->getNumColumns();
+    }
     return static_cast<S32>(mColumns.size());
 }
 
 LLScrollListCell* LLScrollListItem::getColumn(const S32 i) const
 {
+    if (!hasCells())
+    {
+        makeCells();
+    }
     if (0 <= i && i < (S32)mColumns.size())
     {
         return mColumns[i];
@@ -127,6 +187,15 @@ LLScrollListCell* LLScrollListItem::getColumn(const S32 i) const
     return NULL;
 }
 
+const std::string& LLScrollListItem::getVirtualText(S32 column) const
+{
+    if (mRowStore && 0 <= column && column < mRowStore->getNumColumns())
+    {
+        return mRowStore->getText(mStoreRow, column);
+    }
+    return LLStringUtil::null;
+}
+
 std::string LLScrollListItem::getContentsCSV() const
 {
     std::string ret;
@@ -202,3 +271,91 @@ void LLScrollListItem::draw(const LLRect& rect, const LLColor4& fg_color, const
     }
 }
 
+//---------------------------------------------------------------------------
+// LLScrollListRowStore
+//---------------------------------------------------------------------------
+
+LLScrollListRowStore::LLScrollListRowStore(S32 num_columns)
+:   mNumColumns(num_columns),
+    mColumnWidths(num_columns, 0)
+{
+}
+
+LLScrollListRowStore::~LLScrollListRowStore()
+{
+    // Rows outliving us would point at freed text
+    llassert(mText.size() == mFreeRows.size() * mNumColumns);
+}
+
+void LLScrollListRowStore::setNumColumns(S32 columns)
+{
+    if (columns == mNumColumns)
+    {
+        return;
+    }
+
+    // Existing cells were made for the old columns
+    std::vector<LLScrollListItem*> none;
+    releaseCells(none);
+
+    S32 num_rows = mNumColumns ? static_cast<S32>(mText.size()) / mNumColumns : 0;
+    std::vector<std::string> text(num_rows * columns);
+    for (S32 row = 0; row < num_rows; ++row)
+    {
+        for (S32 col = 0; col < llmin(columns, mNumColumns); ++col)
+        {
+            text[row * columns + col].swap(mText[row * mNumColumns + col]);
+        }
+    }
+    mText.swap(text);
+    mNumColumns = columns;
+    mColumnWidths.resize(columns, 0);
+}
+
+S32 LLScrollListRowStore::addRow(const std::vector<std::string>& text)
+{
+    S32 row;
+    if (!mFreeRows.empty())
+    {
+        row = mFreeRows.back();
+        mFreeRows.pop_back();
+    }
+    else
+    {
+        row = static_cast<S32>(mText.size()) / llmax(mNumColumns, 1);
+        mText.resize((row + 1) * mNumColumns);
+    }
+
+    for (S32 col = 0; col < mNumColumns; ++col)
+    {
+        setText(row, col, col < (S32)text.size() ? text[col] : LLStringUtil::null);
+    }
+    return row;
+}
+
+void LLScrollListRowStore::removeRow(S32 row)
+{
+    for (S32 col = 0; col < mNumColumns; ++col)
+    {
+        std::string().swap(mText[row * mNumColumns + col]);
+    }
+    mFreeRows.push_back(row);
+}
+
+void LLScrollListRowStore::releaseCells(const std::vector<LLScrollListItem*>& keep)
+{
+    std::vector<LLScrollListItem*> rows;
+    rows.swap(mRowsWithCells);
+    for (LLScrollListItem* item : rows)
+    {
+        if (std::find(keep.begin(), keep.end(), item) != keep.end())
+        {
+            mRowsWithCells.push_back(item);
+        }
+        else
+        {
+            std::for_each(item->mColumns.begin(), item->mColumns.end(), DeletePointer());
+            item->mColumns.clear();
+        }
+    }
+}
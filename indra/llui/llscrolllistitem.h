@@ -40,6 +40,7 @@
 class LLCheckBoxCtrl;
 class LLResizeBar;
 class LLScrollListCtrl;
+class LLScrollListRowStore;
 class LLScrollColumnHeader;
 class LLUIImage;
 
@@ -112,8 +113,16 @@ public:
 
     S32     getNumColumns() const;
 
+    // Cells of a virtual row are made here on first use
     LLScrollListCell *getColumn(const S32 i) const;
 
+    // Virtual rows keep their text in the list's LLScrollListRowStore
+    // and only have cells while something needs them.
+    bool    isVirtual() const               { return mRowStore != NULL; }
+    bool    hasCells() const                { return !mRowStore || !mColumns.empty(); }
+    // Text of a column of a virtual row, without making its cells
+    const std::string& getVirtualText(S32 column) const;
+
     std::string getContentsCSV() const;
 
     virtual void draw(const LLRect& rect,
@@ -125,8 +134,13 @@ public:
 
 protected:
     LLScrollListItem( const Params& );
+    LLScrollListItem( const Params&, LLScrollListRowStore* row_store, S32 row );
 
 private:
+    friend class LLScrollListRowStore;
+    void    makeCells() const;
+    void    releaseCells();
+
     bool    mSelected;
     bool    mHighlighted;
     S32     mHoverIndex;
@@ -135,8 +149,48 @@ private:
     void*   mUserdata;
     LLSD    mItemValue;
     LLSD    mItemAltValue;
-    std::vector<LLScrollListCell *> mColumns;
+    mutable std::vector<LLScrollListCell *> mColumns;
     LLRect  mRectangle;
+    LLScrollListRowStore* mRowStore;
+    S32     mStoreRow;
+};
+
+//---------------------------------------------------------------------------
+// LLScrollListRowStore
+//---------------------------------------------------------------------------
+// Column text of the virtual rows of one list, one row after the other
+// in a single vector, and the column widths their cells are made with.
+class LLScrollListRowStore
+{
+public:
+    LLScrollListRowStore(S32 num_columns);
+    ~LLScrollListRowStore();
+
+    S32     getNumColumns() const           { return mNumColumns; }
+    void    setNumColumns(S32 columns);
+
+    S32     getColumnWidth(S32 column) const { return mColumnWidths[column]; }
+    void    setColumnWidth(S32 column, S32 width) { mColumnWidths[column] = width; }
+
+    S32     addRow(const std::vector<std::string>& text);
+    void    removeRow(S32 row);
+
+    const std::string& getText(S32 row, S32 column) const { return mText[row * mNumColumns + column]; }
+    void    setText(S32 row, S32 column, const std::string& text) { mText[row * mNumColumns + column] = text; }
+
+    S32     getCellRowCount() const         { return static_cast<S32>(mRowsWithCells.size()); }
+
+    // Drop the cells of every row except those in 'keep'
+    void    releaseCells(const std::vector<LLScrollListItem*>& keep);
+
+private:
+    friend class LLScrollListItem;
+
+    S32                             mNumColumns;
+    std::vector<std::string>        mText;
+    std::vector<S32>                mColumnWidths;
+    std::vector<S32>                mFreeRows;
+    std::vector<LLScrollListItem*>  mRowsWithCells;
 };
 
 #endif
@@ -60,6 +60,7 @@ LLTextBase::line_info::line_info(S32 index_start, S32 index_end, LLRect rect, S3
 :   mDocIndexStart(index_start),
     mDocIndexEnd(index_end),
     mRect(rect),
+    mExtent(rect),
     mLineNum(line_num)
 {}
 
@@ -297,6 +298,19 @@ LLTextBase::LLTextBase(const LLTextBase::Params &p)
         addChild(mDocumentView);
     }
 
+    // inline widgets get a container of their own, so that text appended
+    // below them moves the container rather than each widget
+    LLView::Params inline_view_params;
+    inline_view_params.name = "inline_views";
+    inline_view_params.rect = LLRect(0, 0, mDocumentView->getRect().getWidth(), 0);
+    inline_view_params.mouse_opaque = false;
+    inline_view_params.follows.flags(FOLLOWS_LEFT | FOLLOWS_RIGHT);
+    mInlineViews = LLUICtrlFactory::create<LLView>(inline_view_params);
+    mDocumentView->addChild(mInlineViews);
+    mInlineViewsBottom = 0;
+    mLineOffset = 0;
+    mReflowSegmentCount = 0;
+
     if (mSpellCheck)
     {
         LLSpellChecker::setSettingsChangeCallback(boost::bind(&LLTextBase::onSpellCheckSettingsChange, this));
@@ -410,8 +424,8 @@ void LLTextBase::drawHighlightsBackground(const highlight_list_t& highlights, co
         LLRect content_display_rect = getVisibleDocumentRect();
 
         // binary search for line that starts before top of visible buffer
-        line_list_t::const_iterator line_iter = std::lower_bound(mLineInfoList.begin(), mLineInfoList.end(), content_display_rect.mTop, compare_bottom());
-        line_list_t::const_iterator end_iter = std::upper_bound(mLineInfoList.begin(), mLineInfoList.end(), content_display_rect.mBottom, compare_top());
+        line_list_t::const_iterator line_iter = std::lower_bound(mLineInfoList.begin(), mLineInfoList.end(), content_display_rect.mTop - mLineOffset, compare_bottom());
+        line_list_t::const_iterator end_iter = std::upper_bound(mLineInfoList.begin(), mLineInfoList.end(), content_display_rect.mBottom - mLineOffset, compare_top());
         highlight_list_t::const_iterator itHighlight = highlights.begin();
 
         // Find the coordinates of the selected area
@@ -435,11 +449,8 @@ void LLTextBase::drawHighlightsBackground(const highlight_list_t& highlights, co
                     S32 segment_offset;
                     getSegmentAndOffset(line_iter->mDocIndexStart, &segment_iter, &segment_offset);
 
-                    LLRect selection_rect;
-                    selection_rect.mLeft = line_iter->mRect.mLeft;
-                    selection_rect.mRight = line_iter->mRect.mLeft;
-                    selection_rect.mBottom = line_iter->mRect.mBottom;
-                    selection_rect.mTop = line_iter->mRect.mTop;
+                    LLRect selection_rect = getLineRect(*line_iter);
+                    selection_rect.mRight = selection_rect.mLeft;
 
                     for (; segment_iter != mSegments.end(); ++segment_iter, segment_offset = 0)
                     {
@@ -523,8 +534,8 @@ std::vector<LLRect> LLTextBase::getSelectionRects()
     LLRect content_display_rect = getVisibleDocumentRect();
 
     // binary search for line that starts before top of visible buffer
-    line_list_t::const_iterator line_iter = std::lower_bound(mLineInfoList.begin(), mLineInfoList.end(), content_display_rect.mTop, compare_bottom());
-    line_list_t::const_iterator end_iter = std::upper_bound(mLineInfoList.begin(), mLineInfoList.end(), content_display_rect.mBottom, compare_top());
+    line_list_t::const_iterator line_iter = std::lower_bound(mLineInfoList.begin(), mLineInfoList.end(), content_display_rect.mTop - mLineOffset, compare_bottom());
+    line_list_t::const_iterator end_iter = std::upper_bound(mLineInfoList.begin(), mLineInfoList.end(), content_display_rect.mBottom - mLineOffset, compare_top());
 
     bool done = false;
 
@@ -589,8 +600,8 @@ std::vector<LLRect> LLTextBase::getSelectionRects()
             LLRect selection_rect;
             selection_rect.mLeft = (S32)left_precise;
             selection_rect.mRight = (S32)right_precise;
-            selection_rect.mBottom = line_iter->mRect.mBottom;
-            selection_rect.mTop = line_iter->mRect.mTop;
+            selection_rect.mBottom = line_iter->mRect.mBottom + mLineOffset;
+            selection_rect.mTop = line_iter->mRect.mTop + mLineOffset;
 
             selection_rects.push_back(selection_rect);
         }
@@ -901,7 +912,7 @@ void LLTextBase::drawText()
 
         LLRectf text_rect((F32)line.mRect.mLeft, (F32)line.mRect.mTop, (F32)line.mRect.mRight, (F32)line.mRect.mBottom);
         text_rect.mRight = (F32)mDocumentView->getRect().getWidth(); // clamp right edge to document extents
-        text_rect.translate((F32)mDocumentView->getRect().mLeft, (F32)mDocumentView->getRect().mBottom); // adjust by scroll position
+        text_rect.translate((F32)mDocumentView->getRect().mLeft, (F32)(mDocumentView->getRect().mBottom + mLineOffset)); // adjust by scroll position
 
         // draw a single line of text
         S32 seg_start = line_start;
@@ -1493,11 +1504,11 @@ void LLTextBase::draw()
         {
             if (visible_lines_rect.isEmpty())
             {
-                visible_lines_rect = mLineInfoList[i].mRect;
+                visible_lines_rect = getLineRect(mLineInfoList[i]);
             }
             else
             {
-                visible_lines_rect.unionWith(mLineInfoList[i].mRect);
+                visible_lines_rect.unionWith(getLineRect(mLineInfoList[i]));
             }
         }
         text_rect = visible_lines_rect;
@@ -1861,12 +1872,21 @@ void LLTextBase::reflow()
             }
         }
 
+        const S32 reflow_start_index = line_start_index;
+        bool relayout_all = mLineInfoList.empty();
+        if (relayout_all)
+        {
+            // nothing kept, start from a fresh layout origin
+            mLineOffset = 0;
+        }
+
         S32 line_height = 0;
         S32 seg_line_offset = line_count + 1;
 
         while(seg_iter != mSegments.end())
         {
             LLTextSegmentPtr segment = *seg_iter;
+            ++mReflowSegmentCount;
 
             // track maximum height of any segment on this line
             S32 cur_index = segment->getStart() + seg_offset;
@@ -1902,11 +1922,7 @@ void LLTextBase::reflow()
             if (last_segment_char_on_line < segment->getEnd())
             {
                 // add line info and keep going
-                mLineInfoList.push_back(line_info(
-                                            line_start_index,
-                                            last_segment_char_on_line,
-                                            line_rect,
-                                            line_count));
+                pushLineInfo(line_start_index, last_segment_char_on_line, line_rect, line_count);
 
                 line_start_index = segment->getStart() + seg_offset;
                 cur_top -= ll_round((F32)line_height * mLineSpacingMult) + mLineSpacingPixels;
@@ -1916,11 +1932,7 @@ void LLTextBase::reflow()
             // ...just consumed last segment..
             else if (++segment_set_t::iterator(seg_iter) == mSegments.end())
             {
-                mLineInfoList.push_back(line_info(
-                                            line_start_index,
-                                            last_segment_char_on_line,
-                                            line_rect,
-                                            line_count));
+                pushLineInfo(line_start_index, last_segment_char_on_line, line_rect, line_count);
                 cur_top -= ll_round((F32)line_height * mLineSpacingMult) + mLineSpacingPixels;
                 break;
             }
@@ -1930,11 +1942,7 @@ void LLTextBase::reflow()
                 // subtract pixels used and increment segment
                 if (force_newline)
                 {
-                    mLineInfoList.push_back(line_info(
-                                                line_start_index,
-                                                last_segment_char_on_line,
-                                                line_rect,
-                                                line_count));
+                    pushLineInfo(line_start_index, last_segment_char_on_line, line_rect, line_count);
                     line_start_index = segment->getStart() + seg_offset;
                     cur_top -= ll_round((F32)line_height * mLineSpacingMult) + mLineSpacingPixels;
                     line_height = 0;
@@ -1950,16 +1958,28 @@ void LLTextBase::reflow()
             }
         }
 
-        // calculate visible region for diplaying text
+        // inline widgets sit at fixed layout coordinates inside mInlineViews,
+        // which only grows when the text runs past its bottom.  Grow it to
+        // twice the text height so that this happens O(log n) times.
+        const S32 layout_bottom = mLineInfoList.empty() ? 0 : mLineInfoList.back().mExtent.mBottom;
+        if (layout_bottom < mInlineViewsBottom || relayout_all)
+        {
+            mInlineViewsBottom = llmin(2 * layout_bottom, layout_bottom - mVisibleTextRect.getHeight());
+            mInlineViews->reshape(mInlineViews->getRect().getWidth(), -mInlineViewsBottom);
+            relayout_all = true;
+        }
+
+        // calculate visible region for diplaying text, this also moves
+        // mInlineViews and with it every widget above the reflowed lines
         updateRects();
 
-        for (segment_set_t::iterator segment_it = mSegments.begin();
-            segment_it != mSegments.end();
-            ++segment_it)
+        // lay out only the reflowed segments, unless every widget has moved
+        segment_set_t::iterator segment_it = relayout_all ? mSegments.begin() : getSegIterContaining(reflow_start_index);
+        for (; segment_it != mSegments.end(); ++segment_it)
         {
             LLTextSegmentPtr segmentp = *segment_it;
             segmentp->updateLayout(*this);
-
+            ++mReflowSegmentCount;
         }
     }
 
@@ -1999,6 +2019,16 @@ void LLTextBase::reflow()
     updateCursorXPos();
 }
 
+void LLTextBase::pushLineInfo(S32 index_start, S32 index_end, const LLRect& rect, S32 line_num)
+{
+    line_info line(index_start, index_end, rect, line_num);
+    if (!mLineInfoList.empty())
+    {
+        line.mExtent.unionWith(mLineInfoList.back().mExtent);
+    }
+    mLineInfoList.push_back(line);
+}
+
 LLRect LLTextBase::getTextBoundingRect()
 {
     reflow();
@@ -2084,7 +2114,7 @@ S32 LLTextBase::getFirstVisibleLine() const
     LLRect visible_region = getVisibleDocumentRect();
 
     // binary search for line that starts before top of visible buffer
-    line_list_t::const_iterator iter = std::lower_bound(mLineInfoList.begin(), mLineInfoList.end(), visible_region.mTop, compare_bottom());
+    line_list_t::const_iterator iter = std::lower_bound(mLineInfoList.begin(), mLineInfoList.end(), visible_region.mTop - mLineOffset, compare_bottom());
 
     return (S32)(iter - mLineInfoList.begin());
 }
@@ -2097,6 +2127,7 @@ std::pair<S32, S32> LLTextBase::getVisibleLines(bool require_fully_visible)
 
     // make sure we have an up-to-date mLineInfoList
     reflow();
+    visible_region.translate(0, -mLineOffset); // into layout coordinates
 
     if (require_fully_visible)
     {
@@ -2120,12 +2151,12 @@ LLTextViewModel* LLTextBase::getViewModel() const
 
 void LLTextBase::addDocumentChild(LLView* view)
 {
-    mDocumentView->addChild(view);
+    mInlineViews->addChild(view);
 }
 
 void LLTextBase::removeDocumentChild(LLView* view)
 {
-    mDocumentView->removeChild(view);
+    mInlineViews->removeChild(view);
 }
 
 
@@ -2896,7 +2927,7 @@ S32 LLTextBase::getDocIndexFromLocalCoord( S32 local_x, S32 local_y, bool round,
 {
     // Figure out which line we're nearest to.
     LLRect doc_rect = mDocumentView->getRect();
-    S32 doc_y = local_y - doc_rect.mBottom;
+    S32 doc_y = local_y - doc_rect.mBottom - mLineOffset; // in layout coordinates, like the line rects
 
     // binary search for line that starts before local_y
     line_list_t::const_iterator line_iter = std::lower_bound(mLineInfoList.begin(), mLineInfoList.end(), doc_y, compare_bottom());
@@ -3034,8 +3065,8 @@ LLRect LLTextBase::getDocRectFromDocIndex(S32 pos) const
 
     LLRect doc_rect;
     doc_rect.mLeft = (S32)doc_left_precise;
-    doc_rect.mBottom = line_iter->mRect.mBottom;
-    doc_rect.mTop = line_iter->mRect.mTop;
+    doc_rect.mBottom = line_iter->mRect.mBottom + mLineOffset;
+    doc_rect.mTop = line_iter->mRect.mTop + mLineOffset;
 
     // set rect to 0 width
     doc_rect.mRight = doc_rect.mLeft;
@@ -3174,7 +3205,7 @@ void LLTextBase::changeLine( S32 delta )
     {
         LLRect visible_region = getVisibleDocumentRect();
         S32 new_cursor_pos = getDocIndexFromLocalCoord(mDesiredXPixel,
-                                                       mLineInfoList[new_line].mRect.mBottom + mVisibleTextRect.mBottom - visible_region.mBottom, true);
+                                                       getLineRect(mLineInfoList[new_line]).mBottom + mVisibleTextRect.mBottom - visible_region.mBottom, true);
         S32 actual_line = getLineNumFromDocIndex(new_cursor_pos);
         if (actual_line != new_line)
         {
@@ -3341,13 +3372,9 @@ void LLTextBase::updateRects()
     }
     else
     {
-        mTextBoundingRect = mLineInfoList.begin()->mRect;
-        for (line_list_t::const_iterator line_iter = ++mLineInfoList.begin();
-            line_iter != mLineInfoList.end();
-            ++line_iter)
-        {
-            mTextBoundingRect.unionWith(line_iter->mRect);
-        }
+        // the last line's extent already covers every line above it
+        mTextBoundingRect = mLineInfoList.back().mExtent;
+        mTextBoundingRect.translate(0, mLineOffset);
 
         mTextBoundingRect.mTop += mVPad;
 
@@ -3369,10 +3396,7 @@ void LLTextBase::updateRects()
             break;
         }
         // move line segments to fit new document rect
-        for (line_list_t::iterator it = mLineInfoList.begin(); it != mLineInfoList.end(); ++it)
-        {
-            it->mRect.translate(0, delta_pos);
-        }
+        mLineOffset += delta_pos;
         mTextBoundingRect.translate(0, delta_pos);
     }
 
@@ -3448,10 +3472,7 @@ void LLTextBase::updateRects()
         // move line segments to fit new visible rect
         if (delta_pos != 0)
         {
-            for (line_list_t::iterator it = mLineInfoList.begin(); it != mLineInfoList.end(); ++it)
-            {
-                it->mRect.translate(0, delta_pos);
-            }
+            mLineOffset += delta_pos;
             mTextBoundingRect.translate(0, delta_pos);
         }
     }
@@ -3479,6 +3500,9 @@ void LLTextBase::updateRects()
         }
     }
     mDocumentView->setShape(doc_rect);
+
+    // the layout origin of mInlineViews is the top of the text
+    mInlineViews->setOrigin(0, mInlineViewsBottom + mLineOffset);
 }
 
 
@@ -3520,16 +3544,17 @@ LLRect LLTextBase::getVisibleDocumentRect() const
             it != end_it;
             ++it)
         {
-            bool line_visible = mClipPartial ? visible_text_rect.contains(it->mRect) : visible_text_rect.overlaps(it->mRect);
+            LLRect line_rect = getLineRect(*it);
+            bool line_visible = mClipPartial ? visible_text_rect.contains(line_rect) : visible_text_rect.overlaps(line_rect);
             if (line_visible)
             {
                 if (visible_lines_rect.isEmpty())
                 {
-                    visible_lines_rect = it->mRect;
+                    visible_lines_rect = line_rect;
                 }
                 else
                 {
-                    visible_lines_rect.unionWith(it->mRect);
+                    visible_lines_rect.unionWith(line_rect);
                 }
             }
         }
@@ -4112,7 +4137,9 @@ S32 LLInlineViewSegment::getNumChars(S32 num_pixels, S32 segment_offset, S32 lin
 void LLInlineViewSegment::updateLayout(const LLTextBase& editor)
 {
     LLRect start_rect = editor.getDocRectFromDocIndex(mStart);
-    mView->setOrigin(start_rect.mLeft + mLeftPad, start_rect.mBottom + mBottomPad);
+    // the widget's parent is the editor's inline view container
+    const LLRect& parent_rect = mView->getParent()->getRect();
+    mView->setOrigin(start_rect.mLeft + mLeftPad - parent_rect.mLeft, start_rect.mBottom + mBottomPad - parent_rect.mBottom);
 }
 
 F32 LLInlineViewSegment::draw(S32 start, S32 end, S32 selection_start, S32 selection_end, const LLRectf& draw_rect)
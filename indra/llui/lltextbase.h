@@ -483,6 +483,8 @@ public:
 
     S32                     getLength() const { return static_cast<S32>(getWText().length()); }
     S32                     getLineCount() const { return static_cast<S32>(mLineInfoList.size()); }
+    // segments measured or laid out by reflow() so far
+    U32                     getReflowSegmentCount() const { return mReflowSegmentCount; }
     S32                     removeFirstLine(); // returns removed length
 
     void                    addDocumentChild(LLView* view);
@@ -558,7 +560,8 @@ protected:
         line_info(S32 index_start, S32 index_end, LLRect rect, S32 line_num);
         S32 mDocIndexStart;
         S32 mDocIndexEnd;
-        LLRect mRect;
+        LLRect mRect;   // in layout coordinates, see getLineRect()
+        LLRect mExtent; // union of this line's rect and those of all lines above it
         S32 mLineNum; // actual line count (ignoring soft newlines due to word wrap)
     };
     typedef std::vector<line_info> line_list_t;
@@ -688,6 +691,7 @@ protected:
 
     // misc
     void                            updateRects();
+    void                            pushLineInfo(S32 index_start, S32 index_end, const LLRect& rect, S32 line_num);
     void                            needsScroll() { mScrollNeeded = true; }
 
     struct URLLabelCallback;
@@ -708,12 +712,21 @@ protected:
 
     std::vector<LLRect> getSelectionRects();
 
+    // rect of a line in document coordinates
+    LLRect getLineRect(const line_info& line) const
+    {
+        LLRect rect(line.mRect);
+        rect.translate(0, mLineOffset);
+        return rect;
+    }
+
 protected:
     // text segmentation and flow
     segment_set_t               mSegments;
     line_list_t                 mLineInfoList;
     LLRect                      mVisibleTextRect;           // The rect in which text is drawn.  Excludes borders.
     LLRect                      mTextBoundingRect;
+    S32                         mLineOffset;                // Line rects are kept in layout coordinates, this moves them into the document.
 
     // default text style
     LLStyle::Params             mStyle;
@@ -796,10 +809,13 @@ protected:
     // support widgets
     LLHandle<LLContextMenu>     mPopupMenuHandle;
     LLView*                     mDocumentView;
+    LLView*                     mInlineViews;       // holds inline widgets in layout coordinates, moved as a whole with mLineOffset
+    S32                         mInlineViewsBottom; // layout coordinate of the bottom of mInlineViews
     LLScrollContainer*          mScroller;
 
     // transient state
     S32                         mReflowIndex;       // index at which to start reflow.  S32_MAX indicates no reflow needed.
+    U32                         mReflowSegmentCount;
     bool                        mScrollNeeded;      // need to change scroll region because of change to cursor position
     S32                         mScrollIndex;       // index of first character to keep visible in scroll region
 
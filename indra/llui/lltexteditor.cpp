@@ -2483,7 +2483,7 @@ void LLTextEditor::drawPreeditMarker()
                 }
 
                 line_info& line = mLineInfoList[cur_line];
-                LLRect text_rect(line.mRect);
+                LLRect text_rect(getLineRect(line));
                 text_rect.mRight = mDocumentView->getRect().getWidth(); // clamp right edge to document extents
                 text_rect.translate(mDocumentView->getRect().mLeft, mDocumentView->getRect().mBottom); // adjust by scroll position
 
@@ -30,7 +30,7 @@
 #include "llurlregistry.h"
 #include "lluriparser.h"
 
-#include <boost/algorithm/string/find.hpp> //for boost::ifind_first -KC
+#include <algorithm>
 
 // default dummy callback that ignores any label updates from the server
 void LLUrlRegistryNullCallback(const std::string &url, const std::string &label, const std::string& icon)
@@ -118,14 +118,26 @@ void LLUrlRegistry::registerUrl(LLUrlEntryBase *url, bool force_front)
 {
     if (url)
     {
+        std::vector<U32> anchors;
+        for (const std::string &anchor : url->getAnchors())
+        {
+            anchors.push_back(mAnchorMatcher.addAnchor(anchor));
+        }
+
         if (force_front)  // IDEVO
+        {
             mUrlEntry.insert(mUrlEntry.begin(), url);
+            mUrlEntryAnchors.insert(mUrlEntryAnchors.begin(), anchors);
+        }
         else
-        mUrlEntry.push_back(url);
+        {
+            mUrlEntry.push_back(url);
+            mUrlEntryAnchors.push_back(anchors);
+        }
     }
 }
 
-static bool matchRegex(const char *text, boost::regex regex, U32 &start, U32 &end)
+static bool matchRegex(const char *text, const boost::regex &regex, U32 &start, U32 &end)
 {
     boost::cmatch result;
     bool found;
@@ -162,70 +174,12 @@ static bool matchRegex(const char *text, boost::regex regex, U32 &start, U32 &en
     return true;
 }
 
-static bool stringHasUrl(const std::string &text)
-{
-    // fast heuristic test for a URL in a string. This is used
-    // to avoid lots of costly regex calls, BUT it needs to be
-    // kept in sync with the LLUrlEntry regexes we support.
-    return (text.find("://") != std::string::npos ||
-            // text.find("www.") != std::string::npos ||
-            // text.find(".com") != std::string::npos ||
-            // allow ALLCAPS urls -KC
-            boost::ifind_first(text, "www.") ||
-            boost::ifind_first(text, ".com") ||
-            boost::ifind_first(text, ".net") ||
-            boost::ifind_first(text, ".edu") ||
-            boost::ifind_first(text, ".org") ||
-            text.find("<nolink>") != std::string::npos ||
-            text.find("<icon") != std::string::npos ||
-            text.find("@") != std::string::npos);
-}
-
-static bool stringHasJira(const std::string &text)
-{
-    // same as above, but for jiras
-    // <FS:CR> Please make sure to sync these with the items in LLUrlEntryJira::LLUrlEntryJira() if you make a change
-    return (text.find("ARVD") != std::string::npos ||
-            text.find("BUG") != std::string::npos ||
-            text.find("CHOP") != std::string::npos ||
-            text.find("CHUIBUG") != std::string::npos ||
-            text.find("CTS") != std::string::npos ||
-            text.find("DOC") != std::string::npos ||
-            text.find("DN") != std::string::npos ||
-            text.find("ECC") != std::string::npos ||
-            text.find("EXP") != std::string::npos ||
-            text.find("FIRE") != std::string::npos ||
-            text.find("FITMESH") != std::string::npos ||
-            text.find("LEAP") != std::string::npos ||
-            text.find("LLSD") != std::string::npos ||
-            text.find("MATBUG") != std::string::npos ||
-            text.find("MISC") != std::string::npos ||
-            text.find("OPEN") != std::string::npos ||
-            text.find("PATHBUG") != std::string::npos ||
-            text.find("PLAT") != std::string::npos ||
-            text.find("PYO") != std::string::npos ||
-            text.find("SCR") != std::string::npos ||
-            text.find("SH") != std::string::npos ||
-            text.find("SINV") != std::string::npos ||
-            text.find("SLS") != std::string::npos ||
-            text.find("SNOW") != std::string::npos ||
-            text.find("SOCIAL") != std::string::npos ||
-            text.find("STORM") != std::string::npos ||
-            text.find("SUN") != std::string::npos ||
-            text.find("SUP") != std::string::npos ||
-            text.find("SVC") != std::string::npos ||
-            text.find("TPV") != std::string::npos ||
-            text.find("VWR") != std::string::npos ||
-            text.find("WEB") != std::string::npos);
-}
-
 bool LLUrlRegistry::findUrl(const std::string &text, LLUrlMatch &match, const LLUrlLabelCallback &cb, bool is_content_trusted)
 {
-    // avoid costly regexes if there is clearly no URL in the text
-    if (! (stringHasUrl(text) || stringHasJira(text)))
-    {
-        return false;
-    }
+    // find the anchors of all url entries in one pass over the text,
+    // to avoid costly regexes for entries that clearly cannot match
+    std::vector<bool> anchor_found(mAnchorMatcher.getAnchorCount());
+    mAnchorMatcher.scan(text, anchor_found);
 
     // find the first matching regex from all url entries in the registry
     U32 match_start = 0, match_end = 0;
@@ -234,6 +188,13 @@ bool LLUrlRegistry::findUrl(const std::string &text, LLUrlMatch &match, const LL
     std::vector<LLUrlEntryBase *>::iterator it;
     for (it = mUrlEntry.begin(); it != mUrlEntry.end(); ++it)
     {
+        const std::vector<U32> &anchors = mUrlEntryAnchors[it - mUrlEntry.begin()];
+        if (!anchors.empty() &&
+            std::none_of(anchors.begin(), anchors.end(), [&anchor_found](U32 anchor) { return anchor_found[anchor]; }))
+        {
+            continue;
+        }
+
         //Skip for url entry icon if content is not trusted
         if((mUrlEntryIcon == *it) && ((text.find("Hand") != std::string::npos) || !is_content_trusted))
         {
@@ -407,3 +368,122 @@ void LLUrlRegistry::setKeybindingHandler(LLKeyBindingToStringHandler* handler)
     LLUrlEntryKeybinding *entry = (LLUrlEntryKeybinding*)mUrlEntryKeybinding;
     entry->setHandler(handler);
 }
+
+//
+// LLUrlAnchorMatcher
+//
+
+LLUrlAnchorMatcher::LLUrlAnchorMatcher()
+{
+    build();
+}
+
+U32 LLUrlAnchorMatcher::addAnchor(const std::string &anchor)
+{
+    llassert(!anchor.empty());
+
+    std::string lower = anchor;
+    LLStringUtil::toLower(lower);
+    std::vector<std::string>::iterator it = std::find(mAnchors.begin(), mAnchors.end(), lower);
+    if (it != mAnchors.end())
+    {
+        return static_cast<U32>(it - mAnchors.begin());
+    }
+
+    mAnchors.push_back(lower);
+    build();
+    return static_cast<U32>(mAnchors.size() - 1);
+}
+
+void LLUrlAnchorMatcher::build()
+{
+    // only the characters used by anchors need their own columns in
+    // the transition table, all others share class 0
+    memset(mClass, 0, sizeof(mClass));
+    mClassCount = 1;
+    for (const std::string &anchor : mAnchors)
+    {
+        for (char c : anchor)
+        {
+            U8 lower = static_cast<U8>(c);
+            if (!mClass[lower])
+            {
+                mClass[lower] = static_cast<U8>(mClassCount);
+                mClass[static_cast<U8>(toupper(lower))] = static_cast<U8>(mClassCount);
+                ++mClassCount;
+            }
+        }
+    }
+    const U32 classes = mClassCount;
+
+    // trie of the anchors, state 0 is the root and never a child so a
+    // zero transition means there is none yet
+    mNext.assign(classes, 0);
+    mAnchorAt.assign(1, -1);
+    for (size_t i = 0; i < mAnchors.size(); ++i)
+    {
+        U32 state = 0;
+        for (char c : mAnchors[i])
+        {
+            U32 &next = mNext[state * classes + mClass[static_cast<U8>(c)]];
+            if (!next)
+            {
+                next = static_cast<U32>(mAnchorAt.size());
+                mAnchorAt.push_back(-1);
+                mNext.resize(mNext.size() + classes, 0);
+            }
+            // mNext may have been reallocated
+            state = mNext[state * classes + mClass[static_cast<U8>(c)]];
+        }
+        mAnchorAt[state] = static_cast<S32>(i);
+    }
+
+    // breadth first, point missing transitions at those of the longest
+    // proper suffix that is also in the trie
+    std::vector<U32> fail(mAnchorAt.size(), 0);
+    mOutputLink.assign(mAnchorAt.size(), 0);
+    std::vector<U32> queue;
+    for (U32 c = 0; c < classes; ++c)
+    {
+        if (mNext[c])
+        {
+            queue.push_back(mNext[c]);
+        }
+    }
+    for (size_t head = 0; head < queue.size(); ++head)
+    {
+        U32 state = queue[head];
+        for (U32 c = 0; c < classes; ++c)
+        {
+            U32 &next = mNext[state * classes + c];
+            U32 fallback = mNext[fail[state] * classes + c];
+            if (next)
+            {
+                fail[next] = fallback;
+                mOutputLink[next] = mAnchorAt[fallback] >= 0 ? fallback : mOutputLink[fallback];
+                queue.push_back(next);
+            }
+            else
+            {
+                next = fallback;
+            }
+        }
+    }
+}
+
+void LLUrlAnchorMatcher::scan(const std::string &text, std::vector<bool> &found) const
+{
+    llassert(found.size() >= mAnchors.size());
+
+    const U32 *next = mNext.data();
+    const U32 classes = mClassCount;
+    U32 state = 0;
+    for (char c : text)
+    {
+        state = next[state * classes + mClass[static_cast<U8>(c)]];
+        for (U32 s = mAnchorAt[state] >= 0 ? state : mOutputLink[state]; s; s = mOutputLink[s])
+        {
+            found[mAnchorAt[s]] = true;
+        }
+    }
+}
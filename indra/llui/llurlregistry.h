@@ -38,6 +38,42 @@
 
 class LLKeyBindingToStringHandler;
 
+///
+/// LLUrlAnchorMatcher finds which of a set of literal strings occur in
+/// a text, ignoring ASCII case, in a single pass over the text.  It is
+/// an Aho-Corasick automaton with the transitions of every state
+/// precomputed, so each byte of input costs one table lookup.
+///
+/// LLUrlRegistry uses it to find the anchors of all registered Url
+/// entries at once and then only runs the regexes of entries whose
+/// anchors are present.
+///
+class LLUrlAnchorMatcher
+{
+public:
+    LLUrlAnchorMatcher();
+
+    /// Add a non-empty literal and return its index.  Adding a literal
+    /// again returns the index it was first given.
+    U32 addAnchor(const std::string &anchor);
+
+    U32 getAnchorCount() const { return static_cast<U32>(mAnchors.size()); }
+
+    /// Set found[i] for each anchor i that occurs in text. 'found' must
+    /// have getAnchorCount() elements.
+    void scan(const std::string &text, std::vector<bool> &found) const;
+
+private:
+    void build();
+
+    std::vector<std::string>    mAnchors;       // Lower case
+    U8                          mClass[256];    // Byte to character class, 0 for none
+    U32                         mClassCount;
+    std::vector<U32>            mNext;          // Transitions, mNext[state * mClassCount + class]
+    std::vector<S32>            mAnchorAt;      // Anchor ending in each state, or -1
+    std::vector<U32>            mOutputLink;    // Nearest suffix state ending an anchor, or 0
+};
+
 /// This default callback for findUrl() simply ignores any label updates
 void LLUrlRegistryNullCallback(const std::string &url,
                                const std::string &label,
@@ -56,6 +92,8 @@ void LLUrlRegistryNullCallback(const std::string &url,
 ///
 /// New Url types can be added to the registry with the registerUrl
 /// method. E.g., to add support for a new secondlife:///app/ Url.
+/// The regex of a Url type is only tried on strings that contain one
+/// of the anchors it declares, see LLUrlEntryBase::getAnchors().
 ///
 /// Computing the label for a Url could involve a roundtrip request
 /// to the server (e.g., to find the actual agent or group name).
@@ -95,6 +133,8 @@ public:
 
 private:
     std::vector<LLUrlEntryBase *> mUrlEntry;
+    std::vector<std::vector<U32> > mUrlEntryAnchors;    // Anchor indices of each entry in mUrlEntry
+    LLUrlAnchorMatcher mAnchorMatcher;
     LLUrlEntryBase* mUrlEntryTrusted;
     LLUrlEntryBase* mUrlEntryIcon;
     LLUrlEntryBase* mLLUrlEntryInvalidSLURL;
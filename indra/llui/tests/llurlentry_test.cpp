@@ -27,6 +27,7 @@
 
 #include "linden_common.h"
 #include "../llurlentry.h"
+#include "../llurlregistry.h"
 #include "../lluictrl.h"
 //#include "llurlentry_stub.cpp"
 #include "lltut.h"
@@ -36,6 +37,8 @@
 
 #include <boost/regex.hpp>
 
+#include <algorithm>
+
 #if LL_WINDOWS
 // because something pulls in window and lldxdiag dependencies which in turn need wbemuuid.lib
     #pragma comment(lib, "wbemuuid.lib")
@@ -108,6 +111,28 @@ namespace
 
 namespace tut
 {
+    // the registry only tries an entry's regex on text containing one
+    // of its anchors, so every match must contain one
+    void ensureAnchored(const std::string &testname, LLUrlEntryBase &entry,
+                        const std::string &url)
+    {
+        if (entry.getAnchors().empty())
+        {
+            return;
+        }
+        std::string lower_url = url;
+        LLStringUtil::toLower(lower_url);
+        for (std::string anchor : entry.getAnchors())
+        {
+            LLStringUtil::toLower(anchor);
+            if (lower_url.find(anchor) != std::string::npos)
+            {
+                return;
+            }
+        }
+        fail(testname + ": match has none of the entry's anchors");
+    }
+
     void testRegex(const std::string &testname, LLUrlEntryBase &entry,
                    const char *text, const std::string &expected)
     {
@@ -119,11 +144,20 @@ namespace tut
         {
             S32 start = static_cast<U32>(result[0].first - text);
             S32 end = static_cast<U32>(result[0].second - text);
+            ensureAnchored(testname, entry, std::string(text+start, end-start));
             url = entry.getUrl(std::string(text+start, end-start));
         }
         ensure_equals(testname, url, expected);
     }
 
+    void testAnchors(const std::string &testname, LLUrlEntryBase &entry,
+                     const char *text)
+    {
+        boost::cmatch result;
+        ensure(testname + ": no match", boost::regex_search(text, result, entry.getPattern()));
+        ensureAnchored(testname, entry, result[0].str());
+    }
+
     void dummyCallback(const std::string &url, const std::string &label, const std::string& icon)
     {
     }
@@ -932,4 +966,93 @@ namespace tut
             "http://[ 2001:0db8:11a3:09d7:1f34:8a2e:07a0:765d ]",
             "");
     }
+
+    template<> template<>
+    void object::test<17>()
+    {
+        //
+        // test LLUrlAnchorMatcher
+        //
+        LLUrlAnchorMatcher matcher;
+        U32 http = matcher.addAnchor("http://");
+        U32 https = matcher.addAnchor("HTTPS://");
+        U32 tail = matcher.addAnchor("ps://");
+        U32 www = matcher.addAnchor("www.");
+        U32 at = matcher.addAnchor("@");
+        ensure_equals("duplicate anchor", matcher.addAnchor("Http://"), http);
+        ensure_equals("anchor count", matcher.getAnchorCount(), 5);
+
+        std::vector<bool> found(matcher.getAnchorCount());
+        matcher.scan("see Https://WWW.example.com", found);
+        ensure("https not found", found[https]);
+        ensure("overlapping suffix not found", found[tail]);
+        ensure("www not found", found[www]);
+        ensure("http found", !found[http]);
+        ensure("@ found", !found[at]);
+
+        found.assign(matcher.getAnchorCount(), false);
+        matcher.scan("wwwhttp:/ www http://", found);
+        ensure("http not found after partial match", found[http]);
+        ensure("partial www found", !found[www]);
+
+        found.assign(matcher.getAnchorCount(), false);
+        matcher.scan("", found);
+        ensure("anchor in empty text", std::find(found.begin(), found.end(), true) == found.end());
+    }
+
+    template<> template<>
+    void object::test<18>()
+    {
+        //
+        // test the anchors of entries without regex tests above
+        //
+        LLUrlEntryHTTPNoProtocol no_protocol;
+        testAnchors("no protocol", no_protocol, "go to WWW.example.com now");
+
+        LLUrlEntryInvalidSLURL invalid_slurl;
+        testAnchors("invalid slurl", invalid_slurl, "http://maps.secondlife.com/secondlife/Ahern/-1/2/3");
+
+        LLUrlEntryAgentCompleteName complete_name;
+        testAnchors("agent complete name", complete_name,
+                    "x-grid-location-info://lincoln.lindenlab.com/app/agent/0e346d8b-4433-4d66-a6b0-fd37083abc4c/completename");
+
+        LLUrlEntryAgentDisplayName display_name;
+        testAnchors("agent display name", display_name,
+                    "secondlife:///app/agent/0e346d8b-4433-4d66-a6b0-fd37083abc4c/displayname");
+
+        FSUrlEntryAgentSelf agent_self;
+        testAnchors("agent self", agent_self,
+                    "secondlife:///app/agentself/0e346d8b-4433-4d66-a6b0-fd37083abc4c/inspect");
+
+        LLUrlEntryInventory inventory;
+        testAnchors("inventory", inventory,
+                    "hop://grid.example.org:8002/app/inventory/0e346d8b-4433-4d66-a6b0-fd37083abc4c/select");
+
+        LLUrlEntryObjectIM object_im;
+        testAnchors("object im", object_im,
+                    "secondlife:///app/objectim/7bcd7864-da6b-e43f-4486-91d28a28d95b?name=Object");
+
+        LLUrlEntryChat chat;
+        testAnchors("chat", chat, "SECONDLIFE:///APP/CHAT/42/hello");
+
+        FSUrlEntryWear wear;
+        testAnchors("wear folder", wear, "secondlife:///app/wear_folder/?folder_id=0e346d8b");
+
+        FSHelpDebugUrlEntrySL help;
+        testAnchors("help", help, "secondlife:///app/fshelp/showdebug/RenderVolumeLODFactor");
+
+        LLUrlEntryWorldMap world_map;
+        testAnchors("world map", world_map, "secondlife:///app/worldmap/Ahern/50/50/50");
+
+        LLUrlEntryExperienceProfile experience;
+        testAnchors("experience", experience,
+                    "secondlife:///app/experience/0e346d8b-4433-4d66-a6b0-fd37083abc4c/profile");
+
+        LLUrlEntryIcon icon;
+        testAnchors("icon", icon, "<ICON>Hand</ICON>");
+
+        LLUrlEntryJira jira;
+        testAnchors("jira", jira, "fixed in FIRE-1234.");
+        testAnchors("jira spot", jira, "SPOT-42");
+    }
 }
@@ -28,12 +28,17 @@
 #include "llviewerprecompiledheaders.h"
 
 #include "fsfloaterstatistics.h"
+#include "llcoproceduremanager.h"
+#include "llstatbar.h"
+#include "llstatview.h"
 #include "llviewercontrol.h"
 
 
 
 FSFloaterStatistics::FSFloaterStatistics(const LLSD& key)
-    : LLFloater(key)
+    : LLFloater(key),
+    mPoolGaugeView(nullptr),
+    mPoolGaugeCount(0)
 {
 }
 
@@ -47,9 +52,46 @@ bool FSFloaterStatistics::postBuild()
     {
         setIsChrome(true);
     }
+    mPoolGaugeView = findChild<LLStatView>("coprocedures");
+    updatePoolGauges();
     return true;
 }
 
+void FSFloaterStatistics::draw()
+{
+    updatePoolGauges();
+    LLFloater::draw();
+}
+
+void FSFloaterStatistics::updatePoolGauges()
+{
+    if (!mPoolGaugeView || !LLCoprocedureManager::instanceExists())
+    {
+        return;
+    }
+
+    // Pools are created on first use, so new ones can turn up at any time
+    const std::vector<std::string>& pools = LLCoprocedureManager::instance().getGaugedPools();
+    for (; mPoolGaugeCount < pools.size(); ++mPoolGaugeCount)
+    {
+        LLStringUtil::format_map_t args;
+        args["[POOL]"] = pools[mPoolGaugeCount];
+
+        LLStatBar::Params limit;
+        limit.name = llformat("coproc_limit_%d", (S32)mPoolGaugeCount);
+        limit.label = getString("pool_limit", args);
+        limit.stat = limit.name;
+        mPoolGaugeView->addChild(LLUICtrlFactory::create<LLStatBar>(limit));
+
+        LLStatBar::Params latency;
+        latency.name = llformat("coproc_latency_%d", (S32)mPoolGaugeCount);
+        latency.label = getString("pool_latency", args);
+        latency.stat = latency.name;
+        latency.decimal_digits = 2;
+        mPoolGaugeView->addChild(LLUICtrlFactory::create<LLStatBar>(latency));
+    }
+}
+
 void FSFloaterStatistics::onOpen(const LLSD& key)
 {
     if (gSavedSettings.getBOOL("FSStatisticsNoFocus"))
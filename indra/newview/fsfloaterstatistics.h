@@ -30,6 +30,8 @@
 
 #include "llfloater.h"
 
+class LLStatView;
+
 class FSFloaterStatistics : public LLFloater
 {
 
@@ -39,6 +41,14 @@ public:
 
     void onOpen(const LLSD& key) override;
     bool postBuild() override;
+    void draw() override;
+
+private:
+    // Adds gauges for coprocedure pools created since the last call
+    void updatePoolGauges();
+
+    LLStatView* mPoolGaugeView;
+    size_t      mPoolGaugeCount;
 };
 
 #endif // FS_FLOATERSTATISTICS_H
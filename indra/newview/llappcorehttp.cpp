@@ -63,64 +63,65 @@ static const struct
     U32                         mMax;
     U32                         mRate;
     bool                        mPipelined;
+    U32                         mThread;            // Service thread when 'HttpServiceThreads' is enabled
     std::string                 mKey;
     const char *                mUsage;
 } init_data[LLAppCoreHttp::AP_COUNT] =
 {
     { // AP_DEFAULT
-        8,      8,      8,      0,      false,
+        8,      8,      8,      0,      false,  0,
         "",
         "other"
     },
     // <FS:Beq> Avoid stall in texture fetch due to asset fetching. [Drake]
     { // AP_ASSET
-        12,     1,      16,     0,      true,
+        12,     1,      16,     0,      true,   3,
         "AssetFetchConcurrency",
         "asset fetch"
     },
     // </FS:Beq>
     { // AP_TEXTURE
-        8,      1,      12,     0,      true,
+        8,      1,      12,     0,      true,   1,
         "TextureFetchConcurrency",
         "texture fetch"
     },
     { // AP_MESH1
-        32,     1,      128,    0,      false,
+        32,     1,      128,    0,      false,  2,
         "MeshMaxConcurrentRequests",
         "mesh fetch"
     },
     { // AP_MESH2
-        8,      1,      32,     0,      true,
+        8,      1,      32,     0,      true,   2,
         "Mesh2MaxConcurrentRequests",
         "mesh2 fetch"
     },
     { // AP_LARGE_MESH
-        2,      1,      8,      0,      false,
+        2,      1,      8,      0,      false,  2,
         "",
         "large mesh fetch"
     },
     { // AP_UPLOADS
-        2,      1,      8,      0,      false,
+        2,      1,      8,      0,      false,  0,
         "",
         "asset upload"
     },
     { // AP_LONG_POLL
-        32,     32,     32,     0,      false,
+        32,     32,     32,     0,      false,  0,
         "",
         "long poll"
     },
     { // AP_INVENTORY
-        4,      1,      4,      0,      false,
+        4,      1,      4,      0,      false,  0,
         "",
         "inventory"
     },
     { // AP_MATERIALS
-        2,      1,      8,      0,      false,
+        2,      1,      8,      0,      false,  0,
         "RenderMaterials",
         "material manager requests"
     },
     { // AP_AGENT
-        2,      1,      32,     0,      false,
+        2,      1,      32,     0,      false,  0,
         "Agent",
         "Agent requests"
     }
@@ -133,7 +134,8 @@ static void ssl_verification_changed();
 LLAppCoreHttp::HttpClass::HttpClass()
     : mPolicy(LLCore::HttpRequest::DEFAULT_POLICY_ID),
       mConnLimit(0U),
-      mPipelined(false)
+      mPipelined(false),
+      mHttp2(false)
 {}
 
 
@@ -142,7 +144,9 @@ LLAppCoreHttp::LLAppCoreHttp()
       mStopHandle(LLCORE_HTTP_HANDLE_INVALID),
       mStopRequested(0.0),
       mStopped(false),
-      mPipelined(true)
+      mPipelined(true),
+      mHttp2(false),
+      mServiceThreads(false)
 {}
 
 
@@ -269,6 +273,22 @@ void LLAppCoreHttp::init()
         }
     }
 
+    // Global HTTP/2 setting
+    static const std::string http_http2("HttpHTTP2");
+    if (gSavedSettings.controlExists(http_http2))
+    {
+        mHttp2 = gSavedSettings.getBOOL(http_http2);
+        LL_INFOS("Init") << "HTTP/2 " << (mHttp2 ? "enabled" : "disabled") << "!" << LL_ENDL;
+    }
+
+    // Global dedicated service thread setting
+    static const std::string http_service_threads("HttpServiceThreads");
+    if (gSavedSettings.controlExists(http_service_threads))
+    {
+        mServiceThreads = gSavedSettings.getBOOL(http_service_threads);
+        LL_INFOS("Init") << "HTTP service threads " << (mServiceThreads ? "enabled" : "disabled") << "!" << LL_ENDL;
+    }
+
     // Need a request object to handle dynamic options before setting them
     mRequest = new LLCore::HttpRequest;
 
@@ -428,6 +448,40 @@ void LLAppCoreHttp::refreshSettings(bool initial)
 
         }
 
+        // HTTP/2 multiplexing for classes that would otherwise pipeline.
+        // Static only as libcurl doesn't tolerate switching a multi
+        // handle's multiplexing with transfers in flight.
+        if (initial && init_data[i].mPipelined && mHttp2)
+        {
+            status = LLCore::HttpRequest::setStaticPolicyOption(LLCore::HttpRequest::PO_HTTP_VERSION,
+                                                                mHttpClasses[app_policy].mPolicy,
+                                                                2L,
+                                                                NULL);
+            if (! status)
+            {
+                LL_WARNS("Init") << "Unable to enable HTTP/2 for " << init_data[i].mUsage
+                                 << ".  Reason:  " << status.toString()
+                                 << LL_ENDL;
+            }
+            mHttpClasses[app_policy].mHttp2 = bool(status);
+        }
+
+        // Move busy classes off the main service thread so their
+        // transfers don't delay completions for everyone else.
+        if (initial && mServiceThreads && init_data[i].mThread)
+        {
+            status = LLCore::HttpRequest::setStaticPolicyOption(LLCore::HttpRequest::PO_SERVICE_THREAD,
+                                                                mHttpClasses[app_policy].mPolicy,
+                                                                init_data[i].mThread,
+                                                                NULL);
+            if (! status)
+            {
+                LL_WARNS("Init") << "Unable to assign service thread for " << init_data[i].mUsage
+                                 << ".  Reason:  " << status.toString()
+                                 << LL_ENDL;
+            }
+        }
+
         // Init- or run-time settings.  Must use the queued request API.
 
         // Pipelining changes
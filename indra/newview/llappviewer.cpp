@@ -37,6 +37,7 @@
 #include "llerrorcontrol.h"
 #include "lleventtimer.h"
 #include "llfile.h"
+#include "llframearena.h"
 #include "llviewertexturelist.h"
 #include "llgroupmgr.h"
 #include "llagent.h"
@@ -50,6 +51,7 @@
 #include "llwindow.h"
 #include "llviewerstats.h"
 #include "llviewerstatsrecorder.h"
+#include "llviewertelemetry.h"
 #include "llkeyconflict.h" // for legacy keybinding support, remove later
 #include "llmarketplacefunctions.h"
 #include "llmarketplacenotifications.h"
@@ -128,6 +130,7 @@
 #include "llavatarnamecache.h"
 #include "lldiriterator.h"
 #include "llexperiencecache.h"
+#include "llhttpresponsecache.h"
 #include "llimagej2c.h"
 #include "llmemory.h"
 #include "llprimitive.h"
@@ -1496,6 +1499,7 @@ bool LLAppViewer::init()
     LLEnvironment::createInstance();
     LLWorld::createInstance();
     LLViewerStatsRecorder::createInstance();
+    LLViewerTelemetry::createInstance();
     LLSelectMgr::createInstance();
     LLViewerCamera::createInstance();
     LL::GLTFSceneManager::createInstance();
@@ -1661,6 +1665,9 @@ bool LLAppViewer::doFrame()
 
         LLTrace::get_thread_recorder()->pullFromChildren();
 
+        // Release the last frame's temporaries
+        LLFrameArena::current().reset();
+
         //clear call stack records
         LL_CLEAR_CALLSTACKS();
     }
@@ -1766,6 +1773,11 @@ bool LLAppViewer::doFrame()
                 }
             }
 
+            if (LLViewerTelemetry::instanceExists())
+            {
+                LLViewerTelemetry::instance().idle();
+            }
+
             if (gDoDisconnect && (LLStartUp::getStartupState() == STATE_STARTED))
             {
                 LL_PROFILE_ZONE_NAMED_CATEGORY_APP("Shutdown:SaveSnapshot");
@@ -2551,6 +2563,7 @@ bool LLAppViewer::cleanup()
     LLEnvironment::deleteSingleton();
     LLSelectMgr::deleteSingleton();
     LLViewerStatsRecorder::deleteSingleton();
+    LLViewerTelemetry::deleteSingleton();
     LLViewerEventRecorder::deleteSingleton();
     LLWorld::deleteSingleton();
     LLVoiceClient::deleteSingleton();
@@ -5142,6 +5155,18 @@ bool LLAppViewer::initCache()
     }
     // </FS:Ansariel>
 
+    // Response cache for capability GETs that opt in
+    const U32 http_cache_mb = gSavedSettings.getU32("HttpResponseCacheSize");
+    if (http_cache_mb && !read_only && !LLCoreHttpUtil::HttpResponseCache::instanceExists())
+    {
+        LLCoreHttpUtil::HttpResponseCache::createInstance(gDirUtilp->getExpandedFilename(LL_PATH_CACHE, "httpcache"),
+                                                         U64(http_cache_mb) * 1024 * 1024);
+        if (mPurgeCache)
+        {
+            LLCoreHttpUtil::HttpResponseCache::instance().clear();
+        }
+    }
+
     // <FS:ND> For Windows, purging the cache can take an extraordinary amount of time. Rename the cache dir and purge it using another thread.
     startCachePurge();
     // </FS:ND>
@@ -6336,6 +6361,7 @@ void LLAppViewer::disconnectViewer()
 
     LLAvatarNameCache::instance().setCustomNameCheckCallback(LLAvatarNameCache::custom_name_check_callback_t()); // <FS:Ansariel> Contact sets
     saveNameCache();
+    LLCoreHttpUtil::HttpResponseCache::deleteSingleton();
     if (LLExperienceCache::instanceExists())
     {
         // TODO: LLExperienceCache::cleanup() logic should be moved to
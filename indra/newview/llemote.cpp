@@ -95,7 +95,7 @@ bool LLEmote::onActivate()
         // <FS:Ansariel> [Legacy Bake]
         //mParam->setWeight(0.f);
         mParam->setWeight(0.f, false);
-        mCharacter->updateVisualParams();
+        mCharacter->requestVisualParamsUpdate();
     }
 
     return true;
@@ -131,7 +131,7 @@ bool LLEmote::onUpdate(F32 time, U8* joint_mask)
             default_param->setWeight( default_param_weight, false);
         }
 
-        mCharacter->updateVisualParams();
+        mCharacter->requestVisualParamsUpdate();
     }
 
     return true;
@@ -158,7 +158,7 @@ void LLEmote::onDeactivate()
         default_param->setWeight( default_param->getMaxWeight(), false);
     }
 
-    mCharacter->updateVisualParams();
+    mCharacter->requestVisualParamsUpdate();
 }
 
 
@@ -37,6 +37,7 @@
 #include "v3color.h"
 
 #include "lldefs.h"
+#include "hbxxh.h"
 
 #include "lldrawpoolavatar.h"
 #include "lldrawpoolbump.h"
@@ -1183,6 +1184,84 @@ void push_for_transform(LLVertexBuffer* buff, U32 source_count, U32 dest_count)
     }
 }
 
+U64 LLFace::calcBatchKey() const
+{
+    if (mVertexBuffer.isNull() || !mDrawablep || mVObjp.isNull())
+    {
+        return 0;
+    }
+
+    const LLTextureEntry* tep = getTextureEntry();
+    if (!tep)
+    {
+        return 0;
+    }
+
+    // vertex colour, texture mapping and glow strength only reach the
+    // vertex data, so they are left out
+    const void* ptrs[] =
+    {
+        mVertexBuffer.get(),
+        getTexture(),
+        mVObjp->getTENormalMap(mTEOffset),
+        mVObjp->getTESpecularMap(mTEOffset),
+        tep->getMaterialParams().get(),
+        tep->getGLTFRenderMaterial(),
+        mAvatar
+    };
+
+    F32 alpha = tep->getColor().mV[VALPHA];
+    U8 flags[] =
+    {
+        tep->getBumpmap(),
+        tep->getShiny(),
+        tep->getFullbright(),
+        tep->getMediaTexGen(),
+        (U8)(alpha <= 0.f ? 2 : (alpha < 0.999f ? 1 : 0)),
+        (U8)(tep->getGlow() > 0.f),
+        (U8)(tep->isSelected() || mVObjp->isSelected()),
+        mTextureIndex
+    };
+
+    U64 skin_hash = mSkinInfo ? mSkinInfo->mHash : 0;
+
+    HBXXH64 hash;
+    hash.update((const void*)ptrs, sizeof(ptrs));
+    hash.update((const void*)flags, sizeof(flags));
+    hash.update((const void*)&skin_hash, sizeof(skin_hash));
+    hash.update((const void*)tep->getMaterialID().get(), MATERIAL_ID_SIZE);
+    hash.update((const void*)&mState, sizeof(mState));
+    hash.update((const void*)&mPoolType, sizeof(mPoolType));
+
+    U64 key = hash.digest();
+    return key ? key : 1;
+}
+
+bool LLFace::canGetGeometryVolumeOffThread() const
+{
+    if (!mDrawablep || mVObjp.isNull())
+    {
+        return false;
+    }
+
+    const LLTextureEntry* tep = getTextureEntry();
+    if (!tep)
+    {
+        return false;
+    }
+
+    // selected faces may clone mVertexBuffer into mVertexBufferGLTF, and
+    // a clone left over from a selection gets released
+    if (tep->isSelected() || mVertexBufferGLTF.notNull())
+    {
+        return false;
+    }
+
+    // animated children get their relative transform swapped in and out
+    // around each face
+    return !mDrawablep->isState(LLDrawable::ANIMATED_CHILD);
+}
+
 bool LLFace::getGeometryVolume(const LLVolume& volume,
                                 S32 face_index,
                                 const LLMatrix4& mat_vert_in,
@@ -164,6 +164,10 @@ public:
                             bool force_rebuild = false,
                             bool no_debug_assert = false,
                             bool rebuild_for_gltf = false);
+    // true if getGeometryVolume() can run on a worker thread for this face:
+    // it won't create or release a GL buffer, and its object's transform
+    // doesn't get swapped around the rebuild
+    bool canGetGeometryVolumeOffThread() const;
 
     // For avatar
     U16          getGeometryAvatar(
@@ -240,6 +244,15 @@ public:
     void setDrawOrderIndex(U32 index) { mDrawOrderIndex = index; }
     U32 getDrawOrderIndex() const { return mDrawOrderIndex; }
 
+    // hash of everything that decides which render batches and draw infos
+    // this face lands in, recorded when its group was last built.  While it
+    // still matches calcBatchKey(), the face can be updated in place in its
+    // current vertex buffer range without rebuilding the group.  0 when the
+    // face has no buffer.
+    U64 calcBatchKey() const;
+    void setBatchKey(U64 key) { mBatchKey = key; }
+    U64 getBatchKey() const { return mBatchKey; }
+
     // return true if this face is in an alpha draw pool
     bool isInAlphaPool() const;
 public: //aligned members
@@ -317,6 +330,7 @@ private:
     bool        mIsMediaAllowed;
 
     U32 mDrawOrderIndex = 0; // see setDrawOrderIndex
+    U64 mBatchKey = 0; // see setBatchKey
 
 // [SL:KB] - Patch: Render-TextureToggle (Catznip-4.0)
     mutable bool                       mShowDiffTexture;
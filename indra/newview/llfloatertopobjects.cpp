@@ -58,6 +58,20 @@
 // <FS:Ansariel> Name returned if object is not an avatar (with and without display names)
 const std::string OBJECT_NOT_AVATAR_NAME = "(?\?\?) (?\?\?)";
 
+// Columns of objects_list, in the order of the floater's XUI
+enum EObjectsColumn
+{
+    COLUMN_SCORE,
+    COLUMN_NAME,
+    COLUMN_OWNER,
+    COLUMN_LOCATION,
+    COLUMN_PARCEL,
+    COLUMN_TIME,
+    COLUMN_URLS,
+    COLUMN_MEMORY,
+    COLUMN_COUNT
+};
+
 //LLFloaterTopObjects* LLFloaterTopObjects::sInstance = NULL;
 
 // Globals
@@ -213,58 +227,31 @@ void LLFloaterTopObjects::handleReply(LLMessageSystem *msg, void** data)
             }
         }
 
-        LLSD element;
-
-        element["id"] = task_id;
-
-        LLSD columns;
-        S32 column_num = 0;
-        columns[column_num]["column"] = "score";
-        columns[column_num]["value"] = llformat("%0.3f", score);
-        columns[column_num++]["font"] = "SANSSERIF";
-
-        columns[column_num]["column"] = "name";
-        columns[column_num]["value"] = name_buf;
-        columns[column_num++]["font"] = "SANSSERIF";
-
         // Owner names can have trailing spaces sent from server
         LLStringUtil::trim(owner_buf);
 
         // *TODO: Send owner_id from server and look up display name
         owner_buf = LLCacheName::buildUsername(owner_buf);
 
-        columns[column_num]["column"] = "owner";
-        columns[column_num]["value"] = owner_buf;
-        columns[column_num++]["font"] = "SANSSERIF";
-
-        columns[column_num]["column"] = "location";
-        columns[column_num]["value"] = llformat("<%0.f, %0.f, %0.f>", location_x, location_y, location_z);
-        columns[column_num++]["font"] = "SANSSERIF";
-
-        columns[column_num]["column"] = "parcel";
-        columns[column_num]["value"] = parcel_buf;
-        columns[column_num++]["font"] = "SANSSERIF";
-
-        columns[column_num]["column"] = "time";
-        columns[column_num]["type"] = "date";
-        columns[column_num]["value"] = LLDate((double)time_stamp);
-        columns[column_num++]["font"] = "SANSSERIF";
+        // A region can report thousands of objects, so they go in as
+        // virtual rows, in the order of the columns of objects_list.
+        // The time is written so that it sorts as text.
+        std::vector<std::string> columns(COLUMN_COUNT);
+        columns[COLUMN_SCORE] = llformat("%0.3f", score);
+        columns[COLUMN_NAME] = name_buf;
+        columns[COLUMN_OWNER] = owner_buf;
+        columns[COLUMN_LOCATION] = llformat("<%0.f, %0.f, %0.f>", location_x, location_y, location_z);
+        columns[COLUMN_PARCEL] = parcel_buf;
+        columns[COLUMN_TIME] = LLDate((double)time_stamp).toHTTPDateString("%Y-%m-%d %H:%M:%S");
 
         if (mCurrentMode == STAT_REPORT_TOP_SCRIPTS
             && have_extended_data)
         {
-            columns[column_num]["column"] = "memory";
-            columns[column_num]["value"] = llformat("%0.0f", (script_memory / 1024.f));
-            columns[column_num++]["font"] = "SANSSERIF";
-
-            columns[column_num]["column"] = "URLs";
-            columns[column_num]["value"] = llformat("%d", public_urls);
-            columns[column_num++]["font"] = "SANSSERIF";
+            columns[COLUMN_MEMORY] = llformat("%0.0f", (script_memory / 1024.f));
+            columns[COLUMN_URLS] = llformat("%d", public_urls);
         }
-        element["columns"] = columns;
-        list->addElement(element);
+        list->addVirtualRow(columns, task_id);
 
-        mObjectListData.append(element);
         mObjectListIDs.push_back(task_id);
 
         mtotalScore += score;
@@ -351,9 +338,9 @@ void LLFloaterTopObjects::updateSelectionInfo()
     llassert(sli);
     if (sli)
     {
-        getChild<LLUICtrl>("object_name_editor")->setValue(sli->getColumn(1)->getValue().asString());
-        getChild<LLUICtrl>("owner_name_editor")->setValue(sli->getColumn(2)->getValue().asString());
-        getChild<LLUICtrl>("parcel_name_editor")->setValue(sli->getColumn(4)->getValue().asString());
+        getChild<LLUICtrl>("object_name_editor")->setValue(sli->getColumn(COLUMN_NAME)->getValue().asString());
+        getChild<LLUICtrl>("owner_name_editor")->setValue(sli->getColumn(COLUMN_OWNER)->getValue().asString());
+        getChild<LLUICtrl>("parcel_name_editor")->setValue(sli->getColumn(COLUMN_PARCEL)->getValue().asString());
     }
 }
 
@@ -454,7 +441,6 @@ void LLFloaterTopObjects::clearList()
         list->operateOnAll(LLCtrlListInterface::OP_DELETE);
     }
 
-    mObjectListData.clear();
     mObjectListIDs.clear();
     mtotalScore = 0.f;
 
@@ -533,8 +519,8 @@ void LLFloaterTopObjects::showBeacon()
     LLScrollListItem* first_selected = list->getFirstSelected();
     if (!first_selected) return;
 
-    std::string name = first_selected->getColumn(1)->getValue().asString();
-    std::string pos_string =  first_selected->getColumn(3)->getValue().asString();
+    std::string name = first_selected->getColumn(COLUMN_NAME)->getValue().asString();
+    std::string pos_string =  first_selected->getColumn(COLUMN_LOCATION)->getValue().asString();
 
     F32 x, y, z;
     S32 matched = sscanf(pos_string.c_str(), "<%g,%g,%g>", &x, &y, &z);
@@ -596,7 +582,7 @@ void LLFloaterTopObjects::onTeleportToObject()
     LLScrollListItem* first_selected = mObjectsScrollList->getFirstSelected();
     if (!first_selected) return;
 
-    std::string pos_string = first_selected->getColumn(3)->getValue().asString();
+    std::string pos_string = first_selected->getColumn(COLUMN_LOCATION)->getValue().asString();
 
     F32 x, y, z;
     S32 matched = sscanf(pos_string.c_str(), "<%g,%g,%g>", &x, &y, &z);
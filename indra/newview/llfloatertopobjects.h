@@ -111,7 +111,6 @@ private:
 private:
     std::string mMethod;
 
-    LLSD mObjectListData;
     uuid_vec_t mObjectListIDs;
 
     U32 mCurrentMode;
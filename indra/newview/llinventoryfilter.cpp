@@ -35,6 +35,7 @@
 #include "llinventorymodel.h"
 #include "llinventorymodelbackgroundfetch.h"
 #include "llinventoryfunctions.h"
+#include "llinventorysearchindex.h"
 #include "llmarketplacefunctions.h"
 #include "llregex.h"
 #include "llviewercontrol.h"
@@ -56,6 +57,15 @@
 
 #include "llinventorydefines.h"     // <FS:Zi> FIRE-31369: Add inventory filter for coalesced objects
 
+struct LLInventoryFilter::IndexedSearch
+{
+    std::string                                 mSubString;
+    LLInventoryFilter::ESearchType              mSearchType;
+    LLInventorySearchIndex*                     mIndex;
+    U32                                         mGeneration;
+    LLInventorySearchIndex::result_ptr_t        mMatches;   // Null until the search is done
+};
+
 LLInventoryFilter::FilterOps::FilterOps(const Params& p)
 :   mFilterObjectTypes(p.object_types),
     mFilterCategoryTypes(p.category_types),
@@ -111,27 +121,32 @@ bool LLInventoryFilter::check(const LLFolderViewModelItem* item)
         return true;
     }
 
-    std::string desc = listener->getSearchableCreatorName();
-    switch(mSearchType)
+    const bool use_index = isAnsweredByIndex(listener);
+
+    std::string desc;
+    if (!use_index)
     {
-        case SEARCHTYPE_CREATOR:
-            desc = listener->getSearchableCreatorName();
-            break;
-        case SEARCHTYPE_DESCRIPTION:
-            desc = listener->getSearchableDescription();
-            break;
-        case SEARCHTYPE_UUID:
-            desc = listener->getSearchableUUIDString();
-            break;
-        // <FS:Ansariel> Allow searching by all
-        case SEARCHTYPE_ALL:
-            desc = listener->getSearchableAll();
-            break;
-        // </FS:Ansariel>
-        case SEARCHTYPE_NAME:
-        default:
-            desc = listener->getSearchableName();
-            break;
+        switch(mSearchType)
+        {
+            case SEARCHTYPE_CREATOR:
+                desc = listener->getSearchableCreatorName();
+                break;
+            case SEARCHTYPE_DESCRIPTION:
+                desc = listener->getSearchableDescription();
+                break;
+            case SEARCHTYPE_UUID:
+                desc = listener->getSearchableUUIDString();
+                break;
+            // <FS:Ansariel> Allow searching by all
+            case SEARCHTYPE_ALL:
+                desc = listener->getSearchableAll();
+                break;
+            // </FS:Ansariel>
+            case SEARCHTYPE_NAME:
+            default:
+                desc = listener->getSearchableName();
+                break;
+        }
     }
 
     bool passed = true;
@@ -167,6 +182,10 @@ bool LLInventoryFilter::check(const LLFolderViewModelItem* item)
             }
         }
     }
+    else if (use_index)
+    {
+        passed = mIndexedSearch->mMatches->count(listener->getUUID()) > 0;
+    }
     else
     {
         passed = (mFilterSubString.size() ? desc.find(mFilterSubString) != std::string::npos : true);
@@ -708,6 +727,11 @@ std::string::size_type LLInventoryFilter::getStringMatchOffset(LLFolderViewModel
     if (mSearchType == SEARCHTYPE_NAME || mSearchType == SEARCHTYPE_ALL)
     // </FS:Ansariel>
     {
+        const LLFolderViewModelItemInventory* listener = static_cast<const LLFolderViewModelItemInventory*>(item);
+        if (isAnsweredByIndex(listener) && !mIndexedSearch->mMatches->count(listener->getUUID()))
+        {
+            return std::string::npos;
+        }
         return mFilterSubString.size() ? item->getSearchableName().find(mFilterSubString) : std::string::npos;
     }
     else
@@ -795,6 +819,7 @@ void LLInventoryFilter::setSearchType(ESearchType type)
     {
         mSearchType = type;
         setModified();
+        updateIndexedSearch();
     }
 }
 
@@ -1011,6 +1036,80 @@ void LLInventoryFilter::setFilterUUID(const LLUUID& object_id)
     mFilterOps.mFilterTypes = FILTERTYPE_UUID;
 }
 
+void LLInventoryFilter::updateIndexedSearch()
+{
+    mIndexedSearch.reset();
+
+    LLInventorySearchIndex::EField field;
+    switch (mSearchType)
+    {
+        case SEARCHTYPE_NAME:
+            // Token and exact word searches look at the words of the
+            // displayed name, leave them to check()
+            if (!mFilterTokens.empty() || !mExactToken.empty())
+            {
+                return;
+            }
+            field = LLInventorySearchIndex::FIELD_NAME;
+            break;
+        case SEARCHTYPE_DESCRIPTION:
+            field = LLInventorySearchIndex::FIELD_DESCRIPTION;
+            break;
+        case SEARCHTYPE_CREATOR:
+            field = LLInventorySearchIndex::FIELD_CREATOR;
+            break;
+        default:
+            return;
+    }
+    if (mFilterSubString.empty())
+    {
+        return;
+    }
+
+    mIndexedSearch = std::make_shared<IndexedSearch>();
+    mIndexedSearch->mSubString = mFilterSubString;
+    mIndexedSearch->mSearchType = mSearchType;
+    mIndexedSearch->mIndex = LLInventorySearchIndex::getInstance();
+
+    // The filter may be gone, or searching for something else, by the
+    // time the answer arrives.
+    std::weak_ptr<IndexedSearch> weak_search = mIndexedSearch;
+    if (!mIndexedSearch->mIndex->find(field, mFilterSubString,
+        [weak_search](const LLInventorySearchIndex::result_ptr_t& matches)
+        {
+            if (auto search = weak_search.lock())
+            {
+                search->mMatches = matches;
+            }
+        }))
+    {
+        mIndexedSearch.reset();
+        return;
+    }
+    mIndexedSearch->mGeneration = mIndexedSearch->mIndex->getGeneration();
+}
+
+bool LLInventoryFilter::isAnsweredByIndex(const LLFolderViewModelItemInventory* listener) const
+{
+    if (!mIndexedSearch || !mIndexedSearch->mMatches
+        || mIndexedSearch->mSearchType != mSearchType || mIndexedSearch->mSubString != mFilterSubString)
+    {
+        return false;
+    }
+    // Folders, items changed since the search, and items the index
+    // doesn't know (such as those in an object's contents) are checked
+    // one by one
+    if (mIndexedSearch->mGeneration != mIndexedSearch->mIndex->getGeneration()
+        || !mIndexedSearch->mIndex->isIndexed(listener->getUUID()))
+    {
+        return false;
+    }
+    // The index holds model names, so are items showing a suffix such
+    // as " (worn)" after theirs
+    return mSearchType != SEARCHTYPE_NAME
+        || listener->getSearchableName().size() == listener->getDisplayName().size();
+}
+
 void LLInventoryFilter::setFilterSubString(const std::string& string)
 {
     std::string filter_sub_string_new = string;
@@ -1061,6 +1160,7 @@ void LLInventoryFilter::setFilterSubString(const std::string& string)
             && !filter_sub_string_new.substr(0, mFilterSubString.size()).compare(mFilterSubString);
 
         mFilterSubString = filter_sub_string_new;
+        updateIndexedSearch();
         if (exact_token_changed)
         {
             setModified(FILTER_RESTART);
@@ -1855,7 +1955,9 @@ LLInventoryFilter::EFilterCreatorType LLInventoryFilter::getFilterCreatorType()
 
 bool LLInventoryFilter::isTimedOut()
 {
-    return mFilterTime.hasExpired();
+    // Hold the filter pass while the search index works on the current
+    // search string, so that the pass runs once, with its answer.
+    return mFilterTime.hasExpired() || (mIndexedSearch && !mIndexedSearch->mMatches);
 }
 
 void LLInventoryFilter::resetTime(S32 timeout)
@@ -371,6 +371,8 @@ private:
     bool                checkAgainstCreator(const class LLFolderViewModelItemInventory* listener) const;
     bool                checkAgainstSearchVisibility(const class LLFolderViewModelItemInventory* listener) const;
     bool                checkAgainstClipboard(const LLUUID& object_id) const;
+    void                updateIndexedSearch();
+    bool                isAnsweredByIndex(const class LLFolderViewModelItemInventory* listener) const;
 
     FilterOps               mFilterOps;
     FilterOps               mDefaultFilterOps;
@@ -401,6 +403,12 @@ private:
     std::vector<std::string> mFilterTokens;
     std::string              mExactToken;
 
+    // Name, description and creator searches are answered by the
+    // inventory search index in the background.  The filter pass waits
+    // for the answer, see isTimedOut().
+    struct IndexedSearch;
+    std::shared_ptr<IndexedSearch> mIndexedSearch;
+
     bool mSingleFolderMode;
 };
 
@@ -0,0 +1,193 @@
+/**
+ * @file llinventorysearchindex.cpp
+ * @brief Background substring search over inventory descriptions and creators
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+
+#include "llinventorysearchindex.h"
+
+#include "llavatarnamecache.h"
+#include "llinventorymodel.h"
+#include "llviewerinventory.h"
+#include "workqueue.h"
+
+LLInventorySearchIndex::LLInventorySearchIndex()
+:   mIndex(std::make_shared<Index>()),
+    mGeneration(0),
+    mBuilt(false)
+{
+    gInventory.addObserver(this);
+}
+
+LLInventorySearchIndex::~LLInventorySearchIndex()
+{
+    if (gInventory.containsObserver(this))
+    {
+        gInventory.removeObserver(this);
+    }
+}
+
+S32 LLInventorySearchIndex::getItemCount() const
+{
+    return mIndex->mTrigrams.size();
+}
+
+bool LLInventorySearchIndex::find(EField field, const std::string& substring, callback_t callback)
+{
+    LL::WorkQueue::ptr_t main_queue = LL::WorkQueue::getInstance("mainloop");
+    LL::WorkQueue::ptr_t general_queue = LL::WorkQueue::getInstance("General");
+    if (!main_queue || !general_queue)
+    {
+        return false;
+    }
+
+    if (!mBuilt)
+    {
+        build();
+    }
+
+    // Creator names live in the avatar name cache, which is only safe
+    // to use here on the main thread.  There are far fewer creators
+    // than items, so resolve which of them match and leave the worker
+    // to find their items.  The main thread is the only writer of the
+    // index, so no lock is needed to read it here.
+    id_set_t creators;
+    if (field == FIELD_CREATOR)
+    {
+        for (const auto& creator : mIndex->mTrigrams.getGroups())
+        {
+            LLAvatarName av_name;
+            if (creator.first.notNull() && LLAvatarNameCache::get(creator.first, &av_name))
+            {
+                std::string username = av_name.getUserName();
+                LLStringUtil::toUpper(username);
+                if (username.find(substring) != std::string::npos)
+                {
+                    creators.insert(creator.first);
+                }
+            }
+        }
+    }
+
+    std::shared_ptr<Index> index = mIndex;
+    return main_queue->postTo(
+        general_queue,
+        [index, field, substring, creators = std::move(creators)]() // Work done on general queue
+        {
+            LL_PROFILE_ZONE_NAMED("inventory index search");
+            auto matches = std::make_shared<id_set_t>();
+            LLSharedMutexLock lock(&index->mMutex);
+            if (field == FIELD_CREATOR)
+            {
+                index->mTrigrams.searchGroups(creators, *matches);
+            }
+            else
+            {
+                index->mTrigrams.search(field, substring, *matches);
+            }
+            return result_ptr_t(matches);
+        },
+        [callback](result_ptr_t matches) // Callback to main thread
+        {
+            callback(matches);
+        });
+}
+
+void LLInventorySearchIndex::changed(U32 mask)
+{
+    if (!mBuilt)
+    {
+        return;
+    }
+
+    const LLInventoryModel::changed_items_t& changed_ids = gInventory.getChangedIDs();
+    if (changed_ids.count(LLUUID::null))
+    {
+        // Something changed without saying what, start over on next use.
+        // Queries in flight keep the old index alive.
+        mIndex = std::make_shared<Index>();
+        mBuilt = false;
+        ++mGeneration;
+        return;
+    }
+
+    bool modified = false;
+    LLExclusiveMutexLock lock(&mIndex->mMutex);
+    for (const LLUUID& id : changed_ids)
+    {
+        // Most changes (worn state, moves) leave what we index alone,
+        // the trigram index sees that and keeps the document.
+        const LLViewerInventoryItem* item = gInventory.getItem(id);
+        if (item)
+        {
+            modified |= updateItem(item);
+        }
+        else
+        {
+            modified |= mIndex->mTrigrams.remove(id);
+        }
+    }
+    if (modified)
+    {
+        ++mGeneration;
+    }
+}
+
+void LLInventorySearchIndex::build()
+{
+    LL_PROFILE_ZONE_SCOPED;
+
+    LLInventoryModel::cat_array_t cats;
+    LLInventoryModel::item_array_t items;
+    if (gInventory.getRootFolderID().notNull())
+    {
+        gInventory.collectDescendents(gInventory.getRootFolderID(), cats, items, LLInventoryModel::INCLUDE_TRASH);
+    }
+    if (gInventory.getLibraryRootFolderID().notNull())
+    {
+        gInventory.collectDescendents(gInventory.getLibraryRootFolderID(), cats, items, LLInventoryModel::INCLUDE_TRASH);
+    }
+
+    LLExclusiveMutexLock lock(&mIndex->mMutex);
+    for (const LLPointer<LLViewerInventoryItem>& item : items)
+    {
+        updateItem(item);
+    }
+    mBuilt = true;
+
+    LL_INFOS("Inventory") << "Indexed " << mIndex->mTrigrams.size() << " items for search" << LL_ENDL;
+}
+
+// Called with the index locked
+bool LLInventorySearchIndex::updateItem(const LLViewerInventoryItem* item)
+{
+    std::vector<std::string> fields(FIELD_COUNT);
+    fields[FIELD_NAME] = item->getName();
+    LLStringUtil::toUpper(fields[FIELD_NAME]);
+    fields[FIELD_DESCRIPTION] = item->getDescription();
+    LLStringUtil::toUpper(fields[FIELD_DESCRIPTION]);
+    return mIndex->mTrigrams.update(item->getUUID(), item->getCreatorUUID(), fields);
+}
@@ -0,0 +1,106 @@
+/**
+ * @file llinventorysearchindex.h
+ * @brief Background substring search over inventory descriptions and creators
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLINVENTORYSEARCHINDEX_H
+#define LL_LLINVENTORYSEARCHINDEX_H
+
+#include "llinventoryobserver.h"
+#include "llmutex.h"
+#include "llsingleton.h"
+#include "lltrigramindex.h"
+
+class LLViewerInventoryItem;
+
+/**
+ * Trigram index over the names, descriptions and creators of the items
+ * in the inventory model, so that searching a large inventory by those
+ * fields does not need a model lookup and string copy per item on the
+ * main thread.  Queries run on the "General" work queue and hand the
+ * set of matching item ids back on the main thread.  Results are
+ * exact, see LLTrigramIndex.
+ *
+ * Names are the model names.  Folders, whose displayed names may be
+ * localized, and items showing a state suffix such as " (worn)" are
+ * not answered by the index; LLInventoryFilter checks those itself.
+ *
+ * The index is built from gInventory by the first query and kept up
+ * to date from inventory change notifications after that.
+ */
+class LLInventorySearchIndex : public LLInventoryObserver, public LLSingleton<LLInventorySearchIndex>
+{
+    LLSINGLETON(LLInventorySearchIndex);
+    virtual ~LLInventorySearchIndex();
+
+public:
+    // Fields of the trigram index, creators are its groups
+    enum EField
+    {
+        FIELD_NAME,
+        FIELD_DESCRIPTION,
+        FIELD_COUNT,
+        FIELD_CREATOR = FIELD_COUNT
+    };
+
+    typedef LLTrigramIndex::id_set_t id_set_t;
+    typedef std::shared_ptr<const id_set_t> result_ptr_t;
+    typedef std::function<void(const result_ptr_t&)> callback_t;
+
+    /// Find the items whose upper cased name or description, or creator
+    /// user name, contains 'substring', which must already be upper
+    /// cased.  'callback' is called on the main thread once the search
+    /// is done.  Returns false, and never calls 'callback', if the
+    /// search could not be started (the viewer is shutting down).
+    bool find(EField field, const std::string& substring, callback_t callback);
+
+    /*virtual*/ void changed(U32 mask) override;
+
+    S32 getItemCount() const;
+    bool isIndexed(const LLUUID& id) const { return mIndex->mTrigrams.contains(id); }
+    /// Changes whenever the index does, answers from an older generation
+    /// may be out of date.
+    U32 getGeneration() const { return mGeneration; }
+
+private:
+    // Shared with queries in flight, so that they can outlive us
+    struct Index
+    {
+        Index() : mTrigrams(FIELD_COUNT) {}
+
+        LLTrigramIndex  mTrigrams;
+        LLSharedMutex   mMutex;
+    };
+
+    void build();
+
+    bool updateItem(const LLViewerInventoryItem* item);
+
+    std::shared_ptr<Index>  mIndex;
+    U32                     mGeneration;
+    bool                    mBuilt;
+};
+
+#endif // LL_LLINVENTORYSEARCHINDEX_H
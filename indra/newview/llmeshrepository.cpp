@@ -600,7 +600,8 @@ public:
           mProcessed(false),
           mHttpHandle(LLCORE_HTTP_HANDLE_INVALID),
           mOffset(offset),
-          mRequestedBytes(requested_bytes)
+          mRequestedBytes(requested_bytes),
+          mBodySink(std::make_shared<LLCore::HttpBodySink>(size_t(requested_bytes)))
         {}
 
     virtual ~LLMeshHandlerBase()
@@ -621,6 +622,7 @@ public:
     LLCore::HttpHandle mHttpHandle;
     U32 mOffset;
     U32 mRequestedBytes;
+    LLCore::HttpBodySink::ptr_t mBodySink;  // Response body lands here when it fits
 };
 
 
@@ -1343,13 +1345,22 @@ void LLMeshRepoThread::constructUrl(LLUUID mesh_id, std::string * url, int * leg
 LLCore::HttpHandle LLMeshRepoThread::getByteRange(const std::string & url, int legacy_cap_version,
 // </FS:Ansariel> [UDP Assets]
                                                   size_t offset, size_t len,
-                                                  const LLCore::HttpHandler::ptr_t &handler)
+                                                  const LLCore::HttpHandler::ptr_t &handler,
+                                                  const LLCore::HttpBodySink::ptr_t &sink)
 {
     // Also used in lltexturefetch.cpp
     static LLCachedControl<bool> disable_range_req(gSavedSettings, "HttpRangeRequestsDisable", false);
 
     LLCore::HttpHandle handle(LLCORE_HTTP_HANDLE_INVALID);
 
+    // Options carrying a sink are per-request
+    LLCore::HttpOptions::ptr_t options(len < LARGE_MESH_FETCH_THRESHOLD ? mHttpOptions : mHttpLargeOptions);
+    if (sink && sink->getBuffer() && ! disable_range_req)
+    {
+        options = LLCore::HttpOptions::ptr_t(new LLCore::HttpOptions(*options));
+        options->setBodySink(sink);
+    }
+
     if (len < LARGE_MESH_FETCH_THRESHOLD)
     {
         // <FS:Ansariel> [UDP Assets]
@@ -1359,7 +1370,7 @@ LLCore::HttpHandle LLMeshRepoThread::getByteRange(const std::string & url, int l
                                                     url,
                                                     (disable_range_req ? size_t(0) : offset),
                                                     (disable_range_req ? size_t(0) : len),
-                                                    mHttpOptions,
+                                                    options,
                                                     mHttpHeaders,
                                                     handler);
         if (LLCORE_HTTP_HANDLE_INVALID != handle)
@@ -1373,7 +1384,7 @@ LLCore::HttpHandle LLMeshRepoThread::getByteRange(const std::string & url, int l
                                                    url,
                                                    (disable_range_req ? size_t(0) : offset),
                                                    (disable_range_req ? size_t(0) : len),
-                                                   mHttpLargeOptions,
+                                                   options,
                                                    mHttpHeaders,
                                                    handler);
         if (LLCORE_HTTP_HANDLE_INVALID != handle)
@@ -1480,7 +1491,7 @@ bool LLMeshRepoThread::fetchMeshSkinInfo(const LLUUID& mesh_id, bool can_retry)
                 LLMeshHandlerBase::ptr_t handler(new LLMeshSkinInfoHandler(mesh_id, offset, size));
                 // <FS:Ansariel> [UDP Assets]
                 //LLCore::HttpHandle handle = getByteRange(http_url, offset, size, handler);
-                LLCore::HttpHandle handle = getByteRange(http_url, legacy_cap_version, offset, size, handler);
+                LLCore::HttpHandle handle = getByteRange(http_url, legacy_cap_version, offset, size, handler, handler->mBodySink);
                 // </FS:Ansariel> [UDP Assets]
                 if (LLCORE_HTTP_HANDLE_INVALID == handle)
                 {
@@ -1609,7 +1620,7 @@ bool LLMeshRepoThread::fetchMeshDecomposition(const LLUUID& mesh_id)
                 LLMeshHandlerBase::ptr_t handler(new LLMeshDecompositionHandler(mesh_id, offset, size));
                 // <FS:Ansariel> [UDP Assets]
                 //LLCore::HttpHandle handle = getByteRange(http_url, offset, size, handler);
-                LLCore::HttpHandle handle = getByteRange(http_url, legacy_cap_version, offset, size, handler);
+                LLCore::HttpHandle handle = getByteRange(http_url, legacy_cap_version, offset, size, handler, handler->mBodySink);
                 // </FS:Ansariel> [UDP Assets]
                 if (LLCORE_HTTP_HANDLE_INVALID == handle)
                 {
@@ -1722,7 +1733,7 @@ bool LLMeshRepoThread::fetchMeshPhysicsShape(const LLUUID& mesh_id)
                 LLMeshHandlerBase::ptr_t handler(new LLMeshPhysicsShapeHandler(mesh_id, offset, size));
                 // <FS:Ansariel> [UDP Assets]
                 //LLCore::HttpHandle handle = getByteRange(http_url, offset, size, handler);
-                LLCore::HttpHandle handle = getByteRange(http_url, legacy_cap_version, offset, size, handler);
+                LLCore::HttpHandle handle = getByteRange(http_url, legacy_cap_version, offset, size, handler, handler->mBodySink);
                 // </FS:Ansariel> [UDP Assets]
                 if (LLCORE_HTTP_HANDLE_INVALID == handle)
                 {
@@ -1802,7 +1813,7 @@ bool LLMeshRepoThread::fetchMeshHeader(const LLVolumeParams& mesh_params, bool c
             file.read(buffer, bytes);
             if (headerReceived(mesh_params, buffer, bytes) == MESH_OK)
             {
-                LL_DEBUGS(LOG_MESH) << "Mesh/Cache: Mesh header for ID " << mesh_params.getSculptID() << " - was retrieved from the cache." << LL_ENDL;
+                LL_DEBUGS_ARGS(LOG_MESH, "Mesh/Cache: Mesh header for ID ", mesh_params.getSculptID(), " - was retrieved from the cache.");
 
                 // Found mesh in cache
                 return true;
@@ -1822,7 +1833,7 @@ bool LLMeshRepoThread::fetchMeshHeader(const LLVolumeParams& mesh_params, bool c
 
     if (!http_url.empty())
     {
-        LL_DEBUGS(LOG_MESH) << "Mesh/Cache: Mesh header for ID " << mesh_params.getSculptID() << " - was retrieved from the simulator." << LL_ENDL;
+        LL_DEBUGS_ARGS(LOG_MESH, "Mesh/Cache: Mesh header for ID ", mesh_params.getSculptID(), " - was retrieved from the simulator.");
 
         //grab first 4KB if we're going to bother with a fetch.  Cache will prevent future fetches if a full mesh fits
         //within the first 4KB
@@ -1831,7 +1842,7 @@ bool LLMeshRepoThread::fetchMeshHeader(const LLVolumeParams& mesh_params, bool c
         LLMeshHandlerBase::ptr_t handler(new LLMeshHeaderHandler(mesh_params, 0, MESH_HEADER_SIZE));
         // <FS:Ansariel> [UDP Assets]
         //LLCore::HttpHandle handle = getByteRange(http_url, 0, MESH_HEADER_SIZE, handler);
-        LLCore::HttpHandle handle = getByteRange(http_url, legacy_cap_version, 0, MESH_HEADER_SIZE, handler);
+        LLCore::HttpHandle handle = getByteRange(http_url, legacy_cap_version, 0, MESH_HEADER_SIZE, handler, handler->mBodySink);
         // </FS:Ansariel> [UDP Assets]
         if (LLCORE_HTTP_HANDLE_INVALID == handle)
         {
@@ -1921,7 +1932,7 @@ bool LLMeshRepoThread::fetchMeshLOD(const LLVolumeParams& mesh_params, S32 lod,
                     {
                         delete[] buffer;
 
-                        LL_DEBUGS(LOG_MESH) << "Mesh/Cache: Mesh body for ID " << mesh_id << " - was retrieved from the cache." << LL_ENDL;
+                        LL_DEBUGS_ARGS(LOG_MESH, "Mesh/Cache: Mesh body for ID ", mesh_id, " - was retrieved from the cache.");
 
                         return true;
                     }
@@ -1940,12 +1951,12 @@ bool LLMeshRepoThread::fetchMeshLOD(const LLVolumeParams& mesh_params, S32 lod,
 
             if (!http_url.empty())
             {
-                LL_DEBUGS(LOG_MESH) << "Mesh/Cache: Mesh body for ID " << mesh_id << " - was retrieved from the simulator." << LL_ENDL;
+                LL_DEBUGS_ARGS(LOG_MESH, "Mesh/Cache: Mesh body for ID ", mesh_id, " - was retrieved from the simulator.");
 
                 LLMeshHandlerBase::ptr_t handler(new LLMeshLODHandler(mesh_params, lod, offset, size));
                 // <FS:Ansariel> [UDP Assets]
                 //LLCore::HttpHandle handle = getByteRange(http_url, offset, size, handler);
-                LLCore::HttpHandle handle = getByteRange(http_url, legacy_cap_version, offset, size, handler);
+                LLCore::HttpHandle handle = getByteRange(http_url, legacy_cap_version, offset, size, handler, handler->mBodySink);
                 // </FS:Ansariel> [UDP Assets]
                 if (LLCORE_HTTP_HANDLE_INVALID == handle)
                 {
@@ -3215,6 +3226,12 @@ void LLMeshHandlerBase::onCompleted(LLCore::HttpHandle handle, LLCore::HttpRespo
         S32 body_offset(0);
         U8 * data(NULL);
         auto data_size(body ? body->size() : 0);
+        const bool in_sink(! body && mBodySink && mBodySink->size());
+        if (in_sink)
+        {
+            // Body was written straight into our buffer
+            data_size = mBodySink->size();
+        }
 
         if (data_size > 0)
         {
@@ -3266,11 +3283,16 @@ void LLMeshHandlerBase::onCompleted(LLCore::HttpHandle handle, LLCore::HttpRespo
                 goto common_exit;
             }
 
-            // *TODO: Try to get rid of data copying and add interfaces
-            // that support BufferArray directly.  Introduce a two-phase
-            // handler, optional first that takes a body, fallback second
-            // that requires a temporary allocation and data copy.
+            // Bodies that fit the handler's sink are used in place.
+            // Otherwise the BufferArray needs a temporary allocation
+            // and data copy.
             body_offset = mOffset - offset;
+            if (in_sink)
+            {
+                LLMeshRepository::sBytesReceived += static_cast<U32>(data_size);
+                processData(body, body_offset, mBodySink->getData() + body_offset, static_cast<S32>(data_size) - body_offset);
+                goto common_exit;
+            }
             data = new(std::nothrow) U8[data_size - body_offset];
             if (data)
             {
@@ -474,7 +474,8 @@ private:
     LLCore::HttpHandle getByteRange(const std::string & url, int legacy_cap_version,
     // </FS:Ansariel> [UDP Assets]
                                     size_t offset, size_t len,
-                                    const LLCore::HttpHandler::ptr_t &handler);
+                                    const LLCore::HttpHandler::ptr_t &handler,
+                                    const LLCore::HttpBodySink::ptr_t &sink = LLCore::HttpBodySink::ptr_t());
 };
 
 
@@ -477,7 +477,7 @@ bool LLPhysicsMotionController::onUpdate(F32 time, U8* joint_mask)
     }
 
     if (update_visuals)
-            mCharacter->updateVisualParams();
+            mCharacter->requestVisualParamsUpdate();
 
     return true;
 }
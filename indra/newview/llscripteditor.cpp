@@ -117,15 +117,16 @@ void LLScriptEditor::drawLineNumbers()
         for (S32 cur_line = first_line; cur_line < num_lines; cur_line++)
         {
             line_info& line = mLineInfoList[cur_line];
+            LLRect line_rect = getLineRect(line);
 
-            if ((line.mRect.mTop - scrolled_view_rect.mBottom) < mVisibleTextRect.mBottom)
+            if ((line_rect.mTop - scrolled_view_rect.mBottom) < mVisibleTextRect.mBottom)
             {
                 break;
             }
 
-            S32 line_bottom = line.mRect.mBottom - scrolled_view_rect.mBottom + mVisibleTextRect.mBottom;
+            S32 line_bottom = line_rect.mBottom - scrolled_view_rect.mBottom + mVisibleTextRect.mBottom;
             // draw the line numbers
-            if(line.mLineNum != last_line_num && line.mRect.mTop <= scrolled_view_rect.mTop)
+            if(line.mLineNum != last_line_num && line_rect.mTop <= scrolled_view_rect.mTop)
             {
                 const LLWString ltext = utf8str_to_wstring(llformat("%d", line.mLineNum ));
                 bool is_cur_line = cursor_line == line.mLineNum;
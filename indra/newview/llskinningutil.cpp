@@ -283,6 +283,72 @@ void LLSkinningUtil::getPerVertexSkinMatrix(
     (void)valid_weights;
 }
 
+void LLSkinningUtil::initBindShapePalette(LLMatrix4a* palette, const LLMatrix4a* mat, U32 count, const LLMatrix4a& bind_shape)
+{
+    // palette[j](v) == mat[j](bind_shape(v)); the w column is ignored by
+    // affineTransform() so this stays exact for any bind shape matrix.
+    for (U32 j = 0; j < count; ++j)
+    {
+        mat[j].rotate(bind_shape.mMatrix[0], palette[j].mMatrix[0]);
+        mat[j].rotate(bind_shape.mMatrix[1], palette[j].mMatrix[1]);
+        mat[j].rotate(bind_shape.mMatrix[2], palette[j].mMatrix[2]);
+        mat[j].affineTransform(bind_shape.mMatrix[3], palette[j].mMatrix[3]);
+    }
+}
+
+void LLSkinningUtil::skinFacePositions(const LLVolumeFace& src_face, const LLMatrix4a* palette, U32 max_joints,
+                                       LLVector4a* dst, LLVector4a& min, LLVector4a& max)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+
+    static const U32 BLOCK_SIZE = 32;
+    LLMatrix4a blended[BLOCK_SIZE];
+
+    const U32 num_vertices = src_face.mNumVertices;
+    const LLVector4a* src = src_face.mPositions;
+
+    min.splat(F32_MAX);
+    max.splat(-F32_MAX);
+
+    for (U32 block = 0; block < num_vertices; block += BLOCK_SIZE)
+    {
+        const U32 block_end = llmin(block + BLOCK_SIZE, num_vertices);
+
+    #if USE_SEPARATE_JOINT_INDICES_AND_WEIGHTS
+        if (src_face.mJointIndices) // preconditioned joint indices
+        {
+            const U8* idx = src_face.mJointIndices + block * 4;
+            for (U32 j = block; j < block_end; ++j, idx += 4)
+            {
+                const F32* w = src_face.mJustWeights[j].getF32ptr();
+                LLMatrix4a& final_mat = blended[j - block];
+                final_mat.setMul(palette[idx[0]], w[0]);
+                for (U32 k = 1; k < 4; ++k)
+                {
+                    LLMatrix4a src_mat;
+                    src_mat.setMul(palette[idx[k]], w[k]);
+                    final_mat.add(src_mat);
+                }
+            }
+        }
+        else
+    #endif
+        {
+            for (U32 j = block; j < block_end; ++j)
+            {
+                FSSkinningUtil::getPerVertexSkinMatrixSSE(src_face.mWeights[j], palette, false, blended[j - block], max_joints);
+            }
+        }
+
+        for (U32 j = block; j < block_end; ++j)
+        {
+            blended[j - block].affineTransform(src[j], dst[j]);
+            min.setMin(min, dst[j]);
+            max.setMax(max, dst[j]);
+        }
+    }
+}
+
 void LLSkinningUtil::initJointNums(LLMeshSkinInfo* skin, LLVOAvatar *avatar)
 {
     if (!skin->mJointNumsInitialized)
@@ -66,6 +66,19 @@ namespace LLSkinningUtil
         final_mat.add(src[3]);
     }
 
+    // Folds the bind shape matrix into each joint matrix of a palette from
+    // initSkinningMatrixPalette() so that skinning a vertex takes a single
+    // affine transform.
+    void initBindShapePalette(LLMatrix4a* palette, const LLMatrix4a* mat, U32 count, const LLMatrix4a& bind_shape);
+
+    // Skins the positions of a rigged face against a palette from
+    // initBindShapePalette(), writing them to dst and their bounds to
+    // min/max.  Vertices are processed in blocks: all blend matrices of a
+    // block first, then all transforms.  Safe to call concurrently for
+    // different faces.
+    void skinFacePositions(const LLVolumeFace& src_face, const LLMatrix4a* palette, U32 max_joints,
+                           LLVector4a* dst, LLVector4a& min, LLVector4a& max);
+
     void initJointNums(LLMeshSkinInfo* skin, LLVOAvatar *avatar);
     void updateRiggingInfo(const LLMeshSkinInfo* skin, LLVOAvatar *avatar, LLVolumeFace& vol_face);
     LLQuaternion getUnscaledQuaternion(const LLMatrix4& mat4);
@@ -464,6 +464,7 @@ void LLSpatialGroup::shift(const LLVector4a &offset)
     mObjectBounds[0].add(offset);
     mObjectExtents[0].add(offset);
     mObjectExtents[1].add(offset);
+    shiftChildBounds(offset);
 
     if (!getSpatialPartition()->mRenderByGroup &&
         getSpatialPartition()->mPartitionType != LLViewerRegion::PARTITION_TREE &&
@@ -1096,6 +1097,24 @@ public:
         return res;
     }
 
+    virtual void frustumCheckChildren(const OctreeNode* n, S32* results)
+    {
+        LL_PROFILE_ZONE_SCOPED;
+        if (!AABBInFrustumNoFarClipChildBounds(n, results))
+        {
+            LLViewerOctreeCull::frustumCheckChildren(n, results);
+            return;
+        }
+
+        for (U32 i = 0; i < n->getChildCount(); i++)
+        {
+            if (results[i] != 0)
+            {
+                results[i] = llmin(results[i], AABBSphereIntersectGroupExtents((LLViewerOctreeGroup*) n->getChild(i)->getListener(0)));
+            }
+        }
+    }
+
     virtual void processGroup(LLViewerOctreeGroup* base_group)
     {
         LL_PROFILE_ZONE_SCOPED;
@@ -1125,6 +1144,14 @@ public:
         S32 res = AABBInFrustumNoFarClipObjectBounds(group);
         return res;
     }
+
+    virtual void frustumCheckChildren(const OctreeNode* n, S32* results)
+    {
+        if (!AABBInFrustumNoFarClipChildBounds(n, results))
+        {
+            LLViewerOctreeCull::frustumCheckChildren(n, results);
+        }
+    }
 };
 
 class LLOctreeCullShadow : public LLOctreeCull
@@ -1142,6 +1169,14 @@ public:
     {
         return AABBInFrustumObjectBounds(group);
     }
+
+    virtual void frustumCheckChildren(const OctreeNode* n, S32* results)
+    {
+        if (!AABBInFrustumChildBounds(n, results))
+        {
+            LLViewerOctreeCull::frustumCheckChildren(n, results);
+        }
+    }
 };
 
 class LLOctreeCullVisExtents: public LLOctreeCullShadow
@@ -1444,9 +1479,42 @@ S32 LLSpatialPartition::cull(LLCamera &camera, std::vector<LLDrawable *>* result
 
 extern bool gCubeSnapshot;
 
+// Call func with the culler cull() uses for this partition
+template <typename FUNC>
+static void with_octree_culler(LLCamera& camera, bool infinite_far_clip, FUNC&& func)
+{
+    if (LLPipeline::sShadowRender)
+    {
+        LLOctreeCullShadow culler(&camera);
+        func(culler);
+    }
+    else if (infinite_far_clip || (!LLPipeline::sUseFarClip && !gCubeSnapshot))
+    {
+        LLOctreeCullNoFarClip culler(&camera);
+        func(culler);
+    }
+    else
+    {
+        LLOctreeCull culler(&camera);
+        func(culler);
+    }
+}
+
 S32 LLSpatialPartition::cull(LLCamera &camera, bool do_occlusion)
 {
     LL_PROFILE_ZONE_SCOPED_CATEGORY_SPATIAL;
+    prepareCull();
+
+    with_octree_culler(camera, mInfiniteFarClip, [this](LLViewerOctreeCull& culler)
+    {
+        culler.traverse(mOctree);
+    });
+
+    return 0;
+}
+
+void LLSpatialPartition::prepareCull()
+{
 #if LL_OCTREE_PARANOIA_CHECK
     ((LLSpatialGroup*)mOctree->getListener(0))->checkStates();
 #endif
@@ -1456,22 +1524,28 @@ S32 LLSpatialPartition::cull(LLCamera &camera, bool do_occlusion)
 #if LL_OCTREE_PARANOIA_CHECK
     ((LLSpatialGroup*)mOctree->getListener(0))->validate();
 #endif
+}
 
-    if (LLPipeline::sShadowRender)
-    {
-        LLOctreeCullShadow culler(&camera);
-        culler.traverse(mOctree);
-    }
-    else if (mInfiniteFarClip || (!LLPipeline::sUseFarClip && !gCubeSnapshot))
+void LLSpatialPartition::gatherCull(LLCamera& camera, LLViewerOctreeCull::cull_node_list_t& nodes)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_SPATIAL;
+    nodes.clear();
+
+    with_octree_culler(camera, mInfiniteFarClip, [this, &nodes](LLViewerOctreeCull& culler)
     {
-        LLOctreeCullNoFarClip culler(&camera);
-        culler.traverse(mOctree);
-    }
-    else
+        culler.gather(mOctree, nodes);
+    });
+}
+
+S32 LLSpatialPartition::cull(LLCamera& camera, const LLViewerOctreeCull::cull_node_list_t& gathered)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_SPATIAL;
+
+    with_octree_culler(camera, mInfiniteFarClip, [this, &gathered](LLViewerOctreeCull& culler)
     {
-        LLOctreeCull culler(&camera);
+        culler.setGathered(&gathered);
         culler.traverse(mOctree);
-    }
+    });
 
     return 0;
 }
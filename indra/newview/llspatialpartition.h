@@ -431,6 +431,13 @@ public:
     /*virtual*/ S32 cull(LLCamera &camera, bool do_occlusion=false); // Cull on arbitrary frustum
     S32 cull(LLCamera &camera, std::vector<LLDrawable *>* results, bool for_select); // Cull on arbitrary frustum
 
+    // Culling in stages, see LLPipeline::updateCull().  prepareCull() and
+    // cull() run on the main thread; gatherCull() may run on any thread
+    // once the tree has been prepared.
+    void prepareCull();
+    void gatherCull(LLCamera& camera, LLViewerOctreeCull::cull_node_list_t& nodes);
+    S32 cull(LLCamera& camera, const LLViewerOctreeCull::cull_node_list_t& gathered);
+
     bool isVisible(const LLVector3& v);
     bool isHUDPartition() ;
 
@@ -694,10 +701,32 @@ class LLVolumeGeometryManager: public LLGeometryManager
     U32 genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace** faces, U32 face_count, bool distance_sort = false, bool batch_textures = false, bool rigged = false);
     void registerFace(LLSpatialGroup* group, LLFace* facep, U32 type);
 
+    // While RenderParallelGeometry is set, genDrawInfo() calls made between
+    // these leave filling the new vertex buffers to endDeferredPacking(),
+    // which packs them as parallel jobs and then uploads them.  Calls nest;
+    // the outermost end does the work.  No group may be rebuilt twice in
+    // between, as its faces would be packed from the first build.
+    static void beginDeferredPacking();
+    static void endDeferredPacking();
+
 private:
     void allocateFaces(U32 pMaxFaceCount);
     void freeFaces();
 
+    static void packDeferred();
+
+    // faces of one vertex buffer waiting in sPackFaces
+    struct PackBatch
+    {
+        LLPointer<LLVertexBuffer> mBuffer;
+        U32 mFirstFace;
+        U32 mFaceCount;
+    };
+
+    static U32 sPackDepth;
+    static std::vector<LLFace*> sPackFaces;
+    static std::vector<PackBatch> sPackBatches;
+
     static int32_t sInstanceCount;
     static LLFace** sFullbrightFaces[2];
     static LLFace** sBumpFaces[2];
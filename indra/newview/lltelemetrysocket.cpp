@@ -0,0 +1,157 @@
+/**
+ * @file lltelemetrysocket.cpp
+ * @brief Non-blocking UNIX socket output of whole lines for telemetry export
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+#include "lltelemetrysocket.h"
+
+#include "lltimer.h"
+
+#if LL_LINUX || LL_DARWIN
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+LLTelemetrySocket::LLTelemetrySocket(const std::string& path)
+:   mPath(path),
+    mFD(-1),
+    mNextConnect(0.0),
+    mMidLine(false)
+{
+}
+
+LLTelemetrySocket::~LLTelemetrySocket()
+{
+    disconnect();
+}
+
+void LLTelemetrySocket::attach(int fd)
+{
+    disconnect();
+#if LL_LINUX || LL_DARWIN
+    mFD = fd;
+    if (fcntl(mFD, F_SETFL, fcntl(mFD, F_GETFL) | O_NONBLOCK) != 0)
+    {
+        disconnect();
+    }
+#endif
+}
+
+void LLTelemetrySocket::send(std::string& pending)
+{
+#if LL_LINUX || LL_DARWIN
+    if (mFD < 0)
+    {
+        connect();
+    }
+    size_t sent_total = 0;
+    while (mFD >= 0 && sent_total < pending.size())
+    {
+#ifdef MSG_NOSIGNAL
+        ssize_t sent = ::send(mFD, pending.data() + sent_total, pending.size() - sent_total, MSG_NOSIGNAL);
+#else
+        ssize_t sent = ::send(mFD, pending.data() + sent_total, pending.size() - sent_total, 0);
+#endif
+        if (sent >= 0)
+        {
+            sent_total += sent;
+            mMidLine = pending[sent_total - 1] != '\n';
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            // Keep the rest of a line already partly sent, by this call
+            // or an earlier one, drop the others.
+            size_t keep = 0;
+            if (mMidLine)
+            {
+                size_t end = pending.find('\n', sent_total);
+                keep = (end == std::string::npos ? pending.size() : end + 1) - sent_total;
+            }
+            pending = pending.substr(sent_total, keep);
+            return;
+        }
+        else if (errno != EINTR)
+        {
+            disconnect();
+        }
+    }
+#endif
+    pending.clear();
+}
+
+void LLTelemetrySocket::connect()
+{
+#if LL_LINUX || LL_DARWIN
+    F64 now = LLTimer::getTotalSeconds();
+    if (now < mNextConnect)
+    {
+        return;
+    }
+    mNextConnect = now + RETRY_SECONDS;
+
+    sockaddr_un addr = {};
+    if (mPath.empty() || mPath.size() >= sizeof(addr.sun_path))
+    {
+        return;
+    }
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, mPath.c_str(), sizeof(addr.sun_path) - 1);
+
+    mFD = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (mFD < 0)
+    {
+        return;
+    }
+#ifdef SO_NOSIGPIPE
+    int on = 1;
+    setsockopt(mFD, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+    // A listener with a full backlog fails the connect rather than
+    // holding it; it is retried later like any other failure.
+    if (fcntl(mFD, F_SETFL, fcntl(mFD, F_GETFL) | O_NONBLOCK) != 0 ||
+        ::connect(mFD, (sockaddr*)&addr, sizeof(addr)) != 0)
+    {
+        disconnect();
+    }
+#endif
+}
+
+void LLTelemetrySocket::disconnect()
+{
+#if LL_LINUX || LL_DARWIN
+    if (mFD >= 0)
+    {
+        ::close(mFD);
+        mFD = -1;
+    }
+#endif
+    // A new connection starts at the beginning of a line
+    mMidLine = false;
+}
@@ -0,0 +1,67 @@
+/**
+ * @file lltelemetrysocket.h
+ * @brief Non-blocking UNIX socket output of whole lines for telemetry export
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLTELEMETRYSOCKET_H
+#define LL_LLTELEMETRYSOCKET_H
+
+#include <string>
+
+// Sends lines of text to a UNIX domain stream socket.  While no listener
+// is connected the output is discarded and a reconnect is tried at most
+// every RETRY_SECONDS, so a collector can come and go.  The socket never
+// blocks: lines a slow collector has no room for are dropped, but a line
+// it got part of is always finished first, so it only ever sees whole
+// lines.  Not thread safe, LLViewerTelemetry uses it from its writer
+// thread only.  Does nothing on platforms without UNIX sockets.
+class LLTelemetrySocket
+{
+public:
+    static constexpr double RETRY_SECONDS = 5.0;
+
+    LLTelemetrySocket(const std::string& path);
+    ~LLTelemetrySocket();
+
+    // Use an already connected socket instead of connecting to the path
+    void attach(int fd);
+
+    // Sends as much of pending as the socket takes.  On return pending
+    // holds what is left of a partly sent line, everything else is gone.
+    void send(std::string& pending);
+
+    bool isConnected() const    { return mFD >= 0; }
+
+private:
+    void connect();
+    void disconnect();
+
+    std::string mPath;
+    int         mFD;
+    double      mNextConnect;
+    bool        mMidLine;       // The collector got part of a line
+};
+
+#endif // LL_LLTELEMETRYSOCKET_H
@@ -29,6 +29,7 @@
 #include <iostream>
 #include <map>
 #include <algorithm>
+#include <cmath>
 
 #include "lltexturefetch.h"
 
@@ -631,6 +632,7 @@ private:
 
     LLCore::HttpHandle      mHttpHandle;                // Handle of any active request
     LLCore::BufferArray *   mHttpBufferArray;           // Refcounted pointer to response data
+    LLCore::HttpBodySink::ptr_t mHttpBodySink;          // Image-sized buffer the response body is written into
     S32                     mHttpPolicyClass;
     bool                    mHttpActive;                // Active request to http library
     U32                     mHttpReplySize,             // Actual received data size
@@ -950,6 +952,7 @@ LLTextureFetchWorker::LLTextureFetchWorker(LLTextureFetch* fetcher,
       mMetricsStartTime(0),
       mHttpHandle(LLCORE_HTTP_HANDLE_INVALID),
       mHttpBufferArray(NULL),
+      mHttpBodySink(),
       mHttpPolicyClass(mFetcher->mHttpPolicyClass),
       mHttpActive(false),
       mHttpReplySize(0U),
@@ -1010,6 +1013,7 @@ LLTextureFetchWorker::~LLTextureFetchWorker()
         mHttpBufferArray->release();
         mHttpBufferArray = NULL;
     }
+    mHttpBodySink.reset();
     unlockWorkMutex();                                                  // -Mw
     mFetcher->removeFromHTTPQueue(mID, (S32Bytes)0);
     mFetcher->removeHttpWaiter(mID);
@@ -1107,6 +1111,7 @@ void LLTextureFetchWorker::resetFormattedData()
         mHttpBufferArray->release();
         mHttpBufferArray = NULL;
     }
+    mHttpBodySink.reset();
     if (mFormattedImage.notNull())
     {
         mFormattedImage->deleteData();
@@ -1158,7 +1163,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
         // </FS:Ansariel>
         {
             LL_PROFILE_ZONE_NAMED_CATEGORY_THREAD("tfwdw - priority < 0");
-            LL_DEBUGS(LOG_TXT) << mID << " abort: mImagePriority < F_ALMOST_ZERO" << LL_ENDL;
+            LL_DEBUGS_ARGS(LOG_TXT, mID, " abort: mImagePriority < F_ALMOST_ZERO");
             return true; // abort
         }
     }
@@ -1236,6 +1241,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
             mHttpBufferArray->release();
             mHttpBufferArray = NULL;
         }
+        mHttpBodySink.reset();
         mHttpReplySize = 0;
         mHttpReplyOffset = 0;
         mHaveAllData = false;
@@ -1245,8 +1251,8 @@ bool LLTextureFetchWorker::doWork(S32 param)
         setState(LOAD_FROM_TEXTURE_CACHE);
         mInCache = false;
         mDesiredSize = llmax(mDesiredSize, TEXTURE_CACHE_ENTRY_SIZE); // min desired size is TEXTURE_CACHE_ENTRY_SIZE
-        LL_DEBUGS(LOG_TXT) << mID << ": Priority: " << llformat("%8.0f",mImagePriority)
-                           << " Desired Discard: " << mDesiredDiscard << " Desired Size: " << mDesiredSize << LL_ENDL;
+        LL_DEBUGS_ARGS(LOG_TXT, mID, ": Priority: ", llformat("%8.0f",mImagePriority), " Desired Discard: ",
+                       mDesiredDiscard, " Desired Size: ", mDesiredSize);
 
         // fall through
     }
@@ -1313,7 +1319,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
                 //
                 //This should never happen
                 //
-                LL_DEBUGS(LOG_TXT) << mID << " this should never happen" << LL_ENDL;
+                LL_DEBUGS_ARGS(LOG_TXT, mID, " this should never happen");
                 return false;
             }
         }
@@ -1341,9 +1347,9 @@ bool LLTextureFetchWorker::doWork(S32 param)
             setState(DECODE_IMAGE);
             mInCache = true;
             mWriteToCacheState = NOT_WRITE ;
-            LL_DEBUGS(LOG_TXT) << mID << ": Cached. Bytes: " << mFormattedImage->getDataSize()
-                               << " Size: " << llformat("%dx%d",mFormattedImage->getWidth(),mFormattedImage->getHeight())
-                               << " Desired Discard: " << mDesiredDiscard << " Desired Size: " << mDesiredSize << LL_ENDL;
+            LL_DEBUGS_ARGS(LOG_TXT, mID, ": Cached. Bytes: ", mFormattedImage->getDataSize(), " Size: ",
+                           llformat("%dx%d",mFormattedImage->getWidth(),mFormattedImage->getHeight()),
+                           " Desired Discard: ", mDesiredDiscard, " Desired Size: ", mDesiredSize);
             record(LLTextureFetch::sCacheHitRate, LLUnits::Ratio::fromValue(1));
         }
         else
@@ -1357,7 +1363,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
             // need more data
             else
             {
-                LL_DEBUGS(LOG_TXT) << mID << ": Not in Cache" << LL_ENDL;
+                LL_DEBUGS_ARGS(LOG_TXT, mID, ": Not in Cache");
                 setState(LOAD_FROM_NETWORK);
             }
             record(LLTextureFetch::sCacheHitRate, LLUnits::Ratio::fromValue(0));
@@ -1408,7 +1414,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
                         LL_WARNS(LOG_TXT) << "Trying to fetch a texture of non-default type by UUID. This probably won't work!" << LL_ENDL;
                     }
                     setUrl(http_url + "/?texture_id=" + mID.asString().c_str());
-                    LL_DEBUGS(LOG_TXT) << "Texture URL: " << mUrl << LL_ENDL;
+                    LL_DEBUGS_ARGS(LOG_TXT, "Texture URL: ", mUrl);
                     mWriteToCacheState = CAN_WRITE ; //because this texture has a fixed texture id.
                     mCanUseCapability = true;
                     mRegionRetryAttempt = 0;
@@ -1491,7 +1497,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
                 }
             }
 
-            LL_DEBUGS(LOG_TXT) << mID << ": Loaded from Sim. Bytes: " << mFormattedImage->getDataSize() << LL_ENDL;
+            LL_DEBUGS_ARGS(LOG_TXT, mID, ": Loaded from Sim. Bytes: ", mFormattedImage->getDataSize());
             mFetcher->removeFromNetworkQueue(this, false);
             if (mFormattedImage.isNull() || !mFormattedImage->getDataSize())
             {
@@ -1632,14 +1638,50 @@ bool LLTextureFetchWorker::doWork(S32 param)
         mLoaded = false;
         mGetStatus = LLCore::HttpStatus();
         mGetReason.clear();
-        LL_DEBUGS(LOG_TXT) << "HTTP GET: " << mID << " Offset: " << mRequestedOffset
-                           << " Bytes: " << mRequestedSize
-                           << " Bandwidth(kbps): " << mFetcher->getTextureBandwidth() << "/" << mFetcher->mMaxBandwidth
-                           << LL_ENDL;
+        LL_DEBUGS_ARGS(LOG_TXT, "HTTP GET: ", mID, " Offset: ", mRequestedOffset, " Bytes: ", mRequestedSize,
+                       " Bandwidth(kbps): ", mFetcher->getTextureBandwidth(), "/", mFetcher->mMaxBandwidth);
 
         // Will call callbackHttpGet when curl request completes
         // Only server bake images use the returned headers currently, for getting retry-after field.
         LLCore::HttpOptions::ptr_t options = (mFTType == FTT_SERVER_BAKE) ? mFetcher->mHttpOptionsWithHeaders: mFetcher->mHttpOptions;
+        mHttpBodySink.reset();
+        if (! disable_range_req
+            && mRequestedSize > 0
+            && (mRequestedOffset + mRequestedSize) <= HTTP_REQUESTS_RANGE_END_MAX)
+        {
+            // Have libcurl write the body straight into a buffer sized
+            // for the final image data, leaving room in front for what
+            // we already have, rather than into a BufferArray that is
+            // copied out again once the request completes.
+            mHttpBodySink = std::make_shared<LLCore::HttpBodySink>(size_t(mRequestedOffset + mRequestedSize),
+                                                                   size_t(mRequestedOffset));
+            if (mHttpBodySink->getBuffer())
+            {
+                options = LLCore::HttpOptions::ptr_t(new LLCore::HttpOptions(*options));
+                options->setBodySink(mHttpBodySink);
+            }
+            else
+            {
+                mHttpBodySink.reset();
+            }
+        }
+
+        // On a multiplexed HTTP/2 connection give the textures covering
+        // the most of the screen the largest share of it.  The priority
+        // is a pixel area, so weigh by its magnitude.  HTTP/1.1 ignores
+        // the weight, so the shared options are used as they are.
+        if (mFetcher->mHttp2)
+        {
+            const int stream_weight = llclamp(S32(std::log2(llmax(mImagePriority, 1.f)) * 12.f) + 1, 1, 256);
+            if (stream_weight != options->getStreamWeight())
+            {
+                if (!mHttpBodySink)
+                {
+                    options = LLCore::HttpOptions::ptr_t(new LLCore::HttpOptions(*options));
+                }
+                options->setStreamWeight(stream_weight);
+            }
+        }
         if (disable_range_req)
         {
             // 'Range:' requests may be disabled in which case all HTTP
@@ -1804,7 +1846,10 @@ bool LLTextureFetchWorker::doWork(S32 param)
                 mUrl.clear();
             }
 
-            if (! mHttpBufferArray || ! mHttpBufferArray->size())
+            // Body is either in our sink or, if the library had to
+            // fall back, in a BufferArray.
+            const bool in_sink(! mHttpBufferArray && mHttpBodySink && mHttpBodySink->size());
+            if (! in_sink && (! mHttpBufferArray || ! mHttpBufferArray->size()))
             {
                 // no data received.
                 if (mHttpBufferArray)
@@ -1812,6 +1857,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
                     mHttpBufferArray->release();
                     mHttpBufferArray = NULL;
                 }
+                mHttpBodySink.reset();
 
                 // abort.
                 setState(DONE);
@@ -1820,7 +1866,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
                 return true;
             }
 
-            S32 append_size(static_cast<S32>(mHttpBufferArray->size()));
+            S32 append_size(static_cast<S32>(in_sink ? mHttpBodySink->size() : mHttpBufferArray->size()));
             S32 total_size(cur_size + append_size);
             S32 src_offset(0);
             llassert_always(append_size == mRequestedSize);
@@ -1844,7 +1890,24 @@ bool LLTextureFetchWorker::doWork(S32 param)
                 mRequestedOffset += src_offset;
             }
 
-            U8 * buffer = (U8 *)ll_aligned_malloc_16(total_size);
+            U8 * buffer(NULL);
+            if (in_sink && total_size <= (S32)mHttpBodySink->getCapacity())
+            {
+                // Take over the sink's buffer.  In the usual case the
+                // useful part of the body already sits right after the
+                // data we have.  Slide it into place when the server
+                // answered with a different range.
+                U8 * src(mHttpBodySink->getData() + src_offset);
+                buffer = mHttpBodySink->detach();
+                if (src != buffer + cur_size)
+                {
+                    memmove(buffer + cur_size, src, append_size);
+                }
+            }
+            else
+            {
+                buffer = (U8 *)ll_aligned_malloc_16(total_size);
+            }
             if (!buffer)
             {
                 // abort. If we have no space for packet, we have not enough space to decode image
@@ -1881,14 +1944,26 @@ bool LLTextureFetchWorker::doWork(S32 param)
                 // Copy previously collected data into buffer
                 memcpy(buffer, mFormattedImage->getData(), cur_size);
             }
-            mHttpBufferArray->read(src_offset, (char *) buffer + cur_size, append_size);
+            if (mHttpBufferArray)
+            {
+                mHttpBufferArray->read(src_offset, (char *) buffer + cur_size, append_size);
+            }
+            else if (mHttpBodySink && mHttpBodySink->getBuffer())
+            {
+                // Sink too small for a relocated body, copy after all
+                memcpy(buffer + cur_size, mHttpBodySink->getData() + src_offset, append_size);
+            }
 
             // NOTE: setData releases current data and owns new data (buffer)
             mFormattedImage->setData(buffer, total_size);
 
             // Done with buffer array
-            mHttpBufferArray->release();
-            mHttpBufferArray = NULL;
+            if (mHttpBufferArray)
+            {
+                mHttpBufferArray->release();
+                mHttpBufferArray = NULL;
+            }
+            mHttpBodySink.reset();
             mHttpReplySize = 0;
             mHttpReplyOffset = 0;
 
@@ -1936,7 +2011,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
         {
             // We aborted, don't decode
             setState(DONE);
-            LL_DEBUGS(LOG_TXT) << mID << " DECODE_IMAGE abort: desired discard " << mDesiredDiscard << "<0" << LL_ENDL;
+            LL_DEBUGS_ARGS(LOG_TXT, mID, " DECODE_IMAGE abort: desired discard ", mDesiredDiscard, "<0");
             return true;
         }
 
@@ -1946,7 +2021,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
 
             //abort, don't decode
             setState(DONE);
-            LL_DEBUGS(LOG_TXT) << mID << " DECODE_IMAGE abort: (mFormattedImage->getDataSize() <= 0)" << LL_ENDL;
+            LL_DEBUGS_ARGS(LOG_TXT, mID, " DECODE_IMAGE abort: (mFormattedImage->getDataSize() <= 0)");
             return true;
         }
         if (mLoadedDiscard < 0)
@@ -1955,7 +2030,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
 
             //abort, don't decode
             setState(DONE);
-            LL_DEBUGS(LOG_TXT) << mID << " DECODE_IMAGE abort: mLoadedDiscard < 0" << LL_ENDL;
+            LL_DEBUGS_ARGS(LOG_TXT, mID, " DECODE_IMAGE abort: mLoadedDiscard < 0");
             return true;
         }
         mDecodeTimer.reset();
@@ -1965,8 +2040,8 @@ bool LLTextureFetchWorker::doWork(S32 param)
         S32 discard = mHaveAllData ? 0 : mLoadedDiscard;
         mDecoded  = false;
         setState(DECODE_IMAGE_UPDATE);
-        LL_DEBUGS(LOG_TXT) << mID << ": Decoding. Bytes: " << mFormattedImage->getDataSize() << " Discard: " << discard
-                           << " All Data: " << mHaveAllData << LL_ENDL;
+        LL_DEBUGS_ARGS(LOG_TXT, mID, ": Decoding. Bytes: ", mFormattedImage->getDataSize(), " Discard: ",
+                       discard, " All Data: ", mHaveAllData);
 
         // In case worked manages to request decode, be shut down,
         // then init and request decode again with first decode
@@ -1980,7 +2055,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
             // Abort, failed to put into queue.
             // Happens if viewer is shutting down
             setState(DONE);
-            LL_DEBUGS(LOG_TXT) << mID << " DECODE_IMAGE abort: failed to post for decoding" << LL_ENDL;
+            LL_DEBUGS_ARGS(LOG_TXT, mID, " DECODE_IMAGE abort: failed to post for decoding");
             return true;
         }
         // fall though
@@ -1998,7 +2073,7 @@ bool LLTextureFetchWorker::doWork(S32 param)
                 if (mCachedSize > 0 && !mInLocalCache && mRetryAttempt == 0)
                 {
                     // Cache file should be deleted, try again
-                    LL_DEBUGS(LOG_TXT) << mID << ": Decode of cached file failed (removed), retrying" << LL_ENDL;
+                    LL_DEBUGS_ARGS(LOG_TXT, mID, ": Decode of cached file failed (removed), retrying");
                     llassert_always(mDecodeHandle == 0);
                     mFormattedImage = NULL;
                     ++mRetryAttempt;
@@ -2008,15 +2083,15 @@ bool LLTextureFetchWorker::doWork(S32 param)
                 }
                 else
                 {
-                    LL_DEBUGS(LOG_TXT) << "Failed to Decode image " << mID << " after " << mRetryAttempt << " retries" << LL_ENDL;
+                    LL_DEBUGS_ARGS(LOG_TXT, "Failed to Decode image ", mID, " after ", mRetryAttempt, " retries");
                     setState(DONE); // failed
                 }
             }
             else
             {
                 llassert_always(mRawImage.notNull());
-                LL_DEBUGS(LOG_TXT) << mID << ": Decoded. Discard: " << mDecodedDiscard
-                                   << " Raw Image: " << llformat("%dx%d",mRawImage->getWidth(),mRawImage->getHeight()) << LL_ENDL;
+                LL_DEBUGS_ARGS(LOG_TXT, mID, ": Decoded. Discard: ", mDecodedDiscard, " Raw Image: ",
+                               llformat("%dx%d",mRawImage->getWidth(),mRawImage->getHeight()));
                 setState(WRITE_TO_CACHE);
             }
             // fall through
@@ -2099,9 +2174,9 @@ bool LLTextureFetchWorker::doWork(S32 param)
         {
             // More data was requested, return to INIT
             setState(INIT);
-            LL_DEBUGS(LOG_TXT) << mID << " more data requested, returning to INIT: "
-                               << " mDecodedDiscard " << mDecodedDiscard << ">= 0 && mDesiredDiscard " << mDesiredDiscard
-                               << "<" << " mDecodedDiscard " << mDecodedDiscard << LL_ENDL;
+            LL_DEBUGS_ARGS(LOG_TXT, mID, " more data requested, returning to INIT: ", " mDecodedDiscard ",
+                           mDecodedDiscard, ">= 0 && mDesiredDiscard ", mDesiredDiscard, "<",
+                           " mDecodedDiscard ", mDecodedDiscard);
             // return false;
             return doWork(param);
         }
@@ -2176,10 +2251,7 @@ void LLTextureFetchWorker::onCompleted(LLCore::HttpHandle handle, LLCore::HttpRe
 
     std::string reason(status.toString());
     setGetStatus(status, reason);
-    LL_DEBUGS(LOG_TXT) << "HTTP COMPLETE: " << mID
-                       << " status: " << status.toTerseString()
-                       << " '" << reason << "'"
-                       << LL_ENDL;
+    LL_DEBUGS_ARGS(LOG_TXT, "HTTP COMPLETE: ", mID, " status: ", status.toTerseString(), " '", reason, "'");
 
     if (! status)
     {
@@ -2423,16 +2495,23 @@ S32 LLTextureFetchWorker::callbackHttpGet(LLCore::HttpResponse * response,
         // get length of stream:
         LLCore::BufferArray * body(response->getBody());
         data_size = body ? static_cast<S32>(body->size()) : 0;
+        if (! body && mHttpBodySink)
+        {
+            // Delivered directly into our buffer
+            data_size = static_cast<S32>(mHttpBodySink->size());
+        }
 
-        LL_DEBUGS(LOG_TXT) << "HTTP RECEIVED: " << mID.asString() << " Bytes: " << data_size << LL_ENDL;
+        LL_DEBUGS_ARGS(LOG_TXT, "HTTP RECEIVED: ", mID.asString(), " Bytes: ", data_size);
         if (data_size > 0)
         {
-            // *TODO: set the formatted image data here directly to avoid the copy
-
-            // Hold on to body for later copy
+            // Hold on to body for later copy.  Bodies written into
+            // mHttpBodySink need no further handling here.
             llassert_always(NULL == mHttpBufferArray);
-            body->addRef();
-            mHttpBufferArray = body;
+            if (body)
+            {
+                body->addRef();
+                mHttpBufferArray = body;
+            }
 
             if (partial)
             {
@@ -2498,7 +2577,6 @@ S32 LLTextureFetchWorker::callbackHttpGet(LLCore::HttpResponse * response,
             LLViewerStatsRecorder::instance().textureFetch();
         }
 
-        // *TODO: set the formatted image data here directly to avoid the copy
     }
     else
     {
@@ -2565,12 +2643,12 @@ void LLTextureFetchWorker::callbackDecoded(bool success, const std::string &erro
         // Queue doesn't support canceling old requests.
         // This shouldn't normally happen, but in case it's possible that a worked
         // will request decode, be aborted, reinited then start a new decode
-        LL_DEBUGS(LOG_TXT) << mID << " received obsolete decode's callback" << LL_ENDL;
+        LL_DEBUGS_ARGS(LOG_TXT, mID, " received obsolete decode's callback");
         return; // ignore
     }
     if (mState != DECODE_IMAGE_UPDATE)
     {
-        LL_DEBUGS(LOG_TXT) << "Decode callback for " << mID << " with state = " << mState << LL_ENDL;
+        LL_DEBUGS_ARGS(LOG_TXT, "Decode callback for ", mID, " with state = ", mState);
         mDecodeHandle = 0;
         return;
     }
@@ -2583,8 +2661,8 @@ void LLTextureFetchWorker::callbackDecoded(bool success, const std::string &erro
         mRawImage = raw;
         mAuxImage = aux;
         mDecodedDiscard = mFormattedImage->getDiscardLevel();
-        LL_DEBUGS(LOG_TXT) << mID << ": Decode Finished. Discard: " << mDecodedDiscard
-                           << " Raw Image: " << llformat("%dx%d",mRawImage->getWidth(),mRawImage->getHeight()) << LL_ENDL;
+        LL_DEBUGS_ARGS(LOG_TXT, mID, ": Decode Finished. Discard: ", mDecodedDiscard, " Raw Image: ",
+                       llformat("%dx%d",mRawImage->getWidth(),mRawImage->getHeight()));
     }
     else
     {
@@ -2684,6 +2762,7 @@ LLTextureFetch::LLTextureFetch(LLTextureCache* cache, bool threaded, bool qa_mod
       mHttpOptionsWithHeaders(),
       mHttpHeaders(),
       mHttpPolicyClass(LLCore::HttpRequest::DEFAULT_POLICY_ID),
+      mHttp2(false),
       mHttpMetricsHeaders(),
       mHttpMetricsPolicyClass(LLCore::HttpRequest::DEFAULT_POLICY_ID),
       mTotalCacheReadCount(0U),
@@ -2704,6 +2783,7 @@ LLTextureFetch::LLTextureFetch(LLTextureCache* cache, bool threaded, bool qa_mod
     mHttpHeaders = LLCore::HttpHeaders::ptr_t(new LLCore::HttpHeaders);
     mHttpHeaders->append(HTTP_OUT_HEADER_ACCEPT, HTTP_CONTENT_IMAGE_X_J2C);
     mHttpPolicyClass = app_core_http.getPolicy(LLAppCoreHttp::AP_TEXTURE);
+    mHttp2 = app_core_http.isHttp2(LLAppCoreHttp::AP_TEXTURE);
     mHttpMetricsHeaders = LLCore::HttpHeaders::ptr_t(new LLCore::HttpHeaders);
     mHttpMetricsHeaders->append(HTTP_OUT_HEADER_CONTENT_TYPE, HTTP_CONTENT_LLSD_XML);
     mHttpMetricsPolicyClass = app_core_http.getPolicy(LLAppCoreHttp::AP_REPORTING);
@@ -2778,13 +2858,13 @@ S32 LLTextureFetch::createRequest(FTType f_type, const std::string& url, const L
         llassert(!url.empty() && (!exten.empty() && LLImageBase::getCodecFromExtension(exten) != IMG_CODEC_J2C));
 
         // Do full requests for baked textures to reduce interim blurring.
-        LL_DEBUGS(LOG_TXT) << "full request for " << id << " texture is FTT_SERVER_BAKE" << LL_ENDL;
+        LL_DEBUGS_ARGS(LOG_TXT, "full request for ", id, " texture is FTT_SERVER_BAKE");
         desired_size = MAX_IMAGE_DATA_SIZE;
         desired_discard = 0;
     }
     else if (!url.empty() && (!exten.empty() && LLImageBase::getCodecFromExtension(exten) != IMG_CODEC_J2C))
     {
-        LL_DEBUGS(LOG_TXT) << "full request for " << id << " exten is not J2C: " << exten << LL_ENDL;
+        LL_DEBUGS_ARGS(LOG_TXT, "full request for ", id, " exten is not J2C: ", exten);
         // Only do partial requests for J2C at the moment
         desired_size = MAX_IMAGE_DATA_SIZE;
         desired_discard = 0;
@@ -2859,8 +2939,8 @@ S32 LLTextureFetch::createRequest(FTType f_type, const std::string& url, const L
         worker->unlockWorkMutex();                                      // -Mw
     }
 
-    LL_DEBUGS(LOG_TXT) << "REQUESTED: " << id << " f_type " << fttype_to_string(f_type)
-                       << " Discard: " << desired_discard << " size " << desired_size << LL_ENDL;
+    LL_DEBUGS_ARGS(LOG_TXT, "REQUESTED: ", id, " f_type ", fttype_to_string(f_type), " Discard: ",
+                   desired_discard, " size ", desired_size);
     return desired_discard;
 }
 
@@ -3097,7 +3177,7 @@ bool LLTextureFetch::getRequestFinished(const LLUUID& id, S32& discard_level,
             skipped_states_time = worker->mSkippedStatesTime;
             worker->mStateTimer.reset();
             res = true;
-            LL_DEBUGS(LOG_TXT) << id << ": Request Finished. State: " << worker->mState << " Discard: " << discard_level << LL_ENDL;
+            LL_DEBUGS_ARGS(LOG_TXT, id, ": Request Finished. State: ", worker->mState, " Discard: ", discard_level);
             worker->unlockWorkMutex();                                  // -Mw
 
             sample(sTexDecodeLatency, decode_time);
@@ -373,6 +373,7 @@ private:
     LLCore::HttpOptions::ptr_t          mHttpOptionsWithHeaders;        // Ttf
     LLCore::HttpHeaders::ptr_t          mHttpHeaders;                   // Ttf
     LLCore::HttpRequest::policy_t       mHttpPolicyClass;               // T*
+    bool                                mHttp2;                         // T*
     LLCore::HttpHeaders::ptr_t          mHttpMetricsHeaders;            // Ttf
     LLCore::HttpRequest::policy_t       mHttpMetricsPolicyClass;        // T*
     S32                                 mHttpHighWater;                 // Ttf
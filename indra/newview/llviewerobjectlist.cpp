@@ -1040,6 +1040,7 @@ void LLViewerObjectList::update(LLAgent &agent)
                 objectp->idleUpdate(agent, frame_time);
             }
         }
+        LLVOAvatar::updateQueuedMotions(agent);
     }
     else
     {
@@ -1051,6 +1052,9 @@ void LLViewerObjectList::update(LLAgent &agent)
                 objectp->idleUpdate(agent, frame_time);
         }
 
+        // animate avatars queued during idleUpdate()
+        LLVOAvatar::updateQueuedMotions(agent);
+
         //update flexible objects
         LLVolumeImplFlexible::updateClass();
 
@@ -469,6 +469,7 @@ LLViewerOctreeGroup::LLViewerOctreeGroup(OctreeNode* node)
 
     mBounds[0] = node->getCenter();
     mBounds[1] = node->getSize();
+    mChildBoundsCount = 0;
 
     mOctreeNode->addListener(this);
 }
@@ -563,12 +564,14 @@ void LLViewerOctreeGroup::rebound()
         mExtents[1] = group->mExtents[1];
 
         group->setState(SKIP_FRUSTUM_CHECK);
+        mChildBoundsCount = 0;
     }
     else if (mOctreeNode->getChildCount() == 0)
     { //copy object bounding box if this is a leaf
         boundObjects(true, mExtents[0], mExtents[1]);
         mBounds[0] = mObjectBounds[0];
         mBounds[1] = mObjectBounds[1];
+        mChildBoundsCount = 0;
     }
     else
     {
@@ -600,6 +603,8 @@ void LLViewerOctreeGroup::rebound()
         mBounds[0].mul(0.5f);
         mBounds[1].setSub(newMax, newMin);
         mBounds[1].mul(0.5f);
+
+        updateChildBounds();
     }
 
     clearState(DIRTY);
@@ -607,6 +612,50 @@ void LLViewerOctreeGroup::rebound()
     return;
 }
 
+void LLViewerOctreeGroup::updateChildBounds()
+{
+    const U32 count = mOctreeNode->getChildCount();
+    llassert(count <= 8);
+
+    LL_ALIGN_16(F32 soa[2][6][4]);
+    memset(soa, 0, sizeof(soa));
+    for (U32 i = 0; i < count; i++)
+    {
+        const LLViewerOctreeGroup* group = (LLViewerOctreeGroup*) mOctreeNode->getChild(i)->getListener(0);
+        const F32* center = group->mBounds[0].getF32ptr();
+        const F32* size = group->mBounds[1].getF32ptr();
+        for (U32 j = 0; j < 3; j++)
+        {
+            soa[i / 4][j][i % 4] = center[j];
+            soa[i / 4][j + 3][i % 4] = size[j];
+        }
+    }
+
+    for (U32 packet = 0; packet < 2; packet++)
+    {
+        for (U32 j = 0; j < 6; j++)
+        {
+            mChildBounds[packet][j].load4a(soa[packet][j]);
+        }
+    }
+    mChildBoundsCount = count;
+}
+
+// Children move with their parent, so packets only need the offset applied
+void LLViewerOctreeGroup::shiftChildBounds(const LLVector4a& offset)
+{
+    LLVector4a x, y, z;
+    x.splat<0>(offset);
+    y.splat<1>(offset);
+    z.splat<2>(offset);
+    for (U32 packet = 0; packet < 2; packet++)
+    {
+        mChildBounds[packet][0].add(x);
+        mChildBounds[packet][1].add(y);
+        mChildBounds[packet][2].add(z);
+    }
+}
+
 //virtual
 void LLViewerOctreeGroup::handleInsertion(const TreeNode* node, LLViewerOctreeEntry* obj)
 {
@@ -1345,9 +1394,11 @@ void LLViewerOctreeCull::traverse(const OctreeNode* n)
 {
     LL_PROFILE_ZONE_SCOPED;
     LLViewerOctreeGroup* group = (LLViewerOctreeGroup*) n->getListener(0);
+    const CullNode* gathered = findGathered(group);
 
     if (earlyFail(group))
     {
+        skipGathered(gathered);
         return;
     }
 
@@ -1355,23 +1406,87 @@ void LLViewerOctreeCull::traverse(const OctreeNode* n)
         (mRes && group->hasState(LLViewerOctreeGroup::SKIP_FRUSTUM_CHECK)))
     {   //fully in, just add everything
         LL_PROFILE_ZONE_NAMED_CATEGORY_OCTREE("AllInside");
+        mCurrent = gathered;
         OctreeTraveler::traverse(n);
     }
     else
     {
         LL_PROFILE_ZONE_NAMED_CATEGORY_OCTREE("Check inside?");
-        mRes = frustumCheck(group);
+        mRes = gathered ? gathered->mFrustum : frustumCheck(group);
 
         if (mRes)
         { //at least partially in, run on down
             LL_PROFILE_ZONE_NAMED_CATEGORY_OCTREE("PartiallyIn");
+            mCurrent = gathered;
             OctreeTraveler::traverse(n);
         }
+        else
+        {
+            skipGathered(gathered);
+        }
 
         mRes = 0;
     }
 }
 
+void LLViewerOctreeCull::gather(const OctreeNode* n, cull_node_list_t& nodes)
+{
+    gather(n, frustumCheck((LLViewerOctreeGroup*) n->getListener(0)), nodes);
+}
+
+// res is the frustumCheck() result for n, tested with its siblings
+void LLViewerOctreeCull::gather(const OctreeNode* n, S32 res, cull_node_list_t& nodes)
+{
+    LLViewerOctreeGroup* group = (LLViewerOctreeGroup*) n->getListener(0);
+    const bool skip_check = group->hasState(LLViewerOctreeGroup::SKIP_FRUSTUM_CHECK);
+
+    // traverse() only tests below a node that is partially in, or one it
+    // takes on trust from its parent
+    CullNode node;
+    node.mGroup = group;
+    node.mFrustum = (S8)res;
+    node.mObjects = -1;
+    const bool partial = res == 1 || skip_check;
+    if (partial && n->getElementCount() > 0 && n->getChildCount() > 0)
+    {
+        node.mObjects = (S8)frustumCheckObjects(group);
+    }
+
+    const U32 index = (U32)nodes.size();
+    nodes.push_back(node);
+    if (partial && n->getChildCount() > 0)
+    {
+        S32 child_res[8];
+        frustumCheckChildren(n, child_res);
+        for (U32 i = 0; i < n->getChildCount(); i++)
+        {
+            gather(n->getChild(i), child_res[i], nodes);
+        }
+    }
+    nodes[index].mEnd = (U32)nodes.size();
+}
+
+// Gathered nodes are in traversal order, so the next one traverse() can
+// use is always at mGatherIndex.
+const LLViewerOctreeCull::CullNode* LLViewerOctreeCull::findGathered(const LLViewerOctreeGroup* group)
+{
+    if (mGathered &&
+        mGatherIndex < mGathered->size() &&
+        (*mGathered)[mGatherIndex].mGroup == group)
+    {
+        return &(*mGathered)[mGatherIndex++];
+    }
+    return NULL;
+}
+
+void LLViewerOctreeCull::skipGathered(const CullNode* node)
+{
+    if (node)
+    {
+        mGatherIndex = node->mEnd;
+    }
+}
+
 //------------------------------------------
 //agent space group culling
 S32 LLViewerOctreeCull::AABBInFrustumNoFarClipGroupBounds(const LLViewerOctreeGroup* group)
@@ -1443,6 +1558,41 @@ S32 LLViewerOctreeCull::AABBRegionSphereIntersectObjectExtents(const LLViewerOct
     return AABBSphereIntersect(group->mObjectExtents[0], group->mObjectExtents[1], mCamera->getOrigin() - shift, mCamera->mFrustumCornerDist);
 }
 //------------------------------------------
+//agent space packet culling of child groups
+bool LLViewerOctreeCull::AABBInFrustumNoFarClipChildBounds(const OctreeNode* n, S32* results)
+{
+    const LLViewerOctreeGroup* group = (LLViewerOctreeGroup*) n->getListener(0);
+    const U32 count = group->getChildBoundsCount();
+    if (!count || count != n->getChildCount())
+    {
+        return false;
+    }
+
+    for (U32 i = 0; i < count; i += 4)
+    {
+        const LLVector4a* bounds = group->getChildBounds(i / 4);
+        mCamera->AABBInFrustumNoFarClip4(bounds, bounds + 3, results + i);
+    }
+    return true;
+}
+
+bool LLViewerOctreeCull::AABBInFrustumChildBounds(const OctreeNode* n, S32* results)
+{
+    const LLViewerOctreeGroup* group = (LLViewerOctreeGroup*) n->getListener(0);
+    const U32 count = group->getChildBoundsCount();
+    if (!count || count != n->getChildCount())
+    {
+        return false;
+    }
+
+    for (U32 i = 0; i < count; i += 4)
+    {
+        const LLVector4a* bounds = group->getChildBounds(i / 4);
+        mCamera->AABBInFrustum4(bounds, bounds + 3, results + i);
+    }
+    return true;
+}
+//------------------------------------------
 //check if the objects projection large enough
 
 bool LLViewerOctreeCull::checkProjectionArea(const LLVector4a& center, const LLVector4a& size, const LLVector3& shift, F32 pixel_threshold, F32 near_radius)
@@ -1478,14 +1628,27 @@ bool LLViewerOctreeCull::checkObjects(const OctreeNode* branch, const LLViewerOc
     {
         return true;
     }
-    else if (mRes == 1 && !frustumCheckObjects(group)) //no objects in frustum
+    else if (mRes == 1) //no objects in frustum?
     {
-        return false;
+        S32 res = (mCurrent && mCurrent->mGroup == group && mCurrent->mObjects >= 0) ? mCurrent->mObjects : frustumCheckObjects(group);
+        if (!res)
+        {
+            return false;
+        }
     }
 
     return true;
 }
 
+//virtual
+void LLViewerOctreeCull::frustumCheckChildren(const OctreeNode* n, S32* results)
+{
+    for (U32 i = 0; i < n->getChildCount(); i++)
+    {
+        results[i] = frustumCheck((LLViewerOctreeGroup*) n->getChild(i)->getListener(0));
+    }
+}
+
 //virtual
 void LLViewerOctreeCull::preprocess(LLViewerOctreeGroup* group)
 {
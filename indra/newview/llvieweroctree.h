@@ -244,6 +244,13 @@ public:
     const LLVector4a* getObjectBounds() const  {return mObjectBounds;}
     const LLVector4a* getObjectExtents() const {return mObjectExtents;}
 
+    // Bounds of the child groups as structure of arrays, for packet frustum
+    // tests.  Packet i holds children 4i..4i+3 as center x, y, z then size
+    // x, y, z.  Kept by rebound(); getChildBoundsCount() is 0 when this node
+    // has no packets (a leaf, or a single child it copied the bounds of).
+    const LLVector4a* getChildBounds(U32 packet) const { return mChildBounds[packet]; }
+    U32 getChildBoundsCount() const { return mChildBoundsCount; }
+
     //octree wrappers to make code more readable
     element_iter getDataBegin() { return mOctreeNode->getDataBegin(); }
     element_iter getDataEnd() { return mOctreeNode->getDataEnd(); }
@@ -252,8 +259,10 @@ public:
 
 protected:
     void checkStates();
+    void shiftChildBounds(const LLVector4a& offset);
 private:
     virtual bool boundObjects(bool empty, LLVector4a& minOut, LLVector4a& maxOut);
+    void updateChildBounds();
 
 protected:
     U32         mState;
@@ -263,6 +272,8 @@ protected:
     LL_ALIGN_16(LLVector4a mObjectBounds[2]);  // bounding box (center, size) of objects in this node
     LL_ALIGN_16(LLVector4a mExtents[2]);       // extents (min, max) of this node and all its children
     LL_ALIGN_16(LLVector4a mObjectExtents[2]); // extents (min, max) of objects in this node
+    LL_ALIGN_16(LLVector4a mChildBounds[2][6]); // see getChildBounds()
+    U32         mChildBoundsCount;
 
     S32         mAnyVisible; //latest visible to any camera
     S32         mVisible[LLViewerCamera::NUM_CAMERAS];
@@ -369,11 +380,31 @@ public:
 class LLViewerOctreeCull : public OctreeTraveler
 {
 public:
+    // Frustum test results for one node, recorded by gather()
+    struct CullNode
+    {
+        LLViewerOctreeGroup*    mGroup;
+        U32                     mEnd;       // index one past the last node of this subtree
+        S8                      mFrustum;   // frustumCheck()
+        S8                      mObjects;   // frustumCheckObjects(), -1 if not tested
+    };
+    typedef std::vector<CullNode> cull_node_list_t;
+
     LLViewerOctreeCull(LLCamera* camera)
-        : mCamera(camera), mRes(0) { }
+        : mCamera(camera), mRes(0), mGathered(NULL), mGatherIndex(0), mCurrent(NULL) { }
 
     virtual void traverse(const OctreeNode* n);
 
+    // Run the frustum tests traverse() may need for the tree at n, and
+    // nothing else, so independent trees can be gathered on worker threads.
+    // Occlusion is ignored here; traverse() still applies it.
+    void gather(const OctreeNode* n, cull_node_list_t& nodes);
+
+    // Have traverse() take its frustum test results from nodes gathered for
+    // the same tree and camera.  Nodes that weren't gathered are tested as
+    // usual, so the outcome is the same as an ungathered traverse().
+    void setGathered(const cull_node_list_t* nodes) { mGathered = nodes; mGatherIndex = 0; }
+
 protected:
     virtual bool earlyFail(LLViewerOctreeGroup* group);
 
@@ -397,18 +428,36 @@ protected:
     S32 AABBInRegionFrustumObjectBounds(const LLViewerOctreeGroup* group);
     S32 AABBRegionSphereIntersectObjectExtents(const LLViewerOctreeGroup* group, const LLVector3& shift);
 
+    //agent space packet culls of all the children of a node, false if
+    //the node has no child bounds packets
+    bool AABBInFrustumNoFarClipChildBounds(const OctreeNode* n, S32* results);
+    bool AABBInFrustumChildBounds(const OctreeNode* n, S32* results);
+
     virtual S32 frustumCheck(const LLViewerOctreeGroup* group) = 0;
     virtual S32 frustumCheckObjects(const LLViewerOctreeGroup* group) = 0;
 
+    // frustumCheck() every child of n, into results[0..child count)
+    virtual void frustumCheckChildren(const OctreeNode* n, S32* results);
+
     bool checkProjectionArea(const LLVector4a& center, const LLVector4a& size, const LLVector3& shift, F32 pixel_threshold, F32 near_radius);
     virtual bool checkObjects(const OctreeNode* branch, const LLViewerOctreeGroup* group);
     virtual void preprocess(LLViewerOctreeGroup* group);
     virtual void processGroup(LLViewerOctreeGroup* group);
     virtual void visit(const OctreeNode* branch);
 
+private:
+    void gather(const OctreeNode* n, S32 res, cull_node_list_t& nodes);
+    const CullNode* findGathered(const LLViewerOctreeGroup* group);
+    void skipGathered(const CullNode* node);
+
 protected:
     LLCamera *mCamera;
     S32 mRes;
+
+private:
+    const cull_node_list_t* mGathered;
+    U32 mGatherIndex;
+    const CullNode* mCurrent;   // gathered results for the node being visited
 };
 
 //scan the octree, output the info of each node for debug use.
@@ -224,6 +224,7 @@ public:
     std::set< LLPointer<LLViewerOctreeGroup> >      mVisibleGroups; //visible groupa
     LLVOCachePartition*                   mVOCachePartition;
     LLVOCacheEntry::vocache_entry_set_t   mVisibleEntries; //must-be-created visible entries wait for objects creation.
+    LLVOCacheEntry::vocache_entry_set_t   mPriorEntries; //confirmed entries that were active on the last visit, created ahead of the cache tree cull.
     LLVOCacheEntry::vocache_entry_priority_list_t mWaitingList; //transient list storing sorted visible entries waiting for object creation.
     std::set<U32>                          mNonCacheableCreatedList; //list of local ids of all non-cacheable objects
     LLVOCacheEntry::vocache_gltf_overrides_map_t mGLTFOverridesLLSD; // for materials
@@ -772,6 +773,7 @@ LLViewerRegion::~LLViewerRegion()
     mDead = true;
     mImpl->mActiveSet.clear();
     mImpl->mVisibleEntries.clear();
+    mImpl->mPriorEntries.clear();
     mImpl->mVisibleGroups.clear();
     mImpl->mWaitingSet.clear();
 
@@ -852,6 +854,14 @@ void LLViewerRegion::loadObjectCache()
         {
             mCacheDirty = true;
         }
+        else
+        {
+            static LLCachedControl<bool> use_scene_snapshot(gSavedSettings, "ObjectCacheSceneSnapshot", false);
+            if (use_scene_snapshot && sVOCacheCullingEnabled)
+            {
+                vocache.readSceneSnapshot(mHandle, mImpl->mCacheID, mImpl->mCacheMap);
+            }
+        }
     }
 }
 
@@ -878,6 +888,13 @@ void LLViewerRegion::saveObjectCache()
         instance.writeToCache(mHandle, mImpl->mCacheID, mImpl->mCacheMap, mCacheDirty, removal_enabled);
         instance.writeGenericExtrasToCache(mHandle, mImpl->mCacheID, mImpl->mGLTFOverridesLLSD, mCacheDirty, removal_enabled);
         mCacheDirty = false;
+
+        //the snapshot is written even when the cache is clean, the set of active objects changes on every visit.
+        static LLCachedControl<bool> use_scene_snapshot(gSavedSettings, "ObjectCacheSceneSnapshot", false);
+        if (use_scene_snapshot && sVOCacheCullingEnabled)
+        {
+            instance.writeSceneSnapshot(mHandle, mImpl->mCacheID, mImpl->mCacheMap);
+        }
     }
 
     if (LLAppViewer::instance()->isQuitting())
@@ -1229,6 +1246,7 @@ void LLViewerRegion::killCacheEntry(LLVOCacheEntry* entry, bool for_rendering)
 
     //remove from the forced visible list
     mImpl->mVisibleEntries.erase(entry);
+    mImpl->mPriorEntries.erase(entry);
 
     //disconnect from parent if it is a child
     if(entry->getParentID() > 0)
@@ -1486,7 +1504,7 @@ void LLViewerRegion::updateVisibleEntries(F32 max_time)
         return;
     }
 
-    if(mImpl->mVisibleGroups.empty() && mImpl->mVisibleEntries.empty())
+    if(mImpl->mVisibleGroups.empty() && mImpl->mVisibleEntries.empty() && mImpl->mPriorEntries.empty())
     {
         return;
     }
@@ -1568,6 +1586,23 @@ void LLViewerRegion::updateVisibleEntries(F32 max_time)
         }
     }
 
+    //process entries that were active on the last visit, using the scene contribution restored from the snapshot
+    //until the group pass above has computed a current one. done last so no entry in mWaitingList is re-scored.
+    for(LLVOCacheEntry::vocache_entry_set_t::iterator iter = mImpl->mPriorEntries.begin(); iter != mImpl->mPriorEntries.end();)
+    {
+        LLVOCacheEntry* vo_entry = *iter;
+
+        if(vo_entry->isValid() && vo_entry->getState() < LLVOCacheEntry::WAITING)
+        {
+            mImpl->mWaitingList.insert(vo_entry);
+            ++iter;
+        }
+        else //created or gone
+        {
+            iter = mImpl->mPriorEntries.erase(iter);
+        }
+    }
+
     if(needs_update)
     {
         mImpl->mLastCameraOrigin = camera_origin;
@@ -2907,6 +2942,16 @@ void LLViewerRegion::decodeBoundingInfo(LLVOCacheEntry* entry)
     {
         addToVOCacheTree(entry);
     }
+
+    if(entry->hasState(LLVOCacheEntry::PRIOR_ACTIVE))
+    {
+        //confirmed by the sim and active on the last visit: queue it now instead of waiting for the cache tree cull.
+        entry->clearState(LLVOCacheEntry::PRIOR_ACTIVE);
+        if(entry->isState(LLVOCacheEntry::INACTIVE))
+        {
+            mImpl->mPriorEntries.insert(entry);
+        }
+    }
     return ;
 }
 
@@ -3221,6 +3266,7 @@ void LLViewerRegion::dumpCache()
 
 void LLViewerRegion::clearVOCacheFromMemory()
 {
+    mImpl->mPriorEntries.clear();
     mImpl->mCacheMap.clear();
 }
 
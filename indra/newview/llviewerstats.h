@@ -222,6 +222,7 @@ extern SimMeasurement<F64Megabytes >    SIM_PHYSICS_MEM;
 
 extern LLTrace::SampleStatHandle<F64Milliseconds >  FRAMETIME_JITTER,
                                                     FRAMETIME_SLEW,
+                                                    FRAMETIME,
                                                     SIM_PING;
 
 extern LLTrace::EventStatHandle<LLUnit<F64, LLUnits::Meters> > AGENT_POSITION_SNAP;
@@ -0,0 +1,360 @@
+/**
+ * @file llviewertelemetry.cpp
+ * @brief Periodic export of viewer performance counters for monitoring
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#include "llviewerprecompiledheaders.h"
+#include "llviewertelemetry.h"
+
+#include "llappviewer.h"
+#include "llasynclogwriter.h"
+#include "lldate.h"
+#include "lldir.h"
+#include "llfile.h"
+#include "llmemory.h"
+#include "llmeshrepository.h"
+#include "lltelemetrysocket.h"
+#include "lltexturefetch.h"
+#include "llviewercontrol.h"
+#include "llviewerstats.h"
+#include "httpstats.h"
+
+#include <cerrno>
+
+namespace
+{
+    // Each sample is well under 1KB, a small ring is plenty
+    const size_t TELEMETRY_RING_SIZE = 16 * 1024;
+
+    // Keeps the output valid JSON lines when samples had to be dropped
+    void format_dropped(std::ostream& out, U32 dropped)
+    {
+        out << "{\"time\":" << llformat("%.3f", LLDate::now().secondsSinceEpoch())
+            << ",\"dropped_samples\":" << dropped << "}";
+    }
+
+    // Collects output until the writer thread flushes, then hands the whole
+    // batch to send().  Runs on the writer thread only.
+    class BatchBuf : public std::streambuf
+    {
+    protected:
+        int_type overflow(int_type c) override
+        {
+            if (!traits_type::eq_int_type(c, traits_type::eof()))
+            {
+                mPending.push_back(traits_type::to_char_type(c));
+            }
+            return traits_type::not_eof(c);
+        }
+
+        std::streamsize xsputn(const char* s, std::streamsize n) override
+        {
+            mPending.append(s, (size_t)n);
+            return n;
+        }
+
+        int sync() override
+        {
+            send();
+            // Never report failure, the stream would ignore further output
+            return 0;
+        }
+
+        virtual void send() = 0;
+
+        std::string mPending;
+    };
+
+    // Appends to a file and rotates it to <file>.1 once it grows past the
+    // size limit, on the writer thread so the main thread never waits on
+    // the rename.
+    class RotatingFileBuf : public BatchBuf
+    {
+    public:
+        RotatingFileBuf(const std::string& path, U64 max_size)
+        :   mPath(path),
+            mFile(NULL),
+            mSize(0),
+            mMaxSize(max_size)
+        {
+        }
+
+        ~RotatingFileBuf()
+        {
+            if (mFile)
+            {
+                LLFile::close(mFile);
+            }
+        }
+
+        bool open()
+        {
+            mFile = LLFile::fopen(mPath, "ab");
+            if (!mFile)
+            {
+                return false;
+            }
+            fseek(mFile, 0, SEEK_END);
+            mSize = (U64)llmax(0L, ftell(mFile));
+            return true;
+        }
+
+    protected:
+        void send() override
+        {
+            if (mFile && !mPending.empty())
+            {
+                mSize += fwrite(mPending.data(), 1, mPending.size(), mFile);
+                fflush(mFile);
+            }
+            mPending.clear();
+
+            if (mFile && mMaxSize > 0 && mSize > mMaxSize)
+            {
+                LLFile::close(mFile);
+                std::string old_file = mPath + ".1";
+                LLFile::remove(old_file, ENOENT);
+                LLFile::rename(mPath, old_file);
+                // Output is discarded if the new file can't be opened
+                mSize = 0;
+                mFile = LLFile::fopen(mPath, "ab");
+            }
+        }
+
+    private:
+        std::string mPath;
+        LLFILE*     mFile;
+        U64         mSize;
+        const U64   mMaxSize;
+    };
+
+#if LL_LINUX || LL_DARWIN
+    // Sends to a UNIX domain socket, see LLTelemetrySocket
+    class UnixSocketBuf : public BatchBuf
+    {
+    public:
+        UnixSocketBuf(const std::string& path)
+        :   mSocket(path)
+        {
+        }
+
+    protected:
+        void send() override
+        {
+            mSocket.send(mPending);
+        }
+
+    private:
+        LLTelemetrySocket mSocket;
+    };
+#endif
+}
+
+LLViewerTelemetry::LLViewerTelemetry()
+:   mMaxFileSizeKB(0),
+    mFailed(false),
+    mLastMeshRequests(0),
+    mLastMeshErrors(0),
+    mLastHTTPRequests(0),
+    mLastHTTPBytes(0.0)
+{
+}
+
+LLViewerTelemetry::~LLViewerTelemetry()
+{
+    close();
+}
+
+void LLViewerTelemetry::idle()
+{
+    static LLCachedControl<F32> interval(gSavedSettings, "TelemetryExportInterval", 0.f);
+    static LLCachedControl<std::string> file_setting(gSavedSettings, "TelemetryExportFile", "");
+    static LLCachedControl<std::string> socket_setting(gSavedSettings, "TelemetryExportSocket", "");
+    static LLCachedControl<U32> max_size_kb(gSavedSettings, "TelemetryExportMaxFileSizeKB", 10240);
+
+    if (interval <= 0.f)
+    {
+        if (mWriter || mFailed)
+        {
+            close();
+            mFailed = false;
+        }
+        return;
+    }
+
+    std::string socket = socket_setting;
+    std::string file;
+    if (socket.empty())
+    {
+        file = file_setting;
+        if (file.empty())
+        {
+            file = gDirUtilp->getExpandedFilename(LL_PATH_LOGS, "telemetry.jsonl");
+        }
+    }
+
+    if (file != mFile || socket != mSocket || (!file.empty() && max_size_kb != mMaxFileSizeKB))
+    {
+        close();
+        mFailed = !open(file, socket, max_size_kb);
+    }
+    if (mFailed || mTimer.getElapsedTimeF32() < interval)
+    {
+        return;
+    }
+    mTimer.reset();
+
+    mWriter->post(makeSample());
+}
+
+bool LLViewerTelemetry::open(const std::string& file, const std::string& socket, U32 max_size_kb)
+{
+    mFile = file;
+    mSocket = socket;
+    mMaxFileSizeKB = max_size_kb;
+
+    if (!socket.empty())
+    {
+#if LL_LINUX || LL_DARWIN
+        mBuf.reset(new UnixSocketBuf(socket));
+        LL_INFOS() << "Exporting telemetry to socket " << socket << LL_ENDL;
+#else
+        LL_WARNS() << "TelemetryExportSocket is not supported on this platform, telemetry export disabled" << LL_ENDL;
+        return false;
+#endif
+    }
+    else
+    {
+        RotatingFileBuf* buf = new RotatingFileBuf(file, (U64)max_size_kb * 1024);
+        mBuf.reset(buf);
+        if (!buf->open())
+        {
+            LL_WARNS() << "Unable to open telemetry file " << file << LL_ENDL;
+            mBuf.reset();
+            return false;
+        }
+        LL_INFOS() << "Exporting telemetry to " << file << LL_ENDL;
+    }
+
+    mStream.reset(new std::ostream(mBuf.get()));
+    mWriter.reset(new LLError::AsyncLogWriter(*mStream, TELEMETRY_RING_SIZE, format_dropped));
+
+    // Start the running totals from now so the first sample reports a
+    // single interval
+    mLastMeshRequests = LLMeshRepository::sHTTPRequestCount;
+    mLastMeshErrors = LLMeshRepository::sHTTPErrorCount;
+    if (LLCore::HTTPStats::instanceExists())
+    {
+        mLastHTTPRequests = LLCore::HTTPStats::instance().getRequestCount();
+        mLastHTTPBytes = LLCore::HTTPStats::instance().getDataDownBytes();
+    }
+    mRecording.restart();
+    mTimer.reset();
+    return true;
+}
+
+void LLViewerTelemetry::close()
+{
+    // The writer drains before the stream goes away.  Neither output
+    // blocks, so this doesn't wait on a stalled collector.
+    mWriter.reset();
+    mStream.reset();
+    mBuf.reset();
+    mRecording.stop();
+    mFile.clear();
+    mSocket.clear();
+}
+
+std::string LLViewerTelemetry::makeSample()
+{
+    mRecording.stop();
+
+    F64 duration = mRecording.getDuration().value();
+    S32 frames = (S32)mRecording.getSum(LLStatViewer::FPS);
+    F64 frame_mean = 0.0;
+    F64 frame_max = 0.0;
+    if (mRecording.getSampleCount(LLStatViewer::FRAMETIME) > 0)
+    {
+        frame_mean = mRecording.getMean(LLStatViewer::FRAMETIME).value();
+        frame_max = mRecording.getMax(LLStatViewer::FRAMETIME).value();
+    }
+    F64 ping = 0.0;
+    if (mRecording.getSampleCount(LLStatViewer::SIM_PING) > 0)
+    {
+        ping = mRecording.getMean(LLStatViewer::SIM_PING).value();
+    }
+    S32 stutters = (S32)mRecording.getSum(LLStatViewer::FRAMETIME_DOUBLED);
+    F64 udp_in_kb = mRecording.getSum(LLStatViewer::MESSAGE_SYSTEM_DATA_IN).value();
+    F64 texture_udp_kb = mRecording.getSum(LLStatViewer::TEXTURE_NETWORK_DATA_RECEIVED).value();
+
+    mRecording.restart();
+
+    S32 texture_requests = 0;
+    S32 texture_http = 0;
+    if (LLTextureFetch* fetcher = LLAppViewer::getTextureFetch())
+    {
+        texture_requests = fetcher->getNumRequests();
+        texture_http = fetcher->getNumHTTPRequests();
+    }
+
+    U32 mesh_requests = LLMeshRepository::sHTTPRequestCount - mLastMeshRequests;
+    U32 mesh_errors = LLMeshRepository::sHTTPErrorCount - mLastMeshErrors;
+    mLastMeshRequests = LLMeshRepository::sHTTPRequestCount;
+    mLastMeshErrors = LLMeshRepository::sHTTPErrorCount;
+
+    S32 http_requests = 0;
+    F64 http_in_kb = 0.0;
+    if (LLCore::HTTPStats::instanceExists())
+    {
+        // The counters restart when HTTP stats are reset, report the new
+        // totals rather than a negative delta
+        S32 requests = LLCore::HTTPStats::instance().getRequestCount();
+        F64 bytes = LLCore::HTTPStats::instance().getDataDownBytes();
+        http_requests = requests >= mLastHTTPRequests ? requests - mLastHTTPRequests : requests;
+        http_in_kb = (bytes >= mLastHTTPBytes ? bytes - mLastHTTPBytes : bytes) / 1024.0;
+        mLastHTTPRequests = requests;
+        mLastHTTPBytes = bytes;
+    }
+
+    return llformat("{\"time\":%.3f,\"interval\":%.3f,\"frames\":%d,\"fps\":%.2f,"
+                    "\"frame_ms_mean\":%.2f,\"frame_ms_max\":%.2f,\"stutters\":%d,"
+                    "\"tex_requests\":%d,\"tex_http\":%d,"
+                    "\"mesh_headers\":%d,\"mesh_lods\":%d,\"mesh_lod_pending\":%u,"
+                    "\"mesh_http\":%u,\"mesh_http_errors\":%u,"
+                    "\"http_requests\":%d,\"http_in_kb\":%.1f,"
+                    "\"udp_in_kb\":%.1f,\"tex_udp_kb\":%.1f,\"ping_ms\":%.1f,"
+                    "\"rss_mb\":%.1f}",
+                    LLDate::now().secondsSinceEpoch(), duration, frames,
+                    duration > 0.0 ? frames / duration : 0.0,
+                    frame_mean, frame_max, stutters,
+                    texture_requests, texture_http,
+                    (S32)LLMeshRepoThread::sActiveHeaderRequests,
+                    (S32)LLMeshRepoThread::sActiveLODRequests,
+                    LLMeshRepository::sLODPending,
+                    mesh_requests, mesh_errors,
+                    http_requests, http_in_kb,
+                    udp_in_kb, texture_udp_kb, ping,
+                    LLMemory::getCurrentRSS() / (1024.0 * 1024.0));
+}
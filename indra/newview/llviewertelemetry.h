@@ -0,0 +1,91 @@
+/**
+ * @file llviewertelemetry.h
+ * @brief Periodic export of viewer performance counters for monitoring
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+#ifndef LL_LLVIEWERTELEMETRY_H
+#define LL_LLVIEWERTELEMETRY_H
+
+#include "llerror.h"
+#include "llframetimer.h"
+#include "llsingleton.h"
+#include "lltracerecording.h"
+
+#include <memory>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+namespace LLError
+{
+class AsyncLogWriter;
+}
+
+// Streams a sample of frame time, fetch queues, HTTP traffic and memory
+// use as one JSON object per line, every TelemetryExportInterval seconds,
+// for unattended installs monitored from outside the viewer.  Output goes
+// to TelemetryExportSocket (a UNIX domain stream socket, where supported)
+// or else to TelemetryExportFile, rotated at TelemetryExportMaxFileSizeKB.
+//
+// The main thread only reads counters and formats a short line once per
+// interval; all file and socket I/O, rotation included, is done by an
+// LLError::AsyncLogWriter thread, which drops lines rather than block if
+// the output stalls.
+class LLViewerTelemetry : public LLSimpleton<LLViewerTelemetry>
+{
+    LOG_CLASS(LLViewerTelemetry);
+public:
+    LLViewerTelemetry();
+    ~LLViewerTelemetry();
+
+    // Call once per frame.  Picks up settings changes and writes a sample
+    // when one is due.
+    void idle();
+
+private:
+    bool open(const std::string& file, const std::string& socket, U32 max_size_kb);
+    void close();
+    std::string makeSample();
+
+    std::unique_ptr<std::streambuf>         mBuf;
+    std::unique_ptr<std::ostream>           mStream;
+    std::unique_ptr<LLError::AsyncLogWriter> mWriter;
+
+    std::string         mFile;              // Current file, empty if writing to a socket
+    std::string         mSocket;            // Current socket path
+    U32                 mMaxFileSizeKB;     // Rotation size of the current file
+    bool                mFailed;            // Could not open the configured output
+
+    LLTrace::Recording  mRecording;         // Frame stats since the last sample
+    LLFrameTimer        mTimer;
+
+    // Running totals at the last sample, to report per interval deltas
+    U32                 mLastMeshRequests;
+    U32                 mLastMeshErrors;
+    S32                 mLastHTTPRequests;
+    F64                 mLastHTTPBytes;
+};
+
+#endif // LL_LLVIEWERTELEMETRY_H
@@ -73,6 +73,7 @@
 #include "llassetstorage.h"
 #include "llerrorcontrol.h"
 #include "llfontgl.h"
+#include "llframearena.h"
 #include "llmousehandler.h"
 #include "llrect.h"
 #include "llsky.h"
@@ -309,6 +310,10 @@ LLTrace::SampleStatHandle<> LLViewerWindow::sMouseVelocityStat("Mouse Velocity")
 class RecordToChatConsoleRecorder : public LLError::Recorder
 {
 public:
+    // recordMessage() below does nothing, so don't have every message
+    // formatted for it
+    virtual bool enabled() { return false; }
+
     virtual void recordMessage(LLError::ELevel level,
                                 const std::string& message)
     {
@@ -742,10 +747,28 @@ public:
             LLRender::sUICalls = LLRender::sUIVerts = 0;
             ypos += y_inc;
 
+            LLFrameArena& frame_arena = LLFrameArena::current();
+            addText(xpos, ypos, llformat("Frame Arena: %d allocs, %.1f KB, %d heap blocks",
+                                         frame_arena.getLastAllocationCount(), frame_arena.getLastBytesAllocated() / 1024.f,
+                                         frame_arena.getLastBlockAllocationCount()));
+            ypos += y_inc;
+
+            LLFontGL::GlyphRunStats glyph_runs = LLFontGL::getGlyphRunStats();
+            U64 glyph_run_lookups = glyph_runs.mHits + glyph_runs.mMisses;
+            addText(xpos, ypos, llformat("Glyph Runs: %.1f%% hits, %.1f ms saved",
+                                         glyph_run_lookups ? 100.0 * glyph_runs.mHits / glyph_run_lookups : 0.0,
+                                         glyph_runs.mSecondsSaved * 1000.0));
+            ypos += y_inc;
+
             addText(xpos,ypos, llformat("%d/%d Nodes visible", gPipeline.mNumVisibleNodes, LLSpatialGroup::sNodeCount));
 
             ypos += y_inc;
 
+            addText(xpos, ypos, llformat("%d Groups rebuilt (%.1f KB), %d Faces patched (%.1f KB)",
+                                         LLPipeline::sRebuiltGroups, LLPipeline::sRebuiltBytes / 1024.f,
+                                         LLPipeline::sPatchedFaces, LLPipeline::sPatchedBytes / 1024.f));
+            ypos += y_inc;
+
             if (!LLOcclusionCullingGroup::sPendingQueries.empty())
             {
                 addText(xpos,ypos, llformat("%d Queries pending", LLOcclusionCullingGroup::sPendingQueries.size()));
@@ -31,6 +31,7 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <sstream>
+#include <mutex>
 
 #include "llaudioengine.h"
 #include "noise.h"
@@ -70,6 +71,7 @@
 #include "llmanipscale.h"  // for get_default_max_prim_scale()
 #include "llmeshrepository.h"
 #include "llmutelist.h"
+#include "llparallelfor.h"
 #include "llmoveview.h"
 #include "llnotificationsutil.h"
 #include "llphysicsshapebuilderutil.h"
@@ -644,6 +646,7 @@ F32 LLVOAvatar::sGreyUpdateTime = 0.f;
 LLPointer<LLViewerTexture> LLVOAvatar::sCloudTexture = NULL;
 std::vector<LLUUID> LLVOAvatar::sAVsIgnoringARTLimit;
 S32 LLVOAvatar::sAvatarsNearby = 0;
+std::vector<LLPointer<LLVOAvatar> > LLVOAvatar::sQueuedMotionAvatars;
 
 //-----------------------------------------------------------------------------
 // Helper functions
@@ -658,6 +661,9 @@ LLVOAvatar::LLVOAvatar(const LLUUID& id,
                        LLViewerRegion* regionp) :
     LLAvatarAppearance(&gAgentWearables),
     LLViewerObject(id, pcode, regionp),
+    mMotionsQueued(false),
+    mQueuedSitGroundConstrained(false),
+    mQueuedVisible(false),
     mSpecialRenderMode(0),
     mAttachmentSurfaceArea(0.f),
     mAttachmentVisibleTriangleCount(0),
@@ -2154,6 +2160,15 @@ void LLVOAvatar::buildCharacter()
 {
     LLAvatarAppearance::buildCharacter();
 
+    // The skeleton was just rebuilt, so lay the hierarchy out afresh.
+    // It follows later edits to the tree by itself.
+    static LLCachedControl<bool> flattened_skeleton(gSavedSettings, "AvatarFlattenedSkeleton", false);
+    mJointHierarchy.reset();
+    if (flattened_skeleton)
+    {
+        mJointHierarchy = std::make_unique<LLJointHierarchy>(mRoot);
+    }
+
     // Not done building yet; more to do.
     mIsBuilt = false;
 
@@ -2881,7 +2896,17 @@ void LLVOAvatar::idleUpdate(LLAgent &agent, const F64 &time)
     // store off last frame's root position to be consistent with camera position
     mLastRootPos = mRoot->getWorldPosition();
     bool detailed_update = updateCharacter(agent);
+    if (mMotionsQueued)
+    {
+        // finished by updateQueuedMotions()
+        return;
+    }
+
+    finishIdleUpdate(agent, detailed_update);
+}
 
+void LLVOAvatar::finishIdleUpdate(LLAgent &agent, bool detailed_update)
+{
     static LLUICachedControl<bool> visualizers_in_calls("ShowVoiceVisualizersInCalls", false);
     bool voice_enabled = (visualizers_in_calls || LLVoiceClient::getInstance()->inProximalChannel()) &&
                          LLVoiceClient::getInstance()->getVoiceEnabled(mID);
@@ -5416,12 +5441,24 @@ bool LLVOAvatar::updateCharacter(LLAgent &agent)
     {
         updateMotions(LLCharacter::FORCE_UPDATE);
     }
+    else if (queueMotions(is_attachment))
+    {
+        mQueuedSitGroundConstrained = was_sit_ground_constrained;
+        mQueuedVisible = visible;
+        return visible;
+    }
     else
     {
         // Might be better to do HIDDEN_UPDATE if cloud
         updateMotions(LLCharacter::NORMAL_UPDATE);
     }
 
+    finishUpdateCharacter(was_sit_ground_constrained, visible);
+    return visible;
+}
+
+bool LLVOAvatar::finishUpdateCharacter(bool was_sit_ground_constrained, bool visible, bool update_joints)
+{
     // Special handling for sitting on ground.
     if (!getParent() && (isSitting() || was_sit_ground_constrained))
     {
@@ -5443,16 +5480,94 @@ bool LLVOAvatar::updateCharacter(LLAgent &agent)
     // Generate footstep sounds when feet hit the ground
     updateFootstepSounds();
 
-    // Update child joints as needed.
-    mRoot->updateWorldMatrixChildren();
-
     if (visible)
     {
         // System avatar mesh vertices need to be reskinned.
         mNeedsSkin = true;
     }
 
-    return visible;
+    // Update child joints as needed.
+    if (!update_joints && mJointHierarchy && mRoot->mUpdateXform)
+    {
+        return false;
+    }
+    mRoot->updateWorldMatrixChildren();
+    return true;
+}
+
+// Queue this avatar's motions for updateQueuedMotions() rather than
+// evaluating them now. Returns false if the motions were brought up to
+// date here, or were never eligible, and the update should carry on.
+bool LLVOAvatar::queueMotions(bool is_attachment)
+{
+    static LLCachedControl<bool> parallel_motions(gSavedSettings, "AvatarParallelMotionUpdate", false);
+    // Our own avatar stays serial as its stop requests feed back into the
+    // agent, and so does animesh riding on an avatar's attachment point.
+    if (!parallel_motions || isSelf() || is_attachment || isUIAvatar())
+    {
+        return false;
+    }
+
+    if (!prepareMotions(LLCharacter::NORMAL_UPDATE))
+    {
+        finishMotions();
+        return false;
+    }
+
+    mMotionsQueued = true;
+    sQueuedMotionAvatars.push_back(this);
+    return true;
+}
+
+//static
+void LLVOAvatar::updateQueuedMotions(LLAgent &agent)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_AVATAR;
+    if (sQueuedMotionAvatars.empty())
+    {
+        return;
+    }
+
+    // Keyframe sampling, constraints and pose blending only touch the
+    // avatar's own motions and joints. getGround() is serialized, and
+    // start/stop calls from motions wait for finishMotions().
+    LL::parallelFor("General", sQueuedMotionAvatars.size(), 1,
+                    [](size_t begin, size_t end)
+                    {
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            sQueuedMotionAvatars[i]->evaluateMotions();
+                        }
+                    });
+
+    // Joint world matrices, and everything that reads them, wait until
+    // all poses are in.
+    std::vector<LLJointHierarchy*> hierarchies;
+    for (LLVOAvatar* avatarp : sQueuedMotionAvatars)
+    {
+        avatarp->mMotionsQueued = false;
+        avatarp->finishMotions();
+        if (avatarp->isDead())
+        {
+            continue;
+        }
+        if (!avatarp->finishUpdateCharacter(avatarp->mQueuedSitGroundConstrained, avatarp->mQueuedVisible, false))
+        {
+            hierarchies.push_back(avatarp->mJointHierarchy.get());
+        }
+    }
+
+    // Flattened skeletons are independent of each other
+    LLJointHierarchy::updateAll(hierarchies);
+
+    for (LLVOAvatar* avatarp : sQueuedMotionAvatars)
+    {
+        if (!avatarp->isDead())
+        {
+            avatarp->finishIdleUpdate(agent, avatarp->mQueuedVisible);
+        }
+    }
+    sQueuedMotionAvatars.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -7710,6 +7825,11 @@ void LLVOAvatar::getGround(const LLVector3 &in_pos_agent, LLVector3 &out_pos_age
         return;
     }
 
+    // Ground constraints call this from the threads of updateQueuedMotions(),
+    // and the raycast may build volume octrees, so run one at a time.
+    static std::mutex ground_mutex;
+    std::lock_guard<std::mutex> lock(ground_mutex);
+
     p0_global = gAgent.getPosGlobalFromAgent(in_pos_agent) + z_vec;
     p1_global = gAgent.getPosGlobalFromAgent(in_pos_agent) - z_vec;
     LLViewerObject *obj;
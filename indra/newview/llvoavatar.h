@@ -40,6 +40,7 @@
 #include "lldrawpoolalpha.h"
 #include "llviewerobject.h"
 #include "llcharacter.h"
+#include "lljointhierarchy.h"
 #include "llcontrol.h"
 #include "llviewerjointmesh.h"
 #include "llviewerjointattachment.h"
@@ -285,6 +286,28 @@ public:
     void            updateTimeStep();
     void            updateRootPositionAndRotation(LLAgent &agent, F32 speed, bool was_sit_ground_constrained);
 
+    // With AvatarParallelMotionUpdate set, idleUpdate() of other residents'
+    // avatars stops short of evaluating their motions and queues them
+    // instead.  The queued avatars are animated here as parallel jobs,
+    // flattened skeletons get their world matrices as another parallel
+    // batch, then each avatar finishes its update on the main thread in
+    // queue order.
+    static void     updateQueuedMotions(LLAgent &agent);
+
+private:
+    bool            queueMotions(bool is_attachment);
+    // Returns false if the caller is left to update the joint hierarchy's
+    // world matrices, which only happens when update_joints is false.
+    bool            finishUpdateCharacter(bool was_sit_ground_constrained, bool visible, bool update_joints = true);
+    void            finishIdleUpdate(LLAgent &agent, bool detailed_update);
+
+    static std::vector<LLPointer<LLVOAvatar> > sQueuedMotionAvatars;
+    bool            mMotionsQueued;
+    bool            mQueuedSitGroundConstrained;
+    bool            mQueuedVisible;
+
+public:
+
     void            idleUpdateVoiceVisualizer(bool voice_enabled, const LLVector3 &position);
     void            idleUpdateMisc(bool detailed_update);
     virtual void    idleUpdateAppearanceAnimation();
@@ -498,6 +521,10 @@ public:
 
     S32                 mLastSkeletonSerialNum;
 
+private:
+    // Flattened form of the joint tree, if AvatarFlattenedSkeleton is set
+    std::unique_ptr<LLJointHierarchy> mJointHierarchy;
+
 
 /**                    Skeleton
  **                                                                            **
@@ -36,6 +36,15 @@
 #include "llagent.h" // <FS:Beq/> For gAgent
 #include "llworld.h" // For LLWorld::getInstance()
 
+#if LL_WINDOWS
+#include "llwin32headers.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 //static variables
 U32 LLVOCacheEntry::sMinFrameRange = 0;
 F32 LLVOCacheEntry::sNearRadius = 1.0f;
@@ -57,6 +66,91 @@ bool check_write(LLAPRFile* apr_file, void* src, S32 n_bytes)
     return apr_file->write(src, n_bytes) == n_bytes ;
 }
 
+//-------------------------------------------------------------------
+//LLVOCacheMappedFile
+//-------------------------------------------------------------------
+// Read-only memory mapping of a region cache file. Entries loaded from it keep a reference
+// until their body is first needed, so records that are never touched are never paged in.
+class LLVOCacheMappedFile
+{
+public:
+    LLVOCacheMappedFile() = default;
+    ~LLVOCacheMappedFile() { unmap(); }
+
+    bool map(const std::string& filename);
+    const U8* getData() const { return mData; }
+    size_t getSize() const    { return mSize; }
+
+private:
+    void unmap();
+
+    U8*     mData = nullptr;
+    size_t  mSize = 0;
+};
+
+bool LLVOCacheMappedFile::map(const std::string& filename)
+{
+    unmap();
+#if LL_WINDOWS
+    HANDLE file = CreateFileW(ll_convert_string_to_wide(filename).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                              NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    {
+        mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    }
+    CloseHandle(file); //the mapping keeps the file open.
+    if (!mapping)
+    {
+        return false;
+    }
+    mData = (U8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping); //the view keeps the mapping alive.
+    if (!mData)
+    {
+        return false;
+    }
+    mSize = (size_t)size.QuadPart;
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED)
+        {
+            mData = (U8*)data;
+            mSize = (size_t)st.st_size;
+        }
+    }
+    ::close(fd); //the mapping keeps the file open.
+#endif
+    return mData != nullptr;
+}
+
+void LLVOCacheMappedFile::unmap()
+{
+    if (mData)
+    {
+#if LL_WINDOWS
+        UnmapViewOfFile(mData);
+#else
+        munmap(mData, mSize);
+#endif
+    }
+    mData = nullptr;
+    mSize = 0;
+}
+
 // Material Override Cache needs a version label, so we can upgrade this later.
 const std::string LLGLTFOverrideCacheEntry::VERSION_LABEL = {"GLTFCacheVer"};
 const int LLGLTFOverrideCacheEntry::VERSION = 1;
@@ -165,6 +259,7 @@ LLVOCacheEntry::LLVOCacheEntry(U32 local_id, U32 crc, LLDataPackerBinaryBuffer &
     mHitCount(0),
     mDupeCount(0),
     mCRCChangeCount(0),
+    mFileOffset(0),
     mState(INACTIVE),
     mSceneContrib(0.f),
     mValid(true),
@@ -185,6 +280,7 @@ LLVOCacheEntry::LLVOCacheEntry()
     mDupeCount(0),
     mCRCChangeCount(0),
     mBuffer(NULL),
+    mFileOffset(0),
     mState(INACTIVE),
     mSceneContrib(0.f),
     mValid(true),
@@ -197,6 +293,7 @@ LLVOCacheEntry::LLVOCacheEntry()
 LLVOCacheEntry::LLVOCacheEntry(LLAPRFile* apr_file)
 :   LLViewerOctreeEntryData(LLViewerOctreeEntry::LLVOCACHEENTRY),
     mBuffer(NULL),
+    mFileOffset(0),
     mUpdateFlags(-1),
     mState(INACTIVE),
     mSceneContrib(0.f),
@@ -261,6 +358,27 @@ LLVOCacheEntry::LLVOCacheEntry(LLAPRFile* apr_file)
     }
 }
 
+// Only the table of the mapped file is read here, the record itself is left for decodeMapped().
+LLVOCacheEntry::LLVOCacheEntry(const std::shared_ptr<LLVOCacheMappedFile>& file, U32 local_id, U32 crc, U32 offset)
+:   LLViewerOctreeEntryData(LLViewerOctreeEntry::LLVOCACHEENTRY),
+    mLocalID(local_id),
+    mCRC(crc),
+    mUpdateFlags(-1),
+    mHitCount(0),
+    mDupeCount(0),
+    mCRCChangeCount(0),
+    mBuffer(NULL),
+    mMappedFile(file),
+    mFileOffset(offset),
+    mState(INACTIVE),
+    mSceneContrib(0.f),
+    mValid(false),
+    mParentID(0),
+    mBSphereRadius(-1.0f)
+{
+    mDP.assignBuffer(mBuffer, 0);
+}
+
 LLVOCacheEntry::~LLVOCacheEntry()
 {
     mDP.freeBuffer();
@@ -275,6 +393,8 @@ void LLVOCacheEntry::updateEntry(U32 crc, LLDataPackerBinaryBuffer &dp)
     }
 
     mDP.freeBuffer();
+    mMappedFile.reset();
+    mFileOffset = 0; //the record in the region file is stale now.
 
     llassert_always(dp.getBufferSize() > 0);
     mBuffer = new U8[dp.getBufferSize()];
@@ -310,7 +430,7 @@ void LLVOCacheEntry::removeAllChildren()
 //virtual
 void LLVOCacheEntry::setOctreeEntry(LLViewerOctreeEntry* entry)
 {
-    if(!entry && mDP.getBufferSize() > 0)
+    if(!entry && getDP())
     {
         LLUUID fullid;
         LLViewerObject::unpackUUID(&mDP, fullid, "ID");
@@ -407,6 +527,8 @@ LLVOCacheEntry* LLVOCacheEntry::getChild()
 
 LLDataPackerBinaryBuffer *LLVOCacheEntry::getDP()
 {
+    decodeMapped();
+
     if (mDP.getBufferSize() == 0)
     {
         //LL_INFOS() << "Not getting cache entry, invalid!" << LL_ENDL;
@@ -416,6 +538,50 @@ LLDataPackerBinaryBuffer *LLVOCacheEntry::getDP()
     return &mDP;
 }
 
+void LLVOCacheEntry::decodeMapped()
+{
+    if (!mMappedFile)
+    {
+        return;
+    }
+
+    const U8* record = mMappedFile->getData() + mFileOffset;
+    S32 size = -1;
+    if ((size_t)mFileOffset + ENTRY_HEADER_SIZE <= mMappedFile->getSize())
+    {
+        U32 local_id;
+        memcpy(&local_id, record, sizeof(U32));
+        memcpy(&size, record + (5 * sizeof(U32)), sizeof(S32));
+        if (local_id != mLocalID || (size_t)mFileOffset + ENTRY_HEADER_SIZE + size > mMappedFile->getSize())
+        {
+            size = -1;
+        }
+    }
+
+    if (size < 1 || size > MAX_ENTRY_BODY_SIZE)
+    {
+        //leave the body empty, getDP() then reports nothing cached and the sim resends the object.
+        LL_WARNS() << "Bogus mapped cache entry " << mLocalID << ", size " << size << LL_ENDL;
+    }
+    else
+    {
+        //counters recorded this session are added to the stored ones.
+        S32 count;
+        memcpy(&count, record + (2 * sizeof(U32)), sizeof(S32));
+        mHitCount += count;
+        memcpy(&count, record + (3 * sizeof(U32)), sizeof(S32));
+        mDupeCount += count;
+        memcpy(&count, record + (4 * sizeof(U32)), sizeof(S32));
+        mCRCChangeCount += count;
+
+        mBuffer = new U8[size];
+        memcpy(mBuffer, record + ENTRY_HEADER_SIZE, size);
+        mDP.assignBuffer(mBuffer, size);
+    }
+
+    mMappedFile.reset();
+}
+
 void LLVOCacheEntry::recordHit()
 {
     mHitCount++;
@@ -432,8 +598,10 @@ void LLVOCacheEntry::dump() const
         << LL_ENDL;
 }
 
-S32 LLVOCacheEntry::writeToBuffer(U8 *data_buffer) const
+S32 LLVOCacheEntry::writeToBuffer(U8 *data_buffer)
 {
+    decodeMapped();
+
     S32 size = mDP.getBufferSize();
 
     if (size > MAX_ENTRY_BODY_SIZE)
@@ -1164,6 +1332,78 @@ void LLVOCachePartition::removeOccluder(LLVOCacheGroup* group)
 // Format strings used to construct filename for the object cache
 static const char OBJECT_CACHE_FILENAME[] = "objects_%d_%d.slc";
 static const char OBJECT_CACHE_EXTRAS_FILENAME[] = "objects_%d_%d_extras.slec";
+static const char OBJECT_CACHE_SCENE_FILENAME[] = "objects_%d_%d_scene.slss";
+static const U32 SCENE_SNAPSHOT_VERSION = 1;
+
+// Memory mapped region cache file:
+//   MappedCacheHeader | entry records | MappedCacheSlot[num_slots] | MappedCacheTrailer
+// Records use the same layout as the legacy file. Each save appends the changed records and
+// a new table sorted by local id, and the trailer at the end of the file locates the current
+// table. Superseded records and tables stay in the file until they outweigh the live records,
+// then the file is rewritten.
+static const char OBJECT_CACHE_MAPPED_FILENAME[] = "objects_%d_%d.slcm";
+static const U32 MAPPED_CACHE_MAGIC = 0x4d434f56; //'VOCM'
+static const U32 MAPPED_TABLE_MAGIC = 0x54434f56; //'VOCT'
+static const U32 MAPPED_CACHE_VERSION = 1;
+
+struct MappedCacheHeader
+{
+    U32 mMagic;
+    U32 mVersion;
+    U8  mCacheID[UUID_BYTES];
+};
+
+struct MappedCacheSlot
+{
+    U32 mLocalID;
+    U32 mCRC;
+    U32 mOffset; //record offset from the start of the file
+    U32 mSize;   //record size, header included
+};
+
+struct MappedCacheTrailer
+{
+    U32 mNumSlots;
+    U32 mMagic;
+};
+
+// Locate the current table of a mapped region file, false if the file is not usable for this region.
+static bool get_mapped_table(const LLVOCacheMappedFile& file, const LLUUID& id, const MappedCacheSlot*& slots, U32& num_slots)
+{
+    const size_t size = file.getSize();
+    if (size < sizeof(MappedCacheHeader) + sizeof(MappedCacheTrailer))
+    {
+        return false;
+    }
+
+    MappedCacheHeader header;
+    memcpy(&header, file.getData(), sizeof(MappedCacheHeader));
+    if (header.mMagic != MAPPED_CACHE_MAGIC || header.mVersion != MAPPED_CACHE_VERSION || memcmp(header.mCacheID, id.mData, UUID_BYTES))
+    {
+        return false;
+    }
+
+    MappedCacheTrailer trailer;
+    memcpy(&trailer, file.getData() + size - sizeof(MappedCacheTrailer), sizeof(MappedCacheTrailer));
+    const size_t table_bytes = (size_t)trailer.mNumSlots * sizeof(MappedCacheSlot);
+    if (trailer.mMagic != MAPPED_TABLE_MAGIC || table_bytes > size - sizeof(MappedCacheHeader) - sizeof(MappedCacheTrailer))
+    {
+        return false;
+    }
+
+    //the table is written 4-byte aligned, and the mapping is page aligned.
+    slots = (const MappedCacheSlot*)(file.getData() + size - sizeof(MappedCacheTrailer) - table_bytes);
+    num_slots = trailer.mNumSlots;
+    return true;
+}
+
+// One record per root entry that was in the rendering pipeline when the region was saved.
+struct SceneSnapshotRecord
+{
+    U32 mLocalID;
+    U32 mCRC;
+    F32 mSceneContrib;
+};
 
 const U32 MAX_NUM_OBJECT_ENTRIES = 128 ;
 const U32 MIN_ENTRIES_TO_PURGE = 16 ;
@@ -1177,10 +1417,12 @@ LLVOCache::LLVOCache(bool read_only) :
     mReadOnly(read_only),
     mNumEntries(0),
     mCacheSize(1),
-    mEnabled(true)
+    mEnabled(true),
+    mMappedFiles(false)
 {
 #ifndef LL_TEST
     mEnabled = gSavedSettings.getBOOL("ObjectCacheEnabled");
+    mMappedFiles = gSavedSettings.getBOOL("ObjectCacheMappedFiles");
 #endif
     mLocalAPRFilePoolp = new LLVolatileAPRPool() ;
 }
@@ -1381,6 +1623,24 @@ std::string LLVOCache::getObjectCacheExtrasFilename(U64 handle)
                llformat(OBJECT_CACHE_EXTRAS_FILENAME, region_x, region_y));
 }
 
+std::string LLVOCache::getMappedCacheFilename(U64 handle)
+{
+    U32 region_x, region_y;
+
+    grid_from_region_handle(handle, &region_x, &region_y);
+    return gDirUtilp->getExpandedFilename(LL_PATH_CACHE, object_cache_dirname,
+               llformat(OBJECT_CACHE_MAPPED_FILENAME, region_x, region_y));
+}
+
+std::string LLVOCache::getSceneSnapshotFilename(U64 handle)
+{
+    U32 region_x, region_y;
+
+    grid_from_region_handle(handle, &region_x, &region_y);
+    return gDirUtilp->getExpandedFilename(LL_PATH_CACHE, object_cache_dirname,
+               llformat(OBJECT_CACHE_SCENE_FILENAME, region_x, region_y));
+}
+
 void LLVOCache::removeFromCache(HeaderEntryInfo* entry)
 {
     if(mReadOnly)
@@ -1393,6 +1653,7 @@ void LLVOCache::removeFromCache(HeaderEntryInfo* entry)
     getObjectCacheFilename(entry->mHandle, filename);
     LL_WARNS("GLTF", "VOCache") << "Removing object cache for handle " << entry->mHandle << "Filename: " << filename << LL_ENDL;
     LLAPRFile::remove(filename, mLocalAPRFilePoolp);
+    LLFile::remove(getMappedCacheFilename(entry->mHandle), ENOENT);
 
     // Note: `removeFromCache` should take responsibility for cleaning up all cache artefacts specfic to the handle/entry.
     // as such this now includes the generic extras
@@ -1400,6 +1661,9 @@ void LLVOCache::removeFromCache(HeaderEntryInfo* entry)
     LL_WARNS("GLTF", "VOCache") << "Removing generic extras for handle " << entry->mHandle << "Filename: " << filename << LL_ENDL;
     LLFile::remove(filename);
 
+    // the scene snapshot refers to entries of the object cache, it is meaningless without it.
+    LLFile::remove(getSceneSnapshotFilename(entry->mHandle));
+
     entry->mTime = INVALID_TIME ;
     updateEntry(entry) ; //update the head file.
 }
@@ -1571,6 +1835,15 @@ bool LLVOCache::readFromCache(U64 handle, const LLUUID& id, LLVOCacheEntry::voca
     bool success = true ;
     S32 num_entries = 0 ; // lifted out of inner loop.
     std::string filename; // lifted out of loop
+    // without a mapped file yet, the legacy file is read and converted on the next write.
+    const bool read_mapped = mMappedFiles && LLFile::isfile(getMappedCacheFilename(handle));
+    if(read_mapped)
+    {
+        filename = getMappedCacheFilename(handle);
+        success = readFromMappedFile(handle, id, cache_entry_map);
+        num_entries = static_cast<S32>(cache_entry_map.size());
+    }
+    else
     {
 		LL_PROFILE_ZONE_NAMED_CATEGORY_NETWORK("VOCache:loadRegionObjectCache");        
         LLUUID cache_id;
@@ -1619,7 +1892,42 @@ bool LLVOCache::readFromCache(U64 handle, const LLUUID& id, LLVOCacheEntry::voca
     }
 
     LL_DEBUGS("GLTF", "VOCache") << "Read " << cache_entry_map.size() << " entries from object cache " << filename << ", expected " << num_entries << ", success=" << (success?"True":"False") << LL_ENDL;
-    return success;
+    return success && (read_mapped || !mMappedFiles); //reporting a legacy read as failed marks the cache dirty.
+}
+
+bool LLVOCache::readFromMappedFile(U64 handle, const LLUUID& id, LLVOCacheEntry::vocache_entry_map_t& cache_entry_map)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+    std::string filename(getMappedCacheFilename(handle));
+    std::shared_ptr<LLVOCacheMappedFile> file = std::make_shared<LLVOCacheMappedFile>();
+    if(!file->map(filename))
+    {
+        LL_WARNS() << "Failed to map object cache " << filename << LL_ENDL;
+        return false;
+    }
+
+    const MappedCacheSlot* slots = NULL;
+    U32 num_slots = 0;
+    if(!get_mapped_table(*file, id, slots, num_slots))
+    {
+        LL_INFOS() << "Cache ID or table doesn't match for this region, discarding " << filename << LL_ENDL;
+        return false;
+    }
+
+    //only the table is read, records are paged in when an entry is first used.
+    const size_t table_offset = (const U8*)slots - file->getData();
+    for(U32 i = 0; i < num_slots; i++)
+    {
+        const MappedCacheSlot& slot = slots[i];
+        if(!slot.mLocalID || slot.mOffset < sizeof(MappedCacheHeader) || (size_t)slot.mOffset + slot.mSize > table_offset)
+        {
+            LL_WARNS() << "Aborting cache file load for " << filename << ", cache file corruption!" << LL_ENDL;
+            return false;
+        }
+        cache_entry_map[slot.mLocalID] = new LLVOCacheEntry(file, slot.mLocalID, slot.mCRC, slot.mOffset);
+    }
+
+    return true;
 }
 
 // We now pass in the cache entry map, so that we can remove entries from extras that are no longer in the primary cache.
@@ -1840,6 +2148,15 @@ void LLVOCache::writeToCache(U64 handle, const LLUUID& id, const LLVOCacheEntry:
 
     //write to cache file
     bool success = true ;
+    if(mMappedFiles)
+    {
+        success = writeToMappedFile(handle, id, cache_entry_map, removal_enabled);
+        if(success)
+        {
+            LLFile::remove(filename, ENOENT); //converted from the legacy format.
+        }
+    }
+    else
     {
         std::string filename;
         getObjectCacheFilename(handle, filename);
@@ -1902,6 +2219,10 @@ void LLVOCache::writeToCache(U64 handle, const LLUUID& id, const LLVOCacheEntry:
                 LL_DEBUGS("VOCache") << "Wrote " << num_entries << " entries to the primary VOCache file " << filename << ". success = " << (success ? "True":"False") << LL_ENDL;
             }
         }
+        if(success)
+        {
+            LLFile::remove(getMappedCacheFilename(handle), ENOENT); //stale once the legacy file is newer.
+        }
     }
 
     if(!success)
@@ -1912,6 +2233,145 @@ void LLVOCache::writeToCache(U64 handle, const LLUUID& id, const LLVOCacheEntry:
     return ;
 }
 
+bool LLVOCache::writeToMappedFile(U64 handle, const LLUUID& id, const LLVOCacheEntry::vocache_entry_map_t& cache_entry_map, bool removal_enabled)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+    std::string filename(getMappedCacheFilename(handle));
+
+    //records of the current table that entries still point at are kept in place.
+    std::unordered_map<U32, MappedCacheSlot> current_slots; //by offset
+    size_t file_size = 0;
+    {
+        LLVOCacheMappedFile file;
+        const MappedCacheSlot* slots = NULL;
+        U32 num_slots = 0;
+        if(file.map(filename) && get_mapped_table(file, id, slots, num_slots))
+        {
+            file_size = file.getSize();
+            for(U32 i = 0; i < num_slots; i++)
+            {
+                current_slots[slots[i].mOffset] = slots[i];
+            }
+        }
+    }
+
+    std::vector<MappedCacheSlot> table;
+    std::vector<LLVOCacheEntry*> dirty_entries;
+    size_t kept_bytes = 0;
+    for(LLVOCacheEntry::vocache_entry_map_t::const_iterator iter = cache_entry_map.begin(); iter != cache_entry_map.end(); ++iter)
+    {
+        LLVOCacheEntry* entry = iter->second;
+        if(removal_enabled && !entry->isValid())
+        {
+            continue;
+        }
+
+        std::unordered_map<U32, MappedCacheSlot>::const_iterator slot = current_slots.find(entry->getFileOffset());
+        if(entry->getFileOffset() && slot != current_slots.end() && slot->second.mLocalID == entry->getLocalID() && slot->second.mCRC == entry->getCRC())
+        {
+            table.push_back(slot->second);
+            kept_bytes += slot->second.mSize;
+        }
+        else
+        {
+            dirty_entries.push_back(entry);
+        }
+    }
+
+    //rewrite once superseded records and old tables outweigh the live records.
+    const bool rewrite = !file_size || file_size - sizeof(MappedCacheHeader) - kept_bytes > kept_bytes;
+    if(rewrite)
+    {
+        table.clear();
+        dirty_entries.clear();
+        for(LLVOCacheEntry::vocache_entry_map_t::const_iterator iter = cache_entry_map.begin(); iter != cache_entry_map.end(); ++iter)
+        {
+            //nothing may keep the old mapping alive while the file is truncated.
+            iter->second->decodeMapped();
+            if(!removal_enabled || iter->second->isValid())
+            {
+                dirty_entries.push_back(iter->second);
+            }
+        }
+    }
+
+    LLAPRFile apr_file(filename, rewrite ? APR_CREATE|APR_WRITE|APR_BINARY|APR_TRUNCATE : APR_WRITE|APR_BINARY|APR_APPEND, mLocalAPRFilePoolp);
+    size_t offset = rewrite ? 0 : file_size;
+    bool success = true;
+    if(rewrite)
+    {
+        MappedCacheHeader header;
+        header.mMagic = MAPPED_CACHE_MAGIC;
+        header.mVersion = MAPPED_CACHE_VERSION;
+        memcpy(header.mCacheID, id.mData, UUID_BYTES);
+        success = check_write(&apr_file, &header, sizeof(MappedCacheHeader));
+        offset += sizeof(MappedCacheHeader);
+    }
+
+    const S32 buffer_size = 32768; //should be large enough for couple MAX_ENTRY_BODY_SIZE
+    U8 data_buffer[buffer_size];
+    S32 size_in_buffer = 0;
+    std::vector<std::pair<LLVOCacheEntry*, U32> > written; //offsets are only assigned once the table is on disk.
+    for(LLVOCacheEntry* entry : dirty_entries)
+    {
+        if(!success)
+        {
+            break;
+        }
+
+        S32 size = entry->writeToBuffer(data_buffer + size_in_buffer);
+        if(size <= ENTRY_HEADER_SIZE)
+        {
+            continue; //nothing cached for this entry.
+        }
+
+        MappedCacheSlot slot = { entry->getLocalID(), entry->getCRC(), (U32)offset, (U32)size };
+        table.push_back(slot);
+        written.push_back(std::make_pair(entry, (U32)offset));
+        offset += size;
+        size_in_buffer += size;
+
+        if(buffer_size - size_in_buffer < MAX_ENTRY_BODY_SIZE + ENTRY_HEADER_SIZE)
+        {
+            success = check_write(&apr_file, data_buffer, size_in_buffer);
+            size_in_buffer = 0;
+        }
+    }
+    if(success && size_in_buffer > 0)
+    {
+        success = check_write(&apr_file, data_buffer, size_in_buffer);
+    }
+
+    if(success)
+    {
+        //keep the table ID-indexed and aligned.
+        std::sort(table.begin(), table.end(), [](const MappedCacheSlot& a, const MappedCacheSlot& b) { return a.mLocalID < b.mLocalID; });
+
+        U32 padding = 0;
+        const S32 padding_size = (S32)((4 - offset % 4) % 4);
+        MappedCacheTrailer trailer = { static_cast<U32>(table.size()), MAPPED_TABLE_MAGIC };
+        success = (!padding_size || check_write(&apr_file, &padding, padding_size)) &&
+                  (table.empty() || check_write(&apr_file, table.data(), (S32)(table.size() * sizeof(MappedCacheSlot)))) &&
+                  check_write(&apr_file, &trailer, sizeof(MappedCacheTrailer));
+    }
+    apr_file.close();
+
+    if(!success)
+    {
+        LL_WARNS() << "Failed to write cache to disk " << filename << LL_ENDL;
+        LLFile::remove(filename, ENOENT);
+        return false;
+    }
+
+    for(const std::pair<LLVOCacheEntry*, U32>& entry : written)
+    {
+        entry.first->setFileOffset(entry.second);
+    }
+
+    LL_DEBUGS("VOCache") << (rewrite ? "Rewrote " : "Appended ") << written.size() << " of " << table.size() << " entries to the mapped VOCache file " << filename << LL_ENDL;
+    return true;
+}
+
 void LLVOCache::removeGenericExtrasForHandle(U64 handle)
 {
     if(mReadOnly)
@@ -2030,3 +2490,111 @@ void LLVOCache::writeGenericExtrasToCache(U64 handle, const LLUUID& id, const LL
     }
     LL_DEBUGS("GLTF") << "Completed writing extras cache for handle " << handle << ", " << num_entries << " entries. Total in RAM: " << inmem_entries << " skipped (no persist): " << skipped << LL_ENDL;
 }
+
+S32 LLVOCache::readSceneSnapshot(U64 handle, const LLUUID& id, LLVOCacheEntry::vocache_entry_map_t& cache_entry_map)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+    if(!mEnabled || cache_entry_map.empty())
+    {
+        return 0;
+    }
+    llassert_always(mInitialized);
+
+    if(mHandleEntryMap.find(handle) == mHandleEntryMap.end()) //no cache
+    {
+        return 0;
+    }
+
+    std::string filename(getSceneSnapshotFilename(handle));
+    if(!LLFile::isfile(filename))
+    {
+        return 0;
+    }
+    LLAPRFile apr_file(filename, APR_READ|APR_BINARY, mLocalAPRFilePoolp);
+
+    LLUUID cache_id;
+    U32 version = 0;
+    S32 num_entries = 0;
+    if(!check_read(&apr_file, cache_id.mData, UUID_BYTES) || cache_id != id ||
+       !check_read(&apr_file, &version, sizeof(U32)) || version != SCENE_SNAPSHOT_VERSION ||
+       !check_read(&apr_file, &num_entries, sizeof(S32)) || num_entries < 0 || num_entries > (S32)cache_entry_map.size())
+    {
+        LL_DEBUGS("VOCache") << "Discarding scene snapshot " << filename << LL_ENDL;
+        return 0;
+    }
+
+    std::vector<SceneSnapshotRecord> records(num_entries);
+    if(num_entries > 0 && !check_read(&apr_file, records.data(), num_entries * sizeof(SceneSnapshotRecord)))
+    {
+        LL_WARNS() << "Failed reading scene snapshot " << filename << LL_ENDL;
+        return 0;
+    }
+
+    S32 flagged = 0;
+    for(const SceneSnapshotRecord& record : records)
+    {
+        LLVOCacheEntry::vocache_entry_map_t::iterator iter = cache_entry_map.find(record.mLocalID);
+        if(iter == cache_entry_map.end() || iter->second->getCRC() != record.mCRC)
+        {
+            continue; //object changed since the snapshot was taken.
+        }
+
+        iter->second->setState(LLVOCacheEntry::PRIOR_ACTIVE);
+        iter->second->setSceneContribution(record.mSceneContrib);
+        ++flagged;
+    }
+
+    LL_DEBUGS("VOCache") << "Read scene snapshot " << filename << ", " << flagged << " of " << num_entries << " entries still match" << LL_ENDL;
+    return flagged;
+}
+
+void LLVOCache::writeSceneSnapshot(U64 handle, const LLUUID& id, const LLVOCacheEntry::vocache_entry_map_t& cache_entry_map)
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_NETWORK;
+    if(!mEnabled || mReadOnly)
+    {
+        return;
+    }
+    llassert_always(mInitialized);
+
+    if(mHandleEntryMap.find(handle) == mHandleEntryMap.end()) //object cache was not written
+    {
+        return;
+    }
+
+    std::vector<SceneSnapshotRecord> records;
+    for(LLVOCacheEntry::vocache_entry_map_t::const_iterator iter = cache_entry_map.begin(); iter != cache_entry_map.end(); ++iter)
+    {
+        LLVOCacheEntry* entry = iter->second;
+        //children follow their parents into the rendering pipeline, only root entries are recorded.
+        if(!entry->isValid() || entry->isChild() || !entry->isState(LLVOCacheEntry::ACTIVE))
+        {
+            continue;
+        }
+        records.push_back({ entry->getLocalID(), entry->getCRC(), entry->getSceneContribution() });
+    }
+
+    std::string filename(getSceneSnapshotFilename(handle));
+    if(records.empty())
+    {
+        LLFile::remove(filename);
+        return;
+    }
+
+    S32 num_entries = static_cast<S32>(records.size());
+    U32 version = SCENE_SNAPSHOT_VERSION;
+    LLAPRFile apr_file(filename, APR_CREATE|APR_WRITE|APR_BINARY|APR_TRUNCATE, mLocalAPRFilePoolp);
+    bool success = check_write(&apr_file, (void*)id.mData, UUID_BYTES) &&
+                   check_write(&apr_file, &version, sizeof(U32)) &&
+                   check_write(&apr_file, &num_entries, sizeof(S32)) &&
+                   check_write(&apr_file, records.data(), num_entries * sizeof(SceneSnapshotRecord));
+    apr_file.close();
+
+    if(!success)
+    {
+        LL_WARNS() << "Failed writing scene snapshot " << filename << LL_ENDL;
+        LLFile::remove(filename);
+        return;
+    }
+    LL_DEBUGS("VOCache") << "Wrote " << num_entries << " entries to the scene snapshot " << filename << LL_ENDL;
+}
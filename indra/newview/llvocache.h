@@ -34,11 +34,13 @@
 #include "llapr.h"
 #include "llgltfmaterial.h"
 
+#include <memory>
 #include <unordered_map>
 
 //---------------------------------------------------------------------------
 // Cache entries
 class LLCamera;
+class LLVOCacheMappedFile;
 
 class LLGLTFOverrideCacheEntry
 {
@@ -70,6 +72,7 @@ public:
 
         //high 16-bit state
         IN_VO_TREE = 0x00010000,    //the entry is in the object cache tree.
+        PRIOR_ACTIVE = 0x00020000,  //the entry was in the rendering pipeline when the region scene snapshot was saved.
 
         LOW_BITS  = 0x0000ffff,
         HIGH_BITS = 0xffff0000
@@ -110,6 +113,7 @@ protected:
 public:
     LLVOCacheEntry(U32 local_id, U32 crc, LLDataPackerBinaryBuffer &dp);
     LLVOCacheEntry(LLAPRFile* apr_file);
+    LLVOCacheEntry(const std::shared_ptr<LLVOCacheMappedFile>& file, U32 local_id, U32 crc, U32 offset);
     LLVOCacheEntry();
 
     void updateEntry(U32 crc, LLDataPackerBinaryBuffer &dp);
@@ -126,14 +130,18 @@ public:
     U32 getCRC() const              { return mCRC; }
     S32 getHitCount() const         { return mHitCount; }
     S32 getCRCChangeCount() const   { return mCRCChangeCount; }
+    U32 getFileOffset() const       { return mFileOffset; }
+    void setFileOffset(U32 offset)  { mFileOffset = offset; }
+    bool isMapped() const           { return mMappedFile != nullptr; }
 
     void calcSceneContribution(const LLVector4a& camera_origin, bool needs_update, U32 last_update, F32 dist_threshold);
     void setSceneContribution(F32 scene_contrib) {mSceneContrib = scene_contrib;}
     F32 getSceneContribution() const             { return mSceneContrib;}
 
     void dump() const;
-    S32 writeToBuffer(U8 *data_buffer) const;
+    S32 writeToBuffer(U8 *data_buffer);
     LLDataPackerBinaryBuffer *getDP();
+    void decodeMapped(); //copy the body out of the mapped region file.
     void recordHit();
     void recordDupe() { mDupeCount++; }
 
@@ -183,6 +191,8 @@ protected:
     S32                         mCRCChangeCount;
     LLDataPackerBinaryBuffer    mDP;
     U8                          *mBuffer;
+    std::shared_ptr<LLVOCacheMappedFile> mMappedFile; //set until the body is first needed.
+    U32                         mFileOffset; //offset of the record in the mapped region file, 0 if it has to be written.
 
     F32                         mSceneContrib; //projected scene contributuion of this object.
     U32                         mState; //high 16 bits reserved for special use.
@@ -294,20 +304,31 @@ public:
 
     bool readFromCache(U64 handle, const LLUUID& id, LLVOCacheEntry::vocache_entry_map_t& cache_entry_map) ;
     void readGenericExtrasFromCache(U64 handle, const LLUUID& id, LLVOCacheEntry::vocache_gltf_overrides_map_t& cache_extras_entry_map, const LLVOCacheEntry::vocache_entry_map_t& cache_entry_map);
+    // flag entries that were in the rendering pipeline on the last visit and restore their scene contribution.
+    // returns the number of entries flagged.
+    S32  readSceneSnapshot(U64 handle, const LLUUID& id, LLVOCacheEntry::vocache_entry_map_t& cache_entry_map);
 
     void writeToCache(U64 handle, const LLUUID& id, const LLVOCacheEntry::vocache_entry_map_t& cache_entry_map, bool dirty_cache, bool removal_enabled);
     void writeGenericExtrasToCache(U64 handle, const LLUUID& id, const LLVOCacheEntry::vocache_gltf_overrides_map_t& cache_extras_entry_map, bool dirty_cache, bool removal_enabled);
+    void writeSceneSnapshot(U64 handle, const LLUUID& id, const LLVOCacheEntry::vocache_entry_map_t& cache_entry_map);
     void removeEntry(U64 handle) ;
     void removeGenericExtrasForHandle(U64 handle);
 
     U32 getCacheEntries() { return mNumEntries; }
     U32 getCacheEntriesMax() { return mCacheSize; }
 
+    // the ObjectCacheMappedFiles setting is read at construction, tests switch formats here.
+    void setMappedFiles(bool mapped) { mMappedFiles = mapped; }
+
 private:
     void setDirNames(ELLPath location);
     // determine the cache filename for the region from the region handle
     void getObjectCacheFilename(U64 handle, std::string& filename);
     std::string getObjectCacheExtrasFilename(U64 handle);
+    std::string getSceneSnapshotFilename(U64 handle);
+    std::string getMappedCacheFilename(U64 handle);
+    bool readFromMappedFile(U64 handle, const LLUUID& id, LLVOCacheEntry::vocache_entry_map_t& cache_entry_map);
+    bool writeToMappedFile(U64 handle, const LLUUID& id, const LLVOCacheEntry::vocache_entry_map_t& cache_entry_map, bool removal_enabled);
     void removeFromCache(HeaderEntryInfo* entry);
     void readCacheHeader();
     void writeCacheHeader();
@@ -321,6 +342,7 @@ private:
     bool                 mEnabled;
     bool                 mInitialized ;
     bool                 mReadOnly ;
+    bool                 mMappedFiles; //use the memory mapped region file format.
     HeaderMetaInfo       mMetaInfo;
     U32                  mCacheSize;
     U32                  mNumEntries;
@@ -55,6 +55,7 @@
 #include "llhudmanager.h"
 #include "llflexibleobject.h"
 #include "llskinningutil.h"
+#include "llparallelfor.h"
 #include "llsky.h"
 #include "lltexturefetch.h"
 #include "llvector4a.h"
@@ -1837,6 +1838,36 @@ bool LLVOVolume::setParent(LLViewerObject* parent)
     return ret ;
 }
 
+// Faces must already have been regenerated if the face mapping changed.
+bool LLVOVolume::patchFaces()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+    for (S32 i = 0; i < mDrawable->getNumFaces(); ++i)
+    {
+        LLFace* facep = mDrawable->getFace(i);
+        if (facep && (!facep->getBatchKey() || facep->getBatchKey() != facep->calcBatchKey()))
+        {
+            return false;
+        }
+    }
+
+    // every face keeps its batch, so rebuildMesh() can rewrite them in
+    // their current buffer ranges (the group was made MESH_DIRTY by
+    // updateGeometry())
+    mDrawable->setState(LLDrawable::REBUILD_MATERIAL);
+    for (S32 i = 0; i < mDrawable->getNumFaces(); ++i)
+    {
+        LLFace* facep = mDrawable->getFace(i);
+        LLVertexBuffer* buff = facep ? facep->getVertexBuffer() : nullptr;
+        if (buff)
+        {
+            LLPipeline::sPatchedFaces++;
+            LLPipeline::sPatchedBytes += facep->getGeomCount() * LLVertexBuffer::calcVertexSize(buff->getTypeMask());
+        }
+    }
+    return true;
+}
+
 // NOTE: regenFaces() MUST be followed by genTriangles()!
 void LLVOVolume::regenFaces()
 {
@@ -2235,7 +2266,25 @@ bool LLVOVolume::updateGeometry(LLDrawable *drawable)
     // needed.
     bool should_update_octree_bounds = bool(getRiggedVolume()) || mDrawable->isState(LLDrawable::REBUILD_POSITION) || !mDrawable->getSpatialExtents()->isFinite3();
 
-    if (mVolumeChanged || mFaceMappingChanged)
+    static LLCachedControl<bool> incremental_rebuild(gSavedSettings, "RenderIncrementalGeometry", false);
+    bool patched = false;
+    bool faces_regenerated = false;
+    if (incremental_rebuild && !mVolumeChanged && !mLODChanged && !mSculptChanged &&
+        (mFaceMappingChanged || mColorChanged))
+    {
+        if (mFaceMappingChanged)
+        {
+            regenFaces();
+            faces_regenerated = true;
+        }
+        patched = patchFaces();
+    }
+
+    if (patched)
+    {
+        compiled = true;
+    }
+    else if (mVolumeChanged || mFaceMappingChanged)
     {
         dirtySpatialGroup();
 
@@ -2253,7 +2302,7 @@ bool LLVOVolume::updateGeometry(LLDrawable *drawable)
             was_regen_faces = lodOrSculptChanged(drawable, compiled, should_update_octree_bounds);
         }
 
-        if (!was_regen_faces) {
+        if (!was_regen_faces && !faces_regenerated) {
             regenFaces();
         }
     }
@@ -5166,11 +5215,16 @@ void LLRiggedVolume::update(
     LLMatrix4a mat[kMaxJoints];
     U32 maxJoints = LLSkinningUtil::getMeshJointCount(skin);
     LLSkinningUtil::initSkinningMatrixPalette(mat, maxJoints, skin, avatar);
-    const LLMatrix4a bind_shape_matrix = skin->mBindShapeMatrix;
+
+    // Fold the bind shape matrix in once rather than per vertex
+    LLMatrix4a palette[kMaxJoints];
+    LLSkinningUtil::initBindShapePalette(palette, mat, maxJoints, skin->mBindShapeMatrix);
 
     S32 rigged_vert_count = 0;
     S32 rigged_face_count = 0;
     LLVector4a box_min, box_max;
+    box_min.clear();
+    box_max.clear();
     S32 face_begin;
     S32 face_end;
     if (face_index == DO_NOT_UPDATE_FACES)
@@ -5188,111 +5242,82 @@ void LLRiggedVolume::update(
         face_begin = face_index;
         face_end = face_begin + 1;
     }
+
+    // Gather the faces to skin on this thread; weights checks and settings
+    // lookups aren't thread safe.
+    std::vector<S32> rigged_faces;
+    rigged_faces.reserve(face_end - face_begin);
     for (S32 i = face_begin; i < face_end; ++i)
     {
         const LLVolumeFace& vol_face = volume->getVolumeFace(i);
-
         LLVolumeFace& dst_face = mVolumeFaces[i];
 
-        LLVector4a* weight = vol_face.mWeights;
-
-        if ( weight )
+        if (vol_face.mWeights && dst_face.mPositions && dst_face.mExtents && dst_face.mNumVertices > 0)
         {
-            LLSkinningUtil::checkSkinWeights(weight, dst_face.mNumVertices, skin);
-
-            LLVector4a* pos = dst_face.mPositions;
-
-            if (pos && dst_face.mExtents)
-            {
-                U32 max_joints = LLSkinningUtil::getMaxJointCount();
-                rigged_vert_count += dst_face.mNumVertices;
-                rigged_face_count++;
+            LLSkinningUtil::checkSkinWeights(vol_face.mWeights, dst_face.mNumVertices, skin);
+            rigged_faces.push_back(i);
+            rigged_vert_count += dst_face.mNumVertices;
+        }
+    }
+    rigged_face_count = static_cast<S32>(rigged_faces.size());
 
-            #if USE_SEPARATE_JOINT_INDICES_AND_WEIGHTS
-                if (vol_face.mJointIndices) // fast path with preconditioned joint indices
-                {
-                    LLMatrix4a src[4];
-                    U8* joint_indices_cursor = vol_face.mJointIndices;
-                    LLVector4a* just_weights = vol_face.mJustWeights;
-                    for (U32 j = 0; j < dst_face.mNumVertices; ++j)
-                    {
-                        LLMatrix4a final_mat;
-                        F32* w = just_weights[j].getF32ptr();
-                        LLSkinningUtil::getPerVertexSkinMatrixWithIndices(w, joint_indices_cursor, mat, final_mat, src);
-                        joint_indices_cursor += 4;
-
-                        LLVector4a& v = vol_face.mPositions[j];
-                        LLVector4a t;
-                        LLVector4a dst;
-                        bind_shape_matrix.affineTransform(v, t);
-                        final_mat.affineTransform(t, dst);
-                        pos[j] = dst;
-                    }
-                }
-                else
-            #endif
-                {
-                    for (S32 j = 0; j < dst_face.mNumVertices; ++j)
-                    {
-                        LLMatrix4a final_mat;
-                        // <FS:ND> Use the SSE2 version
-                        // LLSkinningUtil::getPerVertexSkinMatrix(weight[j].getF32ptr(), mat, false, final_mat, max_joints);
-                        FSSkinningUtil::getPerVertexSkinMatrixSSE(weight[j], mat, false, final_mat, max_joints);
-                        // </FS:ND>
-
-                        LLVector4a& v = vol_face.mPositions[j];
-                        LLVector4a t;
-                        LLVector4a dst;
-                        bind_shape_matrix.affineTransform(v, t);
-                        final_mat.affineTransform(t, dst);
-                        pos[j] = dst;
-                    }
-                }
+    const U32 max_joints = LLSkinningUtil::getMaxJointCount();
+    auto skin_faces = [&](size_t begin, size_t end)
+    {
+        for (size_t f = begin; f < end; ++f)
+        {
+            const LLVolumeFace& vol_face = volume->getVolumeFace(rigged_faces[f]);
+            LLVolumeFace& dst_face = mVolumeFaces[rigged_faces[f]];
 
-                //update bounding box
-                // VFExtents change
-                LLVector4a& min = dst_face.mExtents[0];
-                LLVector4a& max = dst_face.mExtents[1];
+            //update bounding box
+            // VFExtents change
+            LLSkinningUtil::skinFacePositions(vol_face, palette, max_joints, dst_face.mPositions,
+                                              dst_face.mExtents[0], dst_face.mExtents[1]);
 
-                min = pos[0];
-                max = pos[1];
-                if (i==0)
-                {
-                    box_min = min;
-                    box_max = max;
-                }
+            dst_face.mCenter->setAdd(dst_face.mExtents[0], dst_face.mExtents[1]);
+            dst_face.mCenter->mul(0.5f);
+        }
+    };
 
-                for (S32 j = 1; j < dst_face.mNumVertices; ++j)
-                {
-                    min.setMin(min, pos[j]);
-                    max.setMax(max, pos[j]);
-                }
+    // Small attachments aren't worth the hand-off
+    static LLCachedControl<U32> parallel_verts(gSavedSettings, "RiggedVolumeParallelSkinningVertices", 16384);
+    if (parallel_verts && rigged_face_count > 1 && rigged_vert_count >= (S32)parallel_verts())
+    {
+        LL::parallelFor("General", rigged_faces.size(), 1, skin_faces);
+    }
+    else
+    {
+        skin_faces(0, rigged_faces.size());
+    }
 
-                box_min.setMin(min,box_min);
-                box_max.setMax(max,box_max);
+    static LLCachedControl<bool> debugOctree(gSavedSettings,"FSCreateOctreeLog");
+    for (S32 i : rigged_faces)
+    {
+        LLVolumeFace& dst_face = mVolumeFaces[i];
 
-                dst_face.mCenter->setAdd(dst_face.mExtents[0], dst_face.mExtents[1]);
-                dst_face.mCenter->mul(0.5f);
+        if (i == rigged_faces.front())
+        {
+            box_min = dst_face.mExtents[0];
+            box_max = dst_face.mExtents[1];
+        }
+        box_min.setMin(dst_face.mExtents[0], box_min);
+        box_max.setMax(dst_face.mExtents[1], box_max);
 
-            }
+        if (rebuild_face_octrees)
+        {
+            // The octree only serves ray queries; drop it and let
+            // LLVolume::lineSegmentIntersect() rebuild it if one comes.
+            dst_face.destroyOctree();
 
-            if (rebuild_face_octrees)
+            // <FS:ND> Create a debug log for octree insertions if requested.
+            bool _debugOT( debugOctree );
+            if( _debugOT )
             {
-                dst_face.destroyOctree();
-                // <FS:ND> Create a debug log for octree insertions if requested.
-                static LLCachedControl<bool> debugOctree(gSavedSettings,"FSCreateOctreeLog");
-                bool _debugOT( debugOctree );
-                if( _debugOT )
-                    nd::octree::debug::gOctreeDebug += 1;
-                // </FS:ND>
-
+                nd::octree::debug::gOctreeDebug += 1;
                 dst_face.createOctree();
-
-                // <FS:ND> Reset octree log
-                if( _debugOT )
-                    nd::octree::debug::gOctreeDebug -= 1;
-                // </FS:ND>
+                nd::octree::debug::gOctreeDebug -= 1;
             }
+            // </FS:ND>
         }
     }
     mExtraDebugText = llformat("rigged %d/%d - box (%f %f %f) (%f %f %f)",
@@ -5412,6 +5437,9 @@ LLFace** LLVolumeGeometryManager::sSpecFaces[2] = { NULL };
 LLFace** LLVolumeGeometryManager::sNormSpecFaces[2] = { NULL };
 LLFace** LLVolumeGeometryManager::sPbrFaces[2] = { NULL };
 LLFace** LLVolumeGeometryManager::sAlphaFaces[2] = { NULL };
+U32 LLVolumeGeometryManager::sPackDepth = 0;
+std::vector<LLFace*> LLVolumeGeometryManager::sPackFaces;
+std::vector<LLVolumeGeometryManager::PackBatch> LLVolumeGeometryManager::sPackBatches;
 
 LLVolumeGeometryManager::LLVolumeGeometryManager()
     : LLGeometryManager()
@@ -6316,6 +6344,8 @@ void LLVolumeGeometryManager::rebuildGeom(LLSpatialGroup* group)
 
     U32 geometryBytes = 0;
 
+    beginDeferredPacking();
+
     // generate render batches for static geometry
     U32 extra_mask = LLVertexBuffer::MAP_TEXTURE_INDEX;
     bool alpha_sort = true;
@@ -6336,8 +6366,13 @@ void LLVolumeGeometryManager::rebuildGeom(LLSpatialGroup* group)
         rigged = true;
     }
 
+    endDeferredPacking();
+
     group->mGeometryBytes = geometryBytes;
 
+    LLPipeline::sRebuiltGroups++;
+    LLPipeline::sRebuiltBytes += geometryBytes;
+
     {
         //drawables have been rebuilt, clear rebuild status
         for (LLSpatialGroup::element_iter drawable_iter = group->getDataBegin(); drawable_iter != group->getDataEnd(); ++drawable_iter)
@@ -6550,6 +6585,9 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
 
     bool flexi = false;
 
+    static LLCachedControl<bool> parallel_geometry(gSavedSettings, "RenderParallelGeometry", false);
+    const bool defer_packing = sPackDepth > 0 && parallel_geometry;
+
     while (face_iter != end_faces)
     {
         //pull off next face
@@ -6731,6 +6769,7 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
 
         U32 indices_index = 0;
         U16 index_offset = 0;
+        const U32 first_packed = (U32)sPackFaces.size();
 
         while (face_iter < i)
         {
@@ -6742,6 +6781,7 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
                 // Bulk allocation failed
                 facep->setVertexBuffer(buffer);
                 facep->setSize(0, 0); // mark as no geometry
+                facep->setBatchKey(0);
                 ++face_iter;
                 continue;
             }
@@ -6758,6 +6798,11 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
                 //for debugging, set last time face was updated vs moved
                 facep->updateRebuildFlags();
 
+                if (defer_packing && facep->canGetGeometryVolumeOffThread())
+                { //copied by packDeferred()
+                    sPackFaces.push_back(facep);
+                }
+                else
                 { //copy face geometry into vertex buffer
                     LLDrawable* drawablep = facep->getDrawable();
                     LLVOVolume* vobj = drawablep->getVOVolume();
@@ -7133,12 +7178,21 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
                 }
             }
 
+            facep->setBatchKey(facep->calcBatchKey());
+
             ++face_iter;
         }
 
         if (buffer)
         {
-            buffer->unmapBuffer();
+            if (sPackFaces.size() > first_packed)
+            { //upload once the deferred faces are in
+                sPackBatches.push_back({ buffer, first_packed, (U32)sPackFaces.size() - first_packed });
+            }
+            else
+            {
+                buffer->unmapBuffer();
+            }
         }
     }
 
@@ -7151,6 +7205,117 @@ U32 LLVolumeGeometryManager::genDrawInfo(LLSpatialGroup* group, U32 mask, LLFace
     return geometryBytes;
 }
 
+//static
+void LLVolumeGeometryManager::beginDeferredPacking()
+{
+    ++sPackDepth;
+}
+
+//static
+void LLVolumeGeometryManager::endDeferredPacking()
+{
+    llassert(sPackDepth > 0);
+    if (--sPackDepth == 0 && !sPackBatches.empty())
+    {
+        packDeferred();
+    }
+}
+
+static void pack_face(LLFace* facep)
+{
+    LLVOVolume* vobj = facep->getDrawable()->getVOVolume();
+    LLVolume* volume = vobj->getVolume();
+
+    if (!facep->getGeometryVolume(*volume, facep->getTEOffset(),
+        vobj->getRelativeXform(), vobj->getRelativeXformInvTrans(), facep->getGeomIndex(), true))
+    {
+        LL_WARNS() << "Failed to get geometry for face!" << LL_ENDL;
+    }
+}
+
+//static
+void LLVolumeGeometryManager::packDeferred()
+{
+    LL_PROFILE_ZONE_SCOPED_CATEGORY_VOLUME;
+
+    {
+        LL_PROFILE_ZONE_NAMED_CATEGORY_VOLUME("packDeferred - tangents");
+        // Objects of the same shape share an LLVolume, and getGeometryVolume()
+        // generates tangents on demand, so make them here before two batches
+        // can race to create them
+        for (const PackBatch& batch : sPackBatches)
+        {
+            const bool tangents = batch.mBuffer->getTypeMask() & LLVertexBuffer::MAP_TANGENT;
+            for (U32 i = batch.mFirstFace; i < batch.mFirstFace + batch.mFaceCount; ++i)
+            {
+                LLFace* facep = sPackFaces[i];
+                const LLTextureEntry* te = facep->getTextureEntry();
+                if (tangents || te->getBumpmap() || te->getTexGen() != LLTextureEntry::TEX_GEN_DEFAULT)
+                {
+                    facep->getViewerObject()->getVolume()->genTangents(facep->getTEOffset());
+                }
+            }
+        }
+    }
+
+    {
+        LL_PROFILE_ZONE_NAMED_CATEGORY_VOLUME("packDeferred - pack");
+        // one buffer per job, so each buffer's mapped region list is only
+        // touched by one thread
+        LL::parallelFor("General", sPackBatches.size(), 1, [](size_t begin, size_t end)
+            {
+                for (size_t b = begin; b < end; ++b)
+                {
+                    const PackBatch& batch = sPackBatches[b];
+                    for (U32 i = batch.mFirstFace; i < batch.mFirstFace + batch.mFaceCount; ++i)
+                    {
+                        pack_face(sPackFaces[i]);
+                    }
+                }
+            });
+    }
+
+    static LLCachedControl<bool> validate(gSavedSettings, "RenderParallelGeometryValidate", false);
+    if (validate)
+    {
+        LL_PROFILE_ZONE_NAMED_CATEGORY_VOLUME("packDeferred - validate");
+        // repack each buffer on this thread and compare with the jobs' output
+        std::vector<U8> vertices;
+        std::vector<U8> indices;
+        for (const PackBatch& batch : sPackBatches)
+        {
+            LLVertexBuffer* buffer = batch.mBuffer;
+            vertices.assign(buffer->getMappedData(), buffer->getMappedData() + buffer->getSize());
+            indices.assign(buffer->getMappedIndices(), buffer->getMappedIndices() + buffer->getIndicesSize());
+
+            for (U32 i = batch.mFirstFace; i < batch.mFirstFace + batch.mFaceCount; ++i)
+            {
+                pack_face(sPackFaces[i]);
+            }
+
+            if (memcmp(vertices.data(), buffer->getMappedData(), vertices.size()) ||
+                memcmp(indices.data(), buffer->getMappedIndices(), indices.size()))
+            {
+                LL_WARNS() << "Parallel packing differs from serial packing for a buffer of "
+                           << batch.mFaceCount << " faces, "
+                           << buffer->getNumVerts() << " vertices and "
+                           << buffer->getNumIndices() << " indices" << LL_ENDL;
+            }
+        }
+    }
+
+    {
+        LL_PROFILE_ZONE_NAMED_CATEGORY_VOLUME("packDeferred - upload");
+        for (const PackBatch& batch : sPackBatches)
+        {
+            batch.mBuffer->unmapBuffer();
+        }
+    }
+
+    sPackFaces.clear();
+    sPackBatches.clear();
+}
+
 void LLVolumeGeometryManager::addGeometryCount(LLSpatialGroup* group, U32& vertex_count, U32& index_count)
 {
     //for each drawable
@@ -250,6 +250,9 @@ public:
 
                 void    updateFaceFlags();
                 void    regenFaces();
+                // update faces in place if none of them changed batch, see LLFace::calcBatchKey().
+                // Call regenFaces() first if the face mapping changed.
+                bool    patchFaces();
                 bool    genBBoxes(bool force_global, bool should_update_octree_bounds = true);
                 void    preRebuild();
     virtual     void    updateSpatialExtents(LLVector4a& min, LLVector4a& max) override;
@@ -34,6 +34,7 @@
 #include "llviewercontrol.h"
 #include "llfasttimer.h"
 #include "llfontgl.h"
+#include "llframearena.h"
 #include "llnamevalue.h"
 #include "llpointer.h"
 #include "llprimitive.h"
@@ -101,6 +102,7 @@
 #include "llviewerdisplay.h"
 #include "llspatialpartition.h"
 #include "llmutelist.h"
+#include "llparallelfor.h"
 #include "lltoolpie.h"
 #include "llnotifications.h"
 #include "llpathinglib.h"
@@ -298,6 +300,10 @@ void display_update_camera();
 //----------------------------------------
 
 S32     LLPipeline::sCompiles = 0;
+S32     LLPipeline::sRebuiltGroups = 0;
+U64     LLPipeline::sRebuiltBytes = 0;
+S32     LLPipeline::sPatchedFaces = 0;
+U64     LLPipeline::sPatchedBytes = 0;
 
 bool    LLPipeline::sPickAvatar = true;
 bool    LLPipeline::sDynamicLOD = true;
@@ -1933,6 +1939,10 @@ void LLPipeline::resetFrameStats()
     assertInitialized();
 
     sCompiles        = 0;
+    sRebuiltGroups   = 0;
+    sRebuiltBytes    = 0;
+    sPatchedFaces    = 0;
+    sPatchedBytes    = 0;
     mNumVisibleFaces = 0;
 
     if (mOldRenderDebugMask != mRenderDebugMask)
@@ -2444,6 +2454,50 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result, bool hud_att
 
     sCull->clear();
 
+    auto should_cull = [this, hud_attachments](U32 i, LLSpatialPartition* part)
+    {
+        return part && (!hud_attachments ? LLViewerRegion::PARTITION_BRIDGE == i || hasRenderType(part->mDrawableType) : hasRenderType(part->mDrawableType));
+    };
+
+    // The frustum tests of independent partitions can run as parallel jobs.
+    // Everything else culling does (occlusion queries, marking groups
+    // visible, filling sCull) is then applied on this thread, in the same
+    // order as a serial cull.
+    static LLCachedControl<bool> parallel_cull(gSavedSettings, "RenderParallelCull", false);
+    static std::vector<LLSpatialPartition*> cull_parts;
+    static std::vector<LLViewerOctreeCull::cull_node_list_t> cull_nodes;
+    cull_parts.clear();
+    if (parallel_cull)
+    {
+        for (LLViewerRegion* region : LLWorld::getInstance()->getRegionList())
+        {
+            for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
+            {
+                LLSpatialPartition* part = region->getSpatialPartition(i);
+                if (should_cull(i, part))
+                {
+                    part->prepareCull();
+                    cull_parts.push_back(part);
+                }
+            }
+        }
+
+        if (cull_nodes.size() < cull_parts.size())
+        {
+            cull_nodes.resize(cull_parts.size());
+        }
+
+        LL_PROFILE_ZONE_NAMED_CATEGORY_PIPELINE("updateCull - gather");
+        LL::parallelFor("General", cull_parts.size(), 1, [&camera](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                cull_parts[i]->gatherCull(camera, cull_nodes[i]);
+            }
+        });
+    }
+
+    size_t part_index = 0;
     for (LLWorld::region_list_t::const_iterator iter = LLWorld::getInstance()->getRegionList().begin();
             iter != LLWorld::getInstance()->getRegionList().end(); ++iter)
     {
@@ -2452,9 +2506,14 @@ void LLPipeline::updateCull(LLCamera& camera, LLCullResult& result, bool hud_att
         for (U32 i = 0; i < LLViewerRegion::NUM_PARTITIONS; i++)
         {
             LLSpatialPartition* part = region->getSpatialPartition(i);
-            if (part)
+            if (should_cull(i, part))
             {
-                if (!hud_attachments ? LLViewerRegion::PARTITION_BRIDGE == i || hasRenderType(part->mDrawableType) : hasRenderType(part->mDrawableType))
+                if (part_index < cull_parts.size())
+                {
+                    llassert(cull_parts[part_index] == part);
+                    part->cull(camera, cull_nodes[part_index++]);
+                }
+                else
                 {
                     part->cull(camera);
                 }
@@ -2750,6 +2809,7 @@ void LLPipeline::rebuildPriorityGroups()
     gMeshRepo.notifyLoadedMeshes();
 
     mGroupQ1Locked = true;
+    LLVolumeGeometryManager::beginDeferredPacking();
     // Iterate through all drawables on the priority build queue,
     for (LLSpatialGroup::sg_vector_t::iterator iter = mGroupQ1.begin();
          iter != mGroupQ1.end(); ++iter)
@@ -2758,6 +2818,7 @@ void LLPipeline::rebuildPriorityGroups()
         group->rebuildGeom();
         group->clearState(LLSpatialGroup::IN_BUILD_Q1);
     }
+    LLVolumeGeometryManager::endDeferredPacking();
 
     mGroupSaveQ1 = mGroupQ1;
     mGroupQ1.clear();
@@ -3526,6 +3587,7 @@ void LLPipeline::postSort(LLCamera &camera)
     if (!gCubeSnapshot)
     {
         // rebuild drawable geometry
+        LLVolumeGeometryManager::beginDeferredPacking();
         for (LLCullResult::sg_iterator i = sCull->beginDrawableGroups(); i != sCull->endDrawableGroups(); ++i)
         {
             LLSpatialGroup *group = *i;
@@ -3538,6 +3600,7 @@ void LLPipeline::postSort(LLCamera &camera)
                 group->rebuildGeom();
             }
         }
+        LLVolumeGeometryManager::endDeferredPacking();
         LL_PUSH_CALLSTACKS();
         // rebuild groups
         sCull->assertDrawMapsEmpty();
@@ -8312,9 +8375,12 @@ void LLPipeline::renderDeferredLighting()
         if (local_light_count > 0)
         {
             gGL.setSceneBlendType(LLRender::BT_ADD);
-            std::list<LLVector4>        fullscreen_lights;
-            LLDrawable::drawable_list_t spot_lights;
-            LLDrawable::drawable_list_t fullscreen_spot_lights;
+            // Rebuilt every frame, so kept in the frame arena.  Lights are
+            // held by mNearbyLights, plain pointers are enough here.
+            typedef LLFrameVector<LLDrawable*> light_list_t;
+            LLFrameList<LLVector4>      fullscreen_lights;
+            light_list_t                spot_lights;
+            light_list_t                fullscreen_spot_lights;
 
             if (!gCubeSnapshot)
             {
@@ -8324,7 +8390,7 @@ void LLPipeline::renderDeferredLighting()
                 }
             }
 
-            std::list<LLVector4> light_colors;
+            LLFrameList<LLVector4> light_colors;
 
             LLVertexBuffer::unbind();
 
@@ -8454,7 +8520,7 @@ void LLPipeline::renderDeferredLighting()
 
                 gDeferredSpotLightProgram.enableTexture(LLShaderMgr::DEFERRED_PROJECTION);
 
-                for (LLDrawable::drawable_list_t::iterator iter = spot_lights.begin(); iter != spot_lights.end(); ++iter)
+                for (light_list_t::iterator iter = spot_lights.begin(); iter != spot_lights.end(); ++iter)
                 {
                     LLDrawable *drawablep = *iter;
 
@@ -8528,7 +8594,7 @@ void LLPipeline::renderDeferredLighting()
 
                 mScreenTriangleVB->setBuffer();
 
-                for (LLDrawable::drawable_list_t::iterator iter = fullscreen_spot_lights.begin(); iter != fullscreen_spot_lights.end(); ++iter)
+                for (light_list_t::iterator iter = fullscreen_spot_lights.begin(); iter != fullscreen_spot_lights.end(); ++iter)
                 {
                     LLDrawable* drawablep = *iter;
                     LLVOVolume* volume = drawablep->getVOVolume();
@@ -9367,7 +9433,7 @@ bool LLPipeline::getVisiblePointCloud(LLCamera& camera, LLVector3& min, LLVector
         LLPlane(max, LLVector3(0,0,1))};
 
     //potential points
-    std::vector<LLVector3> pp;
+    LLFrameVector<LLVector3> pp;
 
     //add corners of AABB
     pp.push_back(LLVector3(min.mV[0], min.mV[1], min.mV[2]));
@@ -9906,7 +9972,7 @@ void LLPipeline::generateSunShadow(LLCamera& camera)
             //get a temporary view projection
             view[j] = look(camera.getOrigin(), lightDir, -up);
 
-            std::vector<LLVector3> wpf;
+            LLFrameVector<LLVector3> wpf;
 
             for (U32 i = 0; i < fp.size(); i++)
             {
@@ -655,6 +655,10 @@ public:
     S32                     mPoissonOffset;
 
     static S32              sCompiles;
+    static S32              sRebuiltGroups;     // volume groups rebuilt this frame
+    static U64              sRebuiltBytes;      // vertex and index bytes of their buffers
+    static S32              sPatchedFaces;      // faces updated in place instead
+    static U64              sPatchedBytes;
 
     static bool             sShowHUDAttachments;
     static bool             sForceOldBakedUpload; // If true will not use capabilities to upload baked textures.
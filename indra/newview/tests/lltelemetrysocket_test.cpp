@@ -0,0 +1,138 @@
+/**
+ * @file lltelemetrysocket_test.cpp
+ * @brief Test for lltelemetrysocket
+ *
+ * $LicenseInfo:firstyear=2026&license=fsviewerlgpl$
+ * Phoenix qikfox3D Viewer Source Code
+ * Copyright (C) 2026, The Phoenix qikfox3D Project, Inc.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation;
+ * version 2.1 of the License only.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ *
+ * The Phoenix qikfox3D Project, Inc., 1831 Oakwood Drive, Fairmont, Minnesota 56031-3225 USA
+ * http://www.firestormviewer.org
+ * $/LicenseInfo$
+ */
+
+// Precompiled header
+#include "linden_common.h"
+// associated header
+#include "../lltelemetrysocket.h"
+// STL headers
+#include <string>
+// std headers
+#if LL_LINUX || LL_DARWIN
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+// other Linden headers
+#include "../test/lltut.h"
+
+/*****************************************************************************
+*   TUT
+*****************************************************************************/
+namespace tut
+{
+    struct lltelemetrysocket_data
+    {
+        lltelemetrysocket_data():
+            socket("")
+        {
+#if LL_LINUX || LL_DARWIN
+            int fds[2];
+            ensure("socketpair", socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+            socket.attach(fds[0]);
+            reader = fds[1];
+            fcntl(reader, F_SETFL, fcntl(reader, F_GETFL) | O_NONBLOCK);
+#endif
+        }
+
+        ~lltelemetrysocket_data()
+        {
+#if LL_LINUX || LL_DARWIN
+            ::close(reader);
+#endif
+        }
+
+        // Everything the collector can read right now
+        std::string drain()
+        {
+            std::string received;
+#if LL_LINUX || LL_DARWIN
+            char buf[65536];
+            ssize_t got;
+            while ((got = ::read(reader, buf, sizeof(buf))) > 0)
+            {
+                received.append(buf, got);
+            }
+#endif
+            return received;
+        }
+
+        LLTelemetrySocket socket;
+        int reader = -1;
+    };
+    typedef test_group<lltelemetrysocket_data> lltelemetrysocket_group;
+    typedef lltelemetrysocket_group::object object;
+    lltelemetrysocket_group lltelemetrysocketgrp("lltelemetrysocket");
+
+    template<> template<>
+    void object::test<1>()
+    {
+        set_test_name("a partly sent line survives a full socket");
+#if LL_LINUX || LL_DARWIN
+        // far longer than any socket buffer, so it can only go out in part
+        const std::string long_line = std::string(4 * 1024 * 1024, 'x') + "\n";
+        std::string pending = long_line;
+        socket.send(pending);
+        ensure("part of the line was sent", !pending.empty() && pending.size() < long_line.size());
+        const std::string tail = pending;
+
+        // the buffer is still full, so nothing goes out this time: the
+        // rest of the long line must be kept and the new line dropped
+        pending += "{\"dropped\":true}\n";
+        socket.send(pending);
+        ensure_equals("tail kept, new line dropped", pending, tail);
+
+        std::string received;
+        for (int i = 0; i < 1000 && !pending.empty(); ++i)
+        {
+            received += drain();
+            socket.send(pending);
+        }
+        ensure("tail sent", pending.empty());
+        received += drain();
+        ensure_equals("whole line received", received.size(), long_line.size());
+        ensure("same line", received == long_line);
+
+        pending = "{\"next\":1}\n";
+        socket.send(pending);
+        ensure_equals("next line follows", drain(), std::string("{\"next\":1}\n"));
+#else
+        skip("UNIX domain sockets only");
+#endif
+    }
+
+    template<> template<>
+    void object::test<2>()
+    {
+        set_test_name("output is discarded while nothing listens");
+        LLTelemetrySocket unconnected("");
+        std::string pending = "{\"a\":1}\n";
+        unconnected.send(pending);
+        ensure("discarded", pending.empty());
+        ensure("not connected", !unconnected.isConnected());
+    }
+} // namespace tut
@@ -35,6 +35,8 @@
 #include "llregionhandle.h"
 #include "llsdutil.h"
 #include "llsdserialize.h"
+#include "lldatapacker.h"
+#include "llfile.h"
 
 #include "../llviewerobjectlist.h"
 #include "../llviewerregion.h"
@@ -44,7 +46,40 @@
 
 namespace
 {
+    // A few entries with distinct bodies, as the region would hand them to writeToCache()
+    void make_entries(LLVOCacheEntry::vocache_entry_map_t& entries)
+    {
+        for (U32 local_id = 1; local_id <= 3; ++local_id)
+        {
+            U8 body[64];
+            S32 size = 16 * (S32)local_id;
+            for (S32 i = 0; i < size; ++i)
+            {
+                body[i] = (U8)(local_id * 31 + i);
+            }
+            LLDataPackerBinaryBuffer dp(body, size);
+            entries[local_id] = new LLVOCacheEntry(local_id, 1000 + local_id, dp);
+        }
+    }
 
+    // Where LLVOCache keeps the mapped file of a region
+    std::string mapped_filename(U32 region_x, U32 region_y)
+    {
+        return gDirUtilp->getExpandedFilename(LL_PATH_CACHE, "objectcache",
+                                              llformat("objects_%d_%d.slcm", region_x, region_y));
+    }
+
+    std::vector<U8> read_file(const std::string& filename)
+    {
+        llifstream in(filename, std::ios::in | std::ios::binary);
+        return std::vector<U8>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    void write_file(const std::string& filename, const std::vector<U8>& data)
+    {
+        llofstream out(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        out.write((const char*)data.data(), data.size());
+    }
 }
 
 
@@ -144,4 +179,98 @@ namespace tut
 
         LLVOCache::instance().readGenericExtrasFromCache(region_handle, region_id, extras);
     }
+
+    template<> template<>
+    void vocacheTestObject::test<3>()
+    {
+        // mapped region file: what is written reads back, bodies decoded on first use
+        LLVOCache& cache = LLVOCache::instance();
+        cache.setMappedFiles(true);
+
+        U64 region_handle = to_region_handle(256 * 1000, 256 * 1001);
+        LLUUID region_id = LLUUID::generateNewID();
+
+        LLVOCacheEntry::vocache_entry_map_t written;
+        make_entries(written);
+        cache.writeToCache(region_handle, region_id, written, true, false);
+        ensure("mapped file written", LLFile::isfile(mapped_filename(1000, 1001)));
+
+        LLVOCacheEntry::vocache_entry_map_t read;
+        ensure("read succeeds", cache.readFromCache(region_handle, region_id, read));
+        ensure_equals("entry count", read.size(), written.size());
+        for (auto& pair : written)
+        {
+            LLVOCacheEntry::vocache_entry_map_t::iterator found = read.find(pair.first);
+            ensure("entry read back", found != read.end());
+            LLVOCacheEntry* entry = found->second;
+            ensure("body left in the file", entry->isMapped());
+            ensure_equals("crc", entry->getCRC(), pair.second->getCRC());
+
+            LLDataPackerBinaryBuffer* expected = pair.second->getDP();
+            LLDataPackerBinaryBuffer* dp = entry->getDP();
+            ensure("body decoded", dp != NULL && !entry->isMapped());
+            ensure_equals("body size", dp->getBufferSize(), expected->getBufferSize());
+            ensure("body bytes", !memcmp(dp->getBuffer(), expected->getBuffer(), dp->getBufferSize()));
+        }
+
+        cache.setMappedFiles(false);
+    }
+
+    template<> template<>
+    void vocacheTestObject::test<4>()
+    {
+        // a mapped region file cut short is discarded, not read
+        LLVOCache& cache = LLVOCache::instance();
+        cache.setMappedFiles(true);
+
+        U64 region_handle = to_region_handle(256 * 1002, 256 * 1003);
+        LLUUID region_id = LLUUID::generateNewID();
+        std::string filename(mapped_filename(1002, 1003));
+
+        LLVOCacheEntry::vocache_entry_map_t written;
+        make_entries(written);
+        cache.writeToCache(region_handle, region_id, written, true, false);
+
+        std::vector<U8> data(read_file(filename));
+        ensure("mapped file written", data.size() > 64);
+        data.resize(data.size() / 2);
+        write_file(filename, data);
+
+        LLVOCacheEntry::vocache_entry_map_t read;
+        ensure("truncated read fails", !cache.readFromCache(region_handle, region_id, read));
+        ensure("no entries", read.empty());
+
+        cache.setMappedFiles(false);
+    }
+
+    template<> template<>
+    void vocacheTestObject::test<5>()
+    {
+        // a mapped region file of another format version is discarded, not read
+        LLVOCache& cache = LLVOCache::instance();
+        cache.setMappedFiles(true);
+
+        U64 region_handle = to_region_handle(256 * 1004, 256 * 1005);
+        LLUUID region_id = LLUUID::generateNewID();
+        std::string filename(mapped_filename(1004, 1005));
+
+        LLVOCacheEntry::vocache_entry_map_t written;
+        make_entries(written);
+        cache.writeToCache(region_handle, region_id, written, true, false);
+
+        // header is magic, then version
+        std::vector<U8> data(read_file(filename));
+        ensure("mapped file written", data.size() > 8);
+        U32 version;
+        memcpy(&version, &data[4], sizeof(U32));
+        ++version;
+        memcpy(&data[4], &version, sizeof(U32));
+        write_file(filename, data);
+
+        LLVOCacheEntry::vocache_entry_map_t read;
+        ensure("bad version read fails", !cache.readFromCache(region_handle, region_id, read));
+        ensure("no entries", read.empty());
+
+        cache.setMappedFiles(false);
+    }
 }